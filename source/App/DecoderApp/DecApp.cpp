@@ -566,6 +566,10 @@ void DecApp::xCreateDecLib()
   initROM();
 
   // create decoder class
+  m_cDecLib.setNumSubstreamThreads( m_numSubstreamThreads );
+  m_cDecLib.setParseAhead( m_parseAhead );
+  m_cDecLib.setPicturePipeline( m_picturePipeline );
+  m_cDecLib.setNumLoopFilterThreads( m_numLoopFilterThreads );
   m_cDecLib.create();
 
   // initialize decoder class
@@ -688,6 +692,8 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           (!(pcPicTop->getPOC()%2) && pcPicBottom->getPOC() == pcPicTop->getPOC()+1) &&
           (pcPicTop->getPOC() == m_iPOCLastDisplay+1 || m_iPOCLastDisplay < 0))
       {
+        pcPicTop->ctuRowProgress.waitForLumaRow( MAX_INT );
+        pcPicBottom->ctuRowProgress.waitForLumaRow( MAX_INT );
         // write to file
         numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
         if ( !m_reconFileName.empty() )
@@ -740,6 +746,12 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
       if(pcPic->neededForOutput && pcPic->getPOC() >= m_iPOCLastDisplay &&
         (numPicsNotYetDisplayed >  maxNumReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid))
       {
+        if( !pcPic->ctuRowProgress.isFinished() )
+        {
+          // still in-loop filtered, it and the pictures following in output order are written later
+          break;
+        }
+
         // write to file
         numPicsNotYetDisplayed--;
         if (!pcPic->referenced)
@@ -812,6 +824,9 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
  */
 void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
 {
+  // pictures may still be in-loop filtered
+  m_cDecLib.waitForPostFilter();
+
   if(!pcListPic || pcListPic->empty())
   {
     return;
@@ -873,16 +888,14 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
 
         if(pcPicTop)
         {
-          pcPicTop->destroy();
-          delete pcPicTop;
+          m_cDecLib.releasePicBuffer( pcPicTop );
           pcPicTop = NULL;
         }
       }
     }
     if(pcPicBottom)
     {
-      pcPicBottom->destroy();
-      delete pcPicBottom;
+      m_cDecLib.releasePicBuffer( pcPicBottom );
       pcPicBottom = NULL;
     }
   }
@@ -956,8 +969,7 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
       }
       if(pcPic != NULL)
       {
-        pcPic->destroy();
-        delete pcPic;
+        m_cDecLib.releasePicBuffer( pcPic );
         pcPic = NULL;
         *iterPic = nullptr;
       }
@@ -80,7 +80,7 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("OplFile,-opl",              m_oplFilename ,                        string(""), "opl-file name without extension for conformance testing\n")
 
 #if ENABLE_SIMD_OPT
-  ("SIMD",                      ignore,                                string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension\n")
+  ("SIMD",                      ignore,                                string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), capped at the highest extension supported by the CPU; default: the highest supported extension\n")
 #endif
 
   ("WarnUnknowParameter,w",     warnUnknowParameter,                   0,          "warn for unknown configuration parameters instead of failing")
@@ -122,6 +122,10 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("MCTSCheck",                m_mctsCheck,                           false,       "If enabled, the decoder checks for violations of mc_exact_sample_value_match_flag in Temporal MCTS ")
   ("targetSubPicIdx",          m_targetSubPicIdx,                     0,           "Specify which subpicture shall be written to output, using subpic index, 0: disabled, subpicIdx=m_targetSubPicIdx-1 \n" )
   ( "UpscaledOutput",          m_upscaledOutput,                          0,       "Upscaled output for RPR" )
+  ("NumSubstreamThreads",      m_numSubstreamThreads,                 1,           "Number of threads decoding the substreams (WPP CTU rows or tiles) of a slice in parallel")
+  ("ParseAhead",               m_parseAhead,                          false,       "Parse the CTUs of a slice on a separate thread ahead of their prediction and reconstruction, for slices whose substreams are not decoded in parallel")
+  ("PicturePipeline",          m_picturePipeline,                     false,       "In-loop filter each picture on a separate thread while the next picture is decoded, which waits for the reference CTU rows it uses")
+  ("LoopFilterThreads",        m_numLoopFilterThreads,                1,           "Number of threads applying deblocking, SAO and ALF to the CTU rows of a picture in a wavefront")
 #if GDR_LEAK_TEST
   ("RandomAccessPos",          m_gdrPocRandomAccess,                    0,         "POC of GDR Random access picture\n" )
 #endif // GDR_LEAK_TEST
@@ -181,6 +185,18 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     return false;
   }
 
+  if (m_numSubstreamThreads < 1)
+  {
+    msg( ERROR, "NumSubstreamThreads must be at least 1, aborting\n");
+    return false;
+  }
+
+  if (m_numLoopFilterThreads < 1)
+  {
+    msg( ERROR, "LoopFilterThreads must be at least 1, aborting\n");
+    return false;
+  }
+
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
     FILE* targetDecLayerIdSetFile = fopen ( cfg_TargetDecLayerIdSetFile.c_str(), "r" );
@@ -89,6 +89,10 @@ protected:
 
   int          m_upscaledOutput;                     ////< Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR.
   int           m_targetSubPicIdx;                    ///< Specify which subpicture shall be write to output, using subpicture index
+  int           m_numSubstreamThreads;                ///< number of threads decoding the substreams of a slice in parallel
+  bool          m_parseAhead;                         ///< parse the CTUs of a slice on a separate thread ahead of their reconstruction
+  bool          m_picturePipeline;                    ///< in-loop filter a picture on a separate thread while the next one is decoded
+  int           m_numLoopFilterThreads;               ///< number of threads in-loop filtering the CTU rows of a picture
 #if GDR_LEAK_TEST
   int           m_gdrPocRandomAccess;                   ///<
 #endif // GDR_LEAK_TEST
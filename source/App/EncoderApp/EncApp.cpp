@@ -261,6 +261,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setPrintMSSSIM                                       ( m_printMSSSIM );
   m_cEncLib.setPrintWPSNR                                        ( m_printWPSNR );
   m_cEncLib.setCabacZeroWordPaddingEnabled                       ( m_cabacZeroWordPaddingEnabled );
+  m_cEncLib.setCabacInitPresent                                  ( m_cabacInitPresent );
 
   m_cEncLib.setFrameRate                                         ( m_iFrameRate );
   m_cEncLib.setFrameSkip                                         ( m_FrameSkip );
@@ -1103,6 +1104,19 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setDriSEINonlinearModel                              (m_driSEINonlinearModel);
   m_cEncLib.setEntropyCodingSyncEnabledFlag                      ( m_entropyCodingSyncEnabledFlag );
   m_cEncLib.setEntryPointPresentFlag                             ( m_entryPointPresentFlag );
+  m_cEncLib.setNumWppThreads                                     ( m_numWppThreads );
+  m_cEncLib.setNumSplitThreads                                   ( m_numSplitThreads );
+  m_cEncLib.setNumFrameThreads                                   ( m_numFrameThreads );
+  m_cEncLib.setLowMemoryMode                                     ( m_lowMemoryMode );
+#if ENABLE_8BIT_REFERENCES
+  // the 8-bit planes replace the reconstruction of a finished picture, so nothing but the inter prediction of
+  // later pictures of the same layer may read it: no reconstruction file, no resolution change, wrap-around padding,
+  // subpicture padding, weighted prediction, hash ME or composite reference
+  m_cEncLib.setUse8bitRefPics                                    ( m_internalBitDepth[CHANNEL_TYPE_LUMA] == 8 && m_internalBitDepth[CHANNEL_TYPE_CHROMA] == 8
+                                                                   && m_reconFileName.empty() && !m_isField && !m_resChangeInClvsEnabled
+                                                                   && !m_wrapAround && !m_subPicInfoPresentFlag && !m_useWeightedPred && !m_useWeightedBiPred
+                                                                   && !m_HashME && !m_compositeRefEnabled && m_maxLayers == 1 );
+#endif
   m_cEncLib.setTMVPModeId                                        ( m_TMVPModeId );
   m_cEncLib.setSliceLevelRpl                                     ( m_sliceLevelRpl  );
   m_cEncLib.setSliceLevelDblk                                    ( m_sliceLevelDblk );
@@ -1357,6 +1371,14 @@ void EncApp::destroyLib()
   printf( "\nLayerId %2d", m_cEncLib.getLayerId() );
 
   m_cEncLib.printSummary( m_isField );
+#if ENABLE_8BIT_REFERENCES
+  if( m_lowMemoryMode || m_cEncLib.getUse8bitRefPics() )
+#else
+  if( m_lowMemoryMode )
+#endif
+  {
+    PicPlaneMemory::printReport( INFO );
+  }
 
   // delete used buffers in encoder class
   m_cEncLib.deletePicBuffer();
@@ -772,7 +772,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("WarnUnknowParameter,w",                           warnUnknowParameter,                                  0, "warn for unknown configuration parameters instead of failing")
   ("isSDR",                                           sdr,                                              false, "compatibility")
 #if ENABLE_SIMD_OPT
-  ("SIMD",                                            ignore,                                      string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension\n")
+  ("SIMD",                                            ignore,                                      string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), capped at the highest extension supported by the CPU; default: the highest supported extension\n")
 #endif
   // File, I/O and source parameters
   ("InputFile,i",                                     m_inputFileName,                             string(""), "Original YUV input file name")
@@ -805,6 +805,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("PrintMSSSIM",                                     m_printMSSSIM,                                    false, "0 (default) do not print MS-SSIM scores, 1 = print MS-SSIM scores for each frame and for the whole sequence")
   ("PrintWPSNR",                                      m_printWPSNR,                                     false, "0 (default) do not print HDR-PQ based wPSNR, 1 = print HDR-PQ based wPSNR")
   ("CabacZeroWordPaddingEnabled",                     m_cabacZeroWordPaddingEnabled,                     true, "0 do not add conforming cabac-zero-words to bit streams, 1 (default) = add cabac-zero-words as required")
+  ("CabacInitPresent",                                m_cabacInitPresent,          bool( CABAC_INIT_PRESENT_FLAG ), "0 always use the CABAC initialization table of the slice type, 1 (default) = signal cabac_init_flag and choose the table from the previous slice")
   ("ChromaFormatIDC,-cf",                             tmpChromaFormat,                                      0, "ChromaFormatIDC (400|420|422|444 or set 0 (default) for same as InputChromaFormat)")
   ("ConformanceWindowMode",                           m_conformanceWindowMode,                              1, "Window conformance mode (0: no window, 1:automatic padding (default), 2:padding parameters specified, 3:conformance window parameters specified")
   ("HorizontalPadding,-pdx",                          m_sourcePadding[0],                                   0, "Horizontal source padding for conformance window mode 2")
@@ -1253,6 +1254,10 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("Log2ParallelMergeLevel",                          m_log2ParallelMergeLevel,                            2u, "Parallel merge estimation region")
   ("WaveFrontSynchro",                                m_entropyCodingSyncEnabledFlag,                   false, "0: entropy coding sync disabled; 1 entropy coding sync enabled")
   ("EntryPointsPresent",                              m_entryPointPresentFlag,                           true, "0: entry points is not present; 1 entry points may be present in slice header")
+  ("NumWppThreads",                                   m_numWppThreads,                                      1, "Number of threads encoding CTU rows in parallel, requires WaveFrontSynchro (1: single-threaded CTU encoding)")
+  ("NumSplitThreads",                                 m_numSplitThreads,                                    1, "Number of threads evaluating sibling split modes in parallel at the first CU level offering more than one split (1: serial split evaluation). The split modes do not see the fast-decision caches filled by their siblings, which costs about 1-2% bit rate in RA, the bitstream is the same for any value above 1")
+  ("NumFrameThreads",                                 m_numFrameThreads,                                    1, "Number of threads encoding pictures of a GOP in parallel, a picture starts once its reference pictures are finished (1: one picture at a time). Requires CabacInitPresent=0 and AMaxBT=0, the bitstream is the same for any value")
+  ("LowMemoryMode",                                   m_lowMemoryMode,                                  false, "Allocate the wrap-around reconstruction only when the SPS enables it and release the original planes of a picture once it is encoded (kept with field coding, hash ME and composite references); reports the peak picture memory per plane type")
   ("ScalingList",                                     m_useScalingListId,                    SCALING_LIST_OFF, "0/off: no scaling list, 1/default: default scaling lists, 2/file: scaling lists specified in ScalingListFile")
   ("ScalingListFile",                                 m_scalingListFileName,                       string(""), "Scaling list file name. Use an empty string to produce help.")
   ("DisableScalingMatrixForLFNST",                    m_disableScalingMatrixForLfnstBlks,                true, "Disable scaling matrices, when enabled, for LFNST-coded blocks")
@@ -3212,6 +3217,49 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_lumaLevelToDeltaQPMapping.mode && m_uiDeltaQpRD > 0,                      "Luma-level-based Delta QP cannot be used together with slice level multiple-QP optimization\n" );
   xConfirmPara( m_lumaLevelToDeltaQPMapping.mode && m_RCEnableRateControl,                  "Luma-level-based Delta QP cannot be used together with rate control\n" );
 #endif
+  xConfirmPara( m_numWppThreads < 1,                                                         "NumWppThreads must be greater than or equal to 1" );
+  if( m_numWppThreads > 1 )
+  {
+    xConfirmPara( !m_entropyCodingSyncEnabledFlag,                                          "NumWppThreads > 1 requires WaveFrontSynchro to be enabled" );
+    xConfirmPara( m_RCEnableRateControl,                                                    "NumWppThreads > 1 cannot be used together with rate control" );
+    xConfirmPara( m_bUsePerceptQPA,                                                         "NumWppThreads > 1 cannot be used together with perceptual QPA" );
+    xConfirmPara( m_wcgChromaQpControl.isEnabled(),                                         "NumWppThreads > 1 cannot be used together with WCG chroma QP control" );
+    xConfirmPara( m_IBCMode || m_PLTMode,                                                   "NumWppThreads > 1 cannot be used together with IBC or palette mode" );
+    xConfirmPara( m_encDbOpt,                                                               "NumWppThreads > 1 cannot be used together with EncDbOpt" );
+    xConfirmPara( m_MCTSEncConstraint,                                                      "NumWppThreads > 1 cannot be used together with MCTS encoder constraints" );
+    xConfirmPara( m_tsrcRicePresentFlag,                                                    "NumWppThreads > 1 cannot be used together with TSRC Rice parameter signalling" );
+  }
+  xConfirmPara( m_numSplitThreads < 1,                                                       "NumSplitThreads must be greater than or equal to 1" );
+  if( m_numSplitThreads > 1 )
+  {
+    xConfirmPara( m_numWppThreads > 1,                                                      "NumSplitThreads > 1 cannot be used together with NumWppThreads > 1" );
+    xConfirmPara( m_RCEnableRateControl,                                                    "NumSplitThreads > 1 cannot be used together with rate control" );
+    xConfirmPara( m_bUsePerceptQPA,                                                         "NumSplitThreads > 1 cannot be used together with perceptual QPA" );
+    xConfirmPara( m_wcgChromaQpControl.isEnabled(),                                         "NumSplitThreads > 1 cannot be used together with WCG chroma QP control" );
+    xConfirmPara( m_IBCMode || m_PLTMode,                                                   "NumSplitThreads > 1 cannot be used together with IBC or palette mode" );
+    xConfirmPara( m_useColorTrans,                                                          "NumSplitThreads > 1 cannot be used together with the adaptive color transform" );
+    xConfirmPara( m_encDbOpt,                                                               "NumSplitThreads > 1 cannot be used together with EncDbOpt" );
+    xConfirmPara( m_MCTSEncConstraint,                                                      "NumSplitThreads > 1 cannot be used together with MCTS encoder constraints" );
+  }
+  xConfirmPara( m_numFrameThreads < 1,                                                       "NumFrameThreads must be greater than or equal to 1" );
+  if( m_numFrameThreads > 1 )
+  {
+    xConfirmPara( m_numWppThreads > 1 || m_numSplitThreads > 1,                             "NumFrameThreads > 1 cannot be used together with NumWppThreads > 1 or NumSplitThreads > 1" );
+    xConfirmPara( m_cabacInitPresent,                                                       "NumFrameThreads > 1 requires CabacInitPresent=0, the table of a slice would depend on the previous picture" );
+    xConfirmPara( m_useAMaxBT,                                                              "NumFrameThreads > 1 requires AMaxBT=0, the BT size of a picture would depend on the previous pictures" );
+    xConfirmPara( m_lmcsEnabled && ( m_reshapeSignalType == RESHAPE_SIGNAL_PQ || m_updateCtrl == 2 ), "NumFrameThreads > 1 cannot be used together with LMCS model updates in inter pictures" );
+    xConfirmPara( m_maxLayers > 1 || m_isField,                                             "NumFrameThreads > 1 cannot be used together with multiple layers or field coding" );
+    xConfirmPara( m_RCEnableRateControl,                                                    "NumFrameThreads > 1 cannot be used together with rate control" );
+    xConfirmPara( m_bUsePerceptQPA,                                                         "NumFrameThreads > 1 cannot be used together with perceptual QPA" );
+    xConfirmPara( m_wcgChromaQpControl.isEnabled(),                                         "NumFrameThreads > 1 cannot be used together with WCG chroma QP control" );
+    xConfirmPara( m_IBCMode || m_PLTMode || m_HashME,                                       "NumFrameThreads > 1 cannot be used together with IBC, palette mode or hash ME" );
+    xConfirmPara( m_encDbOpt,                                                               "NumFrameThreads > 1 cannot be used together with EncDbOpt" );
+    xConfirmPara( m_MCTSEncConstraint,                                                      "NumFrameThreads > 1 cannot be used together with MCTS encoder constraints" );
+    xConfirmPara( m_tsrcRicePresentFlag || m_reverseLastSigCoeffEnabledFlag,                "NumFrameThreads > 1 cannot be used together with TSRC Rice parameter signalling or reverse last significant coefficient" );
+    xConfirmPara( m_compositeRefEnabled || m_gdrEnabled || m_resChangeInClvsEnabled,        "NumFrameThreads > 1 cannot be used together with composite reference, GDR or RPR" );
+    xConfirmPara( m_lowMemoryMode,                                                          "NumFrameThreads > 1 cannot be used together with the low-memory mode" );
+    xConfirmPara( !m_decodeBitstreams[0].empty() || !m_decodeBitstreams[1].empty() || m_fastForwardToPOC >= 0, "NumFrameThreads > 1 cannot be used together with bitstream decoding or fast-forwarding" );
+  }
   if (m_lumaLevelToDeltaQPMapping.mode && m_lmcsEnabled)
   {
     msg(WARNING, "For HDR-PQ, LMCS should be used mutual-exclusively with Luma-level-based Delta QP. If use LMCS, turn lumaDQP off.\n");
@@ -4340,6 +4388,7 @@ void EncAppCfg::xPrintParameter()
   msg( DETAILS, "Frame MSE output                       : %s\n", ( m_printFrameMSE ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "MS-SSIM output                         : %s\n", ( m_printMSSSIM ? "Enabled" : "Disabled") );
   msg( DETAILS, "Cabac-zero-word-padding                : %s\n", ( m_cabacZeroWordPaddingEnabled ? "Enabled" : "Disabled" ) );
+  msg( DETAILS, "CABAC initialization table selection   : %s\n", ( m_cabacInitPresent ? "Enabled" : "Disabled" ) );
   if (m_isField)
   {
     msg( DETAILS, "Frame/Field                            : Field based coding\n" );
@@ -4531,6 +4580,10 @@ void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "PME:%d ", m_log2ParallelMergeLevel);
   const int iWaveFrontSubstreams = m_entropyCodingSyncEnabledFlag ? (m_sourceHeight + m_uiMaxCUHeight - 1) / m_uiMaxCUHeight : 1;
   msg( VERBOSE, " WaveFrontSynchro:%d WaveFrontSubstreams:%d", m_entropyCodingSyncEnabledFlag?1:0, iWaveFrontSubstreams);
+  msg( VERBOSE, " NumWppThreads:%d", m_numWppThreads );
+  msg( VERBOSE, " NumSplitThreads:%d", m_numSplitThreads );
+  msg( VERBOSE, " NumFrameThreads:%d", m_numFrameThreads );
+  msg( VERBOSE, " LowMemoryMode:%d", m_lowMemoryMode );
   msg( VERBOSE, " ScalingList:%d ", m_useScalingListId );
   msg( VERBOSE, "TMVPMode:%d ", m_TMVPModeId );
   msg( VERBOSE, " DQ:%d ", m_depQuantEnabledFlag);
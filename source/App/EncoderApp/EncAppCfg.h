@@ -129,6 +129,7 @@ protected:
   bool      m_printMSSSIM;
   bool      m_printWPSNR;
   bool      m_cabacZeroWordPaddingEnabled;
+  bool      m_cabacInitPresent;
   bool      m_bClipInputVideoToRec709Range;
   bool      m_bClipOutputVideoToRec709Range;
   bool      m_packedYUVMode;                                  ///< If true, output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data
@@ -510,6 +511,10 @@ protected:
   bool      m_singleSlicePerSubPicFlag;
   bool      m_entropyCodingSyncEnabledFlag;
   bool      m_entryPointPresentFlag;                          ///< flag for the presence of entry points
+  int       m_numWppThreads;                                  ///< number of threads encoding CTU rows in parallel (requires WaveFrontSynchro)
+  int       m_numSplitThreads;                                ///< number of threads evaluating sibling split modes of a CU in parallel
+  int       m_numFrameThreads;                                ///< number of threads encoding pictures of a GOP in parallel
+  bool      m_lowMemoryMode;                                  ///< allocate auxiliary picture planes on demand and release the originals once a picture is encoded
 
   bool      m_bFastUDIUseMPMEnabled;
   bool      m_bFastMEForGenBLowDelayEnabled;
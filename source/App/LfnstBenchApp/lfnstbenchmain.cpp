@@ -0,0 +1,191 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     lfnstbenchmain.cpp
+    \brief    Compares the C and SIMD versions of the LFNST matrix products for bit-exactness and speed
+*/
+
+#include <stdio.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/TrQuant.h"
+#include "Utilities/program_options_lite.h"
+
+//! \ingroup LfnstBenchApp
+//! \{
+
+typedef void LfnstFwd( TCoeff*, TCoeff*, const uint32_t, const uint32_t, const uint32_t, int );
+typedef void LfnstInv( TCoeff*, TCoeff*, const uint32_t, const uint32_t, const uint32_t, int, const int );
+
+static const int maxLog2TrDynamicRange = 15;
+static const int numInputs             = 256;   ///< input vectors per configuration, cycled through by the timing loops
+
+/// gives access to the LFNST kernels TrQuant selected for the detected instruction set
+class LfnstBench : public TrQuant
+{
+public:
+  LfnstFwd* getFwdLfnst() const { return m_fwdLfnst; }
+  LfnstInv* getInvLfnst() const { return m_invLfnst; }
+};
+
+struct LfnstConfig
+{
+  uint32_t size;          ///< 4 for the 4x4 kernel, 8 for the 8x8 kernel
+  int      zeroOutSize;   ///< number of LFNST coefficients, 8 for 4x4 and 8x8 blocks, 16 otherwise
+};
+
+static double timeFwd( LfnstFwd* fwd, std::vector<TCoeff>& src, TCoeff* dst, const LfnstConfig& cfg, const int trSize, const int iterations, int64_t& checksum )
+{
+  const auto start = std::chrono::steady_clock::now();
+  for( int it = 0; it < iterations; it++ )
+  {
+    fwd( &src[( it % numInputs ) * trSize], dst, it & 3, ( it >> 2 ) & 1, cfg.size, cfg.zeroOutSize );
+    checksum += dst[it % cfg.zeroOutSize];
+  }
+  return std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count() / iterations;
+}
+
+static double timeInv( LfnstInv* inv, std::vector<TCoeff>& src, TCoeff* dst, const LfnstConfig& cfg, const int trSize, const int iterations, int64_t& checksum )
+{
+  const auto start = std::chrono::steady_clock::now();
+  for( int it = 0; it < iterations; it++ )
+  {
+    inv( &src[( it % numInputs ) * 16], dst, it & 3, ( it >> 2 ) & 1, cfg.size, cfg.zeroOutSize, maxLog2TrDynamicRange );
+    checksum += dst[it % trSize];
+  }
+  return std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count() / iterations;
+}
+
+// ====================================================================================================================
+// Main function
+// ====================================================================================================================
+
+int main( int argc, char* argv[] )
+{
+  std::string SIMD;
+  int         iterations;
+  uint32_t    seed;
+
+  df::program_options_lite::Options opts;
+  opts.addOptions()
+    ( "SIMD",       SIMD,       std::string( "" ), "SIMD extension to compare against the C version (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), capped at the detected one" )
+    ( "Iterations", iterations, 2000000,           "Number of kernel calls timed per configuration" )
+    ( "Seed",       seed,       1u,                "Seed of the random input coefficients" );
+  df::program_options_lite::ErrorReporter err;
+  df::program_options_lite::scanArgv( opts, argc, ( const char** ) argv, err );
+  if( err.is_errored || iterations <= 0 )
+  {
+    df::program_options_lite::doHelp( std::cout, opts );
+    return 1;
+  }
+
+  // the extension has to be set before TrQuant picks its kernels
+#if ENABLE_SIMD_OPT_TRAFO && defined( TARGET_SIMD_X86 )
+  fprintf( stdout, "\nLFNST kernels: C versus SIMD=%s\n\n", read_x86_extension( SIMD ) );
+#else
+  fprintf( stdout, "\nLFNST kernels: built without SIMD transforms, C versus C\n\n" );
+#endif
+
+  LfnstBench trQuant;
+  LfnstFwd*  fwdSimd = trQuant.getFwdLfnst();
+  LfnstInv*  invSimd = trQuant.getInvLfnst();
+
+  std::mt19937                        rng( seed );
+  std::uniform_int_distribution<int>  coeffDist( -( 1 << maxLog2TrDynamicRange ), ( 1 << maxLog2TrDynamicRange ) - 1 );
+  const LfnstConfig                   configs[] = { { 4, 8 }, { 4, 16 }, { 8, 8 }, { 8, 16 } };
+
+  bool   mismatch = false;
+  int64_t checksum = 0;
+
+  fprintf( stdout, " kernel size coeffs   C [ns]  SIMD [ns]  speed-up  bit-exact\n" );
+  for( const LfnstConfig& cfg : configs )
+  {
+    const int trSize = cfg.size > 4 ? 48 : 16;
+
+    std::vector<TCoeff> fwdSrc( numInputs * trSize );
+    std::vector<TCoeff> invSrc( numInputs * 16 );
+    for( TCoeff& c : fwdSrc )
+    {
+      c = coeffDist( rng );
+    }
+    for( TCoeff& c : invSrc )
+    {
+      c = coeffDist( rng );
+    }
+
+    // every input vector through every matrix of the set, the SIMD versions also have to zero the same tail
+    bool fwdExact = true;
+    bool invExact = true;
+    for( int n = 0; n < numInputs; n++ )
+    {
+      for( uint32_t mode = 0; mode < 4; mode++ )
+      {
+        for( uint32_t index = 0; index < 2; index++ )
+        {
+          TCoeff dstC[48], dstSimd[48];
+          std::fill_n( dstC, 48, 1 );
+          std::fill_n( dstSimd, 48, -1 );
+          TrQuant::fwdLfnstNxN( &fwdSrc[n * trSize], dstC, mode, index, cfg.size, cfg.zeroOutSize );
+          fwdSimd( &fwdSrc[n * trSize], dstSimd, mode, index, cfg.size, cfg.zeroOutSize );
+          fwdExact &= std::equal( dstC, dstC + trSize, dstSimd );
+
+          std::fill_n( dstC, 48, 1 );
+          std::fill_n( dstSimd, 48, -1 );
+          TrQuant::invLfnstNxN( &invSrc[n * 16], dstC, mode, index, cfg.size, cfg.zeroOutSize, maxLog2TrDynamicRange );
+          invSimd( &invSrc[n * 16], dstSimd, mode, index, cfg.size, cfg.zeroOutSize, maxLog2TrDynamicRange );
+          invExact &= std::equal( dstC, dstC + trSize, dstSimd );
+        }
+      }
+    }
+    mismatch |= !fwdExact || !invExact;
+
+    TCoeff dst[48];
+    const double fwdC = timeFwd( TrQuant::fwdLfnstNxN, fwdSrc, dst, cfg, trSize, iterations, checksum );
+    const double fwdS = timeFwd( fwdSimd,              fwdSrc, dst, cfg, trSize, iterations, checksum );
+    const double invC = timeInv( TrQuant::invLfnstNxN, invSrc, dst, cfg, trSize, iterations, checksum );
+    const double invS = timeInv( invSimd,              invSrc, dst, cfg, trSize, iterations, checksum );
+
+    fprintf( stdout, " forward  %2dx%-2d %6d %8.2f %10.2f %9.2f  %s\n", cfg.size, cfg.size, cfg.zeroOutSize, fwdC, fwdS, fwdC / fwdS, fwdExact ? "yes" : "NO" );
+    fprintf( stdout, " inverse  %2dx%-2d %6d %8.2f %10.2f %9.2f  %s\n", cfg.size, cfg.size, cfg.zeroOutSize, invC, invS, invC / invS, invExact ? "yes" : "NO" );
+  }
+
+  // printed so that the timed calls cannot be dropped by the compiler
+  fprintf( stdout, "\nchecksum %lld\n", ( long long ) checksum );
+
+  return mismatch ? 1 : 0;
+}
+
+//! \}
@@ -39,11 +39,24 @@
 
 #include "CodingStructure.h"
 #include "Picture.h"
+#include <algorithm>
 #include <array>
 #include <cmath>
 
 constexpr int AdaptiveLoopFilter::AlfNumClippingValues[];
 
+AdaptiveLoopFilter::CtuRowScratch::CtuRowScratch()
+{
+  for (size_t i = 0; i < NUM_DIRECTIONS; i++)
+  {
+    laplacian[i] = laplacianPtr[i];
+    for (size_t j = 0; j < sizeof(laplacianPtr[i]) / sizeof(laplacianPtr[i][0]); j++)
+    {
+      laplacianPtr[i][j] = laplacianData[i][j];
+    }
+  }
+}
+
 AdaptiveLoopFilter::AdaptiveLoopFilter()
   : m_classifier( nullptr )
 {
@@ -115,11 +128,10 @@ bool AdaptiveLoopFilter::isCrossedByVirtualBoundaries( const CodingStructure& cs
     }
   }
 
-  const Slice& slice = *(cs.slice);
-  int   ctuSize = slice.getSPS()->getCTUSize();
+  int   ctuSize = cs.sps->getCTUSize();
   const Position currCtuPos(xPos, yPos);
   const CodingUnit *currCtu = cs.getCU(currCtuPos, CHANNEL_TYPE_LUMA);
-  const SubPic& curSubPic = slice.getPPS()->getSubPicFromPos(currCtuPos);
+  const SubPic& curSubPic = pps->getSubPicFromPos(currCtuPos);
   bool loopFilterAcrossSubPicEnabledFlag = curSubPic.getloopFilterAcrossEnabledFlag();
   //top
   if (yPos >= ctuSize && clipTop == false)
@@ -401,7 +413,21 @@ void AdaptiveLoopFilter::applyCcAlfFilter(CodingStructure &cs, ComponentID compI
 
 void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
 {
+  prepareCtuRows( cs );
+
+  PelUnitBuf recYuv = cs.getRecoBuf();
+  m_tempBuf.copyFrom( recYuv );
+  PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
+  tmpYuv.extendBorderPel( MAX_ALF_FILTER_LENGTH >> 1 );
 
+  for( int ctuRow = 0; ctuRow < cs.pcv->heightInCtus; ctuRow++ )
+  {
+    xFilterCtuRow( cs, ctuRow, m_tempBuf2, m_laplacian );
+  }
+}
+
+void AdaptiveLoopFilter::prepareCtuRows( CodingStructure& cs, const bool rowWise )
+{
   // set clipping range
   m_clpRngs = cs.slice->getClpRngs();
 
@@ -411,210 +437,305 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
     m_ctuEnableFlag[compIdx] = cs.picture->getAlfCtuEnableFlag( compIdx );
     m_ctuAlternative[compIdx] = cs.picture->getAlfCtuAlternativeData( compIdx );
   }
-  short* alfCtuFilterIndex = nullptr;
-  uint32_t lastSliceIdx = 0xFFFFFFFF;
-
-  PelUnitBuf recYuv = cs.getRecoBuf();
-  m_tempBuf.copyFrom( recYuv );
-  PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
-  tmpYuv.extendBorderPel( MAX_ALF_FILTER_LENGTH >> 1 );
 
   const PreCalcValues& pcv = *cs.pcv;
+  m_coeffSlices.clear();
+  m_sliceCoeffs.clear();
+  m_ctuSliceCoeffs.assign( pcv.sizeInCtus, -1 );
+  m_lastSliceIdx = 0xFFFFFFFF;
+  m_coeffIdx     = -1;
 
-  int ctuIdx = 0;
-  bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
-  int numHorVirBndry = 0, numVerVirBndry = 0;
-  int horVirBndryPos[] = { 0, 0, 0 };
-  int verVirBndryPos[] = { 0, 0, 0 };
+  if( rowWise )
+  {
+    return;
+  }
+  for( int ctuRow = 0; ctuRow < pcv.heightInCtus; ctuRow++ )
+  {
+    prepareCtuRow( cs, ctuRow );
+  }
+}
 
-  for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+void AdaptiveLoopFilter::prepareCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const int yPos = ctuRow * pcv.maxCUHeight;
+
+  int ctuIdx = ctuRow * pcv.widthInCtus;
+  for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
   {
-    for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+    // get first CU in CTU
+    const CodingUnit *cu = cs.getCU( Position(xPos, yPos), CHANNEL_TYPE_LUMA );
+
+    // skip this CTU if ALF is disabled
+    if (!cu->slice->getAlfEnabledFlag(COMPONENT_Y) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cb) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cr))
     {
-      // get first CU in CTU
-      const CodingUnit *cu = cs.getCU( Position(xPos, yPos), CHANNEL_TYPE_LUMA );
+      ctuIdx++;
+      continue;
+    }
 
-      // skip this CTU if ALF is disabled
-      if (!cu->slice->getAlfEnabledFlag(COMPONENT_Y) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cb) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cr))
+    // reload ALF APS each time the slice changes during raster scan filtering, the coefficients are reconstructed once per slice
+    if( ctuIdx == 0 || m_lastSliceIdx != cu->slice->getSliceID() || m_coeffIdx < 0 )
+    {
+      // while the picture is decoded, the slice of the coding structure is already the one of the CTU
+      if( cs.slice != cu->slice )
       {
-        ctuIdx++;
-        continue;
+        cs.slice = cu->slice;
       }
-
-      // reload ALF APS each time the slice changes during raster scan filtering
-      if(ctuIdx == 0 || lastSliceIdx != cu->slice->getSliceID() || alfCtuFilterIndex==nullptr)
+      m_ccAlfFilterParam = cu->slice->m_ccAlfFilterParam;
+      m_coeffIdx = int( std::find( m_coeffSlices.begin(), m_coeffSlices.end(), cu->slice ) - m_coeffSlices.begin() );
+      if( m_coeffIdx == (int) m_coeffSlices.size() )
       {
-        cs.slice = cu->slice;
         reconstructCoeffAPSs(cs, true, cu->slice->getAlfEnabledFlag(COMPONENT_Cb) || cu->slice->getAlfEnabledFlag(COMPONENT_Cr), false);
-        alfCtuFilterIndex = cu->slice->getPic()->getAlfCtbFilterIndex();
-        m_ccAlfFilterParam = cu->slice->m_ccAlfFilterParam;
+        m_coeffSlices.push_back( cu->slice );
+        m_sliceCoeffs.push_back( SliceCoeffs() );
+        SliceCoeffs& coeffs = m_sliceCoeffs.back();
+        memcpy( coeffs.coeffApsLuma,     m_coeffApsLuma,      sizeof( m_coeffApsLuma ) );
+        memcpy( coeffs.clippApsLuma,     m_clippApsLuma,      sizeof( m_clippApsLuma ) );
+        memcpy( coeffs.chromaCoeffFinal, m_chromaCoeffFinal,  sizeof( m_chromaCoeffFinal ) );
+        memcpy( coeffs.chromaClippFinal, m_chromaClippFinal,  sizeof( m_chromaClippFinal ) );
       }
-      lastSliceIdx = cu->slice->getSliceID();
+    }
+    m_lastSliceIdx = cu->slice->getSliceID();
+    m_ctuSliceCoeffs[ctuIdx] = m_coeffIdx;
+    ctuIdx++;
+  }
+}
 
-      const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
-      const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
-      bool ctuEnableFlag = m_ctuEnableFlag[COMPONENT_Y][ctuIdx];
-      for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+void AdaptiveLoopFilter::copyCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const int yPos   = ctuRow * pcv.maxCUHeight;
+  const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
+  const UnitArea rowArea( cs.area.chromaFormat, Area( 0, yPos, pcv.lumaWidth, height ) );
+
+  PelUnitBuf tmpRow = m_tempBuf.subBuf( rowArea );
+  tmpRow.copyFrom( cs.getRecoBuf( rowArea ) );
+
+  // same border as extended around the whole picture, the top and bottom margins are extended along with the first and last row
+  const int margin = MAX_ALF_FILTER_LENGTH >> 1;
+  for( int compIdx = 0; compIdx < getNumberValidComponents( cs.area.chromaFormat ); compIdx++ )
+  {
+    PelBuf     buf       = tmpRow.get( ComponentID( compIdx ) );
+    const int  lineWidth = buf.width + ( margin << 1 );
+    buf.extendBorderPel( margin, 0 );
+
+    if( ctuRow == 0 )
+    {
+      const Pel* line = buf.buf - margin;
+      for( int y = 1; y <= margin; y++ )
       {
-        ctuEnableFlag |= m_ctuEnableFlag[compIdx][ctuIdx] > 0;
-        if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
-        {
-          ctuEnableFlag |= m_ccAlfFilterControl[compIdx - 1][ctuIdx] > 0;
-        }
+        ::memcpy( buf.buf - margin - y * buf.stride, line, sizeof( Pel ) * lineWidth );
       }
-      int rasterSliceAlfPad = 0;
-      if( ctuEnableFlag && isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+    }
+    if( ctuRow == pcv.heightInCtus - 1 )
+    {
+      const Pel* line = buf.bufAt( 0, buf.height - 1 ) - margin;
+      for( int y = 1; y <= margin; y++ )
       {
-        int yStart = yPos;
-        for( int i = 0; i <= numHorVirBndry; i++ )
+        ::memcpy( buf.bufAt( 0, buf.height - 1 ) - margin + y * buf.stride, line, sizeof( Pel ) * lineWidth );
+      }
+    }
+  }
+}
+
+void AdaptiveLoopFilter::createCtuRowScratch( CtuRowScratch& scratch ) const
+{
+  scratch.tempBuf2.destroy();
+  scratch.tempBuf2.create( m_chromaFormat, Area( 0, 0, m_maxCUWidth + (MAX_ALF_PADDING_SIZE << 1), m_maxCUHeight + (MAX_ALF_PADDING_SIZE << 1) ), m_maxCUWidth, MAX_ALF_PADDING_SIZE, 0, false );
+}
+
+void AdaptiveLoopFilter::filterCtuRow( CodingStructure& cs, const int ctuRow, CtuRowScratch& scratch )
+{
+  xFilterCtuRow( cs, ctuRow, scratch.tempBuf2, scratch.laplacian );
+}
+
+void AdaptiveLoopFilter::xFilterCtuRow( CodingStructure& cs, const int ctuRow, PelStorage& tempBuf2, int** laplacian[NUM_DIRECTIONS] )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const short* alfCtuFilterIndex = cs.picture->getAlfCtbFilterIndex();
+
+  PelUnitBuf recYuv = cs.getRecoBuf();
+  PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
+
+  bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
+  int numHorVirBndry = 0, numVerVirBndry = 0;
+  int horVirBndryPos[] = { 0, 0, 0 };
+  int verVirBndryPos[] = { 0, 0, 0 };
+
+  const int yPos = ctuRow * pcv.maxCUHeight;
+  int ctuIdx = ctuRow * pcv.widthInCtus;
+  for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth, ctuIdx++ )
+  {
+    // skip this CTU if ALF is disabled
+    if( m_ctuSliceCoeffs[ctuIdx] < 0 )
+    {
+      continue;
+    }
+    const CodingUnit  *cu     = cs.getCU( Position(xPos, yPos), CHANNEL_TYPE_LUMA );
+    const SliceCoeffs &coeffs = m_sliceCoeffs[m_ctuSliceCoeffs[ctuIdx]];
+
+    const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
+    const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
+    bool ctuEnableFlag = m_ctuEnableFlag[COMPONENT_Y][ctuIdx];
+    for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+    {
+      ctuEnableFlag |= m_ctuEnableFlag[compIdx][ctuIdx] > 0;
+      if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+      {
+        ctuEnableFlag |= m_ccAlfFilterControl[compIdx - 1][ctuIdx] > 0;
+      }
+    }
+    int rasterSliceAlfPad = 0;
+    if( ctuEnableFlag && isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+    {
+      int yStart = yPos;
+      for( int i = 0; i <= numHorVirBndry; i++ )
+      {
+        const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
+        const int h = yEnd - yStart;
+        const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
+        const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
+        int xStart = xPos;
+        for( int j = 0; j <= numVerVirBndry; j++ )
         {
-          const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
-          const int h = yEnd - yStart;
-          const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
-          const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
-          int xStart = xPos;
-          for( int j = 0; j <= numVerVirBndry; j++ )
+          const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
+          const int w = xEnd - xStart;
+          const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
+          const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
+          const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
+          const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
+          PelUnitBuf buf = tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
+          buf.copyFrom( tmpYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
+          // pad top-left unavailable samples for raster slice
+          if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
           {
-            const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
-            const int w = xEnd - xStart;
-            const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
-            const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
-            const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
-            const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
-            PelUnitBuf buf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
-            buf.copyFrom( tmpYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
-            // pad top-left unavailable samples for raster slice
-            if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
+            buf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
+          }
+
+          // pad bottom-right unavailable samples for raster slice
+          if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+          {
+            buf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
+          }
+          buf.extendBorderPel( MAX_ALF_PADDING_SIZE );
+          buf = buf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
+
+          if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
+          {
+            const Area blkSrc( 0, 0, w, h );
+            const Area blkDst( xStart, yStart, w, h );
+            deriveClassification( m_classifier, laplacian, buf.get(COMPONENT_Y), blkDst, blkSrc );
+            short filterSetIndex = alfCtuFilterIndex[ctuIdx];
+            const short *coeff;
+            const Pel   *clip;
+            if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
             {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
+              coeff = coeffs.coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+              clip = coeffs.clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
             }
-
-            // pad bottom-right unavailable samples for raster slice
-            if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+            else
             {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
+              coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
+              clip = m_clipDefault;
             }
-            buf.extendBorderPel( MAX_ALF_PADDING_SIZE );
-            buf = buf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
+            m_filter7x7Blk(m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs
+              , m_alfVBLumaCTUHeight
+              , m_alfVBLumaPos
+            );
+          }
 
-            if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
+          for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+          {
+            ComponentID compID = ComponentID( compIdx );
+            const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
+            const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+
+            if( m_ctuEnableFlag[compIdx][ctuIdx] )
             {
-              const Area blkSrc( 0, 0, w, h );
-              const Area blkDst( xStart, yStart, w, h );
-              deriveClassification( m_classifier, buf.get(COMPONENT_Y), blkDst, blkSrc );
-              short filterSetIndex = alfCtuFilterIndex[ctuIdx];
-              short *coeff;
-              Pel *clip;
-              if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
-              {
-                coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-                clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-              }
-              else
-              {
-                coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
-                clip = m_clipDefault;
-              }
-              m_filter7x7Blk(m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs
-                , m_alfVBLumaCTUHeight
-                , m_alfVBLumaPos
-              );
+              const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
+              const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
+              uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
+              m_filter5x5Blk(m_classifier, recYuv, buf, blkDst, blkSrc, compID, coeffs.chromaCoeffFinal[alt_num], coeffs.chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs
+                , m_alfVBChmaCTUHeight
+                 , m_alfVBChmaPos );
             }
-
-            for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+            if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
             {
-              ComponentID compID = ComponentID( compIdx );
-              const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-              const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+              const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
 
-              if( m_ctuEnableFlag[compIdx][ctuIdx] )
-              {
-                const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
-                const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
-                uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
-                m_filter5x5Blk(m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs
-                  , m_alfVBChmaCTUHeight
-                   , m_alfVBChmaPos );
-              }
-              if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+              if (filterIdx != 0)
               {
-                const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
+                const Area blkSrc(0, 0, w, h);
+                Area blkDst(xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY);
 
-                if (filterIdx != 0)
-                {
-                  const Area blkSrc(0, 0, w, h);
-                  Area blkDst(xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY);
+                const int16_t *filterCoeff = cu->slice->m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
 
-                  const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
-
-                  m_filterCcAlf(recYuv.get(compID), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
-                                m_alfVBLumaCTUHeight, m_alfVBLumaPos);
-                }
+                m_filterCcAlf(recYuv.get(compID), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
+                              m_alfVBLumaCTUHeight, m_alfVBLumaPos);
               }
             }
-
-            xStart = xEnd;
           }
 
-          yStart = yEnd;
+          xStart = xEnd;
         }
+
+        yStart = yEnd;
       }
-      else
+    }
+    else
+    {
+      const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
+      if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
       {
-        const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
-        if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
+        Area blk( xPos, yPos, width, height );
+        deriveClassification( m_classifier, laplacian, tmpYuv.get( COMPONENT_Y ), blk, blk );
+        short filterSetIndex = alfCtuFilterIndex[ctuIdx];
+        const short *coeff;
+        const Pel   *clip;
+        if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
         {
-          Area blk( xPos, yPos, width, height );
-          deriveClassification( m_classifier, tmpYuv.get( COMPONENT_Y ), blk, blk );
-          short filterSetIndex = alfCtuFilterIndex[ctuIdx];
-          short *coeff;
-          Pel *clip;
-          if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
-          {
-            coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-            clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-          }
-          else
-          {
-            coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
-            clip = m_clipDefault;
-          }
-          m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y],
-                         cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
+          coeff = coeffs.coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+          clip = coeffs.clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
         }
+        else
+        {
+          coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
+          clip = m_clipDefault;
+        }
+        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y],
+                       cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
+      }
+
+      for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+      {
+        ComponentID compID = ComponentID( compIdx );
+        const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
+        const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
 
-        for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+        if (m_ctuEnableFlag[compIdx][ctuIdx])
         {
-          ComponentID compID = ComponentID( compIdx );
-          const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-          const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+          Area    blk(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
+          uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
+          m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, blk, compID, coeffs.chromaCoeffFinal[alt_num],
+                         coeffs.chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight,
+                         m_alfVBChmaPos);
+        }
+        if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+        {
+          const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
 
-          if (m_ctuEnableFlag[compIdx][ctuIdx])
+          if (filterIdx != 0)
           {
-            Area    blk(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
-            uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
-            m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num],
-                           m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight,
-                           m_alfVBChmaPos);
-          }
-          if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
-          {
-            const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
-
-            if (filterIdx != 0)
-            {
-              Area blkDst(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
-              Area blkSrc(xPos, yPos, width, height);
+            Area blkDst(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
+            Area blkSrc(xPos, yPos, width, height);
 
-              const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
+            const int16_t *filterCoeff = cu->slice->m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
 
-              m_filterCcAlf(recYuv.get(compID), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
-                            m_alfVBLumaCTUHeight, m_alfVBLumaPos);
-            }
+            m_filterCcAlf(recYuv.get(compID), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
+                          m_alfVBLumaCTUHeight, m_alfVBLumaPos);
           }
         }
       }
-      ctuIdx++;
     }
   }
 }
@@ -826,6 +947,11 @@ void AdaptiveLoopFilter::destroy()
 }
 
 void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const CPelBuf& srcLuma, const Area& blkDst, const Area& blk )
+{
+  deriveClassification( classifier, m_laplacian, srcLuma, blkDst, blk );
+}
+
+void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, int** laplacian[NUM_DIRECTIONS], const CPelBuf& srcLuma, const Area& blkDst, const Area& blk )
 {
   int height = blk.pos().y + blk.height;
   int width = blk.pos().x + blk.width;
@@ -837,7 +963,7 @@ void AdaptiveLoopFilter::deriveClassification( AlfClassifier** classifier, const
     for( int j = blk.pos().x; j < width; j += m_CLASSIFICATION_BLK_SIZE )
     {
       int nWidth = std::min( j + m_CLASSIFICATION_BLK_SIZE, width ) - j;
-      m_deriveClassificationBlk(classifier, m_laplacian, srcLuma, Area( j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight ), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA] + 4
+      m_deriveClassificationBlk(classifier, laplacian, srcLuma, Area( j - blk.pos().x + blkDst.pos().x, i - blk.pos().y + blkDst.pos().y, nWidth, nHeight ), Area(j, i, nWidth, nHeight), m_inputBitDepth[CHANNEL_TYPE_LUMA] + 4
         , m_alfVBLumaCTUHeight
         , m_alfVBLumaPos
       );
@@ -1297,7 +1423,7 @@ void AdaptiveLoopFilter::filterBlkCcAlf(const PelBuf &dstBuf, const CPelUnitBuf
 
   CHECK(!isChroma(compId), "Must be chroma");
 
-  const SPS*     sps           = cs.slice->getSPS();
+  const SPS*     sps           = cs.sps;
   ChromaFormat nChromaFormat   = sps->getChromaFormatIdc();
   const int clsSizeY           = 4;
   const int clsSizeX           = 4;
@@ -80,17 +80,46 @@ public:
   static constexpr int m_ALF_UNUSED_CLASSIDX = 255;
   static constexpr int m_ALF_UNUSED_TRANSPOSIDX = 255;
 
+  /// filter coefficients reconstructed for one slice of the picture
+  struct SliceCoeffs
+  {
+    short coeffApsLuma    [ALF_CTB_MAX_NUM_APS][MAX_NUM_ALF_LUMA_COEFF * MAX_NUM_ALF_CLASSES];
+    Pel   clippApsLuma    [ALF_CTB_MAX_NUM_APS][MAX_NUM_ALF_LUMA_COEFF * MAX_NUM_ALF_CLASSES];
+    short chromaCoeffFinal[MAX_NUM_ALF_ALTERNATIVES_CHROMA][MAX_NUM_ALF_CHROMA_COEFF];
+    Pel   chromaClippFinal[MAX_NUM_ALF_ALTERNATIVES_CHROMA][MAX_NUM_ALF_CHROMA_COEFF];
+  };
+
+  /// scratch buffers of one thread filtering CTU rows
+  struct CtuRowScratch
+  {
+    PelStorage tempBuf2;
+    int**      laplacian[NUM_DIRECTIONS];
+    int*       laplacianPtr[NUM_DIRECTIONS][m_CLASSIFICATION_BLK_SIZE + 5];
+    int        laplacianData[NUM_DIRECTIONS][m_CLASSIFICATION_BLK_SIZE + 5][m_CLASSIFICATION_BLK_SIZE + 5];
+
+    CtuRowScratch();
+  };
+
   AdaptiveLoopFilter();
   virtual ~AdaptiveLoopFilter() {}
   void reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo);
   void reconstructCoeff(AlfParam& alfParam, ChannelType channel, const bool isRdo, const bool isRedo = false);
   void ALFProcess(CodingStructure& cs);
+  /// CTU-row-wise ALF for filtering the rows of a picture on several threads, the coefficients of all slices are reconstructed up front
+  void prepareCtuRows( CodingStructure& cs, const bool rowWise = false );
+  /// with rowWise set the CTU rows are prepared one at a time from the top instead, for rows filtered while the CTUs below are still decoded
+  void prepareCtuRow( CodingStructure& cs, const int ctuRow );
+  /// copies a CTU row to the border-extended source buffer, the rows above and below a filtered row have to be copied beforehand
+  void copyCtuRow( CodingStructure& cs, const int ctuRow );
+  void createCtuRowScratch( CtuRowScratch& scratch ) const;
+  void filterCtuRow( CodingStructure& cs, const int ctuRow, CtuRowScratch& scratch );
   void create( const int picWidth, const int picHeight, const ChromaFormat format, const int maxCUWidth, const int maxCUHeight, const int maxCUDepth, const int inputBitDepth[MAX_NUM_CHANNEL_TYPE] );
   void destroy();
   static void deriveClassificationBlk(AlfClassifier **classifier, int **laplacian[NUM_DIRECTIONS],
                                       const CPelBuf &srcLuma, const Area &blkDst, const Area &blk, const int shift,
                                       const int vbCTUHeight, int vbPos);
   void deriveClassification( AlfClassifier** classifier, const CPelBuf& srcLuma, const Area& blkDst, const Area& blk );
+  void deriveClassification( AlfClassifier** classifier, int** laplacian[NUM_DIRECTIONS], const CPelBuf& srcLuma, const Area& blkDst, const Area& blk );
   template<AlfFilterType filtTypeCcAlf>
   static void filterBlkCcAlf(const PelBuf &dstBuf, const CPelUnitBuf &recSrc, const Area &blkDst, const Area &blkSrc,
                              const ComponentID compId, const int16_t *filterCoeff, const ClpRngs &clpRngs,
@@ -130,6 +159,7 @@ public:
 #endif
 
 protected:
+  void xFilterCtuRow( CodingStructure& cs, const int ctuRow, PelStorage& tempBuf2, int** laplacian[NUM_DIRECTIONS] );
   bool isCrossedByVirtualBoundaries( const CodingStructure& cs, const int xPos, const int yPos, const int width, const int height, bool& clipTop, bool& clipBottom, bool& clipLeft, bool& clipRight, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], int& rasterSliceAlfPad );
   static constexpr int   m_scaleBits = 7; // 8-bits
   CcAlfFilterParam       m_ccAlfFilterParam;
@@ -172,6 +202,11 @@ protected:
   int                          m_alfVBChmaCTUHeight;
   ChromaFormat                 m_chromaFormat;
   ClpRngs                      m_clpRngs;
+  std::vector<SliceCoeffs>     m_sliceCoeffs;
+  std::vector<int>             m_ctuSliceCoeffs;        ///< coefficients of the slice per CTU, -1 where the slice has ALF disabled
+  std::vector<const Slice*>    m_coeffSlices;           ///< slices the entries of m_sliceCoeffs belong to
+  uint32_t                     m_lastSliceIdx;          ///< slice of the last prepared CTU with ALF enabled
+  int                          m_coeffIdx;              ///< coefficients of that slice
 };
 
 #endif
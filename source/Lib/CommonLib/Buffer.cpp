@@ -349,6 +349,14 @@ PelBufferOps::PelBufferOps()
   profGradFilter = gradFilterCore <false>;
   applyPROF      = applyPROFCore;
   roundIntVector = nullptr;
+
+  applyLut       = applyLutCore;
+  scaleSignalFwd = scaleSignalFwdCore;
+  scaleSignalInv = scaleSignalInvCore;
+#if ENABLE_8BIT_REFERENCES
+  packTo8bit     = packTo8bitCore;
+  unpack8bit     = unpack8bitCore;
+#endif
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -362,6 +370,84 @@ void copyBufferCore(Pel *src, int srcStride, Pel *dst, int dstStride, int width,
   }
 }
 
+void applyLutCore(Pel *ptr, int stride, int width, int height, const Pel *lut, int lutSize)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      ptr[x] = lut[ptr[x]];
+    }
+    ptr += stride;
+  }
+}
+
+void scaleSignalFwdCore(Pel *ptr, int stride, int width, int height, int scale, const ClpRng& clpRng)
+{
+  const int maxAbsclipBD = (1 << clpRng.bd) - 1;
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const int sign   = ptr[x] >= 0 ? 1 : -1;
+      const int absval = sign * ptr[x];
+      ptr[x] = (Pel)Clip3(-maxAbsclipBD, maxAbsclipBD, sign * (((absval << CSCALE_FP_PREC) + (scale >> 1)) / scale));
+    }
+    ptr += stride;
+  }
+}
+
+void scaleSignalInvCore(Pel *ptr, int stride, int width, int height, int scale, const ClpRng& clpRng)
+{
+  const int maxAbsclipBD = (1 << clpRng.bd) - 1;
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const Pel clipped = (Pel)Clip3((Pel)(-maxAbsclipBD - 1), (Pel)maxAbsclipBD, ptr[x]);
+      const int sign    = clipped >= 0 ? 1 : -1;
+      const int absval  = sign * clipped;
+      int val = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
+      if (sizeof(Pel) == 2) // avoid overflow when storing data
+      {
+        val = Clip3<int>(-32768, 32767, val);
+      }
+      ptr[x] = (Pel)val;
+    }
+    ptr += stride;
+  }
+}
+
+#if ENABLE_8BIT_REFERENCES
+void packTo8bitCore(const Pel *src, int srcStride, uint8_t *dst, int dstStride, int width, int height)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = (uint8_t) Clip3<Pel>(0, 255, src[x]);
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+void unpack8bitCore(const uint8_t *src, int srcStride, Pel *dst, int dstStride, int width, int height)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = src[x];
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+#endif
+
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize)
 {
   /*left and right padding*/
@@ -420,27 +506,12 @@ void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBu
 template<>
 void AreaBuf<Pel>::rspSignal(std::vector<Pel>& pLUT)
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-  for (unsigned y = 0; y < height; y++)
-  {
-    for (unsigned x = 0; x < width; x++)
-    {
-      dst[x] = pLUT[src[x]];
-    }
-    dst += stride;
-    src += stride;
-  }
+  g_pelBufOP.applyLut(buf, stride, width, height, pLUT.data(), (int)pLUT.size());
 }
 
 template<>
 void AreaBuf<Pel>::scaleSignal(const int scale, const bool dir, const ClpRng& clpRng)
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-  int sign, absval;
-  int maxAbsclipBD = (1<<clpRng.bd) - 1;
-
   if (dir) // forward
   {
     if (width == 1)
@@ -449,55 +520,19 @@ void AreaBuf<Pel>::scaleSignal(const int scale, const bool dir, const ClpRng& cl
     }
     else
     {
-      for (unsigned y = 0; y < height; y++)
-      {
-        for (unsigned x = 0; x < width; x++)
-        {
-          sign = src[x] >= 0 ? 1 : -1;
-          absval = sign * src[x];
-          dst[x] = (Pel)Clip3(-maxAbsclipBD, maxAbsclipBD, sign * (((absval << CSCALE_FP_PREC) + (scale >> 1)) / scale));
-        }
-        dst += stride;
-        src += stride;
-      }
+      g_pelBufOP.scaleSignalFwd(buf, stride, width, height, scale, clpRng);
     }
   }
   else // inverse
   {
-    for (unsigned y = 0; y < height; y++)
-    {
-      for (unsigned x = 0; x < width; x++)
-      {
-        src[x] = (Pel)Clip3((Pel)(-maxAbsclipBD - 1), (Pel)maxAbsclipBD, src[x]);
-        sign = src[x] >= 0 ? 1 : -1;
-        absval = sign * src[x];
-        int val = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
-        if (sizeof(Pel) == 2) // avoid overflow when storing data
-        {
-           val = Clip3<int>(-32768, 32767, val);
-        }
-        dst[x] = (Pel)val;
-      }
-      dst += stride;
-      src += stride;
-    }
+    g_pelBufOP.scaleSignalInv(buf, stride, width, height, scale, clpRng);
   }
 }
 
 template<>
 void AreaBuf<Pel>::applyLumaCTI(std::vector<Pel>& pLUTY)
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-  for (unsigned y = 0; y < height; y++)
-  {
-    for (unsigned x = 0; x < width; x++)
-    {
-      dst[x] = pLUTY[src[x]];
-    }
-    dst += stride;
-    src += stride;
-  }
+  g_pelBufOP.applyLut(buf, stride, width, height, pLUTY.data(), (int)pLUTY.size());
 }
 
 template<>
@@ -766,6 +801,7 @@ PelStorage::PelStorage()
   {
     m_origin[i] = nullptr;
   }
+  m_allocatedBytes = 0;
 }
 
 PelStorage::~PelStorage()
@@ -818,6 +854,7 @@ void PelStorage::create( const ChromaFormat &_chromaFormat, const Area& _area, c
     CHECK( !area, "Trying to create a buffer with zero area" );
 
     m_origin[i] = ( Pel* ) xMalloc( Pel, area );
+    m_allocatedBytes += sizeof( Pel ) * area;
     Pel* topLeft = m_origin[i] + totalWidth * ymargin + xmargin;
     bufs.push_back( PelBuf( topLeft, totalWidth, _area.width >> scaleX, _area.height >> scaleY ) );
   }
@@ -853,6 +890,7 @@ void PelStorage::swap( PelStorage& other )
     std::swap( bufs[i].stride, other.bufs[i].stride );
     std::swap( m_origin[i],    other.m_origin[i] );
   }
+  std::swap( m_allocatedBytes, other.m_allocatedBytes );
 }
 
 void PelStorage::destroy()
@@ -866,6 +904,7 @@ void PelStorage::destroy()
       m_origin[i] = nullptr;
     }
   }
+  m_allocatedBytes = 0;
   bufs.clear();
 }
 
@@ -83,11 +83,25 @@ struct PelBufferOps
   void (*profGradFilter) (Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* gradX, Pel* gradY, const int bitDepth);
   void (*applyPROF)      (Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, const Pel* gradX, const Pel* gradY, int gradStride, const int* dMvX, const int* dMvY, int dMvStride, const bool& bi, int shiftNum, Pel offset, const ClpRng& clpRng);
   void (*roundIntVector) (int* v, int size, unsigned int nShift, const int dmvLimit);
+  void (*applyLut)       (Pel* ptr, int stride, int width, int height, const Pel* lut, int lutSize);
+  void (*scaleSignalFwd) (Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng);
+  void (*scaleSignalInv) (Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng);
+#if ENABLE_8BIT_REFERENCES
+  void (*packTo8bit)     (const Pel* src, int srcStride, uint8_t* dst, int dstStride, int width, int height);
+  void (*unpack8bit)     (const uint8_t* src, int srcStride, Pel* dst, int dstStride, int width, int height);
+#endif
 };
 
 extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize);
+void applyLutCore(Pel *ptr, int stride, int width, int height, const Pel *lut, int lutSize);
+void scaleSignalFwdCore(Pel *ptr, int stride, int width, int height, int scale, const ClpRng& clpRng);
+void scaleSignalInvCore(Pel *ptr, int stride, int width, int height, int scale, const ClpRng& clpRng);
+#if ENABLE_8BIT_REFERENCES
+void packTo8bitCore(const Pel *src, int srcStride, uint8_t *dst, int dstStride, int width, int height);
+void unpack8bitCore(const uint8_t *src, int srcStride, Pel *dst, int dstStride, int width, int height);
+#endif
 void copyBufferCore(Pel *src, int srcStride, Pel *Dst, int dstStride, int width, int height);
 
 template<typename T>
@@ -163,6 +177,11 @@ struct AreaBuf : public Size
 typedef AreaBuf<      Pel>  PelBuf;
 typedef AreaBuf<const Pel> CPelBuf;
 
+#if ENABLE_8BIT_REFERENCES
+typedef AreaBuf<      uint8_t>  Pel8Buf;
+typedef AreaBuf<const uint8_t> CPel8Buf;
+#endif
+
 typedef AreaBuf<      TCoeff>  CoeffBuf;
 typedef AreaBuf<const TCoeff> CCoeffBuf;
 
@@ -1025,10 +1044,12 @@ struct PelStorage : public PelUnitBuf
          PelUnitBuf getBuf( const UnitArea &unit );
   const CPelUnitBuf getBuf( const UnitArea &unit ) const;
   Pel *getOrigin( const int id ) const { return m_origin[id]; }
+  size_t allocatedBytes() const { return m_allocatedBytes; }
 
 private:
 
-  Pel *m_origin[MAX_NUM_COMPONENT];
+  Pel   *m_origin[MAX_NUM_COMPONENT];
+  size_t m_allocatedBytes;
 };
 
 struct CompStorage : public PelBuf
@@ -43,6 +43,8 @@
 #include "UnitTools.h"
 #include "UnitPartitioner.h"
 
+#include <atomic>
+
 
 XUCache g_globalUnitCache = XUCache();
 
@@ -58,11 +60,14 @@ const UnitScale UnitScaleArray[NUM_CHROMA_FORMAT][MAX_NUM_COMPONENT] =
 // coding structure method definitions
 // ---------------------------------------------------------------------------
 
+thread_local CtuLineState* CodingStructure::m_ctuLineState = nullptr;
+
 CodingStructure::CodingStructure(CUCache& cuCache, PUCache& puCache, TUCache& tuCache)
   : area      ()
   , picture   ( nullptr )
   , parent    ( nullptr )
   , bestCS    ( nullptr )
+  , lumaCS    ( nullptr )
   , m_isTuEnc ( false )
   , m_cuCache ( cuCache )
   , m_puCache ( puCache )
@@ -962,10 +967,10 @@ CodingUnit* CodingStructure::getCU( const Position &pos, const ChannelType effCh
 {
   const CompArea &_blk = area.blocks[effChType];
 
-  if( !_blk.contains( pos ) || (treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA) )
+  if( !_blk.contains( pos ) || (getTreeType() == TREE_C && effChType == CHANNEL_TYPE_LUMA) )
   {
     //keep this check, which is helpful to identify bugs
-    if( treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA )
+    if( getTreeType() == TREE_C && effChType == CHANNEL_TYPE_LUMA )
     {
       CHECK( parent == nullptr, "parent shall be valid; consider using function getLumaCU()" );
       CHECK( parent->treeType != TREE_D, "wrong parent treeType " );
@@ -998,9 +1003,9 @@ const CodingUnit* CodingStructure::getCU( const Position &pos, const ChannelType
 {
   const CompArea &_blk = area.blocks[effChType];
 
-  if( !_blk.contains( pos ) || (treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA) )
+  if( !_blk.contains( pos ) || (getTreeType() == TREE_C && effChType == CHANNEL_TYPE_LUMA) )
   {
-    if( treeType == TREE_C && effChType == CHANNEL_TYPE_LUMA )
+    if( getTreeType() == TREE_C && effChType == CHANNEL_TYPE_LUMA )
     {
       CHECK( parent == nullptr, "parent shall be valid; consider using function getLumaCU()" );
       CHECK( parent->treeType != TREE_D, "wrong parent treeType" );
@@ -1110,30 +1115,29 @@ TransformUnit* CodingStructure::getTU( const Position &pos, const ChannelType ef
 
     if( idx != 0 )
     {
-      unsigned extraIdx = 0;
-      if( isLuma( effChType ) )
+      TransformUnit* tu = tus[idx - 1];
+      if( isLuma( effChType ) && tu->cu->ispMode ) // Intra SubPartitions mode
       {
-        const TransformUnit& tu = *tus[idx - 1];
-
-        if( tu.cu->ispMode ) // Intra SubPartitions mode
+        // the sub-partitions are reached through the TU chain of the CU, as CTU lines decoded in parallel interleave their TUs in tus
+        if( subTuIdx != -1 )
         {
-          //we obtain the offset to index the corresponding sub-partition
-          if( subTuIdx != -1 )
+          for( int i = 0; i < subTuIdx; i++ )
           {
-            extraIdx = subTuIdx;
+            tu = tu->next;
+            CHECK( tu == nullptr, "ISP sub-partition index exceeds the TUs of the CU" );
           }
-          else
+        }
+        else
+        {
+          while( !tu->blocks[getFirstComponentOfChannel( effChType )].contains( pos ) )
           {
-            while( !tus[idx - 1 + extraIdx]->blocks[getFirstComponentOfChannel( effChType )].contains( pos ) )
-            {
-              extraIdx++;
-              CHECK( tus[idx - 1 + extraIdx]->cu->treeType == TREE_C, "tu searched by position points to a chroma tree CU" );
-              CHECK( extraIdx > 3, "extraIdx > 3" );
-            }
+            tu = tu->next;
+            CHECK( tu == nullptr, "no ISP sub-partition of the CU contains the position" );
+            CHECK( tu->cu->treeType == TREE_C, "tu searched by position points to a chroma tree CU" );
           }
         }
       }
-      return tus[idx - 1 + extraIdx];
+      return tu;
     }
     else if (m_isTuEnc)
     {
@@ -1166,29 +1170,29 @@ const TransformUnit * CodingStructure::getTU( const Position &pos, const Channel
     const unsigned idx = m_tuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
     if( idx != 0 )
     {
-      unsigned extraIdx = 0;
-      if( isLuma( effChType ) )
+      const TransformUnit* tu = tus[idx - 1];
+      if( isLuma( effChType ) && tu->cu->ispMode ) // Intra SubPartitions mode
       {
-        const TransformUnit& tu = *tus[idx - 1];
-        if( tu.cu->ispMode ) // Intra SubPartitions mode
+        // the sub-partitions are reached through the TU chain of the CU, as CTU lines decoded in parallel interleave their TUs in tus
+        if( subTuIdx != -1 )
         {
-          //we obtain the offset to index the corresponding sub-partition
-          if( subTuIdx != -1 )
+          for( int i = 0; i < subTuIdx; i++ )
           {
-            extraIdx = subTuIdx;
+            tu = tu->next;
+            CHECK( tu == nullptr, "ISP sub-partition index exceeds the TUs of the CU" );
           }
-          else
+        }
+        else
+        {
+          while( !tu->blocks[getFirstComponentOfChannel( effChType )].contains( pos ) )
           {
-            while ( !tus[idx - 1 + extraIdx]->blocks[getFirstComponentOfChannel( effChType )].contains(pos) )
-            {
-              extraIdx++;
-              CHECK( tus[idx - 1 + extraIdx]->cu->treeType == TREE_C, "tu searched by position points to a chroma tree CU" );
-              CHECK( extraIdx > 3, "extraIdx > 3" );
-            }
+            tu = tu->next;
+            CHECK( tu == nullptr, "no ISP sub-partition of the CU contains the position" );
+            CHECK( tu->cu->treeType == TREE_C, "tu searched by position points to a chroma tree CU" );
           }
         }
       }
-      return tus[idx - 1 + extraIdx];
+      return tu;
     }
     else if (m_isTuEnc)
     {
@@ -1203,6 +1207,8 @@ const TransformUnit * CodingStructure::getTU( const Position &pos, const Channel
 
 CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chType )
 {
+  std::unique_lock<std::mutex> unitLock = xLockUnits();
+
   CodingUnit *cu = m_cuCache.get();
 
   cu->UnitArea::operator=( unit );
@@ -1215,16 +1221,26 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
   cu->firstTU   = nullptr;
   cu->lastTU    = nullptr;
   cu->chType    = chType;
-  cu->treeType = treeType;
-  cu->modeType = modeType;
+  cu->treeType = getTreeType();
+  cu->modeType = getModeType();
 
-  CodingUnit *prevCU = m_numCUs > 0 ? cus.back() : nullptr;
+  CodingUnit *prevCU = m_ctuLineState ? m_ctuLineState->lastCU : m_numCUs > 0 ? cus.back() : nullptr;
 
   if( prevCU )
   {
     prevCU->next = cu;
   }
 
+  if( m_ctuLineState )
+  {
+    // the other lines read from the vector without holding the lock
+    CHECK( cus.size() == cus.capacity(), "Unit storage must not be reallocated while decoding CTU lines in parallel" );
+    m_ctuLineState->lastCU = cu;
+    // lines in neighbouring tiles may look the CU up as soon as it is in the index map, it has to tell its slice and tile already
+    cu->slice   = slice;
+    cu->tileIdx = pps->getTileIdx( unit.blocks[chType].lumaPos() );
+    std::atomic_thread_fence( std::memory_order_release );
+  }
   cus.push_back( cu );
 
   uint32_t idx = ++m_numCUs;
@@ -1255,6 +1271,8 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
 
 PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType chType )
 {
+  std::unique_lock<std::mutex> unitLock = xLockUnits();
+
   PredictionUnit *pu = m_puCache.get();
 
   pu->UnitArea::operator=( unit );
@@ -1264,13 +1282,18 @@ PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType
   pu->cu     = m_isTuEnc ? cus[0] : getCU( unit.blocks[chType].pos(), chType );
   pu->chType = chType;
 
-  PredictionUnit *prevPU = m_numPUs > 0 ? pus.back() : nullptr;
+  PredictionUnit *prevPU = m_ctuLineState ? m_ctuLineState->lastPU : m_numPUs > 0 ? pus.back() : nullptr;
 
   if( prevPU && prevPU->cu == pu->cu )
   {
     prevPU->next = pu;
   }
 
+  if( m_ctuLineState )
+  {
+    CHECK( pus.size() == pus.capacity(), "Unit storage must not be reallocated while decoding CTU lines in parallel" );
+    m_ctuLineState->lastPU = pu;
+  }
   pus.push_back( pu );
 
   if( pu->cu->firstPU == nullptr )
@@ -1306,6 +1329,8 @@ PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType
 
 TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType chType )
 {
+  std::unique_lock<std::mutex> unitLock = xLockUnits();
+
   TransformUnit *tu = m_tuCache.get();
 
   tu->UnitArea::operator=( unit );
@@ -1316,7 +1341,7 @@ TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType c
   tu->cu     = m_isTuEnc ? cus[0] : getCU( unit.blocks[chType].pos(), chType );
   tu->chType = chType;
 
-  TransformUnit *prevTU = m_numTUs > 0 ? tus.back() : nullptr;
+  TransformUnit *prevTU = m_ctuLineState ? m_ctuLineState->lastTU : m_numTUs > 0 ? tus.back() : nullptr;
 
   if( prevTU && prevTU->cu == tu->cu )
   {
@@ -1324,6 +1349,11 @@ TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType c
     tu->prev     = prevTU;
   }
 
+  if( m_ctuLineState )
+  {
+    CHECK( tus.size() == tus.capacity(), "Unit storage must not be reallocated while decoding CTU lines in parallel" );
+    m_ctuLineState->lastTU = tu;
+  }
   tus.push_back( tu );
 
   if( tu->cu )
@@ -1747,13 +1777,13 @@ void CodingStructure::rebindPicBufs()
   }
   if( pcv->isEncoder )
   {
-    if (!picture->M_BUFS(0, PIC_RESIDUAL).bufs.empty())
+    if (picture->M_BUFS(0, PIC_RESIDUAL).bufs.empty())
     {
-      m_orgr.create(area.chromaFormat, area.blocks[0], pcv->maxCUWidth);
+      m_orgr.destroy();
     }
-    else
+    else if (m_orgr.bufs.empty())
     {
-      m_orgr.destroy();
+      m_orgr.create(area.chromaFormat, area.blocks[0], pcv->maxCUWidth);
     }
   }
 }
@@ -1829,6 +1859,7 @@ void CodingStructure::initSubStructure( CodingStructure& subStruct, const Channe
 
   subStruct.parent    = this;
   subStruct.picture   = picture;
+  subStruct.lumaCS    = lumaCS;
 
   subStruct.sps       = sps;
   subStruct.vps       = vps;
@@ -2280,7 +2311,8 @@ PelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &type )
 
   const ComponentID compID = blk.compID;
 
-  PelStorage* buf = type == PIC_PREDICTION ? &m_pred : ( type == PIC_RESIDUAL ? &m_resi : ( type == PIC_RECONSTRUCTION ? &m_reco : ( type == PIC_ORG_RESI ? &m_orgr : nullptr ) ) );
+  const bool  lineBuf = m_ctuLineState && m_ctuLineState->predBuf && !parent;
+  PelStorage* buf = type == PIC_PREDICTION ? ( lineBuf ? m_ctuLineState->predBuf : &m_pred ) : ( type == PIC_RESIDUAL ? ( lineBuf ? m_ctuLineState->resiBuf : &m_resi ) : ( type == PIC_RECONSTRUCTION ? &m_reco : ( type == PIC_ORG_RESI ? &m_orgr : nullptr ) ) );
 
   CHECK( !buf, "Unknown buffer requested" );
 
@@ -2314,7 +2346,8 @@ const CPelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &t
 
   const ComponentID compID = blk.compID;
 
-  const PelStorage* buf = type == PIC_PREDICTION ? &m_pred : ( type == PIC_RESIDUAL ? &m_resi : ( type == PIC_RECONSTRUCTION ? &m_reco : ( type == PIC_ORG_RESI ? &m_orgr : nullptr ) ) );
+  const bool        lineBuf = m_ctuLineState && m_ctuLineState->predBuf && !parent;
+  const PelStorage* buf = type == PIC_PREDICTION ? ( lineBuf ? m_ctuLineState->predBuf : &m_pred ) : ( type == PIC_RESIDUAL ? ( lineBuf ? m_ctuLineState->resiBuf : &m_resi ) : ( type == PIC_RECONSTRUCTION ? &m_reco : ( type == PIC_ORG_RESI ? &m_orgr : nullptr ) ) );
 
   CHECK( !buf, "Unknown buffer requested" );
 
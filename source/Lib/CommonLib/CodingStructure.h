@@ -44,6 +44,7 @@
 #include "UnitPartitioner.h"
 #include "Slice.h"
 #include <vector>
+#include <mutex>
 
 
 struct Picture;
@@ -66,6 +67,20 @@ enum PictureType
 };
 extern XUCache g_globalUnitCache;
 
+/// state of a CTU line (WPP row or tile) that a thread decodes into a coding structure shared with other lines
+struct CtuLineState
+{
+  LutMotionCand   motionLut;              ///< HMVP candidates of the line
+  TreeType        treeType  = TREE_D;     ///< local dual tree state of the line
+  ModeType        modeType  = MODE_TYPE_ALL;
+  CodingUnit     *lastCU    = nullptr;    ///< units added last by the line, the units of a CTU are linked among themselves only
+  PredictionUnit *lastPU    = nullptr;
+  TransformUnit  *lastTU    = nullptr;
+  std::mutex     *unitMutex = nullptr;    ///< guards the unit storage of the shared coding structure
+  PelStorage     *predBuf   = nullptr;    ///< prediction and residual buffers of the line, replacing the CTU buffers of the picture
+  PelStorage     *resiBuf   = nullptr;
+};
+
 // ---------------------------------------------------------------------------
 // coding structure
 // ---------------------------------------------------------------------------
@@ -80,6 +95,7 @@ public:
   CodingStructure *parent;
   CodingStructure *bestCS;
   Slice           *slice;
+  const CodingStructure *lumaCS;   ///< holds the collocated luma units of a separate chroma tree, nullptr for the picture-level structure
 
   UnitScale        unitScale[MAX_NUM_COMPONENT];
 
@@ -197,6 +213,10 @@ public:
   Distortion  interHad;
   TreeType    treeType; //because partitioner can not go deep to tu and cu coding (e.g., addCU()), need another variable for indicating treeType
   ModeType    modeType;
+  TreeType    getTreeType() const { return m_ctuLineState ? m_ctuLineState->treeType : treeType; }
+  ModeType    getModeType() const { return m_ctuLineState ? m_ctuLineState->modeType : modeType; }
+  void        setTreeType( const TreeType _treeType ) { ( m_ctuLineState ? m_ctuLineState->treeType : treeType ) = _treeType; }
+  void        setModeType( const ModeType _modeType ) { ( m_ctuLineState ? m_ctuLineState->modeType : modeType ) = _modeType; }
 
   void initStructData  (const int &QP = MAX_INT, const bool &skipMotBuf = false);
   void initSubStructure(      CodingStructure& cs, const ChannelType chType, const UnitArea &subArea, const bool &isTuEnc);
@@ -208,6 +228,7 @@ public:
   void clearTUs();
   void clearPUs();
   void clearCUs();
+  void clearUnits() { clearPUs(); clearTUs(); clearCUs(); }
   const int signalModeCons( const PartSplit split, Partitioner &partitioner, const ModeType modeTypeParent ) const;
   void clearCuPuTuIdxMap  ( const UnitArea &_area, uint32_t numCu, uint32_t numPu, uint32_t numTu, uint32_t* pOffset );
   void getNumCuPuTuOffset ( uint32_t* pArray )
@@ -228,6 +249,12 @@ public:
 
   LutMotionCand motionLut;
 
+  LutMotionCand&       getMotionLut()       { return m_ctuLineState ? m_ctuLineState->motionLut : motionLut; }
+  const LutMotionCand& getMotionLut() const { return m_ctuLineState ? m_ctuLineState->motionLut : motionLut; }
+
+  /// attach the calling thread to a CTU line (nullptr detaches it), units, tree type and HMVP candidates are then kept per line
+  static void setCtuLineState( CtuLineState* lineState ) { m_ctuLineState = lineState; }
+
   void addMiToLut(static_vector<MotionInfo, MAX_NUM_HMVP_CANDS>& lut, const MotionInfo &mi);
 
   PLTBuf prevPLT;
@@ -237,6 +264,10 @@ public:
   void storePrevPLT(PLTBuf& predictor);
 private:
 
+  std::unique_lock<std::mutex> xLockUnits() { return m_ctuLineState && m_ctuLineState->unitMutex ? std::unique_lock<std::mutex>( *m_ctuLineState->unitMutex ) : std::unique_lock<std::mutex>(); }
+
+  static thread_local CtuLineState* m_ctuLineState;
+
   // needed for TU encoding
   bool m_isTuEnc;
 
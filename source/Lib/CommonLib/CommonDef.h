@@ -296,6 +296,7 @@ static const int MAX_NUM_PARTS_IN_CTU =                         ( ( MAX_CU_SIZE
 static const int MAX_NUM_TUS =                                     16; ///< Maximum number of TUs within one CU. When max TB size is 32x32, up to 16 TUs within one CU (128x128) is supported
 static const int MAX_LOG2_DIFF_CU_TR_SIZE =                         3;
 static const int MAX_CU_TILING_PARTITIONS = 1 << ( MAX_LOG2_DIFF_CU_TR_SIZE << 1 );
+static const int PARL_SPLIT_MAX_NUM_JOBS =                          6; ///< max. number of jobs evaluating the modes of one CU in parallel: no split, QT, BT_H, BT_V, TT_H and TT_V
 
 static const int JVET_C0024_ZERO_OUT_TH =                          32;
 
@@ -360,6 +361,7 @@ static const int DMVR_SUBCU_WIDTH_LOG2 = 4;
 static const int DMVR_SUBCU_HEIGHT_LOG2 = 4;
 static const int MAX_NUM_SUBCU_DMVR = ((MAX_CU_SIZE * MAX_CU_SIZE) >> (DMVR_SUBCU_WIDTH_LOG2 + DMVR_SUBCU_HEIGHT_LOG2));
 static const int DMVR_NUM_ITERATION = 2;
+static const int MC_REF_ROW_MARGIN = 8; ///< luma rows below the motion-shifted block that inter prediction may read (interpolation taps, DMVR search range, BDOF padding)
 
 //QTBT high level parameters
 //for I slice luma CTB configuration para.
@@ -68,8 +68,6 @@ namespace DQIntern
   };
 
 
-  enum ScanPosType { SCAN_ISCSBB = 0, SCAN_SOCSBB = 1, SCAN_EOCSBB = 2 };
-
   struct ScanInfo
   {
     ScanInfo() {}
@@ -607,30 +605,6 @@ namespace DQIntern
 
 
 
-  /*================================================================================*/
-  /*=====                                                                      =====*/
-  /*=====   D A T A   S T R U C T U R E S                                      =====*/
-  /*=====                                                                      =====*/
-  /*================================================================================*/
-
-
-  struct PQData
-  {
-    TCoeff  absLevel;
-    int64_t deltaDist;
-  };
-
-
-  struct Decision
-  {
-    int64_t rdCost;
-    TCoeff  absLevel;
-    int     prevId;
-  };
-
-
-
-
   /*================================================================================*/
   /*=====                                                                      =====*/
   /*=====   P R E - Q U A N T I Z E R                                          =====*/
@@ -859,14 +833,7 @@ namespace DQIntern
     uint8_t                     m_memory[ 8 * ( MAX_TB_SIZEY * MAX_TB_SIZEY + MLS_GRP_NUM ) ];
   };
 
-#if JVET_V0106_DEP_QUANT_ENC_OPT
-#define RICEMAX 64
-#define RICE_ORDER_MAX 16
   const int32_t g_goRiceBits[RICE_ORDER_MAX][RICEMAX] =
-#else
-#define RICEMAX 32
-  const int32_t g_goRiceBits[4][RICEMAX] =
-#endif
   {
 #if JVET_V0106_DEP_QUANT_ENC_OPT
     { 32768, 65536, 98304, 131072, 163840, 196608, 262144, 262144, 327680, 327680, 327680, 327680, 393216, 393216, 393216, 393216, 393216, 393216, 393216, 393216, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288 },
@@ -897,7 +864,7 @@ namespace DQIntern
   {
     friend class CommonCtx;
   public:
-    State( const RateEstimator& rateEst, CommonCtx& commonCtx, const int stateId );
+    State( const RateEstimator& rateEst, CommonCtx& commonCtx, StateMem& stateMem, const int stateId );
 
     template<uint8_t numIPos>
     inline void updateState(const ScanInfo &scanInfo, const State *prevStates, const Decision &decision, const int baseLevel, const bool extRiceFlag);
@@ -910,105 +877,25 @@ namespace DQIntern
       m_numSigSbb     = 0;
       m_remRegBins    = 4;  // just large enough for last scan pos
       m_refSbbCtxId   = -1;
-      m_sigFracBits   = m_sigFracBitsArray[ 0 ];
-      m_coeffFracBits = m_gtxFracBitsArray[ 0 ];
+      setSigFracBits  ( m_sigFracBitsArray[ 0 ] );
+      setCoeffFracBits( m_gtxFracBitsArray[ 0 ] );
       m_goRicePar     = 0;
       m_goRiceZero    = 0;
     }
-    void checkRdCosts( const ScanPosType spt, const PQData& pqDataA, const PQData& pqDataB, Decision& decisionA, Decision& decisionB ) const
-    {
-      const int32_t*  goRiceTab = g_goRiceBits[m_goRicePar];
-      int64_t         rdCostA   = m_rdCost + pqDataA.deltaDist;
-      int64_t         rdCostB   = m_rdCost + pqDataB.deltaDist;
-      int64_t         rdCostZ   = m_rdCost;
-      if (m_remRegBins >= 4)
-      {
-        if (pqDataA.absLevel < 4)
-        {
-          rdCostA += m_coeffFracBits.bits[pqDataA.absLevel];
-        }
-        else
-        {
-          const TCoeff value = (pqDataA.absLevel - 4) >> 1;
-          rdCostA +=
-            m_coeffFracBits.bits[pqDataA.absLevel - (value << 1)] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
-        }
-        if (pqDataB.absLevel < 4)
-        {
-          rdCostB += m_coeffFracBits.bits[pqDataB.absLevel];
-        }
-        else
-        {
-          const TCoeff value = (pqDataB.absLevel - 4) >> 1;
-          rdCostB +=
-            m_coeffFracBits.bits[pqDataB.absLevel - (value << 1)] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
-        }
-        if (spt == SCAN_ISCSBB)
-        {
-          rdCostA += m_sigFracBits.intBits[1];
-          rdCostB += m_sigFracBits.intBits[1];
-          rdCostZ += m_sigFracBits.intBits[0];
-        }
-        else if (spt == SCAN_SOCSBB)
-        {
-          rdCostA += m_sbbFracBits.intBits[1] + m_sigFracBits.intBits[1];
-          rdCostB += m_sbbFracBits.intBits[1] + m_sigFracBits.intBits[1];
-          rdCostZ += m_sbbFracBits.intBits[1] + m_sigFracBits.intBits[0];
-        }
-        else if (m_numSigSbb)
-        {
-          rdCostA += m_sigFracBits.intBits[1];
-          rdCostB += m_sigFracBits.intBits[1];
-          rdCostZ += m_sigFracBits.intBits[0];
-        }
-        else
-        {
-          rdCostZ = decisionA.rdCost;
-        }
-      }
-      else
-      {
-        rdCostA +=
-          (1 << SCALE_BITS)
-          + goRiceTab[pqDataA.absLevel <= m_goRiceZero ? pqDataA.absLevel - 1
-                                                       : (pqDataA.absLevel < RICEMAX ? pqDataA.absLevel : RICEMAX - 1)];
-        rdCostB +=
-          (1 << SCALE_BITS)
-          + goRiceTab[pqDataB.absLevel <= m_goRiceZero ? pqDataB.absLevel - 1
-                                                       : (pqDataB.absLevel < RICEMAX ? pqDataB.absLevel : RICEMAX - 1)];
-        rdCostZ += goRiceTab[m_goRiceZero];
-      }
-      if (rdCostA < decisionA.rdCost)
-      {
-        decisionA.rdCost   = rdCostA;
-        decisionA.absLevel = pqDataA.absLevel;
-        decisionA.prevId   = m_stateId;
-      }
-      if (rdCostZ < decisionA.rdCost)
-      {
-        decisionA.rdCost   = rdCostZ;
-        decisionA.absLevel = 0;
-        decisionA.prevId   = m_stateId;
-      }
-      if (rdCostB < decisionB.rdCost)
-      {
-        decisionB.rdCost   = rdCostB;
-        decisionB.absLevel = pqDataB.absLevel;
-        decisionB.prevId   = m_stateId;
-      }
-    }
+
+    inline const StateMem& stateMem() const { return m_stateMem; }
 
     inline void checkRdCostStart(int32_t lastOffset, const PQData &pqData, Decision &decision) const
     {
       int64_t rdCost = pqData.deltaDist + lastOffset;
       if (pqData.absLevel < 4)
       {
-        rdCost += m_coeffFracBits.bits[pqData.absLevel];
+        rdCost += m_stateMem.coeffFracBits[pqData.absLevel][m_stateId];
       }
       else
       {
         const TCoeff value = (pqData.absLevel - 4) >> 1;
-        rdCost += m_coeffFracBits.bits[pqData.absLevel - (value << 1)] + g_goRiceBits[m_goRicePar][value < RICEMAX ? value : RICEMAX-1];
+        rdCost += m_stateMem.coeffFracBits[pqData.absLevel - (value << 1)][m_stateId] + g_goRiceBits[m_goRicePar][value < RICEMAX ? value : RICEMAX-1];
       }
       if( rdCost < decision.rdCost )
       {
@@ -1018,37 +905,48 @@ namespace DQIntern
       }
     }
 
-    inline void checkRdCostSkipSbb(Decision &decision) const
-    {
-      int64_t rdCost = m_rdCost + m_sbbFracBits.intBits[0];
-      if( rdCost < decision.rdCost )
-      {
-        decision.rdCost   = rdCost;
-        decision.absLevel = 0;
-        decision.prevId   = 4+m_stateId;
-      }
-    }
-
     inline void checkRdCostSkipSbbZeroOut(Decision &decision) const
     {
-      int64_t rdCost = m_rdCost + m_sbbFracBits.intBits[0];
+      int64_t rdCost = m_rdCost + m_stateMem.sbbFracBits[0][m_stateId];
       decision.rdCost = rdCost;
       decision.absLevel = 0;
       decision.prevId = 4 + m_stateId;
     }
 
   private:
-    int64_t                   m_rdCost;
+    inline void setSigFracBits( const BinFracBits& fracBits )
+    {
+      m_stateMem.sigFracBits[0][m_stateId] = fracBits.intBits[0];
+      m_stateMem.sigFracBits[1][m_stateId] = fracBits.intBits[1];
+    }
+    inline void setSbbFracBits( const BinFracBits& fracBits )
+    {
+      m_stateMem.sbbFracBits[0][m_stateId] = fracBits.intBits[0];
+      m_stateMem.sbbFracBits[1][m_stateId] = fracBits.intBits[1];
+    }
+    inline void copySbbFracBits( const State& other )
+    {
+      m_stateMem.sbbFracBits[0][m_stateId] = other.m_stateMem.sbbFracBits[0][other.m_stateId];
+      m_stateMem.sbbFracBits[1][m_stateId] = other.m_stateMem.sbbFracBits[1][other.m_stateId];
+    }
+    inline void setCoeffFracBits( const CoeffFracBits& fracBits )
+    {
+      for( int k = 0; k < 6; k++ )
+      {
+        m_stateMem.coeffFracBits[k][m_stateId] = fracBits.bits[k];
+      }
+    }
+
+  private:
+    StateMem&                 m_stateMem;
+    const int8_t              m_stateId;
+    int64_t&                  m_rdCost;
     uint16_t                  m_absLevelsAndCtxInit[24];  // 16x8bit for abs levels + 16x16bit for ctx init id
-    int8_t                    m_numSigSbb;
-    int                       m_remRegBins;
+    int32_t&                  m_numSigSbb;
+    int32_t&                  m_remRegBins;
     int8_t                    m_refSbbCtxId;
-    BinFracBits               m_sbbFracBits;
-    BinFracBits               m_sigFracBits;
-    CoeffFracBits             m_coeffFracBits;
-    int8_t                    m_goRicePar;
-    int8_t                    m_goRiceZero;
-    const int8_t              m_stateId;
+    int32_t&                  m_goRicePar;
+    int32_t&                  m_goRiceZero;
     const BinFracBits*const   m_sigFracBitsArray;
     const CoeffFracBits*const m_gtxFracBitsArray;
     CommonCtx&                m_commonCtx;
@@ -1057,6 +955,111 @@ namespace DQIntern
     unsigned                  effHeight;
   };
 
+  static inline void checkRdCosts( const StateMem& state, const int stateId, const ScanPosType spt, const PQData& pqDataA, const PQData& pqDataB, Decision& decisionA, Decision& decisionB )
+  {
+    const int32_t*  goRiceTab = g_goRiceBits[state.goRicePar[stateId]];
+    const int32_t   goRiceZero= state.goRiceZero[stateId];
+    int64_t         rdCostA   = state.rdCost[stateId] + pqDataA.deltaDist;
+    int64_t         rdCostB   = state.rdCost[stateId] + pqDataB.deltaDist;
+    int64_t         rdCostZ   = state.rdCost[stateId];
+    if (state.remRegBins[stateId] >= 4)
+    {
+      if (pqDataA.absLevel < 4)
+      {
+        rdCostA += state.coeffFracBits[pqDataA.absLevel][stateId];
+      }
+      else
+      {
+        const TCoeff value = (pqDataA.absLevel - 4) >> 1;
+        rdCostA +=
+          state.coeffFracBits[pqDataA.absLevel - (value << 1)][stateId] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
+      }
+      if (pqDataB.absLevel < 4)
+      {
+        rdCostB += state.coeffFracBits[pqDataB.absLevel][stateId];
+      }
+      else
+      {
+        const TCoeff value = (pqDataB.absLevel - 4) >> 1;
+        rdCostB +=
+          state.coeffFracBits[pqDataB.absLevel - (value << 1)][stateId] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
+      }
+      if (spt == SCAN_ISCSBB)
+      {
+        rdCostA += state.sigFracBits[1][stateId];
+        rdCostB += state.sigFracBits[1][stateId];
+        rdCostZ += state.sigFracBits[0][stateId];
+      }
+      else if (spt == SCAN_SOCSBB)
+      {
+        rdCostA += state.sbbFracBits[1][stateId] + state.sigFracBits[1][stateId];
+        rdCostB += state.sbbFracBits[1][stateId] + state.sigFracBits[1][stateId];
+        rdCostZ += state.sbbFracBits[1][stateId] + state.sigFracBits[0][stateId];
+      }
+      else if (state.numSigSbb[stateId])
+      {
+        rdCostA += state.sigFracBits[1][stateId];
+        rdCostB += state.sigFracBits[1][stateId];
+        rdCostZ += state.sigFracBits[0][stateId];
+      }
+      else
+      {
+        rdCostZ = decisionA.rdCost;
+      }
+    }
+    else
+    {
+      rdCostA +=
+        (1 << SCALE_BITS)
+        + goRiceTab[pqDataA.absLevel <= goRiceZero ? pqDataA.absLevel - 1
+                                                   : (pqDataA.absLevel < RICEMAX ? pqDataA.absLevel : RICEMAX - 1)];
+      rdCostB +=
+        (1 << SCALE_BITS)
+        + goRiceTab[pqDataB.absLevel <= goRiceZero ? pqDataB.absLevel - 1
+                                                   : (pqDataB.absLevel < RICEMAX ? pqDataB.absLevel : RICEMAX - 1)];
+      rdCostZ += goRiceTab[goRiceZero];
+    }
+    if (rdCostA < decisionA.rdCost)
+    {
+      decisionA.rdCost   = rdCostA;
+      decisionA.absLevel = pqDataA.absLevel;
+      decisionA.prevId   = stateId;
+    }
+    if (rdCostZ < decisionA.rdCost)
+    {
+      decisionA.rdCost   = rdCostZ;
+      decisionA.absLevel = 0;
+      decisionA.prevId   = stateId;
+    }
+    if (rdCostB < decisionB.rdCost)
+    {
+      decisionB.rdCost   = rdCostB;
+      decisionB.absLevel = pqDataB.absLevel;
+      decisionB.prevId   = stateId;
+    }
+  }
+
+  void checkAllRdCosts( const ScanPosType spt, const PQData* pqData, const StateMem& prev, const StateMem* skip, Decision* decisions )
+  {
+    checkRdCosts( prev, 0, spt, pqData[0], pqData[2], decisions[0], decisions[2] );
+    checkRdCosts( prev, 1, spt, pqData[0], pqData[2], decisions[2], decisions[0] );
+    checkRdCosts( prev, 2, spt, pqData[3], pqData[1], decisions[1], decisions[3] );
+    checkRdCosts( prev, 3, spt, pqData[3], pqData[1], decisions[3], decisions[1] );
+    if( skip )
+    {
+      for( int stateId = 0; stateId < 4; stateId++ )
+      {
+        int64_t rdCost = skip->rdCost[stateId] + skip->sbbFracBits[0][stateId];
+        if( rdCost < decisions[stateId].rdCost )
+        {
+          decisions[stateId].rdCost   = rdCost;
+          decisions[stateId].absLevel = 0;
+          decisions[stateId].prevId   = 4 + stateId;
+        }
+      }
+    }
+  }
+
   unsigned templateAbsCompare(TCoeff sum)
   {
     int rangeIdx = 0;
@@ -1083,13 +1086,19 @@ namespace DQIntern
     return g_riceShift[rangeIdx];
   }
 
-  State::State( const RateEstimator& rateEst, CommonCtx& commonCtx, const int stateId )
-    : m_sbbFracBits     { { 0, 0 } }
+  State::State( const RateEstimator& rateEst, CommonCtx& commonCtx, StateMem& stateMem, const int stateId )
+    : m_stateMem        ( stateMem )
     , m_stateId         ( stateId )
+    , m_rdCost          ( stateMem.rdCost    [stateId] )
+    , m_numSigSbb       ( stateMem.numSigSbb [stateId] )
+    , m_remRegBins      ( stateMem.remRegBins[stateId] )
+    , m_goRicePar       ( stateMem.goRicePar [stateId] )
+    , m_goRiceZero      ( stateMem.goRiceZero[stateId] )
     , m_sigFracBitsArray( rateEst.sigFlagBits(stateId) )
     , m_gtxFracBitsArray( rateEst.gtxFracBits(stateId) )
     , m_commonCtx       ( commonCtx )
   {
+    setSbbFracBits( BinFracBits{ { 0, 0 } } );
   }
 
   template<uint8_t numIPos>
@@ -1103,7 +1112,7 @@ namespace DQIntern
         const State*  prvState  = prevStates            +   decision.prevId;
         m_numSigSbb             = prvState->m_numSigSbb + !!decision.absLevel;
         m_refSbbCtxId           = prvState->m_refSbbCtxId;
-        m_sbbFracBits           = prvState->m_sbbFracBits;
+        copySbbFracBits( *prvState );
         m_remRegBins            = prvState->m_remRegBins - 1;
         m_goRicePar             = prvState->m_goRicePar;
         if( m_remRegBins >= 4 )
@@ -1162,8 +1171,8 @@ namespace DQIntern
         }
 #undef UPDATE
         TCoeff sumGt1 = sumAbs1 - sumNum;
-        m_sigFracBits = m_sigFracBitsArray[scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 )];
-        m_coeffFracBits = m_gtxFracBitsArray[scanInfo.gtxCtxOffsetNext + (sumGt1 < 4 ? sumGt1 : 4)];
+        setSigFracBits  ( m_sigFracBitsArray[scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 )] );
+        setCoeffFracBits( m_gtxFracBitsArray[scanInfo.gtxCtxOffsetNext + (sumGt1 < 4 ? sumGt1 : 4)] );
 
         TCoeff  sumAbs = m_absLevelsAndCtxInit[8 + scanInfo.nextInsidePos] >> 8;
 #define UPDATE(k) {TCoeff t=levels[scanInfo.nextNbInfoSbb.inPos[k]]; sumAbs+=t; }
@@ -1298,8 +1307,8 @@ namespace DQIntern
       TCoeff  sumNum  =   tinit        & 7;
       TCoeff  sumAbs1 = ( tinit >> 3 ) & 31;
       TCoeff  sumGt1  = sumAbs1        - sumNum;
-      m_sigFracBits   = m_sigFracBitsArray[ scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 ) ];
-      m_coeffFracBits = m_gtxFracBitsArray[ scanInfo.gtxCtxOffsetNext + ( sumGt1  < 4 ? sumGt1  : 4 ) ];
+      setSigFracBits  ( m_sigFracBitsArray[ scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 ) ] );
+      setCoeffFracBits( m_gtxFracBitsArray[ scanInfo.gtxCtxOffsetNext + ( sumGt1  < 4 ? sumGt1  : 4 ) ] );
     }
   }
 
@@ -1334,7 +1343,7 @@ namespace DQIntern
     }
     currState.m_goRicePar     = 0;
     currState.m_refSbbCtxId   = currState.m_stateId;
-    currState.m_sbbFracBits   = m_sbbFlagBits[ sigNSbb ];
+    currState.setSbbFracBits( m_sbbFlagBits[ sigNSbb ] );
 
     uint16_t          templateCtxInit[16];
     const int         scanBeg   = scanInfo.scanIdx - scanInfo.sbbSize;
@@ -1385,7 +1394,7 @@ namespace DQIntern
   class DepQuant : private RateEstimator
   {
   public:
-    DepQuant();
+    DepQuant( CheckAllRdCostsFunc checkAllRdCosts );
 
     void    quant   ( TransformUnit& tu, const CCoeffBuf& srcCoeff, const ComponentID compID, const QpParam& cQP, const double lambda, const Ctx& ctx, TCoeff& absSum, bool enableScalingLists, int* quantCoeff );
     void    dequant ( const TransformUnit& tu, CoeffBuf& recCoeff, const ComponentID compID, const QpParam& cQP, bool enableScalingLists, int* quantCoeff );
@@ -1403,6 +1412,7 @@ namespace DQIntern
 
   private:
     CommonCtx   m_commonCtx;
+    StateMem    m_stateMem[ 4 ];
     State       m_allStates[ 12 ];
     State*      m_currStates;
     State*      m_prevStates;
@@ -1410,18 +1420,21 @@ namespace DQIntern
     State       m_startState;
     Quantizer   m_quant;
     Decision    m_trellis[ MAX_TB_SIZEY * MAX_TB_SIZEY ][ 8 ];
+    CheckAllRdCostsFunc m_checkAllRdCosts;
   };
 
 
-#define TINIT(x) {*this,m_commonCtx,x}
-  DepQuant::DepQuant()
+#define TINIT(m,x) {*this,m_commonCtx,m_stateMem[m],x}
+  DepQuant::DepQuant( CheckAllRdCostsFunc checkAllRdCosts )
     : RateEstimator ()
     , m_commonCtx   ()
-    , m_allStates   {TINIT(0),TINIT(1),TINIT(2),TINIT(3),TINIT(0),TINIT(1),TINIT(2),TINIT(3),TINIT(0),TINIT(1),TINIT(2),TINIT(3)}
+    , m_stateMem    ()
+    , m_allStates   {TINIT(0,0),TINIT(0,1),TINIT(0,2),TINIT(0,3),TINIT(1,0),TINIT(1,1),TINIT(1,2),TINIT(1,3),TINIT(2,0),TINIT(2,1),TINIT(2,2),TINIT(2,3)}
     , m_currStates  (  m_allStates      )
     , m_prevStates  (  m_currStates + 4 )
     , m_skipStates  (  m_prevStates + 4 )
-    , m_startState  TINIT(0)
+    , m_startState  TINIT(3,0)
+    , m_checkAllRdCosts( checkAllRdCosts )
   {}
 #undef TINIT
 
@@ -1455,17 +1468,7 @@ namespace DQIntern
 
     PQData  pqData[4];
     m_quant.preQuantCoeff( absCoeff, pqData, quanCoeff );
-    m_prevStates[0].checkRdCosts( spt, pqData[0], pqData[2], decisions[0], decisions[2]);
-    m_prevStates[1].checkRdCosts( spt, pqData[0], pqData[2], decisions[2], decisions[0]);
-    m_prevStates[2].checkRdCosts( spt, pqData[3], pqData[1], decisions[1], decisions[3]);
-    m_prevStates[3].checkRdCosts( spt, pqData[3], pqData[1], decisions[3], decisions[1]);
-    if( spt==SCAN_EOCSBB )
-    {
-      m_skipStates[0].checkRdCostSkipSbb(decisions[0]);
-      m_skipStates[1].checkRdCostSkipSbb(decisions[1]);
-      m_skipStates[2].checkRdCostSkipSbb(decisions[2]);
-      m_skipStates[3].checkRdCostSkipSbb(decisions[3]);
-    }
+    m_checkAllRdCosts( spt, pqData, m_prevStates[0].stateMem(), spt==SCAN_EOCSBB ? &m_skipStates[0].stateMem() : nullptr, decisions );
 
     m_startState.checkRdCostStart( lastOffset, pqData[0], decisions[0] );
     m_startState.checkRdCostStart( lastOffset, pqData[2], decisions[2] );
@@ -1688,7 +1691,13 @@ DepQuant::DepQuant( const Quant* other, bool enc ) : QuantRDOQ( other )
 {
   const DepQuant* dq = dynamic_cast<const DepQuant*>( other );
   CHECK( other && !dq, "The DepQuant cast must be successfull!" );
-  p = new DQIntern::DepQuant();
+  m_checkAllRdCosts = DQIntern::checkAllRdCosts;
+#if ENABLE_SIMD_OPT_DEPQUANT
+#ifdef TARGET_SIMD_X86
+  initDepQuantX86();
+#endif
+#endif
+  p = new DQIntern::DepQuant( m_checkAllRdCosts );
   if( enc )
   {
     DQIntern::g_Rom.init();
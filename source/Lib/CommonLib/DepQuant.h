@@ -45,6 +45,49 @@
 
 
 
+namespace DQIntern
+{
+  enum ScanPosType { SCAN_ISCSBB = 0, SCAN_SOCSBB = 1, SCAN_EOCSBB = 2 };
+
+  struct PQData
+  {
+    TCoeff  absLevel;
+    int64_t deltaDist;
+  };
+
+  struct Decision
+  {
+    int64_t rdCost;
+    TCoeff  absLevel;
+    int     prevId;
+  };
+
+  // rate relevant members of the four trellis states, one lane per state
+  struct StateMem
+  {
+    int64_t rdCost       [4];
+    int32_t remRegBins   [4];
+    int32_t numSigSbb    [4];
+    int32_t goRicePar    [4];
+    int32_t goRiceZero   [4];
+    int32_t sigFracBits  [2][4];
+    int32_t sbbFracBits  [2][4];
+    int32_t coeffFracBits[6][4];
+  };
+
+#if JVET_V0106_DEP_QUANT_ENC_OPT
+#define RICEMAX 64
+#define RICE_ORDER_MAX 16
+#else
+#define RICEMAX 32
+#define RICE_ORDER_MAX 4
+#endif
+  extern const int32_t g_goRiceBits[RICE_ORDER_MAX][RICEMAX];
+
+  // rd cost check of the four previous states (and the skipped sub-block states at the end of a sub-block)
+  typedef void (*CheckAllRdCostsFunc)( const ScanPosType spt, const PQData* pqData, const StateMem& prev, const StateMem* skip, Decision* decisions );
+  void checkAllRdCosts( const ScanPosType spt, const PQData* pqData, const StateMem& prev, const StateMem* skip, Decision* decisions );
+}
 
 
 class DepQuant : public QuantRDOQ
@@ -56,8 +99,15 @@ public:
   virtual void quant  ( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx& ctx );
   virtual void dequant( const TransformUnit &tu, CoeffBuf &dstCoeff, const ComponentID &compID, const QpParam &cQP );
 
+#ifdef TARGET_SIMD_X86
+  void initDepQuantX86();
+  template <X86_VEXT vext>
+  void _initDepQuantX86();
+#endif
+
 private:
   void* p;
+  DQIntern::CheckAllRdCostsFunc m_checkAllRdCosts;
 };
 
 
@@ -277,6 +277,38 @@ bool InterPrediction::xCheckIdenticalMotion( const PredictionUnit &pu )
   return false;
 }
 
+void InterPrediction::xWaitForRefRows( const PredictionUnit& pu )
+{
+  // sub-block merge candidates wait for each of their sub-PUs separately
+  if( pu.mergeType == MRG_TYPE_SUBPU_ATMVP )
+  {
+    return;
+  }
+
+  for( int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+  {
+    const int refIdx = pu.refIdx[refList];
+    if( refIdx < 0 || refIdx >= pu.cu->slice->getNumRefIdx( RefPicList( refList ) ) )
+    {
+      continue;
+    }
+
+    const Picture* refPic = pu.cu->slice->getRefPic( RefPicList( refList ), refIdx );
+    if( refPic->ctuRowProgress.isFinished() )
+    {
+      continue;
+    }
+
+    int lumaY = MAX_INT;
+    if( !pu.cu->affine && !refPic->isRefScaled( pu.cs->pps ) )
+    {
+      const int mvVer = ( pu.mv[refList].getVer() + ( 1 << MV_FRACTIONAL_BITS_INTERNAL ) - 1 ) >> MV_FRACTIONAL_BITS_INTERNAL;
+      lumaY = pu.ly() + pu.lheight() + mvVer + MC_REF_ROW_MARGIN;
+    }
+    refPic->ctuRowProgress.waitForLumaRow( lumaY );
+  }
+}
+
 void InterPrediction::xSubPuMC( PredictionUnit& pu, PelUnitBuf& predBuf, const RefPicList &eRefPicList /*= REF_PIC_LIST_X*/, const bool luma /*= true*/, const bool chroma /*= true*/)
 {
 
@@ -715,126 +747,136 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
       yFrac = (mv.ver << (1 - ::getComponentScaleY(compID, chFmt))) & 31;
     }
 
-    PelBuf & dstBuf = dstPic.bufs[compID];
-    unsigned width  = dstBuf.width;
-    unsigned height = dstBuf.height;
-
-    CPelBuf refBuf;
-    {
-      Position offset = pu.blocks[compID].pos().offset(mv.getHor() >> shiftHor, mv.getVer() >> shiftVer);
-      if (dmvrWidth)
-      {
-        refBuf = refPic->getRecoBuf(CompArea(compID, chFmt, offset, Size(dmvrWidth, dmvrHeight)), wrapRef);
-      }
-      else
-      {
-        refBuf = refPic->getRecoBuf(CompArea(compID, chFmt, offset, pu.blocks[compID].size()), wrapRef);
-      }
-    }
+    const Position offset = pu.blocks[compID].pos().offset(mv.getHor() >> shiftHor, mv.getVer() >> shiftVer);
+    const CompArea refArea( compID, chFmt, offset, dmvrWidth ? Size(dmvrWidth, dmvrHeight) : pu.blocks[compID].size() );
 
-    if (NULL != srcPadBuf)
+#if ENABLE_8BIT_REFERENCES
+    if (refPic->isRecoPacked() && NULL == srcPadBuf)
     {
-      refBuf.buf    = srcPadBuf;
-      refBuf.stride = srcPadStride;
+      xPredInterBlkFilter(compID, pu, refPic->getRecoBuf8(refArea), dstPic.bufs[compID], xFrac, yFrac, dmvrWidth,
+                          dmvrHeight, rndRes, clpRng, bioApplied, bilinearMC, useAltHpelIf, srcPadStride);
     }
-    if (dmvrWidth)
+    else
+#endif
     {
-      width  = dmvrWidth;
-      height = dmvrHeight;
+      const CPelBuf refBuf = NULL != srcPadBuf ? CPelBuf(srcPadBuf, srcPadStride, refArea.size()) : refPic->getRecoBuf(refArea, wrapRef);
+      xPredInterBlkFilter(compID, pu, refBuf, dstPic.bufs[compID], xFrac, yFrac, dmvrWidth, dmvrHeight, rndRes, clpRng,
+                          bioApplied, bilinearMC, useAltHpelIf, srcPadStride);
     }
-    // backup data
-    int  backupWidth        = width;
-    int  backupHeight       = height;
-    Pel *backupDstBufPtr    = dstBuf.buf;
-    int  backupDstBufStride = dstBuf.stride;
+  }
+}
 
-    if (bioApplied && compID == COMPONENT_Y)
-    {
-      width  = width + 2 * BIO_EXTEND_SIZE + 2;
-      height = height + 2 * BIO_EXTEND_SIZE + 2;
+// filters the reference block, which is given by 16-bit or 8-bit samples, into the prediction, with the BDOF border
+template<typename TSrc>
+void InterPrediction::xPredInterBlkFilter( const ComponentID compID, const PredictionUnit& pu, const AreaBuf<const TSrc>& refBuf, PelBuf& dstBuf, const int xFrac, const int yFrac
+                                          , SizeType dmvrWidth
+                                          , SizeType dmvrHeight
+                                          , const bool rndRes, const ClpRng& clpRng
+                                          , const bool bioApplied
+                                          , const bool bilinearMC
+                                          , const bool useAltHpelIf
+                                          , int32_t srcPadStride
+                                         )
+{
+  unsigned width  = dstBuf.width;
+  unsigned height = dstBuf.height;
+  if (dmvrWidth)
+  {
+    width  = dmvrWidth;
+    height = dmvrHeight;
+  }
+  // backup data
+  int  backupWidth        = width;
+  int  backupHeight       = height;
+  Pel *backupDstBufPtr    = dstBuf.buf;
+  int  backupDstBufStride = dstBuf.stride;
 
-      // change MC output
-      dstBuf.stride = width;
-      dstBuf.buf    = m_filteredBlockTmp[2 + m_iRefListIdx][compID] + 2 * dstBuf.stride + 2;
-    }
+  if (bioApplied && compID == COMPONENT_Y)
+  {
+    width  = width + 2 * BIO_EXTEND_SIZE + 2;
+    height = height + 2 * BIO_EXTEND_SIZE + 2;
 
-    if (yFrac == 0)
+    // change MC output
+    dstBuf.stride = width;
+    dstBuf.buf    = m_filteredBlockTmp[2 + m_iRefListIdx][compID] + 2 * dstBuf.stride + 2;
+  }
+
+  if (yFrac == 0)
+  {
+    m_if.filterHor(compID, refBuf.buf, refBuf.stride, dstBuf.buf, dstBuf.stride, backupWidth, backupHeight,
+                   xFrac, rndRes, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
+  }
+  else if (xFrac == 0)
+  {
+    m_if.filterVer(compID, refBuf.buf, refBuf.stride, dstBuf.buf, dstBuf.stride, backupWidth, backupHeight,
+                   yFrac, true, rndRes, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
+  }
+  else
+  {
+    PelBuf tmpBuf = dmvrWidth ? PelBuf(m_filteredBlockTmp[0][compID], Size(dmvrWidth, dmvrHeight))
+                              : PelBuf(m_filteredBlockTmp[0][compID], pu.blocks[compID]);
+    if (dmvrWidth == 0)
     {
-      m_if.filterHor(compID, (Pel *) refBuf.buf, refBuf.stride, dstBuf.buf, dstBuf.stride, backupWidth, backupHeight,
-                     xFrac, rndRes, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
+      tmpBuf.stride = dstBuf.stride;
     }
-    else if (xFrac == 0)
+
+    int vFilterSize = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
+    if (bilinearMC)
     {
-      m_if.filterVer(compID, (Pel *) refBuf.buf, refBuf.stride, dstBuf.buf, dstBuf.stride, backupWidth, backupHeight,
-                     yFrac, true, rndRes, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
+      vFilterSize = NTAPS_BILINEAR;
     }
-    else
+    m_if.filterHor(compID, refBuf.buf - ((vFilterSize >> 1) - 1) * refBuf.stride, refBuf.stride, tmpBuf.buf,
+                   tmpBuf.stride, backupWidth, backupHeight + vFilterSize - 1, xFrac, false, clpRng, bilinearMC,
+                   bilinearMC, useAltHpelIf);
+    JVET_J0090_SET_CACHE_ENABLE(false);
+    m_if.filterVer(compID, (Pel *) tmpBuf.buf + ((vFilterSize >> 1) - 1) * tmpBuf.stride, tmpBuf.stride, dstBuf.buf,
+                   dstBuf.stride, backupWidth, backupHeight, yFrac, false, rndRes, clpRng, bilinearMC, bilinearMC,
+                   useAltHpelIf);
+  }
+  JVET_J0090_SET_CACHE_ENABLE(
+    (srcPadStride == 0)
+    && (bioApplied
+        == false));   // Enabled only in non-DMVR-non-BDOF process, In DMVR process, srcPadStride is always non-zero
+  if (bioApplied && compID == COMPONENT_Y)
+  {
+    const int shift = IF_INTERNAL_FRAC_BITS(clpRng.bd);
+    int        xOffset = (xFrac < 8) ? 1 : 0;
+    int        yOffset = (yFrac < 8) ? 1 : 0;
+    const TSrc *refPel = refBuf.buf - yOffset * refBuf.stride - xOffset;
+    Pel *      dstPel  = m_filteredBlockTmp[2 + m_iRefListIdx][compID] + dstBuf.stride + 1;
+    for (int w = 0; w < (width - 2 * BIO_EXTEND_SIZE); w++)
     {
-      PelBuf tmpBuf = dmvrWidth ? PelBuf(m_filteredBlockTmp[0][compID], Size(dmvrWidth, dmvrHeight))
-                                : PelBuf(m_filteredBlockTmp[0][compID], pu.blocks[compID]);
-      if (dmvrWidth == 0)
-      {
-        tmpBuf.stride = dstBuf.stride;
-      }
-
-      int vFilterSize = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
-      if (bilinearMC)
-      {
-        vFilterSize = NTAPS_BILINEAR;
-      }
-      m_if.filterHor(compID, (Pel *) refBuf.buf - ((vFilterSize >> 1) - 1) * refBuf.stride, refBuf.stride, tmpBuf.buf,
-                     tmpBuf.stride, backupWidth, backupHeight + vFilterSize - 1, xFrac, false, clpRng, bilinearMC,
-                     bilinearMC, useAltHpelIf);
-      JVET_J0090_SET_CACHE_ENABLE(false);
-      m_if.filterVer(compID, (Pel *) tmpBuf.buf + ((vFilterSize >> 1) - 1) * tmpBuf.stride, tmpBuf.stride, dstBuf.buf,
-                     dstBuf.stride, backupWidth, backupHeight, yFrac, false, rndRes, clpRng, bilinearMC, bilinearMC,
-                     useAltHpelIf);
-    }
-    JVET_J0090_SET_CACHE_ENABLE(
-      (srcPadStride == 0)
-      && (bioApplied
-          == false));   // Enabled only in non-DMVR-non-BDOF process, In DMVR process, srcPadStride is always non-zero
-    if (bioApplied && compID == COMPONENT_Y)
-    {
-      const int shift = IF_INTERNAL_FRAC_BITS(clpRng.bd);
-      int        xOffset = (xFrac < 8) ? 1 : 0;
-      int        yOffset = (yFrac < 8) ? 1 : 0;
-      const Pel *refPel  = refBuf.buf - yOffset * refBuf.stride - xOffset;
-      Pel *      dstPel  = m_filteredBlockTmp[2 + m_iRefListIdx][compID] + dstBuf.stride + 1;
-      for (int w = 0; w < (width - 2 * BIO_EXTEND_SIZE); w++)
-      {
-        Pel val   = leftShift_round(refPel[w], shift);
-        dstPel[w] = val - (Pel) IF_INTERNAL_OFFS;
-      }
-
-      refPel = refBuf.buf + (1 - yOffset) * refBuf.stride - xOffset;
-      dstPel = m_filteredBlockTmp[2 + m_iRefListIdx][compID] + 2 * dstBuf.stride + 1;
-      for (int h = 0; h < (height - 2 * BIO_EXTEND_SIZE - 2); h++)
-      {
-        Pel val   = leftShift_round(refPel[0], shift);
-        dstPel[0] = val - (Pel) IF_INTERNAL_OFFS;
+      Pel val   = leftShift_round<Pel>(refPel[w], shift);
+      dstPel[w] = val - (Pel) IF_INTERNAL_OFFS;
+    }
 
-        val               = leftShift_round(refPel[width - 3], shift);
-        dstPel[width - 3] = val - (Pel) IF_INTERNAL_OFFS;
+    refPel = refBuf.buf + (1 - yOffset) * refBuf.stride - xOffset;
+    dstPel = m_filteredBlockTmp[2 + m_iRefListIdx][compID] + 2 * dstBuf.stride + 1;
+    for (int h = 0; h < (height - 2 * BIO_EXTEND_SIZE - 2); h++)
+    {
+      Pel val   = leftShift_round<Pel>(refPel[0], shift);
+      dstPel[0] = val - (Pel) IF_INTERNAL_OFFS;
 
-        refPel += refBuf.stride;
-        dstPel += dstBuf.stride;
-      }
+      val               = leftShift_round<Pel>(refPel[width - 3], shift);
+      dstPel[width - 3] = val - (Pel) IF_INTERNAL_OFFS;
 
-      refPel = refBuf.buf + (height - 2 * BIO_EXTEND_SIZE - 2 + 1 - yOffset) * refBuf.stride - xOffset;
-      dstPel = m_filteredBlockTmp[2 + m_iRefListIdx][compID] + (height - 2 * BIO_EXTEND_SIZE) * dstBuf.stride + 1;
-      for (int w = 0; w < (width - 2 * BIO_EXTEND_SIZE); w++)
-      {
-        Pel val   = leftShift_round(refPel[w], shift);
-        dstPel[w] = val - (Pel) IF_INTERNAL_OFFS;
-      }
+      refPel += refBuf.stride;
+      dstPel += dstBuf.stride;
+    }
 
-      // restore data
-      width         = backupWidth;
-      height        = backupHeight;
-      dstBuf.buf    = backupDstBufPtr;
-      dstBuf.stride = backupDstBufStride;
+    refPel = refBuf.buf + (height - 2 * BIO_EXTEND_SIZE - 2 + 1 - yOffset) * refBuf.stride - xOffset;
+    dstPel = m_filteredBlockTmp[2 + m_iRefListIdx][compID] + (height - 2 * BIO_EXTEND_SIZE) * dstBuf.stride + 1;
+    for (int w = 0; w < (width - 2 * BIO_EXTEND_SIZE); w++)
+    {
+      Pel val   = leftShift_round<Pel>(refPel[w], shift);
+      dstPel[w] = val - (Pel) IF_INTERNAL_OFFS;
     }
+
+    // restore data
+    width         = backupWidth;
+    height        = backupHeight;
+    dstBuf.buf    = backupDstBufPtr;
+    dstBuf.stride = backupDstBufStride;
   }
 }
 
@@ -1191,65 +1233,34 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
           yFrac = (iMvScaleTmpVer << (1 - iScaleY)) & 31;
         }
 
-        const CPelBuf refBuf = refPic->getRecoBuf(
-          CompArea(compID, chFmt, pu.blocks[compID].offset(xInt + w, yInt + h), pu.blocks[compID]), wrapRef);
+        const CompArea refArea(compID, chFmt, pu.blocks[compID].offset(xInt + w, yInt + h), pu.blocks[compID]);
 
-        Pel *ref = (Pel *) refBuf.buf;
         Pel *dst = dstBuf.buf + w + h * dstBuf.stride;
-
-        int refStride = refBuf.stride;
         int dstStride = dstBuf.stride;
 
-        int bw = blockWidth;
-        int bh = blockHeight;
-
         if (enablePROF)
         {
           dst       = dstExtBuf.bufAt(PROF_BORDER_EXT_W, PROF_BORDER_EXT_H);
           dstStride = dstExtBuf.stride;
         }
 
-        if (yFrac == 0)
-        {
-          m_if.filterHor(compID, (Pel *) ref, refStride, dst, dstStride, bw, bh, xFrac, isLast, clpRng);
-        }
-        else if (xFrac == 0)
+#if ENABLE_8BIT_REFERENCES
+        if (refPic->isRecoPacked())
         {
-          m_if.filterVer(compID, (Pel *) ref, refStride, dst, dstStride, bw, bh, yFrac, true, isLast, clpRng);
+          const CPel8Buf refBuf = refPic->getRecoBuf8(refArea);
+          xPredAffineSubBlk(compID, refBuf.buf, refBuf.stride, dst, dstStride, blockWidth, blockHeight, xFrac, yFrac,
+                            vFilterSize, isLast, tmpBuf, clpRng, enablePROF);
         }
         else
+#endif
         {
-          m_if.filterHor(compID, (Pel *) ref - ((vFilterSize >> 1) - 1) * refStride, refStride, tmpBuf.buf,
-                         tmpBuf.stride, bw, bh + vFilterSize - 1, xFrac, false, clpRng);
-          JVET_J0090_SET_CACHE_ENABLE(false);
-          m_if.filterVer(compID, tmpBuf.buf + ((vFilterSize >> 1) - 1) * tmpBuf.stride, tmpBuf.stride, dst, dstStride,
-                         bw, bh, yFrac, false, isLast, clpRng);
-          JVET_J0090_SET_CACHE_ENABLE(true);
+          const CPelBuf refBuf = refPic->getRecoBuf(refArea, wrapRef);
+          xPredAffineSubBlk(compID, refBuf.buf, refBuf.stride, dst, dstStride, blockWidth, blockHeight, xFrac, yFrac,
+                            vFilterSize, isLast, tmpBuf, clpRng, enablePROF);
         }
         if (enablePROF)
         {
           const int shift = IF_INTERNAL_FRAC_BITS(clpRng.bd);
-          const int xOffset = xFrac >> 3;
-          const int yOffset = yFrac >> 3;
-
-          const int refOffset = (blockHeight + 1) * refStride;
-          const int dstOffset = (blockHeight + 1) * dstStride;
-
-          const Pel *refPel = ref - (1 - yOffset) * refStride + xOffset - 1;
-          Pel *      dstPel = dst - dstStride - 1;
-          for (int pw = 0; pw < blockWidth + 2; pw++)
-          {
-            dstPel[pw]             = leftShift_round(refPel[pw], shift) - (Pel) IF_INTERNAL_OFFS;
-            dstPel[pw + dstOffset] = leftShift_round(refPel[pw + refOffset], shift) - (Pel) IF_INTERNAL_OFFS;
-          }
-
-          refPel = ref + yOffset * refBuf.stride + xOffset;
-          dstPel = dst;
-          for (int ph = 0; ph < blockHeight; ph++, refPel += refStride, dstPel += dstStride)
-          {
-            dstPel[-1]         = leftShift_round(refPel[-1], shift) - (Pel) IF_INTERNAL_OFFS;
-            dstPel[blockWidth] = leftShift_round(refPel[blockWidth], shift) - (Pel) IF_INTERNAL_OFFS;
-          }
 
           PelBuf gradXBuf = gradXExt.subBuf(0, 0, blockWidth + 2, blockHeight + 2);
           PelBuf gradYBuf = gradYExt.subBuf(0, 0, blockWidth + 2, blockHeight + 2);
@@ -1274,6 +1285,56 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
 #endif
 }
 
+// filters an affine sub-block from the reference samples, with the PROF border when enabled
+template<typename TSrc>
+void InterPrediction::xPredAffineSubBlk(const ComponentID compID, const TSrc *ref, const int refStride, Pel *dst, const int dstStride,
+                                        const int bw, const int bh, const int xFrac, const int yFrac, const int vFilterSize,
+                                        const bool isLast, const PelBuf &tmpBuf, const ClpRng &clpRng, const bool enablePROF)
+{
+  if (yFrac == 0)
+  {
+    m_if.filterHor(compID, ref, refStride, dst, dstStride, bw, bh, xFrac, isLast, clpRng);
+  }
+  else if (xFrac == 0)
+  {
+    m_if.filterVer(compID, ref, refStride, dst, dstStride, bw, bh, yFrac, true, isLast, clpRng);
+  }
+  else
+  {
+    m_if.filterHor(compID, ref - ((vFilterSize >> 1) - 1) * refStride, refStride, tmpBuf.buf,
+                   tmpBuf.stride, bw, bh + vFilterSize - 1, xFrac, false, clpRng);
+    JVET_J0090_SET_CACHE_ENABLE(false);
+    m_if.filterVer(compID, tmpBuf.buf + ((vFilterSize >> 1) - 1) * tmpBuf.stride, tmpBuf.stride, dst, dstStride,
+                   bw, bh, yFrac, false, isLast, clpRng);
+    JVET_J0090_SET_CACHE_ENABLE(true);
+  }
+  if (enablePROF)
+  {
+    const int shift = IF_INTERNAL_FRAC_BITS(clpRng.bd);
+    const int xOffset = xFrac >> 3;
+    const int yOffset = yFrac >> 3;
+
+    const int refOffset = (bh + 1) * refStride;
+    const int dstOffset = (bh + 1) * dstStride;
+
+    const TSrc *refPel = ref - (1 - yOffset) * refStride + xOffset - 1;
+    Pel *       dstPel = dst - dstStride - 1;
+    for (int pw = 0; pw < bw + 2; pw++)
+    {
+      dstPel[pw]             = leftShift_round<Pel>(refPel[pw], shift) - (Pel) IF_INTERNAL_OFFS;
+      dstPel[pw + dstOffset] = leftShift_round<Pel>(refPel[pw + refOffset], shift) - (Pel) IF_INTERNAL_OFFS;
+    }
+
+    refPel = ref + yOffset * refStride + xOffset;
+    dstPel = dst;
+    for (int ph = 0; ph < bh; ph++, refPel += refStride, dstPel += dstStride)
+    {
+      dstPel[-1] = leftShift_round<Pel>(refPel[-1], shift) - (Pel) IF_INTERNAL_OFFS;
+      dstPel[bw] = leftShift_round<Pel>(refPel[bw], shift) - (Pel) IF_INTERNAL_OFFS;
+    }
+  }
+}
+
 void InterPrediction::applyBiOptFlow(const PredictionUnit &pu, const CPelUnitBuf &yuvSrc0, const CPelUnitBuf &yuvSrc1, const int &refIdx0, const int &refIdx1, PelUnitBuf &yuvDst, const BitDepths &clipBitDepths)
 {
   const int     height = yuvDst.Y().height;
@@ -1509,6 +1570,8 @@ void InterPrediction::motionCompensation( PredictionUnit &pu, PelUnitBuf &predBu
       }
       return;
     }
+    // reference pictures may still be in the post-filter stage of the decoder
+    xWaitForRefRows( pu );
   }
   // dual tree handling for IBC as the only ref
   if ((!luma || !chroma) && eRefPicList == REF_PIC_LIST_0)
@@ -1738,11 +1801,21 @@ void InterPrediction::xPrefetch(PredictionUnit& pu, PelUnitBuf &pcPad, RefPicLis
     }
     /* Pre-fetch similar to HEVC*/
     {
-      CPelBuf refBuf;
       Position Rec_offset = pu.blocks[compID].pos().offset(cMv.getHor() >> mvshiftTempHor, cMv.getVer() >> mvshiftTempVer);
-      refBuf = refPic->getRecoBuf(CompArea((ComponentID)compID, pu.chromaFormat, Rec_offset, pu.blocks[compID].size()), wrapRef);
+      const CompArea refArea((ComponentID)compID, pu.chromaFormat, Rec_offset, pu.blocks[compID].size());
       PelBuf &dstBuf = pcPad.bufs[compID];
-      g_pelBufOP.copyBuffer((Pel *)refBuf.buf, refBuf.stride, ((Pel *)dstBuf.buf) + offset, dstBuf.stride, width, height);
+#if ENABLE_8BIT_REFERENCES
+      if (refPic->isRecoPacked())
+      {
+        const CPel8Buf refBuf = refPic->getRecoBuf8(refArea);
+        g_pelBufOP.unpack8bit(refBuf.buf, refBuf.stride, ((Pel *)dstBuf.buf) + offset, dstBuf.stride, width, height);
+      }
+      else
+#endif
+      {
+        CPelBuf refBuf = refPic->getRecoBuf(refArea, wrapRef);
+        g_pelBufOP.copyBuffer((Pel *)refBuf.buf, refBuf.stride, ((Pel *)dstBuf.buf) + offset, dstBuf.stride, width, height);
+      }
     }
   }
 }
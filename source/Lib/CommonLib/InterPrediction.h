@@ -131,6 +131,20 @@ protected:
                                  , Pel *srcPadBuf = NULL
                                  , int32_t srcPadStride = 0
                                  );
+  template<typename TSrc>
+  void xPredInterBlkFilter      ( const ComponentID compID, const PredictionUnit& pu, const AreaBuf<const TSrc>& refBuf, PelBuf& dstBuf, const int xFrac, const int yFrac
+                                 , SizeType dmvrWidth
+                                 , SizeType dmvrHeight
+                                 , const bool rndRes, const ClpRng& clpRng
+                                 , const bool bioApplied
+                                 , const bool bilinearMC
+                                 , const bool useAltHpelIf
+                                 , int32_t srcPadStride
+                                 );
+  template<typename TSrc>
+  void xPredAffineSubBlk        ( const ComponentID compID, const TSrc* ref, const int refStride, Pel* dst, const int dstStride
+                                 , const int bw, const int bh, const int xFrac, const int yFrac, const int vFilterSize
+                                 , const bool isLast, const PelBuf& tmpBuf, const ClpRng& clpRng, const bool enablePROF );
 
   void xAddBIOAvg4              (const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, const Pel *gradX0, const Pel *gradX1, const Pel *gradY0, const Pel*gradY1, int gradStride, int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng);
   void xBioGradFilter           (Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* gradX, Pel* gradY, int bitDepth);
@@ -145,6 +159,7 @@ protected:
 
   static bool xCheckIdenticalMotion( const PredictionUnit& pu );
 
+  void xWaitForRefRows( const PredictionUnit& pu );
   void xSubPuMC(PredictionUnit& pu, PelUnitBuf& predBuf, const RefPicList &eRefPicList = REF_PIC_LIST_X, const bool luma = true, const bool chroma = true);
   void xSubPuBio(PredictionUnit& pu, PelUnitBuf& predBuf, const RefPicList &eRefPicList = REF_PIC_LIST_X, PelUnitBuf* yuvDstTmp = NULL);
   void destroy();
@@ -349,6 +349,26 @@ InterpolationFilter::InterpolationFilter()
   m_filterCopy[1][0]   = filterCopy<true, false>;
   m_filterCopy[1][1]   = filterCopy<true, true>;
 
+#if ENABLE_8BIT_REFERENCES
+  // [taps][bLast]
+  m_filterHor8[0][0]   = filter<8, false, true, false, uint8_t>;
+  m_filterHor8[0][1]   = filter<8, false, true, true, uint8_t>;
+  m_filterHor8[1][0]   = filter<4, false, true, false, uint8_t>;
+  m_filterHor8[1][1]   = filter<4, false, true, true, uint8_t>;
+  m_filterHor8[2][0]   = filter<2, false, true, false, uint8_t>;
+  m_filterHor8[2][1]   = filter<2, false, true, true, uint8_t>;
+
+  m_filterVer8[0][0]   = filter<8, true, true, false, uint8_t>;
+  m_filterVer8[0][1]   = filter<8, true, true, true, uint8_t>;
+  m_filterVer8[1][0]   = filter<4, true, true, false, uint8_t>;
+  m_filterVer8[1][1]   = filter<4, true, true, true, uint8_t>;
+  m_filterVer8[2][0]   = filter<2, true, true, false, uint8_t>;
+  m_filterVer8[2][1]   = filter<2, true, true, true, uint8_t>;
+
+  m_filterCopy8[0]     = filterCopy<true, false, uint8_t>;
+  m_filterCopy8[1]     = filterCopy<true, true, uint8_t>;
+#endif
+
   m_weightedGeoBlk = xWeightedGeoBlk;
 }
 
@@ -374,8 +394,8 @@ InterpolationFilter::InterpolationFilter()
 //  If you change the functionality here, consider to switch off the SIMD implementation of this function.
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-template<bool isFirst, bool isLast>
-void InterpolationFilter::filterCopy( const ClpRng& clpRng, const Pel *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool biMCForDMVR)
+template<bool isFirst, bool isLast, typename TSrc>
+void InterpolationFilter::filterCopy( const ClpRng& clpRng, const TSrc *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool biMCForDMVR)
 {
   int row, col;
 
@@ -433,7 +453,7 @@ void InterpolationFilter::filterCopy( const ClpRng& clpRng, const Pel *src, int
     {
       for (col = 0; col < width; col++)
       {
-        Pel val = leftShift_round(src[col], shift);
+        Pel val = leftShift_round<Pel>(src[col], shift);
         dst[col] = val - (Pel)IF_INTERNAL_OFFS;
         JVET_J0090_CACHE_ACCESS( &src[col], __FILE__, __LINE__ );
       }
@@ -521,8 +541,8 @@ void InterpolationFilter::filterCopy( const ClpRng& clpRng, const Pel *src, int
 //  If you change the functionality here, consider to switch off the SIMD implementation of this function.
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-template<int N, bool isVertical, bool isFirst, bool isLast>
-void InterpolationFilter::filter(const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR)
+template<int N, bool isVertical, bool isFirst, bool isLast, typename TSrc>
+void InterpolationFilter::filter(const ClpRng& clpRng, TSrc const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR)
 {
   int row, col;
 
@@ -697,6 +717,64 @@ void InterpolationFilter::filterVer(const ClpRng& clpRng, Pel const *src, int sr
   }
 }
 
+#if ENABLE_8BIT_REFERENCES
+template<int N>
+void InterpolationFilter::filterHor(const ClpRng& clpRng, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isLast, TFilterCoeff const *coeff, bool biMCForDMVR)
+{
+  if( N == 8 )
+  {
+    m_filterHor8[0][isLast](clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
+  }
+  else if( N == 4 )
+  {
+    m_filterHor8[1][isLast](clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
+  }
+  else if( N == 2 )
+  {
+    m_filterHor8[2][isLast](clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
+  }
+  else
+  {
+    THROW( "Invalid tap number" );
+  }
+}
+
+template<int N>
+void InterpolationFilter::filterVer(const ClpRng& clpRng, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isFirst, bool isLast, TFilterCoeff const *coeff, bool biMCForDMVR)
+{
+  CHECK( !isFirst, "8-bit samples can only be filtered first" );
+  if( N == 8 )
+  {
+    m_filterVer8[0][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
+  }
+  else if( N == 4 )
+  {
+    m_filterVer8[1][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
+  }
+  else if( N == 2 )
+  {
+    m_filterVer8[2][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR);
+  }
+  else
+  {
+    THROW( "Invalid tap number" );
+  }
+}
+#endif
+
+void InterpolationFilter::xFilterCopy(const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isFirst, bool isLast, bool biMCForDMVR)
+{
+  m_filterCopy[isFirst][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, biMCForDMVR );
+}
+
+#if ENABLE_8BIT_REFERENCES
+void InterpolationFilter::xFilterCopy(const ClpRng& clpRng, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isFirst, bool isLast, bool biMCForDMVR)
+{
+  CHECK( !isFirst, "8-bit samples can only be filtered first" );
+  m_filterCopy8[isLast]( clpRng, src, srcStride, dst, dstStride, width, height, biMCForDMVR );
+}
+#endif
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -715,13 +793,14 @@ void InterpolationFilter::filterVer(const ClpRng& clpRng, Pel const *src, int sr
  * \param  isLast     Flag indicating whether it is the last filtering operation
  * \param  bitDepth   Bit depth
  */
-void InterpolationFilter::filterHor(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride,
+template<typename TSrc>
+void InterpolationFilter::filterHor(const ComponentID compID, TSrc const *src, int srcStride, Pel *dst, int dstStride,
                                     int width, int height, int frac, bool isLast, const ClpRng &clpRng, int nFilterIdx,
                                     bool biMCForDMVR, bool useAltHpelIf)
 {
   if( frac == 0 && nFilterIdx < 2 )
   {
-    m_filterCopy[true][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, biMCForDMVR );
+    xFilterCopy( clpRng, src, srcStride, dst, dstStride, width, height, true, isLast, biMCForDMVR );
   }
   else if( isLuma( compID ) )
   {
@@ -800,13 +879,14 @@ void InterpolationFilter::filterHor(const ComponentID compID, Pel const *src, in
  * \param  isLast     Flag indicating whether it is the last filtering operation
  * \param  bitDepth   Bit depth
  */
-void InterpolationFilter::filterVer(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride,
+template<typename TSrc>
+void InterpolationFilter::filterVer(const ComponentID compID, TSrc const *src, int srcStride, Pel *dst, int dstStride,
                                     int width, int height, int frac, bool isFirst, bool isLast, const ClpRng &clpRng,
                                     int nFilterIdx, bool biMCForDMVR, bool useAltHpelIf)
 {
   if( frac == 0 && nFilterIdx < 2 )
   {
-    m_filterCopy[isFirst][isLast]( clpRng, src, srcStride, dst, dstStride, width, height, biMCForDMVR );
+    xFilterCopy( clpRng, src, srcStride, dst, dstStride, width, height, isFirst, isLast, biMCForDMVR );
   }
   else if( isLuma( compID ) )
   {
@@ -869,6 +949,13 @@ void InterpolationFilter::filterVer(const ComponentID compID, Pel const *src, in
   }
 }
 
+template void InterpolationFilter::filterHor<Pel>(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int frac, bool isLast, const ClpRng &clpRng, int nFilterIdx, bool biMCForDMVR, bool useAltHpelIf);
+template void InterpolationFilter::filterVer<Pel>(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int frac, bool isFirst, bool isLast, const ClpRng &clpRng, int nFilterIdx, bool biMCForDMVR, bool useAltHpelIf);
+#if ENABLE_8BIT_REFERENCES
+template void InterpolationFilter::filterHor<uint8_t>(const ComponentID compID, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int frac, bool isLast, const ClpRng &clpRng, int nFilterIdx, bool biMCForDMVR, bool useAltHpelIf);
+template void InterpolationFilter::filterVer<uint8_t>(const ComponentID compID, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, int frac, bool isFirst, bool isLast, const ClpRng &clpRng, int nFilterIdx, bool biMCForDMVR, bool useAltHpelIf);
+#endif
+
 void InterpolationFilter::weightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1)
 {
   m_weightedGeoBlk(pu, width, height, compIdx, splitDir, predDst, predSrc0, predSrc1);
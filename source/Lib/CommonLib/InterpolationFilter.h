@@ -70,16 +70,24 @@ private:
   static const TFilterCoeff m_lumaAltHpelIFilter[NTAPS_LUMA]; ///< Luma filter taps
   static const TFilterCoeff m_bilinearFilterPrec4[LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS][NTAPS_BILINEAR]; ///< bilinear filter taps
 public:
-  template<bool isFirst, bool isLast>
-  static void filterCopy( const ClpRng& clpRng, const Pel *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool biMCForDMVR);
+  template<bool isFirst, bool isLast, typename TSrc = Pel>
+  static void filterCopy( const ClpRng& clpRng, const TSrc *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool biMCForDMVR);
 
-  template<int N, bool isVertical, bool isFirst, bool isLast>
-  static void filter(const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
+  template<int N, bool isVertical, bool isFirst, bool isLast, typename TSrc = Pel>
+  static void filter(const ClpRng& clpRng, TSrc const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
   template<int N>
   void filterHor(const ClpRng& clpRng, Pel const* src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isLast, TFilterCoeff const *coeff, bool biMCForDMVR);
 
   template<int N>
   void filterVer(const ClpRng& clpRng, Pel const* src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isFirst, bool isLast, TFilterCoeff const *coeff, bool biMCForDMVR);
+#if ENABLE_8BIT_REFERENCES
+  // 8-bit reference samples, always filtered first
+  template<int N>
+  void filterHor(const ClpRng& clpRng, uint8_t const* src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isLast, TFilterCoeff const *coeff, bool biMCForDMVR);
+
+  template<int N>
+  void filterVer(const ClpRng& clpRng, uint8_t const* src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isFirst, bool isLast, TFilterCoeff const *coeff, bool biMCForDMVR);
+#endif
 
   static void xWeightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
   void weightedGeoBlk(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
@@ -93,6 +101,11 @@ public:
   void( *m_filterHor[3][2][2] )( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
   void( *m_filterVer[3][2][2] )( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
   void( *m_filterCopy[2][2] )  ( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool biMCForDMVR);
+#if ENABLE_8BIT_REFERENCES
+  void( *m_filterHor8[3][2] )  ( const ClpRng& clpRng, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
+  void( *m_filterVer8[3][2] )  ( const ClpRng& clpRng, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR);
+  void( *m_filterCopy8[2] )    ( const ClpRng& clpRng, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool biMCForDMVR);
+#endif
   void( *m_weightedGeoBlk )(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
 
   void initInterpolationFilter( bool enable );
@@ -101,10 +114,12 @@ public:
   template <X86_VEXT vext>
   void _initInterpolationFilterX86();
 #endif
-  void filterHor(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride, int width,
+  template<typename TSrc>
+  void filterHor(const ComponentID compID, TSrc const *src, int srcStride, Pel *dst, int dstStride, int width,
                  int height, int frac, bool isLast, const ClpRng &clpRng, int nFilterIdx = 0, bool biMCForDMVR = false,
                  bool useAltHpelIf = false);
-  void filterVer(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride, int width,
+  template<typename TSrc>
+  void filterVer(const ComponentID compID, TSrc const *src, int srcStride, Pel *dst, int dstStride, int width,
                  int height, int frac, bool isFirst, bool isLast, const ClpRng &clpRng, int nFilterIdx = 0,
                  bool biMCForDMVR = false, bool useAltHpelIf = false);
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -112,6 +127,12 @@ public:
 #endif
 
   static TFilterCoeff const * const getChromaFilterTable(const int deltaFract) { return m_chromaFilter[deltaFract]; };
+
+private:
+  void xFilterCopy(const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isFirst, bool isLast, bool biMCForDMVR);
+#if ENABLE_8BIT_REFERENCES
+  void xFilterCopy(const ClpRng& clpRng, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, bool isFirst, bool isLast, bool biMCForDMVR);
+#endif
 };
 
 //! \}
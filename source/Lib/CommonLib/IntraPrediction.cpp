@@ -86,6 +86,24 @@ IntraPrediction::IntraPrediction()
 
   m_piTemp = nullptr;
   m_pMdlmTemp = nullptr;
+
+  m_predIntraPlanar       = xPredIntraPlanar;
+  m_predIntraDc           = xPredIntraDcCore;
+  m_predIntraAngLuma      = xPredIntraAngLumaLines;
+  m_predIntraAngChroma    = xPredIntraAngChromaLines;
+  m_predIntraPdpcPlanarDc = xPredIntraPdpcPlanarDc;
+  m_filterReferenceLine   = xFilterReferenceLine;
+
+  m_lumaDownsample[CCLM_FILTER_COPY]     = xLumaDownsample<CCLM_FILTER_COPY>;
+  m_lumaDownsample[CCLM_FILTER_HOR_3TAP] = xLumaDownsample<CCLM_FILTER_HOR_3TAP>;
+  m_lumaDownsample[CCLM_FILTER_COLLOC]   = xLumaDownsample<CCLM_FILTER_COLLOC>;
+  m_lumaDownsample[CCLM_FILTER_6TAP]     = xLumaDownsample<CCLM_FILTER_6TAP>;
+
+#if ENABLE_SIMD_OPT_INTRA
+#ifdef TARGET_SIMD_X86
+  initIntraPredictionX86();
+#endif
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -149,7 +167,7 @@ void IntraPrediction::init(ChromaFormat chromaFormatIDC, const unsigned bitDepth
 
 // Function for calculating DC value of the reference samples used in Intra prediction
 //NOTE: Bit-Limit - 25-bit source
-Pel IntraPrediction::xGetPredValDc( const CPelBuf &pSrc, const Size &dstSize )
+Pel IntraPrediction::xGetPredValDc( const Pel* refAbove, const Pel* refLeft, const Size &dstSize )
 {
   CHECK( dstSize.width == 0 || dstSize.height == 0, "Empty area provided" );
 
@@ -165,14 +183,14 @@ Pel IntraPrediction::xGetPredValDc( const CPelBuf &pSrc, const Size &dstSize )
   {
     for( idx = 0; idx < width; idx++ )
     {
-      sum += pSrc.at(m_ipaParam.multiRefIndex + 1 + idx, 0);
+      sum += refAbove[idx];
     }
   }
   if ( width <= height )
   {
     for( idx = 0; idx < height; idx++ )
     {
-      sum += pSrc.at(m_ipaParam.multiRefIndex + 1 + idx, 1);
+      sum += refLeft[idx];
     }
   }
 
@@ -233,7 +251,7 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
   switch (uiDirMode)
   {
-    case(PLANAR_IDX): xPredIntraPlanar(srcBuf, piPred); break;
+    case(PLANAR_IDX): m_predIntraPlanar(srcBuf, piPred); break;
     case(DC_IDX):     xPredIntraDc(srcBuf, piPred, channelType, false); break;
     case(BDPCM_IDX):  xPredIntraBDPCM(srcBuf, piPred, isLuma(compID) ? pu.cu->bdpcmMode : pu.cu->bdpcmModeChroma, clpRng); break;
     default:          xPredIntraAng(srcBuf, piPred, channelType, clpRng); break;
@@ -247,18 +265,23 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
     if (uiDirMode == PLANAR_IDX || uiDirMode == DC_IDX)
     {
-      for (int y = 0; y < iHeight; y++)
-      {
-        const int wT   = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(y + 1, 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const int wL    = 32 >> std::min(31, ((x << 1) >> scale));
-          const Pel top   = srcBuf.at(x + 1, 0);
-          const Pel val   = dstBuf.at(x, y);
-          dstBuf.at(x, y) = val + ((wL * (left - val) + wT * (top - val) + 32) >> 6);
-        }
-      }
+      m_predIntraPdpcPlanarDc(srcBuf, dstBuf, scale);
+    }
+  }
+}
+
+void IntraPrediction::xPredIntraPdpcPlanarDc( const CPelBuf &pSrc, PelBuf &pDst, const int scale )
+{
+  for (int y = 0; y < pDst.height; y++)
+  {
+    const int wT   = 32 >> std::min(31, ((y << 1) >> scale));
+    const Pel left = pSrc.at(y + 1, 1);
+    for (int x = 0; x < pDst.width; x++)
+    {
+      const int wL  = 32 >> std::min(31, ((x << 1) >> scale));
+      const Pel top = pSrc.at(x + 1, 0);
+      const Pel val = pDst.at(x, y);
+      pDst.at(x, y) = val + ((wL * (left - val) + wT * (top - val) + 32) >> 6);
     }
   }
 }
@@ -280,9 +303,21 @@ void IntraPrediction::predIntraChromaLM(const ComponentID compID, PelBuf &piPred
   int a, b, iShift;
   xGetLMParameters(pu, compID, chromaArea, a, b, iShift);
 
-  ////// final prediction
-  piPred.copyFrom(Temp);
-  piPred.linearTransform(a, iShift, b, true, pu.cs->slice->clpRng(compID));
+  ////// final prediction, applied while copying out of the downsampled luma buffer
+  const ClpRng& clpRng = pu.cs->slice->clpRng(compID);
+  if ((piPred.width & 7) == 0)
+  {
+    g_pelBufOP.linTf8(Temp.buf, Temp.stride, piPred.buf, piPred.stride, piPred.width, piPred.height, a, iShift, b, clpRng, true);
+  }
+  else if ((piPred.width & 3) == 0)
+  {
+    g_pelBufOP.linTf4(Temp.buf, Temp.stride, piPred.buf, piPred.stride, piPred.width, piPred.height, a, iShift, b, clpRng, true);
+  }
+  else
+  {
+    piPred.copyFrom(Temp);
+    piPred.linearTransform(a, iShift, b, true, clpRng);
+  }
 }
 
 /** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
@@ -349,7 +384,12 @@ void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
 
 void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter )
 {
-  const Pel dcval = xGetPredValDc( pSrc, pDst );
+  m_predIntraDc( pSrc.bufAt( m_ipaParam.multiRefIndex + 1, 0 ), pSrc.bufAt( m_ipaParam.multiRefIndex + 1, 1 ), pDst );
+}
+
+void IntraPrediction::xPredIntraDcCore( const Pel* refAbove, const Pel* refLeft, PelBuf &pDst )
+{
+  const Pel dcval = xGetPredValDc( refAbove, refLeft, pDst );
   pDst.fill( dcval );
 }
 
@@ -562,60 +602,37 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   }
   else
   {
-    for (int y = 0, deltaPos = intraPredAngle * (1 + multiRefIdx); y<height; y++, deltaPos += intraPredAngle, pDsty += dstStride)
+    if ( !isIntegerSlope( abs(intraPredAngle) ) )
     {
-      const int deltaInt   = deltaPos >> 5;
-      const int deltaFract = deltaPos & 31;
-
-      if ( !isIntegerSlope( abs(intraPredAngle) ) )
+      if( isLuma(channelType) )
       {
-        if( isLuma(channelType) )
-        {
-          const bool useCubicFilter = !m_ipaParam.interpolationFlag;
-
-          const TFilterCoeff        intraSmoothingFilter[4] = {TFilterCoeff(16 - (deltaFract >> 1)), TFilterCoeff(32 - (deltaFract >> 1)), TFilterCoeff(16 + (deltaFract >> 1)), TFilterCoeff(deltaFract >> 1)};
-          const TFilterCoeff* const f                       = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(deltaFract) : intraSmoothingFilter;
-
-          for (int x = 0; x < width; x++)
-          {
-            Pel p[4];
-
-            p[0] = refMain[deltaInt + x];
-            p[1] = refMain[deltaInt + x + 1];
-            p[2] = refMain[deltaInt + x + 2];
-            p[3] = refMain[deltaInt + x + 3];
-
-            Pel val = (f[0] * p[0] + f[1] * p[1] + f[2] * p[2] + f[3] * p[3] + 32) >> 6;
-
-            pDsty[x] = ClipPel(val, clpRng);   // always clip even though not always needed
-          }
-        }
-        else
-        {
-          // Do linear filtering
-          for (int x = 0; x < width; x++)
-          {
-            Pel p[2];
-
-            p[0] = refMain[deltaInt + x + 1];
-            p[1] = refMain[deltaInt + x + 2];
-
-            pDsty[x] = p[0] + ((deltaFract * (p[1] - p[0]) + 16) >> 5);
-          }
-        }
+        m_predIntraAngLuma(pDstBuf, dstStride, refMain, width, height, intraPredAngle * (1 + multiRefIdx), intraPredAngle, !m_ipaParam.interpolationFlag, clpRng);
       }
       else
       {
-        // Just copy the integer samples
+        m_predIntraAngChroma(pDstBuf, dstStride, refMain, width, height, intraPredAngle * (1 + multiRefIdx), intraPredAngle);
+      }
+    }
+    else
+    {
+      // Just copy the integer samples
+      for (int y = 0, deltaPos = intraPredAngle * (1 + multiRefIdx); y < height; y++, deltaPos += intraPredAngle)
+      {
+        const int deltaInt = deltaPos >> 5;
         for( int x = 0; x < width; x++ )
         {
-          pDsty[x] = refMain[x + deltaInt + 1];
+          pDstBuf[y * dstStride + x] = refMain[x + deltaInt + 1];
         }
       }
-      if (m_ipaParam.applyPDPC)
+    }
+
+    if (m_ipaParam.applyPDPC)
+    {
+      const int scale = m_ipaParam.angularScale;
+
+      for (int y = 0; y < height; y++, pDsty += dstStride)
       {
-        const int scale       = m_ipaParam.angularScale;
-        int       invAngleSum = 256;
+        int invAngleSum = 256;
 
         for (int x = 0; x < std::min(3 << scale, width); x++)
         {
@@ -643,6 +660,52 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   }
 }
 
+void IntraPrediction::xPredIntraAngLumaLines( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, int deltaPos, const int intraPredAngle, const bool useCubicFilter, const ClpRng& clpRng )
+{
+  for (int y = 0; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride)
+  {
+    const int deltaInt   = deltaPos >> 5;
+    const int deltaFract = deltaPos & 31;
+
+    const TFilterCoeff        intraSmoothingFilter[4] = {TFilterCoeff(16 - (deltaFract >> 1)), TFilterCoeff(32 - (deltaFract >> 1)), TFilterCoeff(16 + (deltaFract >> 1)), TFilterCoeff(deltaFract >> 1)};
+    const TFilterCoeff* const f                       = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(deltaFract) : intraSmoothingFilter;
+
+    for (int x = 0; x < width; x++)
+    {
+      Pel p[4];
+
+      p[0] = refMain[deltaInt + x];
+      p[1] = refMain[deltaInt + x + 1];
+      p[2] = refMain[deltaInt + x + 2];
+      p[3] = refMain[deltaInt + x + 3];
+
+      Pel val = (f[0] * p[0] + f[1] * p[1] + f[2] * p[2] + f[3] * p[3] + 32) >> 6;
+
+      pDst[x] = ClipPel(val, clpRng);   // always clip even though not always needed
+    }
+  }
+}
+
+void IntraPrediction::xPredIntraAngChromaLines( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, int deltaPos, const int intraPredAngle )
+{
+  for (int y = 0; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride)
+  {
+    const int deltaInt   = deltaPos >> 5;
+    const int deltaFract = deltaPos & 31;
+
+    // Do linear filtering
+    for (int x = 0; x < width; x++)
+    {
+      Pel p[2];
+
+      p[0] = refMain[deltaInt + x + 1];
+      p[1] = refMain[deltaInt + x + 2];
+
+      pDst[x] = p[0] + ((deltaFract * (p[1] - p[0]) + 16) >> 5);
+    }
+  }
+}
+
 void IntraPrediction::xPredIntraBDPCM(const CPelBuf &pSrc, PelBuf &pDst, const uint32_t dirMode, const ClpRng& clpRng )
 {
   const int wdt = pDst.width;
@@ -1185,10 +1248,7 @@ void IntraPrediction::xFilterReferenceSamples(const Pel *refBufUnfiltered, Pel *
 
   refBufFiltered[0] = topLeft;
 
-  for (int i = 1; i < predSize; i++)
-  {
-    refBufFiltered[i] = (refBufUnfiltered[i - 1] + 2 * refBufUnfiltered[i] + refBufUnfiltered[i + 1] + 2) >> 2;
-  }
+  m_filterReferenceLine(refBufUnfiltered, refBufFiltered, predSize);
   refBufFiltered[predSize] = refBufUnfiltered[predSize];
 
   refBufFiltered += predStride;
@@ -1196,11 +1256,16 @@ void IntraPrediction::xFilterReferenceSamples(const Pel *refBufUnfiltered, Pel *
 
   refBufFiltered[0] = topLeft;
 
-  for (int i = 1; i < predHSize; i++)
+  m_filterReferenceLine(refBufUnfiltered, refBufFiltered, predHSize);
+  refBufFiltered[predHSize] = refBufUnfiltered[predHSize];
+}
+
+void IntraPrediction::xFilterReferenceLine(const Pel *refUnfiltered, Pel *refFiltered, const int length)
+{
+  for (int i = 1; i < length; i++)
   {
-    refBufFiltered[i] = (refBufUnfiltered[i - 1] + 2 * refBufUnfiltered[i] + refBufUnfiltered[i + 1] + 2) >> 2;
+    refFiltered[i] = (refUnfiltered[i - 1] + 2 * refUnfiltered[i] + refUnfiltered[i + 1] + 2) >> 2;
   }
-  refBufFiltered[predHSize] = refBufUnfiltered[predHSize];
 }
 
 bool isAboveLeftAvailable(const CodingUnit &cu, const ChannelType &chType, const Position &posLT)
@@ -1357,7 +1422,7 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
 
   int iRecStride2       = iRecStride << logSubHeightC;
 
-  const CodingUnit& lumaCU = isChroma( pu.chType ) ? *pu.cs->picture->cs->getCU( lumaArea.pos(), CH_L ) : *pu.cu;
+  const CodingUnit& lumaCU = isChroma( pu.chType ) ? *CS::getLumaCS( *pu.cs ).getCU( lumaArea.pos(), CH_L ) : *pu.cu;
   const CodingUnit&     cu = *pu.cu;
 
   const CompArea& area = isChroma( pu.chType ) ? chromaArea : lumaArea;
@@ -1425,54 +1490,15 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
     {
       addedAboveRight = avaiAboveRightUnits*chromaUnitWidth;
     }
-    for (int i = 0; i < uiCWidth + addedAboveRight; i++)
-    {
-      const bool leftPadding = i == 0 && !leftIsAvailable;
-      if (pu.chromaFormat == CHROMA_444)
-      {
-        piSrc = pRecSrc0 - iRecStride;
-        pDst[i] = piSrc[i];
-      }
-      else if (isFirstRowOfCtu)
-      {
-        piSrc   = pRecSrc0 - iRecStride;
-        pDst[i] = (piSrc[2 * i] * 2 + piSrc[2 * i - (leftPadding ? 0 : 1)] + piSrc[2 * i + 1] + 2) >> 2;
-      }
-      else if (pu.chromaFormat == CHROMA_422)
-      {
-        piSrc = pRecSrc0 - iRecStride2;
 
-        int s = 2;
-        s += piSrc[2 * i] * 2;
-        s += piSrc[2 * i - (leftPadding ? 0 : 1)];
-        s += piSrc[2 * i + 1];
-        pDst[i] = s >> 2;
-      }
-      else if (pu.cs->sps->getCclmCollocatedChromaFlag())
-      {
-        piSrc = pRecSrc0 - iRecStride2;
-
-        int s = 4;
-        s += piSrc[2 * i - iRecStride];
-        s += piSrc[2 * i] * 4;
-        s += piSrc[2 * i - (leftPadding ? 0 : 1)];
-        s += piSrc[2 * i + 1];
-        s += piSrc[2 * i + iRecStride];
-        pDst[i] = s >> 3;
-      }
-      else
-      {
-        piSrc = pRecSrc0 - iRecStride2;
-        int s = 4;
-        s += piSrc[2 * i] * 2;
-        s += piSrc[2 * i + 1];
-        s += piSrc[2 * i - (leftPadding ? 0 : 1)];
-        s += piSrc[2 * i + iRecStride] * 2;
-        s += piSrc[2 * i + 1 + iRecStride];
-        s += piSrc[2 * i + iRecStride - (leftPadding ? 0 : 1)];
-        pDst[i] = s >> 3;
-      }
-    }
+    // only the line next to the block is available at the top CTU boundary
+    const bool           singleLine = pu.chromaFormat == CHROMA_444 || isFirstRowOfCtu;
+    const CclmLumaFilter filter     = pu.chromaFormat == CHROMA_444                      ? CCLM_FILTER_COPY
+                                    : isFirstRowOfCtu || pu.chromaFormat == CHROMA_422 ? CCLM_FILTER_HOR_3TAP
+                                    : pu.cs->sps->getCclmCollocatedChromaFlag()        ? CCLM_FILTER_COLLOC
+                                                                                       : CCLM_FILTER_6TAP;
+    piSrc = pRecSrc0 - (singleLine ? iRecStride : iRecStride2);
+    m_lumaDownsample[filter](pDst, iDstStride, piSrc, iRecStride, uiCWidth + addedAboveRight, 1, !leftIsAvailable, false);
   }
 
   if (leftIsAvailable)
@@ -1530,55 +1556,62 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
   }
 
   // inner part from reconstructed picture buffer
-  for( int j = 0; j < uiCHeight; j++ )
+  const CclmLumaFilter filter = pu.chromaFormat == CHROMA_444              ? CCLM_FILTER_COPY
+                              : pu.chromaFormat == CHROMA_422              ? CCLM_FILTER_HOR_3TAP
+                              : pu.cs->sps->getCclmCollocatedChromaFlag() ? CCLM_FILTER_COLLOC
+                                                                           : CCLM_FILTER_6TAP;
+  m_lumaDownsample[filter](pDst0, iDstStride, pRecSrc0, iRecStride, uiCWidth, uiCHeight, !leftIsAvailable, !aboveIsAvailable);
+}
+
+template<int filter>
+void IntraPrediction::xLumaDownsample( Pel* pDst, const ptrdiff_t dstStride, const Pel* pSrc, const ptrdiff_t srcStride, const int width, const int height, const bool leftPadding, const bool abovePadding )
+{
+  const ptrdiff_t srcStep = filter == CCLM_FILTER_COLLOC || filter == CCLM_FILTER_6TAP ? 2 * srcStride : srcStride;
+
+  for( int j = 0; j < height; j++ )
   {
-    for( int i = 0; i < uiCWidth; i++ )
+    for( int i = 0; i < width; i++ )
     {
-      if (pu.chromaFormat == CHROMA_444)
+      const ptrdiff_t left  = i == 0 && leftPadding  ? 0 : 1;
+      const ptrdiff_t above = j == 0 && abovePadding ? 0 : srcStride;
+
+      if (filter == CCLM_FILTER_COPY)
       {
-        pDst0[i] = pRecSrc0[i];
+        pDst[i] = pSrc[i];
       }
-      else if (pu.chromaFormat == CHROMA_422)
+      else if (filter == CCLM_FILTER_HOR_3TAP)
       {
-        const bool leftPadding  = i == 0 && !leftIsAvailable;
-
         int s = 2;
-        s += pRecSrc0[2 * i] * 2;
-        s += pRecSrc0[2 * i - (leftPadding ? 0 : 1)];
-        s += pRecSrc0[2 * i + 1];
-        pDst0[i] = s >> 2;
+        s += pSrc[2 * i] * 2;
+        s += pSrc[2 * i - left];
+        s += pSrc[2 * i + 1];
+        pDst[i] = s >> 2;
       }
-      else if (pu.cs->sps->getCclmCollocatedChromaFlag())
+      else if (filter == CCLM_FILTER_COLLOC)
       {
-        const bool leftPadding  = i == 0 && !leftIsAvailable;
-        const bool abovePadding = j == 0 && !aboveIsAvailable;
-
         int s = 4;
-        s += pRecSrc0[2 * i - (abovePadding ? 0 : iRecStride)];
-        s += pRecSrc0[2 * i] * 4;
-        s += pRecSrc0[2 * i - (leftPadding ? 0 : 1)];
-        s += pRecSrc0[2 * i + 1];
-        s += pRecSrc0[2 * i + iRecStride];
-        pDst0[i] = s >> 3;
+        s += pSrc[2 * i - above];
+        s += pSrc[2 * i] * 4;
+        s += pSrc[2 * i - left];
+        s += pSrc[2 * i + 1];
+        s += pSrc[2 * i + srcStride];
+        pDst[i] = s >> 3;
       }
       else
       {
-        CHECK(pu.chromaFormat != CHROMA_420, "Chroma format must be 4:2:0 for vertical filtering");
-        const bool leftPadding = i == 0 && !leftIsAvailable;
-
         int s = 4;
-        s += pRecSrc0[2 * i] * 2;
-        s += pRecSrc0[2 * i + 1];
-        s += pRecSrc0[2 * i - (leftPadding ? 0 : 1)];
-        s += pRecSrc0[2 * i + iRecStride] * 2;
-        s += pRecSrc0[2 * i + 1 + iRecStride];
-        s += pRecSrc0[2 * i + iRecStride - (leftPadding ? 0 : 1)];
-        pDst0[i] = s >> 3;
+        s += pSrc[2 * i] * 2;
+        s += pSrc[2 * i + 1];
+        s += pSrc[2 * i - left];
+        s += pSrc[2 * i + srcStride] * 2;
+        s += pSrc[2 * i + 1 + srcStride];
+        s += pSrc[2 * i + srcStride - left];
+        pDst[i] = s >> 3;
       }
     }
 
-    pDst0    += iDstStride;
-    pRecSrc0 += iRecStride2;
+    pDst += dstStride;
+    pSrc += srcStep;
   }
 }
 void IntraPrediction::xGetLMParameters(const PredictionUnit &pu, const ComponentID compID,
@@ -63,6 +63,16 @@ enum PredBuf
 
 static const uint32_t MAX_INTRA_FILTER_DEPTHS=8;
 
+/// luma downsampling filters of the cross-component linear model
+enum CclmLumaFilter
+{
+  CCLM_FILTER_COPY     = 0, ///< 4:4:4, no downsampling
+  CCLM_FILTER_HOR_3TAP = 1, ///< 4:2:2 and the CTU boundary row of 4:2:0, [1 2 1] / 4
+  CCLM_FILTER_COLLOC   = 2, ///< 4:2:0 with collocated chroma, 5-tap cross / 8
+  CCLM_FILTER_6TAP     = 3, ///< 4:2:0, [1 2 1; 1 2 1] / 8
+  NUM_CCLM_FILTERS     = 4
+};
+
 class IntraPrediction
 {
 protected:
@@ -118,16 +128,42 @@ protected:
   ScanElement* m_scanOrder;
   bool         m_bestScanRotationMode;
   // prediction
-  void xPredIntraPlanar           ( const CPelBuf &pSrc, PelBuf &pDst );
+  static void xPredIntraPlanar    ( const CPelBuf &pSrc, PelBuf &pDst );
   void xPredIntraDc               ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter = true );
   void xPredIntraAng              ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const ClpRng& clpRng);
 
+  static void xPredIntraDcCore         ( const Pel* refAbove, const Pel* refLeft, PelBuf &pDst );
+  static void xPredIntraAngLumaLines   ( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, int deltaPos, const int intraPredAngle, const bool useCubicFilter, const ClpRng& clpRng );
+  static void xPredIntraAngChromaLines ( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, int deltaPos, const int intraPredAngle );
+  static void xPredIntraPdpcPlanarDc   ( const CPelBuf &pSrc, PelBuf &pDst, const int scale );
+  static void xFilterReferenceLine     ( const Pel* refUnfiltered, Pel* refFiltered, const int length );
+
+  /// planar prediction from the reference buffer
+  void ( *m_predIntraPlanar      )( const CPelBuf &pSrc, PelBuf &pDst );
+  /// DC prediction from the reference row above and column left, both starting at the first sample of the block
+  void ( *m_predIntraDc          )( const Pel* refAbove, const Pel* refLeft, PelBuf &pDst );
+  /// fractional-slope angular prediction of height lines with the 4-tap cubic or smoothing filter
+  void ( *m_predIntraAngLuma     )( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, int deltaPos, const int intraPredAngle, const bool useCubicFilter, const ClpRng& clpRng );
+  /// fractional-slope angular prediction of height lines with the 2-tap linear filter
+  void ( *m_predIntraAngChroma   )( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, int deltaPos, const int intraPredAngle );
+  /// position dependent combination of the planar or DC prediction with the reference samples
+  void ( *m_predIntraPdpcPlanarDc )( const CPelBuf &pSrc, PelBuf &pDst, const int scale );
+  /// [1 2 1] smoothing of the samples 1..length-1 of a reference line
+  void ( *m_filterReferenceLine  )( const Pel* refUnfiltered, Pel* refFiltered, const int length );
+
+  template<int filter>
+  static void xLumaDownsample( Pel* pDst, const ptrdiff_t dstStride, const Pel* pSrc, const ptrdiff_t srcStride, const int width, const int height, const bool leftPadding, const bool abovePadding );
+
+  /// CCLM luma downsampling of width x height chroma positions, the 4:2:0 filters step two luma lines per chroma line;
+  /// padding replaces the left neighbours of the first column or the above neighbours of the first line
+  void ( *m_lumaDownsample[NUM_CCLM_FILTERS] )( Pel* pDst, const ptrdiff_t dstStride, const Pel* pSrc, const ptrdiff_t srcStride, const int width, const int height, const bool leftPadding, const bool abovePadding );
+
   void initPredIntraParams        ( const PredictionUnit & pu,  const CompArea compArea, const SPS& sps );
 
   static bool isIntegerSlope(const int absAng) { return (0 == (absAng & 0x1F)); }
 
   void xPredIntraBDPCM            ( const CPelBuf &pSrc, PelBuf &pDst, const uint32_t dirMode, const ClpRng& clpRng );
-  Pel  xGetPredValDc              ( const CPelBuf &pSrc, const Size &dstSize );
+  static Pel xGetPredValDc        ( const Pel* refAbove, const Pel* refLeft, const Size &dstSize );
 
   void xFillReferenceSamples      ( const CPelBuf &recoBuf,      Pel* refBufUnfiltered, const CompArea &area, const CodingUnit &cu );
   void xFilterReferenceSamples(const Pel *refBufUnfiltered, Pel *refBufFiltered, const CompArea &area, const SPS &sps,
@@ -169,6 +205,12 @@ public:
   void switchBuffer               (const PredictionUnit &pu, ComponentID compID, PelBuf srcBuff, Pel *dst);
   void geneIntrainterPred         (const CodingUnit &cu);
   void reorderPLT                 (CodingStructure& cs, Partitioner& partitioner, ComponentID compBegin, uint32_t numComp);
+
+#ifdef TARGET_SIMD_X86
+  void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initIntraPredictionX86();
+#endif
 };
 
 //! \}
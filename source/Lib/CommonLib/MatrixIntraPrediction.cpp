@@ -57,6 +57,17 @@ MatrixIntraPrediction::MatrixIntraPrediction():
   m_upsmpFactorHor( 0 ),
   m_upsmpFactorVer( 0 )
 {
+  m_computeReducedPred[0]  = computeReducedPredCore<0>;
+  m_computeReducedPred[1]  = computeReducedPredCore<1>;
+  m_computeReducedPred[2]  = computeReducedPredCore<2>;
+  m_predictionUpsampling1D = predictionUpsampling1D;
+  m_boundaryDownsampling1D = boundaryDownsampling1D;
+
+#if ENABLE_SIMD_OPT_MIP
+#ifdef TARGET_SIMD_X86
+  initMatrixIntraPredictionX86();
+#endif
+#endif
 }
 
 void MatrixIntraPrediction::prepareInputForPred(const CPelBuf &pSrc, const Area &block, const int bitDepth,
@@ -86,10 +97,10 @@ void MatrixIntraPrediction::prepareInputForPred(const CPelBuf &pSrc, const Area
   m_reducedBoundaryTransposed.resize( inputSize );
 
   int* const topReduced = m_reducedBoundary.data();
-  boundaryDownsampling1D( topReduced, m_refSamplesTop.data(), block.width, m_reducedBdrySize );
+  m_boundaryDownsampling1D( topReduced, m_refSamplesTop.data(), block.width, m_reducedBdrySize );
 
   int* const leftReduced = m_reducedBoundary.data() + m_reducedBdrySize;
-  boundaryDownsampling1D( leftReduced, m_refSamplesLeft.data(), block.height, m_reducedBdrySize );
+  m_boundaryDownsampling1D( leftReduced, m_refSamplesLeft.data(), block.height, m_reducedBdrySize );
 
   int* const leftReducedTransposed = m_reducedBoundaryTransposed.data();
   int* const topReducedTransposed  = m_reducedBoundaryTransposed.data() + m_reducedBdrySize;
@@ -251,7 +262,7 @@ void MatrixIntraPrediction::predictionUpsampling( int* const dst, const int* con
     verSrc = horDst;
     verSrcStep *= m_upsmpFactorVer;
 
-    predictionUpsampling1D( horDst, src, m_refSamplesLeft.data(),
+    m_predictionUpsampling1D( horDst, src, m_refSamplesLeft.data(),
                             m_reducedPredSize, m_reducedPredSize,
                             1, m_reducedPredSize, 1, verSrcStep,
                             m_upsmpFactorVer, m_upsmpFactorHor );
@@ -259,7 +270,7 @@ void MatrixIntraPrediction::predictionUpsampling( int* const dst, const int* con
 
   if( m_upsmpFactorVer > 1 )
   {
-    predictionUpsampling1D( dst, verSrc, m_refSamplesTop.data(),
+    m_predictionUpsampling1D( dst, verSrc, m_refSamplesTop.data(),
                             m_reducedPredSize, m_blockSize.width,
                             verSrcStep, 1, m_blockSize.width, 1,
                             1, m_upsmpFactorVer );
@@ -284,25 +295,44 @@ void MatrixIntraPrediction::computeReducedPred( int*const result, const int* con
                                                 const uint8_t* matrix,
                                                 const bool transpose, const int bitDepth )
 {
-  const int inputSize = 2 * m_reducedBdrySize;
-
   // use local buffer for transposed result
   static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( m_reducedPredSize * m_reducedPredSize );
   int*const resPtr = (transpose) ? resBufTransposed.data() : result;
 
+  const int inputOffset = transpose ? m_inputOffsetTransp : m_inputOffset;
+
+  m_computeReducedPred[m_sizeId]( resPtr, input, matrix, inputOffset, bitDepth );
+
+  if( transpose )
+  {
+    for( int y = 0; y < m_reducedPredSize; y++ )
+    {
+      for( int x = 0; x < m_reducedPredSize; x++ )
+      {
+        result[ y * m_reducedPredSize + x ] = resPtr[ x * m_reducedPredSize + y ];
+      }
+    }
+  }
+}
+
+template<int sizeId>
+void MatrixIntraPrediction::computeReducedPredCore( int* const result, const int* const input, const uint8_t* matrix,
+                                                    const int inputOffset, const int bitDepth )
+{
+  const int inputSize       = sizeId == 0 ? 4 : 8;
+  const int reducedPredSize = sizeId < 2 ? 4 : 8;
+
   int sum = 0;
   for( int i = 0; i < inputSize; i++ ) { sum += input[i]; }
   const int offset = (1 << (MIP_SHIFT_MATRIX - 1)) - MIP_OFFSET_MATRIX * sum;
-  CHECK( inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four" );
 
   const uint8_t *weight = matrix;
-  const int   inputOffset = transpose ? m_inputOffsetTransp : m_inputOffset;
 
-  const bool redSize = (m_sizeId == 2);
+  const bool redSize = (sizeId == 2);
   int posRes = 0;
-  for( int y = 0; y < m_reducedPredSize; y++ )
+  for( int y = 0; y < reducedPredSize; y++ )
   {
-    for( int x = 0; x < m_reducedPredSize; x++ )
+    for( int x = 0; x < reducedPredSize; x++ )
     {
       if( redSize ) weight -= 1;
       int tmp0 = redSize ? 0 : (input[0] * weight[0]);
@@ -316,20 +346,9 @@ void MatrixIntraPrediction::computeReducedPred( int*const result, const int* con
         tmp2 += input[i + 2] * weight[i + 2];
         tmp3 += input[i + 3] * weight[i + 3];
       }
-      resPtr[posRes++] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
+      result[posRes++] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
 
       weight += inputSize;
     }
   }
-
-  if( transpose )
-  {
-    for( int y = 0; y < m_reducedPredSize; y++ )
-    {
-      for( int x = 0; x < m_reducedPredSize; x++ )
-      {
-        result[ y * m_reducedPredSize + x ] = resPtr[ x * m_reducedPredSize + y ];
-      }
-    }
-  }
 }
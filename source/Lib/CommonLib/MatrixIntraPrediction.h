@@ -43,6 +43,7 @@
 
 static const int MIP_MAX_INPUT_SIZE             =  8;
 static const int MIP_MAX_REDUCED_OUTPUT_SAMPLES = 64;
+static const int MIP_NUM_SIZE_IDS               =  3;
 
 
 class MatrixIntraPrediction
@@ -54,6 +55,23 @@ public:
   void predBlock(int *const result, const int modeIdx, const bool transpose, const int bitDepth,
                  const ComponentID compId);
 
+  static void boundaryDownsampling1D(int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen);
+  static void predictionUpsampling1D( int* const dst, const int* const src, const int* const bndry,
+                                      const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                      const SizeType srcStep, const SizeType srcStride,
+                                      const SizeType dstStep, const SizeType dstStride,
+                                      const SizeType bndryStep,
+                                      const unsigned int upsmpFactor );
+  template<int sizeId>
+  static void computeReducedPredCore( int* const result, const int* const input, const uint8_t* matrix,
+                                      const int inputOffset, const int bitDepth );
+
+#ifdef TARGET_SIMD_X86
+  void initMatrixIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initMatrixIntraPredictionX86();
+#endif
+
   private:
     ComponentID m_component;
 
@@ -73,15 +91,7 @@ public:
 
     void initPredBlockParams(const Size& block);
 
-    static void boundaryDownsampling1D(int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen);
-
     void predictionUpsampling( int* const dst, const int* const src ) const;
-    static void predictionUpsampling1D( int* const dst, const int* const src, const int* const bndry,
-                                        const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
-                                        const SizeType srcStep, const SizeType srcStride,
-                                        const SizeType dstStep, const SizeType dstStride,
-                                        const SizeType bndryStep,
-                                        const unsigned int upsmpFactor );
 
     const uint8_t* getMatrixData(const int modeIdx) const;
 
@@ -89,6 +99,17 @@ public:
     void computeReducedPred( int*const result, const int* const input,
                              const uint8_t* matrix,
                              const bool transpose, const int bitDepth );
+
+    /// matrix-vector product of the reduced boundary, one kernel per MIP size id
+    void ( *m_computeReducedPred[MIP_NUM_SIZE_IDS] )( int* const result, const int* const input, const uint8_t* matrix,
+                                                      const int inputOffset, const int bitDepth );
+    void ( *m_predictionUpsampling1D )( int* const dst, const int* const src, const int* const bndry,
+                                        const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                        const SizeType srcStep, const SizeType srcStride,
+                                        const SizeType dstStep, const SizeType dstStride,
+                                        const SizeType bndryStep,
+                                        const unsigned int upsmpFactor );
+    void ( *m_boundaryDownsampling1D )( int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen );
   };
 
 #endif //__MATRIXINTRAPPREDICTION__
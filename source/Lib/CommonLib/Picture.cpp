@@ -44,11 +44,102 @@
 // picture methods
 // ---------------------------------------------------------------------------
 
+thread_local int Scheduler::m_splitJobId = 0;
+
+void CtuRowProgress::start( const int ctuHeightLog2 )
+{
+  m_ctuHeightLog2 = ctuHeightLog2;
+  m_numFinishedRows.store( 0, std::memory_order_release );
+}
+
+void CtuRowProgress::setFinished( const int numRows )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_numFinishedRows.store( numRows, std::memory_order_release );
+  }
+  m_cond.notify_all();
+}
+
+void CtuRowProgress::waitForLumaRow( const int lumaY ) const
+{
+  if( isFinished() )
+  {
+    return;
+  }
+  // rows below the picture are only valid once the bottom border has been extended, i.e. with the whole picture
+  const int numRows = lumaY == MAX_INT ? MAX_INT : ( std::max( lumaY, 0 ) >> m_ctuHeightLog2 ) + 1;
+  if( m_numFinishedRows.load( std::memory_order_acquire ) >= numRows )
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [&]() { return m_numFinishedRows.load( std::memory_order_acquire ) >= numRows; } );
+}
+
+std::atomic<size_t> PicPlaneMemory::m_curBytes [NUM_PIC_TYPES];
+std::atomic<size_t> PicPlaneMemory::m_peakBytes[NUM_PIC_TYPES];
+std::atomic<size_t> PicPlaneMemory::m_curTotal;
+std::atomic<size_t> PicPlaneMemory::m_peakTotal;
+
+static inline void updatePeak( std::atomic<size_t> &peak, const size_t value )
+{
+  size_t prev = peak.load( std::memory_order_relaxed );
+  while( prev < value && !peak.compare_exchange_weak( prev, value, std::memory_order_relaxed ) );
+}
+
+void PicPlaneMemory::add( const PictureType type, const size_t bytes )
+{
+  if( !bytes )
+  {
+    return;
+  }
+  updatePeak( m_peakBytes[type], m_curBytes[type].fetch_add( bytes, std::memory_order_relaxed ) + bytes );
+  updatePeak( m_peakTotal,       m_curTotal      .fetch_add( bytes, std::memory_order_relaxed ) + bytes );
+}
+
+void PicPlaneMemory::remove( const PictureType type, const size_t bytes )
+{
+  m_curBytes[type].fetch_sub( bytes, std::memory_order_relaxed );
+  m_curTotal      .fetch_sub( bytes, std::memory_order_relaxed );
+}
+
+void PicPlaneMemory::printReport( const MsgLevel level )
+{
+  static const char* const typeNames[NUM_PIC_TYPES] =
+  {
+    "reconstruction", "original", "true original", "filtered original", "prediction", "residual",
+    "org. residual", "recon. wrap-around", "original input", "true orig. input", "filtered orig. input"
+  };
+
+  msg( level, "\nPeak picture plane memory\n" );
+  for( int t = 0; t < NUM_PIC_TYPES; t++ )
+  {
+    if( m_peakBytes[t] )
+    {
+      msg( level, "  %-22s %10.1f MB\n", typeNames[t], m_peakBytes[t] / ( 1024.0 * 1024.0 ) );
+    }
+  }
+  msg( level, "  %-22s %10.1f MB\n", "total (at peak)", m_peakTotal / ( 1024.0 * 1024.0 ) );
+}
+
+static inline bool isSplitJobBuf( const PictureType &type )
+{
+  return type == PIC_RECONSTRUCTION || type == PIC_PREDICTION || type == PIC_RESIDUAL;
+}
 
 
 Picture::Picture()
 {
   cs                   = nullptr;
+  m_maxCUSize          = 0;
+#if ENABLE_8BIT_REFERENCES
+  for( int i = 0; i < MAX_NUM_COMPONENT; i++ )
+  {
+    m_recoOrigin8[i] = nullptr;
+  }
+  m_recoBytes8         = 0;
+#endif
   m_isSubPicBorderSaved = false;
   m_bIsBorderExtended  = false;
   m_wrapAroundValid    = false;
@@ -77,23 +168,22 @@ Picture::Picture()
   unscaledPic = nullptr;
 }
 
-void Picture::create( const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned _margin, const bool _decoder, const int _layerId, const bool gopBasedTemporalFilterEnabled )
+void Picture::create( const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned _margin, const bool _decoder, const int _layerId, const bool gopBasedTemporalFilterEnabled, const bool lowMemory )
 {
   layerId = _layerId;
   UnitArea::operator=( UnitArea( _chromaFormat, Area( Position{ 0, 0 }, size ) ) );
+  m_maxCUSize       =  _maxCUSize;
   margin            =  MAX_SCALING_RATIO*_margin;
   const Area a      = Area( Position(), size );
-  M_BUFS( 0, PIC_RECONSTRUCTION ).create( _chromaFormat, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
-  M_BUFS( 0, PIC_RECON_WRAP ).create( _chromaFormat, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+  xCreateBuf( 0, PIC_RECONSTRUCTION, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+  if( !lowMemory )
+  {
+    xCreateBuf( 0, PIC_RECON_WRAP, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+  }
 
   if( !_decoder )
   {
-    M_BUFS( 0, PIC_ORIGINAL ).    create( _chromaFormat, a );
-    M_BUFS( 0, PIC_TRUE_ORIGINAL ). create( _chromaFormat, a );
-    if(gopBasedTemporalFilterEnabled)
-    {
-      M_BUFS( 0, PIC_FILTERED_ORIGINAL ). create( _chromaFormat, a );
-    }
+    createOrigBuffers( gopBasedTemporalFilterEnabled );
   }
 #if !KEEP_PRED_AND_RESI_SIGNALS
   m_ctuArea = UnitArea( _chromaFormat, Area( Position{ 0, 0 }, Size( _maxCUSize, _maxCUSize ) ) );
@@ -103,10 +193,14 @@ void Picture::create( const ChromaFormat &_chromaFormat, const Size &size, const
 
 void Picture::destroy()
 {
+  finishSplitParallel();
   for (uint32_t t = 0; t < NUM_PIC_TYPES; t++)
   {
-    M_BUFS(jId, t).destroy();
+    xDestroyBuf( 0, PictureType( t ) );
   }
+#if ENABLE_8BIT_REFERENCES
+  xDestroyRecoBuf8();
+#endif
   m_hashMap.clearAll();
   if (cs)
   {
@@ -150,8 +244,8 @@ void Picture::createTempBuffers( const unsigned _maxCUSize )
   const Area a = m_ctuArea.Y();
 #endif
 
-  M_BUFS( jId, PIC_PREDICTION                   ).create( chromaFormat, a,   _maxCUSize );
-  M_BUFS( jId, PIC_RESIDUAL                     ).create( chromaFormat, a,   _maxCUSize );
+  xCreateBuf( 0, PIC_PREDICTION, a, _maxCUSize );
+  xCreateBuf( 0, PIC_RESIDUAL,   a, _maxCUSize );
 
   if (cs)
   {
@@ -161,20 +255,171 @@ void Picture::createTempBuffers( const unsigned _maxCUSize )
 
 void Picture::destroyTempBuffers()
 {
-  for (uint32_t t = 0; t < NUM_PIC_TYPES; t++)
+  xDestroyBuf( 0, PIC_PREDICTION );
+  xDestroyBuf( 0, PIC_RESIDUAL );
+
+  if (cs)
   {
-    if (t == PIC_RESIDUAL || t == PIC_PREDICTION)
+    cs->rebindPicBufs();
+  }
+}
+
+void Picture::startSplitParallel( const int numJobs, const unsigned _maxCUSize )
+{
+  CHECK( numJobs > PARL_SPLIT_MAX_NUM_JOBS, "Too many split jobs" );
+#if KEEP_PRED_AND_RESI_SIGNALS
+  const Area a( Position{ 0, 0 }, lumaSize() );
+#else
+  const Area a = m_ctuArea.Y();
+#endif
+
+  // every job reconstructs into its own copy of the picture, the originals are shared
+  for( int jId = 1; jId <= numJobs; jId++ )
+  {
+    xCreateBuf( jId, PIC_RECONSTRUCTION, Area( Position(), lumaSize() ), _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+    M_BUFS( jId, PIC_RECONSTRUCTION ).copyFrom( M_BUFS( 0, PIC_RECONSTRUCTION ) );
+    xCreateBuf( jId, PIC_PREDICTION, a, _maxCUSize );
+    xCreateBuf( jId, PIC_RESIDUAL,   a, _maxCUSize );
+  }
+  scheduler.setNumSplitJobs( numJobs );
+}
+
+void Picture::finishSplitParallel()
+{
+  for( int jId = 1; jId <= scheduler.getNumSplitJobs(); jId++ )
+  {
+    for( uint32_t t = 0; t < NUM_PIC_TYPES; t++ )
     {
-      M_BUFS(0, t).destroy();
+      xDestroyBuf( jId, PictureType( t ) );
     }
   }
+  scheduler.setNumSplitJobs( 0 );
+}
 
-  if (cs)
+void Picture::createOrigBuffers( const bool gopBasedTemporalFilterEnabled )
+{
+  const Area a( Position(), lumaSize() );
+
+  xCreateBuf( 0, PIC_ORIGINAL,      a );
+  xCreateBuf( 0, PIC_TRUE_ORIGINAL, a );
+  if( gopBasedTemporalFilterEnabled )
+  {
+    xCreateBuf( 0, PIC_FILTERED_ORIGINAL, a );
+  }
+}
+
+void Picture::createOrigInputBuffers( const Size &inputSize, const bool gopBasedTemporalFilterEnabled )
+{
+  const Area a( Position(), inputSize );
+
+  xCreateBuf( 0, PIC_ORIGINAL_INPUT,      a );
+  xCreateBuf( 0, PIC_TRUE_ORIGINAL_INPUT, a );
+  if( gopBasedTemporalFilterEnabled )
+  {
+    xCreateBuf( 0, PIC_FILTERED_ORIGINAL_INPUT, a );
+  }
+}
+
+void Picture::destroyOrigBuffers()
+{
+  xDestroyBuf( 0, PIC_ORIGINAL );
+  xDestroyBuf( 0, PIC_TRUE_ORIGINAL );
+  xDestroyBuf( 0, PIC_FILTERED_ORIGINAL );
+  xDestroyBuf( 0, PIC_ORIGINAL_INPUT );
+  xDestroyBuf( 0, PIC_TRUE_ORIGINAL_INPUT );
+  xDestroyBuf( 0, PIC_FILTERED_ORIGINAL_INPUT );
+}
+
+#if ENABLE_8BIT_REFERENCES
+void Picture::packRecoBuffers()
+{
+  CHECK( isRecoPacked(), "The reconstruction is already packed" );
+  CHECK( scheduler.getNumSplitJobs(), "The reconstruction cannot be packed while split jobs are running" );
+
+  extendPicBorder( cs->pps );
+
+  // the 8-bit planes cover the picture and the extended border, with the stride of the reconstruction
+  for( int comp = 0; comp < getNumberValidComponents( chromaFormat ); comp++ )
+  {
+    const ComponentID compID  = ComponentID( comp );
+    const CPelBuf     src     = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID );
+    const int         xmargin = margin >> getComponentScaleX( compID, chromaFormat );
+    const int         ymargin = margin >> getComponentScaleY( compID, chromaFormat );
+    const size_t      area    = size_t( src.stride ) * ( src.height + 2 * ymargin );
+
+    m_recoOrigin8[comp] = ( uint8_t* ) xMalloc( uint8_t, area );
+    m_recoBytes8       += area;
+    m_recoBuf8   [comp] = Pel8Buf( m_recoOrigin8[comp] + src.stride * ymargin + xmargin, src.stride, src.width, src.height );
+
+    g_pelBufOP.packTo8bit( src.bufAt( -xmargin, -ymargin ), src.stride, m_recoOrigin8[comp], src.stride, src.width + 2 * xmargin, src.height + 2 * ymargin );
+  }
+  PicPlaneMemory::add( PIC_RECONSTRUCTION, m_recoBytes8 );
+
+  xDestroyBuf( 0, PIC_RECONSTRUCTION );
+  xDestroyBuf( 0, PIC_RECON_WRAP );
+  if( cs )
+  {
+    cs->rebindPicBufs();
+  }
+}
+
+void Picture::createRecoBuffers()
+{
+  xDestroyRecoBuf8();
+  if( !hasRecoBuffers() )
+  {
+    xCreateBuf( 0, PIC_RECONSTRUCTION, Area( Position(), lumaSize() ), m_maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+  }
+  if( cs )
+  {
+    cs->rebindPicBufs();
+  }
+}
+
+void Picture::releaseRecoBuffers()
+{
+  xDestroyRecoBuf8();
+  xDestroyBuf( 0, PIC_RECONSTRUCTION );
+  xDestroyBuf( 0, PIC_RECON_WRAP );
+  if( cs )
   {
     cs->rebindPicBufs();
   }
 }
 
+void Picture::xDestroyRecoBuf8()
+{
+  for( int i = 0; i < MAX_NUM_COMPONENT; i++ )
+  {
+    if( m_recoOrigin8[i] )
+    {
+      xFree( m_recoOrigin8[i] );
+      m_recoOrigin8[i] = nullptr;
+    }
+    m_recoBuf8[i] = Pel8Buf();
+  }
+  PicPlaneMemory::remove( PIC_RECONSTRUCTION, m_recoBytes8 );
+  m_recoBytes8 = 0;
+}
+#endif
+
+void Picture::xCreateBuf( const int jId, const PictureType type, const Area &area, const unsigned _maxCUSize, const unsigned _margin, const unsigned _alignment )
+{
+  M_BUFS( jId, type ).create( chromaFormat, area, _maxCUSize, _margin, _alignment );
+  PicPlaneMemory::add( type, M_BUFS( jId, type ).allocatedBytes() );
+}
+
+void Picture::xDestroyBuf( const int jId, const PictureType type )
+{
+  PicPlaneMemory::remove( type, M_BUFS( jId, type ).allocatedBytes() );
+  M_BUFS( jId, type ).destroy();
+}
+
+void Picture::copySplitRecoBuf( const UnitArea& area, const int jobId )
+{
+  M_BUFS( jobId, PIC_RECONSTRUCTION ).subBuf( area ).copyFrom( M_BUFS( 0, PIC_RECONSTRUCTION ).subBuf( area ) );
+}
+
        PelBuf     Picture::getOrigBuf(const CompArea &blk)        { return getBuf(blk,  PIC_ORIGINAL); }
 const CPelBuf     Picture::getOrigBuf(const CompArea &blk)  const { return getBuf(blk,  PIC_ORIGINAL); }
        PelUnitBuf Picture::getOrigBuf(const UnitArea &unit)       { return getBuf(unit, PIC_ORIGINAL); }
@@ -212,10 +457,10 @@ const CPelBuf     Picture::getRecoBuf(const ComponentID compID, bool wrap) const
 const CPelBuf     Picture::getRecoBuf(const CompArea &blk, bool wrap)      const { return getBuf(blk,                       wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
        PelUnitBuf Picture::getRecoBuf(const UnitArea &unit, bool wrap)           { return getBuf(unit,                      wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
 const CPelUnitBuf Picture::getRecoBuf(const UnitArea &unit, bool wrap)     const { return getBuf(unit,                      wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
-       PelUnitBuf Picture::getRecoBuf(bool wrap)                                 { return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
-const CPelUnitBuf Picture::getRecoBuf(bool wrap)                           const { return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
+       PelUnitBuf Picture::getRecoBuf(bool wrap)                                 { return wrap ? M_BUFS(0, PIC_RECON_WRAP) : M_BUFS(scheduler.getSplitPicId(), PIC_RECONSTRUCTION); }
+const CPelUnitBuf Picture::getRecoBuf(bool wrap)                           const { return wrap ? M_BUFS(0, PIC_RECON_WRAP) : M_BUFS(scheduler.getSplitPicId(), PIC_RECONSTRUCTION); }
 
-void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps )
+void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps, const bool ownUnitCache )
 {
   for( auto &sei : SEIs )
   {
@@ -231,14 +476,22 @@ void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHead
   if( cs )
   {
     cs->initStructData();
+    // the picture may have been taken over from another layer or parameter set
+    cs->sps = &sps;
   }
   else
   {
-    cs = new CodingStructure( g_globalUnitCache.cuCache, g_globalUnitCache.puCache, g_globalUnitCache.tuCache );
+    XUCache &unitCache = ownUnitCache ? m_unitCache : g_globalUnitCache;
+    cs = new CodingStructure( unitCache.cuCache, unitCache.puCache, unitCache.tuCache );
     cs->sps = &sps;
     cs->create(chromaFormatIDC, Area(0, 0, iWidth, iHeight), true, (bool)sps.getPLTMode());
   }
 
+  if( sps.getWrapAroundEnabledFlag() && M_BUFS( 0, PIC_RECON_WRAP ).bufs.empty() )
+  {
+    xCreateBuf( 0, PIC_RECON_WRAP, Area( Position(), lumaSize() ), sps.getMaxCUWidth(), margin, MEMORY_ALIGN_DEF_SIZE );
+  }
+
   cs->vps = vps;
   cs->picture = this;
   cs->slice   = nullptr;  // the slices for this picture have not been set at this point. update cs->slice after swapSliceObject()
@@ -668,6 +921,7 @@ void Picture::rescalePicture( const std::pair<int, int> scalingRatio,
 
 void Picture::saveSubPicBorder(int POC, int subPicX0, int subPicY0, int subPicWidth, int subPicHeight)
 {
+  ctuRowProgress.waitForLumaRow( MAX_INT );
 
   // 1.1 set up margin for back up memory allocation
   int xMargin = margin >> getComponentScaleX(COMPONENT_Y, cs->area.chromaFormat);
@@ -963,33 +1217,78 @@ void Picture::extendPicBorder( const PPS *pps )
 {
   if ( m_bIsBorderExtended )
   {
-    if( isWrapAroundEnabled( pps ) && ( !m_wrapAroundValid || m_wrapAroundOffset != pps->getWrapAroundOffset() ) )
+    if( isWrapAroundEnabled( pps ) )
     {
-      extendWrapBorder( pps );
+      // the border may have been claimed by the post-filter stage of the decoder that still works on the picture
+      ctuRowProgress.waitForLumaRow( MAX_INT );
+      if( !m_wrapAroundValid || m_wrapAroundOffset != pps->getWrapAroundOffset() )
+      {
+        extendWrapBorder( pps );
+      }
     }
     return;
   }
 
+  extendPicBorderSamples( pps );
+  m_bIsBorderExtended = true;
+}
+
+void Picture::extendPicBorderSamples( const PPS *pps, const bool ctuRowsExtended )
+{
   for(int comp=0; comp<getNumberValidComponents( cs->area.chromaFormat ); comp++)
   {
     ComponentID compID = ComponentID( comp );
-    PelBuf p = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID );
-    Pel *piTxt = p.bufAt(0,0);
-    int xmargin = margin >> getComponentScaleX( compID, cs->area.chromaFormat );
-    int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
+    if( !ctuRowsExtended )
+    {
+      xExtendBorderRows( compID, 0, M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID ).height );
+    }
 
-    Pel*  pi = piTxt;
-    // do left and right margins
-    for (int y = 0; y < p.height; y++)
+    // reference picture with horizontal wrapped boundary
+    if ( isWrapAroundEnabled( pps ) )
     {
-      for (int x = 0; x < xmargin; x++)
-      {
-        pi[-xmargin + x] = pi[0];
-        pi[p.width + x]  = pi[p.width - 1];
-      }
-      pi += p.stride;
+      extendWrapBorder( pps );
     }
+    else
+    {
+      m_wrapAroundValid = false;
+      m_wrapAroundOffset = 0;
+    }
+  }
+}
 
+void Picture::extendCtuRowBorder( const int ctuRow )
+{
+  for( int comp = 0; comp < getNumberValidComponents( cs->area.chromaFormat ); comp++ )
+  {
+    const ComponentID compID = ComponentID( comp );
+    const int         scaleY = getComponentScaleY( compID, cs->area.chromaFormat );
+    const int         height = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID ).height;
+
+    xExtendBorderRows( compID, ( ctuRow * cs->pcv->maxCUHeight ) >> scaleY, std::min<int>( ( ( ctuRow + 1 ) * cs->pcv->maxCUHeight ) >> scaleY, height ) );
+  }
+}
+
+// extends the left and right border of the rows yStart .. yEnd-1, the top border with the first row and the bottom border with the last one
+void Picture::xExtendBorderRows( const ComponentID compID, const int yStart, const int yEnd )
+{
+  PelBuf p = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID );
+  int xmargin = margin >> getComponentScaleX( compID, cs->area.chromaFormat );
+  int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
+
+  Pel*  pi = p.bufAt( 0, yStart );
+  // do left and right margins
+  for (int y = yStart; y < yEnd; y++)
+  {
+    for (int x = 0; x < xmargin; x++)
+    {
+      pi[-xmargin + x] = pi[0];
+      pi[p.width + x]  = pi[p.width - 1];
+    }
+    pi += p.stride;
+  }
+
+  if( yEnd == p.height )
+  {
     // pi is now the (0,height) (bottom left of image within bigger picture
     pi -= (p.stride + xmargin);
     // pi is now the (-marginX, height-1)
@@ -997,28 +1296,17 @@ void Picture::extendPicBorder( const PPS *pps )
     {
       ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
     }
+  }
 
-    // pi is still (-marginX, height-1)
-    pi -= ((p.height-1) * p.stride);
+  if( yStart == 0 )
+  {
+    pi = p.bufAt( 0, 0 ) - xmargin;
     // pi is now (-marginX, 0)
     for (int y = 0; y < ymargin; y++ )
     {
       ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
     }
-
-    // reference picture with horizontal wrapped boundary
-    if ( isWrapAroundEnabled( pps ) )
-    {
-      extendWrapBorder( pps );
-    }
-    else
-    {
-      m_wrapAroundValid = false;
-      m_wrapAroundOffset = 0;
-    }
   }
-
-  m_bIsBorderExtended = true;
 }
 
 void Picture::extendWrapBorder( const PPS *pps )
@@ -1067,12 +1355,12 @@ void Picture::extendWrapBorder( const PPS *pps )
 
 PelBuf Picture::getBuf( const ComponentID compID, const PictureType &type )
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL || type == PIC_FILTERED_ORIGINAL || type == PIC_ORIGINAL_INPUT || type == PIC_TRUE_ORIGINAL_INPUT || type == PIC_FILTERED_ORIGINAL_INPUT ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return M_BUFS( isSplitJobBuf( type ) ? scheduler.getSplitPicId() : 0, type ).getBuf( compID );
 }
 
 const CPelBuf Picture::getBuf( const ComponentID compID, const PictureType &type ) const
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL || type == PIC_FILTERED_ORIGINAL || type == PIC_ORIGINAL_INPUT || type == PIC_TRUE_ORIGINAL_INPUT || type == PIC_FILTERED_ORIGINAL_INPUT ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return M_BUFS( isSplitJobBuf( type ) ? scheduler.getSplitPicId() : 0, type ).getBuf( compID );
 }
 
 PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
@@ -1089,11 +1377,11 @@ PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
-    return M_BUFS( jId, type ).getBuf( localBlk );
+    return M_BUFS( isSplitJobBuf( type ) ? scheduler.getSplitPicId() : 0, type ).getBuf( localBlk );
   }
 #endif
 
-  return M_BUFS( jId, type ).getBuf( blk );
+  return M_BUFS( isSplitJobBuf( type ) ? scheduler.getSplitPicId() : 0, type ).getBuf( blk );
 }
 
 const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) const
@@ -1110,11 +1398,11 @@ const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) co
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
-    return M_BUFS( jId, type ).getBuf( localBlk );
+    return M_BUFS( isSplitJobBuf( type ) ? scheduler.getSplitPicId() : 0, type ).getBuf( localBlk );
   }
 #endif
 
-  return M_BUFS( jId, type ).getBuf( blk );
+  return M_BUFS( isSplitJobBuf( type ) ? scheduler.getSplitPicId() : 0, type ).getBuf( blk );
 }
 
 PelUnitBuf Picture::getBuf( const UnitArea &unit, const PictureType &type )
@@ -1143,7 +1431,7 @@ const CPelUnitBuf Picture::getBuf( const UnitArea &unit, const PictureType &type
 
 Pel* Picture::getOrigin( const PictureType &type, const ComponentID compID ) const
 {
-  return M_BUFS( jId, type ).getOrigin( compID );
+  return M_BUFS( isSplitJobBuf( type ) ? scheduler.getSplitPicId() : 0, type ).getOrigin( compID );
 }
 
 void Picture::createSpliceIdx(int nums)
@@ -1262,3 +1550,52 @@ PelUnitBuf Picture::getDisplayBuf()
 
   return *m_invColourTransfBuf;
 }
+
+static inline bool isPicSizeClass( const Picture &pic, const ChromaFormat chromaFormat, const Size &size, const unsigned maxCUSize )
+{
+  return pic.chromaFormat == chromaFormat && pic.lumaSize() == size && pic.getMaxCUSize() == maxCUSize;
+}
+
+int PicturePool::numFree( const ChromaFormat chromaFormat, const Size &size, const unsigned maxCUSize ) const
+{
+  return (int) std::count_if( m_freePics.begin(), m_freePics.end(), [&]( const Picture* pic ) { return isPicSizeClass( *pic, chromaFormat, size, maxCUSize ); } );
+}
+
+Picture* PicturePool::lease( const ChromaFormat chromaFormat, const Size &size, const unsigned maxCUSize )
+{
+  // prefer the most recently returned picture, its buffers are the most likely to still be cached
+  for( auto it = m_freePics.rbegin(); it != m_freePics.rend(); it++ )
+  {
+    if( isPicSizeClass( **it, chromaFormat, size, maxCUSize ) )
+    {
+      Picture* pic = *it;
+      m_freePics.erase( std::next( it ).base() );
+      return pic;
+    }
+  }
+  return nullptr;
+}
+
+Picture* PicturePool::giveBack( Picture* pic )
+{
+  m_freePics.push_back( pic );
+
+  if( (int) m_freePics.size() > m_capacity )
+  {
+    Picture* evicted = m_freePics.front();
+    m_freePics.pop_front();
+    return evicted;
+  }
+  return nullptr;
+}
+
+Picture* PicturePool::takeAny()
+{
+  if( m_freePics.empty() )
+  {
+    return nullptr;
+  }
+  Picture* pic = m_freePics.back();
+  m_freePics.pop_back();
+  return pic;
+}
@@ -50,6 +50,9 @@
 #include "MCTS.h"
 #include "SEIColourTransform.h"
 #include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 
 class SEI;
@@ -57,18 +60,95 @@ class AQpLayer;
 
 typedef std::list<SEI*> SEIMessages;
 
-#define M_BUFS(JID,PID) m_bufs[PID]
+#define M_BUFS(JID,PID) m_bufs[JID][PID]
+
+/// selects the reconstruction, prediction and residual buffers of a picture while sibling split modes are evaluated in parallel
+class Scheduler
+{
+public:
+  Scheduler() : m_numSplitJobs( 0 ) {}
+
+  int         getSplitPicId  () const          { return m_numSplitJobs > 0 ? m_splitJobId : 0; }
+  int         getNumSplitJobs() const          { return m_numSplitJobs; }
+  void        setNumSplitJobs( const int num ) { m_numSplitJobs = num; }
+
+  static int  getSplitJobId  ()                { return m_splitJobId; }
+  static void setSplitJobId  ( const int id )  { m_splitJobId = id; }
+
+private:
+  int                     m_numSplitJobs;   ///< number of job buffer sets allocated for the picture, 0 outside of split-parallel encoding
+  static thread_local int m_splitJobId;     ///< split job evaluated by the calling thread, 0 for the main encoding stack
+};
+
+/// publishes the CTU rows of a picture whose samples are final while its in-loop filtering still runs on another thread
+class CtuRowProgress
+{
+public:
+  CtuRowProgress() : m_numFinishedRows( MAX_INT ), m_ctuHeightLog2( 0 ) {}
+
+  void start         ( const int ctuHeightLog2 );
+  void setFinished   ( const int numRows );
+  bool isFinished    () const { return m_numFinishedRows.load( std::memory_order_acquire ) == MAX_INT; }
+  void waitForLumaRow( const int lumaY ) const;
+
+private:
+  std::atomic<int>                m_numFinishedRows;  ///< CTU rows from the top that are final, MAX_INT once the whole picture and its border are
+  int                             m_ctuHeightLog2;
+  mutable std::mutex              m_mutex;
+  mutable std::condition_variable m_cond;
+};
+
+/// process-wide accounting of the sample memory held by the planes of all pictures, per plane type
+class PicPlaneMemory
+{
+public:
+  static void add        ( const PictureType type, const size_t bytes );
+  static void remove     ( const PictureType type, const size_t bytes );
+  static void printReport( const MsgLevel level );
+
+private:
+  static std::atomic<size_t> m_curBytes [NUM_PIC_TYPES];
+  static std::atomic<size_t> m_peakBytes[NUM_PIC_TYPES];
+  static std::atomic<size_t> m_curTotal;
+  static std::atomic<size_t> m_peakTotal;
+};
 
 struct Picture : public UnitArea
 {
   uint32_t margin;
   Picture();
 
-  void create( const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned margin, const bool bDecoder, const int layerId, const bool gopBasedTemporalFilterEnabled = false );
+  unsigned getMaxCUSize() const { return m_maxCUSize; }
+
+  // with lowMemory, the wrap-around reconstruction is only allocated by finalInit() for an SPS that enables wrap-around
+  void create( const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned margin, const bool bDecoder, const int layerId, const bool gopBasedTemporalFilterEnabled = false, const bool lowMemory = false );
   void destroy();
 
+  void createOrigBuffers     ( const bool gopBasedTemporalFilterEnabled );
+  void createOrigInputBuffers( const Size &inputSize, const bool gopBasedTemporalFilterEnabled );
+  void destroyOrigBuffers    ();
+  bool hasOrigBuffers        () const { return !M_BUFS( 0, PIC_ORIGINAL       ).bufs.empty(); }
+  bool hasOrigInputBuffers   () const { return !M_BUFS( 0, PIC_ORIGINAL_INPUT ).bufs.empty(); }
+
   void createTempBuffers( const unsigned _maxCUSize );
   void destroyTempBuffers();
+
+#if ENABLE_8BIT_REFERENCES
+  // once a picture of an 8-bit sequence is final, the encoder may replace its reconstruction by 8-bit planes
+  // holding the border-extended samples, which only motion compensation and motion estimation read; before its
+  // compression, such a picture holds no reconstruction at all
+  void packRecoBuffers   ();
+  void createRecoBuffers ();
+  void releaseRecoBuffers();
+  bool hasRecoBuffers    () const { return !M_BUFS( 0, PIC_RECONSTRUCTION ).bufs.empty(); }
+  bool isRecoPacked      () const { return m_recoOrigin8[COMPONENT_Y] != nullptr; }
+  const CPel8Buf getRecoBuf8( const ComponentID compID ) const { return m_recoBuf8[compID]; }
+  const CPel8Buf getRecoBuf8( const CompArea &blk )      const { return m_recoBuf8[blk.compID].subBuf( blk.pos(), blk.size() ); }
+
+#endif
+  void startSplitParallel ( const int numJobs, const unsigned _maxCUSize );
+  void finishSplitParallel();
+  void copySplitRecoBuf   ( const UnitArea& area, const int jobId );
   SEIColourTransformApply* m_colourTranfParams;
   PelStorage*              m_invColourTransfBuf;
   void              createColourTransfProcessor(bool firstPictureInSequence, SEIColourTransformApply* ctiCharacteristics, PelStorage* ctiBuf, int width, int height, ChromaFormat fmt, int bitDepth);
@@ -121,8 +201,13 @@ struct Picture : public UnitArea
   const CPelUnitBuf getBuf(const UnitArea &unit,     const PictureType &type) const;
 
   void extendPicBorder( const PPS *pps );
+  // with ctuRowsExtended the sample borders were already extended row by row by extendCtuRowBorder()
+  void extendPicBorderSamples( const PPS *pps, const bool ctuRowsExtended = false );
+  void extendCtuRowBorder( const int ctuRow );
   void extendWrapBorder( const PPS *pps );
-  void finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps );
+  // with ownUnitCache, the coding structure takes its units from a cache of the picture instead of the global one,
+  // so that several threads can compress pictures at the same time
+  void finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps, const bool ownUnitCache = false );
 
   int  getPOC()                               const { return poc; }
   int  getDecodingOrderNumber()               const { return m_decodingOrderNumber; }
@@ -156,6 +241,8 @@ struct Picture : public UnitArea
                                 const bool horCollocatedChromaFlag, const bool verCollocatedChromaFlag );
 
 private:
+  void xExtendBorderRows( const ComponentID compID, const int yStart, const int yEnd );
+
   Window        m_conformanceWindow;
   Window        m_scalingWindow;
   int           m_decodingOrderNumber;
@@ -209,7 +296,20 @@ public:
   bool interLayerRefPicFlag;
   bool mixedNaluTypesInPicFlag;
 
-  PelStorage m_bufs[NUM_PIC_TYPES];
+  PelStorage m_bufs[PARL_SPLIT_MAX_NUM_JOBS + 1][NUM_PIC_TYPES];
+private:
+  unsigned   m_maxCUSize;
+#if ENABLE_8BIT_REFERENCES
+  uint8_t*   m_recoOrigin8[MAX_NUM_COMPONENT];
+  Pel8Buf    m_recoBuf8   [MAX_NUM_COMPONENT];
+  size_t     m_recoBytes8;
+  void xDestroyRecoBuf8();
+#endif
+  void xCreateBuf ( const int jId, const PictureType type, const Area &area, const unsigned _maxCUSize = 0, const unsigned _margin = 0, const unsigned _alignment = 0 );
+  void xDestroyBuf( const int jId, const PictureType type );
+public:
+  Scheduler  scheduler;
+  CtuRowProgress ctuRowProgress;
   const Picture*           unscaledPic;
 
   TComHash           m_hashMap;
@@ -217,12 +317,13 @@ public:
   const TComHash*    getHashMap() const { return &m_hashMap; }
   void               addPictureToHashMapForInter();
 
+  XUCache            m_unitCache;           ///< units of the coding structure, if it does not use the global cache
   CodingStructure*   cs;
   std::deque<Slice*> slices;
   SEIMessages        SEIs;
 
-  uint32_t           getPicWidthInLumaSamples() const                                { return  getRecoBuf( COMPONENT_Y ).width; }
-  uint32_t           getPicHeightInLumaSamples() const                               { return  getRecoBuf( COMPONENT_Y ).height; }
+  uint32_t           getPicWidthInLumaSamples() const                                { return  lumaSize().width; }
+  uint32_t           getPicHeightInLumaSamples() const                               { return  lumaSize().height; }
   Window&            getConformanceWindow()                                          { return  m_conformanceWindow; }
   const Window&      getConformanceWindow() const                                    { return  m_conformanceWindow; }
   Window&            getScalingWindow()                                              { return  m_scalingWindow; }
@@ -307,4 +408,22 @@ std::string hashToString(const PictureHash &digest, int numChar);
 
 typedef std::list<Picture*> PicList;
 
+/// free pictures kept for reuse by an encoder or decoder, matched by the size class of their sample planes
+class PicturePool
+{
+public:
+  PicturePool() : m_capacity( 0 ) {}
+
+  void     setCapacity( const int capacity ) { m_capacity = capacity; }
+  int      numFree    ( const ChromaFormat chromaFormat, const Size &size, const unsigned maxCUSize ) const;
+
+  Picture* lease      ( const ChromaFormat chromaFormat, const Size &size, const unsigned maxCUSize );  ///< a free picture of the size class, nullptr if there is none
+  Picture* giveBack   ( Picture* pic );                                                                 ///< the least recently returned picture if the pool is over capacity, the caller deletes it
+  Picture* takeAny    ();                                                                               ///< removes a free picture to tear the pool down, nullptr once it is empty
+
+private:
+  std::deque<Picture*> m_freePics;  ///< least recently returned first
+  int                  m_capacity;
+};
+
 #endif
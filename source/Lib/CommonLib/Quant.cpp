@@ -132,6 +132,16 @@ QpParam::QpParam(const TransformUnit& tu, const ComponentID &compIDX, const int
 Quant::Quant( const Quant* other )
 {
   xInitScalingList( other );
+
+  m_quantCore    = quantCore;
+  m_dequantCore  = dequantCore;
+  m_preQuantCore = preQuantCore;
+
+#if ENABLE_SIMD_OPT_QUANT
+#ifdef TARGET_SIMD_X86
+  initQuantX86();
+#endif
+#endif
 }
 
 Quant::~Quant()
@@ -416,30 +426,7 @@ void Quant::dequant(const TransformUnit &tu,
     const uint32_t uiLog2TrHeight = floorLog2(uiHeight);
     int *piDequantCoef        = getDequantCoeff(scalingListType, QP_rem, uiLog2TrWidth, uiLog2TrHeight);
 
-    if(rightShift > 0)
-    {
-      const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * piDequantCoef[n]) + iAdd ) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const int leftShift = -rightShift;
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * piDequantCoef[n]) << leftShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    m_dequantCore( piQCoef, piCoef, piDequantCoef, 0, numSamplesInBlock, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
   }
   else
   {
@@ -453,29 +440,34 @@ void Quant::dequant(const TransformUnit &tu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
-    if (rightShift > 0)
-    {
-      const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
+    m_dequantCore( piQCoef, piCoef, nullptr, scale, numSamplesInBlock, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+  }
+}
 
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale + iAdd) >> rightShift;
+void Quant::dequantCore( const TCoeff* src, TCoeff* dst, const int* dequantCoeff, const int scale, const int numCoeff, const int rightShift, const Intermediate_Int minInput, const Intermediate_Int maxInput, const TCoeff minCoeff, const TCoeff maxCoeff )
+{
+  if (rightShift > 0)
+  {
+    const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
 
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
+    for( int n = 0; n < numCoeff; n++ )
     {
-      const int leftShift = -rightShift;
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(minInput, maxInput, src[n]));
+      const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * (dequantCoeff ? dequantCoeff[n] : scale) + iAdd) >> rightShift;
 
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale) << leftShift;
+      dst[n] = TCoeff(Clip3<Intermediate_Int>(minCoeff,maxCoeff,iCoeffQ));
+    }
+  }
+  else
+  {
+    const int leftShift = -rightShift;
 
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
+    for( int n = 0; n < numCoeff; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(minInput, maxInput, src[n]));
+      const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * (dequantCoeff ? dequantCoeff[n] : scale)) << leftShift;
+
+      dst[n] = TCoeff(Clip3<Intermediate_Int>(minCoeff,maxCoeff,iCoeffQ));
     }
   }
 }
@@ -1010,26 +1002,35 @@ void Quant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf
 
     const uint32_t lfnstIdx = tu.cu->lfnstIdx;
     const int maxNumberOfCoeffs = lfnstIdx > 0 ? ((( uiWidth == 4 && uiHeight == 4 ) || ( uiWidth == 8 && uiHeight == 8) ) ? 8 : 16) : piQCoef.area();
-    memset( piQCoef.buf, 0, sizeof(TCoeff) * piQCoef.area() );
-
-    const ScanElement* scan = g_scanOrder[SCAN_GROUPED_4x4][SCAN_DIAG][gp_sizeIdxInfo->idxFrom(uiWidth)][gp_sizeIdxInfo->idxFrom(uiHeight)];
 
-    for (int uiScanPos = 0; uiScanPos < maxNumberOfCoeffs; uiScanPos++)
+    if( maxNumberOfCoeffs == piQCoef.area() )
+    {
+      // all coefficients are quantized, the scan order does not matter
+      m_quantCore( piCoef.buf, piQCoef.buf, deltaU, enableScalingLists ? piQuantCoeff : nullptr, defaultQuantisationCoefficient, maxNumberOfCoeffs, iAdd, iQBits, entropyCodingMinimum, entropyCodingMaximum, uiAbsSum );
+    }
+    else
     {
-      const int uiBlockPos = scan[uiScanPos].idx;
-      const TCoeff iLevel   = piCoef.buf[uiBlockPos];
-      const TCoeff iSign    = (iLevel < 0 ? -1: 1);
+      memset( piQCoef.buf, 0, sizeof(TCoeff) * piQCoef.area() );
 
-      const int64_t  tmpLevel = (int64_t)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
+      const ScanElement* scan = g_scanOrder[SCAN_GROUPED_4x4][SCAN_DIAG][gp_sizeIdxInfo->idxFrom(uiWidth)][gp_sizeIdxInfo->idxFrom(uiHeight)];
 
-      const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
-      deltaU[uiBlockPos] = (TCoeff)((tmpLevel - ((int64_t)quantisedMagnitude<<iQBits) )>> qBits8);
+      for (int uiScanPos = 0; uiScanPos < maxNumberOfCoeffs; uiScanPos++)
+      {
+        const int uiBlockPos = scan[uiScanPos].idx;
+        const TCoeff iLevel   = piCoef.buf[uiBlockPos];
+        const TCoeff iSign    = (iLevel < 0 ? -1: 1);
+
+        const int64_t  tmpLevel = (int64_t)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
 
-      uiAbsSum += quantisedMagnitude;
-      const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
+        const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
+        deltaU[uiBlockPos] = (TCoeff)((tmpLevel - ((int64_t)quantisedMagnitude<<iQBits) )>> qBits8);
 
-      piQCoef.buf[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
-    } // for n
+        uiAbsSum += quantisedMagnitude;
+        const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
+
+        piQCoef.buf[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
+      } // for n
+    }
     if ((tu.cu->bdpcmMode && isLuma(compID)) || (tu.cu->bdpcmModeChroma && isChroma(compID)) )
     {
       fwdResDPCM( tu, compID );
@@ -1045,6 +1046,50 @@ void Quant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf
   //return;
 }
 
+void Quant::quantCore( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int* quantCoeff, const int scale, const int numCoeff, const int64_t add, const int qBits, const TCoeff minCoeff, const TCoeff maxCoeff, TCoeff& absSum )
+{
+  const int qBits8 = qBits - 8;
+
+  for( int n = 0; n < numCoeff; n++ )
+  {
+    const TCoeff  iLevel   = src[n];
+    const TCoeff  iSign    = (iLevel < 0 ? -1: 1);
+
+    const int64_t tmpLevel = (int64_t)abs(iLevel) * (quantCoeff ? quantCoeff[n] : scale);
+
+    const TCoeff quantisedMagnitude = TCoeff((tmpLevel + add ) >> qBits);
+    deltaU[n] = (TCoeff)((tmpLevel - ((int64_t)quantisedMagnitude<<qBits) )>> qBits8);
+
+    absSum += quantisedMagnitude;
+    const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
+
+    dst[n] = Clip3<TCoeff>( minCoeff, maxCoeff, quantisedCoefficient );
+  }
+}
+
+bool Quant::preQuantCore( const TCoeff* src, const int* quantCoeff, const int scale, const int numCoeff, const int64_t thres, uint8_t* sig )
+{
+  if( !sig )
+  {
+    for( int n = 0; n < numCoeff; n++ )
+    {
+      if( (int64_t)abs(src[n]) * (quantCoeff ? quantCoeff[n] : scale) >= thres )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool anySig = false;
+  for( int n = 0; n < numCoeff; n++ )
+  {
+    sig[n]  = (int64_t)abs(src[n]) * (quantCoeff ? quantCoeff[n] : scale) >= thres;
+    anySig |= sig[n] != 0;
+  }
+  return anySig;
+}
+
 bool Quant::xNeedRDOQ(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, const QpParam &cQP)
 {
   const SPS &sps            = *tu.cs->sps;
@@ -1092,18 +1137,8 @@ bool Quant::xNeedRDOQ(TransformUnit &tu, const ComponentID &compID, const CCoeff
   // iAdd is different from the iAdd used in normal quantization
   const int64_t iAdd = int64_t(compID == COMPONENT_Y ? 171 : 256) << (iQBits - 9);
 
-  for (int uiBlockPos = 0; uiBlockPos < rect.area(); uiBlockPos++)
-  {
-    const TCoeff iLevel   = piCoef.buf[uiBlockPos];
-    const int64_t  tmpLevel = (int64_t)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
-    const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
-
-    if (quantisedMagnitude != 0)
-    {
-      return true;
-    }
-  } // for n
-  return false;
+  // a quantized magnitude ( |coeff| * scale + iAdd ) >> iQBits is non-zero, if |coeff| * scale reaches ( 1 << iQBits ) - iAdd
+  return m_preQuantCore( piCoef.buf, enableScalingLists ? piQuantCoeff : nullptr, defaultQuantisationCoefficient, rect.area(), ( int64_t( 1 ) << iQBits ) - iAdd, nullptr );
 }
 
 
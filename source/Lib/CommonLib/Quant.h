@@ -140,8 +140,22 @@ public:
   // de-quantization
   virtual void dequant           ( const TransformUnit &tu, CoeffBuf &dstCoeff, const ComponentID &compID, const QpParam &cQP );
 
+  static void   quantCore        ( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int* quantCoeff, const int scale, const int numCoeff, const int64_t add, const int qBits, const TCoeff minCoeff, const TCoeff maxCoeff, TCoeff& absSum );
+  static void   dequantCore      ( const TCoeff* src, TCoeff* dst, const int* dequantCoeff, const int scale, const int numCoeff, const int rightShift, const Intermediate_Int minInput, const Intermediate_Int maxInput, const TCoeff minCoeff, const TCoeff maxCoeff );
+  static bool   preQuantCore     ( const TCoeff* src, const int* quantCoeff, const int scale, const int numCoeff, const int64_t thres, uint8_t* sig );
+
+#ifdef TARGET_SIMD_X86
+  void initQuantX86();
+  template <X86_VEXT vext>
+  void _initQuantX86();
+#endif
+
 protected:
 
+  void   ( *m_quantCore    )( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int* quantCoeff, const int scale, const int numCoeff, const int64_t add, const int qBits, const TCoeff minCoeff, const TCoeff maxCoeff, TCoeff& absSum ); ///< scalar quantization of a whole block
+  void   ( *m_dequantCore  )( const TCoeff* src, TCoeff* dst, const int* dequantCoeff, const int scale, const int numCoeff, const int rightShift, const Intermediate_Int minInput, const Intermediate_Int maxInput, const TCoeff minCoeff, const TCoeff maxCoeff ); ///< dequantization of a whole block
+  bool   ( *m_preQuantCore )( const TCoeff* src, const int* quantCoeff, const int scale, const int numCoeff, const int64_t thres, uint8_t* sig ); ///< flags the coefficients with |src| * scale >= thres
+
 #if T0196_SELECTIVE_RDOQ
   bool xNeedRDOQ                 ( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, const QpParam &cQP );
 #endif
@@ -679,8 +679,55 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 
   const int iCGNum = lfnstIdx > 0 ? 1 : std::min<int>(JVET_C0024_ZERO_OUT_TH, uiWidth) * std::min<int>(JVET_C0024_ZERO_OUT_TH, uiHeight) >> cctx.log2CGSize();
 
+  // Pre-quantize the whole block to find the last coefficient group with a non-zero level estimate
+  // ( lLevelDouble + ( 1 << ( iQBits - 1 ) ) ) >> iQBits. The groups following it only add their uncoded cost
+  // and a block without any such level is left all zero. The clipping of lLevelDouble cannot turn a
+  // non-zero estimate into a zero one as long as iQBits does not exceed 30.
+  int lastSigSubSetId = iCGNum - 1;
+  if( iQBits > 0 && iQBits <= 30 )
+  {
+    if( !m_preQuantCore( plSrcCoeff, enableScalingLists ? piQCoef : nullptr, defaultQuantisationCoefficient, uiMaxNumCoeff, int64_t( 1 ) << ( iQBits - 1 ), m_preQuantSig ) )
+    {
+      return;
+    }
+    const int maxNonZeroPosInCG = lfnstIdx > 0 && ( ( uiWidth == 4 && uiHeight == 4 ) || ( uiWidth == 8 && uiHeight == 8 ) ) ? 7 : iCGSizeM1;
+    for( lastSigSubSetId = iCGNum - 1; lastSigSubSetId >= 0; lastSigSubSetId-- )
+    {
+      const int minSubPos = lastSigSubSetId << cctx.log2CGSize();
+      int       scanPos   = minSubPos + maxNonZeroPosInCG;
+      while( scanPos >= minSubPos && !m_preQuantSig[cctx.blockPos( scanPos )] )
+      {
+        scanPos--;
+      }
+      if( scanPos >= minSubPos )
+      {
+        break;
+      }
+    }
+    if( lastSigSubSetId < 0 )
+    {
+      return;
+    }
+  }
+
   for (int subSetId = iCGNum - 1; subSetId >= 0; subSetId--)
   {
+    if( subSetId > lastSigSubSetId )
+    {
+      const int minSubPos = subSetId << cctx.log2CGSize();
+      for( iScanPos = minSubPos + iCGSizeM1; iScanPos >= minSubPos; iScanPos-- )
+      {
+        const uint32_t         uiBlkPos     = cctx.blockPos( iScanPos );
+        const int64_t          tmpLevel     = int64_t( abs( plSrcCoeff[uiBlkPos] ) ) * ( enableScalingLists ? piQCoef[uiBlkPos] : defaultQuantisationCoefficient );
+        const Intermediate_Int lLevelDouble = (Intermediate_Int)std::min<int64_t>(tmpLevel, std::numeric_limits<Intermediate_Int>::max() - (Intermediate_Int(1) << (iQBits - 1)));
+        const double           dErr         = double( lLevelDouble );
+        pdCostCoeff0[ iScanPos ]  = dErr * dErr * ( enableScalingLists ? pdErrScale[uiBlkPos] : defaultErrorScale );
+        d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
+        d64BaseCost              += pdCostCoeff0[ iScanPos ];
+      }
+      continue;
+    }
+
     cctx.initSubblock( subSetId );
 
     uint32_t maxNonZeroPosInCG = iCGSizeM1;
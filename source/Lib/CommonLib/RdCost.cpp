@@ -207,6 +207,9 @@ void RdCost::init()
   m_afpDistortFunc[DF_SAD_INTERMEDIATE_BITDEPTH] = RdCost::xGetSAD;
 
   m_afpDistortFunc[DF_SAD_WITH_MASK] = RdCost::xGetSADwMask;
+#if ENABLE_8BIT_REFERENCES
+  m_afpDistortFunc[DF_SAD_REF8] = RdCost::xGetSADRef8;
+#endif
 
 #if ENABLE_SIMD_OPT_DIST
 #ifdef TARGET_SIMD_X86
@@ -232,6 +235,9 @@ void RdCost::setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRef
 
   rcDP.cur.buf    = piRefY;
   rcDP.cur.stride = iRefStride;
+#if ENABLE_8BIT_REFERENCES
+  rcDP.cur8       = nullptr;
+#endif
 
   // set Block Width / Height
   rcDP.cur.width    = org.width;
@@ -514,6 +520,42 @@ Distortion RdCost::xGetSAD( const DistParam& rcDtParam )
   return ( uiSum >> distortionShift );
 }
 
+#if ENABLE_8BIT_REFERENCES
+Distortion RdCost::xGetSADRef8( const DistParam& rcDtParam )
+{
+  CHECK( rcDtParam.applyWeight, "No weighted SAD against 8-bit references" );
+
+  const Pel*     piOrg       = rcDtParam.org.buf;
+  const uint8_t* piCur       = rcDtParam.cur8;
+  const int      iCols       = rcDtParam.org.width;
+        int      iRows       = rcDtParam.org.height;
+  const int      iSubShift   = rcDtParam.subShift;
+  const int      iSubStep    = ( 1 << iSubShift );
+  const int      iStrideCur  = rcDtParam.cur.stride * iSubStep;
+  const int      iStrideOrg  = rcDtParam.org.stride * iSubStep;
+  const uint32_t distortionShift = DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+
+  Distortion uiSum = 0;
+
+  for( ; iRows != 0; iRows -= iSubStep )
+  {
+    for (int n = 0; n < iCols; n++ )
+    {
+      uiSum += abs( piOrg[n] - piCur[n] );
+    }
+    if (rcDtParam.maximumDistortionForEarlyExit < ( uiSum >> distortionShift ))
+    {
+      return ( uiSum >> distortionShift );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  uiSum <<= iSubShift;
+  return ( uiSum >> distortionShift );
+}
+#endif
+
 Distortion RdCost::xGetSAD4( const DistParam& rcDtParam )
 {
   if ( rcDtParam.applyWeight )
@@ -3496,6 +3538,18 @@ void RdCost::setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRef
   rcDP.distFunc = m_afpDistortFunc[ DF_SAD_WITH_MASK ];
 }
 
+#if ENABLE_8BIT_REFERENCES
+void RdCost::setDistParam( DistParam &rcDP, const CPelBuf &org, const uint8_t* piRefY, int iRefStride, int bitDepth, ComponentID compID, int subShiftMode )
+{
+  CHECK( rcDP.useMR, "No mean-removed SAD against 8-bit references" );
+
+  setDistParam( rcDP, org, static_cast<const Pel*>( nullptr ), iRefStride, bitDepth, compID, subShiftMode );
+
+  rcDP.cur8     = piRefY;
+  rcDP.distFunc = m_afpDistortFunc[ DF_SAD_REF8 ];
+}
+#endif
+
 Distortion RdCost::xGetSADwMask( const DistParam& rcDtParam )
 {
   if ( rcDtParam.applyWeight )
@@ -69,6 +69,9 @@ class DistParam
 public:
   CPelBuf               org;
   CPelBuf               cur;
+#if ENABLE_8BIT_REFERENCES
+  const uint8_t*        cur8;            // 8-bit reference samples read by DF_SAD_REF8, with the stride of cur
+#endif
 #if WCG_EXT
   CPelBuf               orgLuma;
 #endif
@@ -95,6 +98,9 @@ public:
   int                   cShiftY;
   DistParam() :
   org(), cur(),
+#if ENABLE_8BIT_REFERENCES
+  cur8( nullptr ),
+#endif
   mask( nullptr ),
   maskStride( 0 ),
   stepX(0),
@@ -180,6 +186,9 @@ public:
   void           setDistParam( DistParam &rcDP, const CPelBuf &org, const CPelBuf &cur, int bitDepth, ComponentID compID, bool useHadamard = false );
   void           setDistParam( DistParam &rcDP, const Pel* pOrg, const Pel* piRefY, int iOrgStride, int iRefStride, int bitDepth, ComponentID compID, int width, int height, int subShiftMode = 0, int step = 1, bool useHadamard = false, bool bioApplied = false );
   void           setDistParam( DistParam &rcDP, const CPelBuf &org, const Pel* piRefY, int iRefStride, const Pel* mask, int iMaskStride, int stepX, int iMaskStride2, int bitDepth,  ComponentID compID);
+#if ENABLE_8BIT_REFERENCES
+  void           setDistParam( DistParam &rcDP, const CPelBuf &org, const uint8_t* piRefY, int iRefStride, int bitDepth, ComponentID compID, int subShiftMode = 0 );
+#endif
 
   double         getMotionLambda          ( )  { return m_dLambdaMotionSAD; }
   void           selectMotionLambda       ( )  { m_motionLambda = getMotionLambda( ); }
@@ -361,6 +370,9 @@ private:
 
   static Distortion xGetSAD_full      ( const DistParam& pcDtParam );
   static Distortion xGetSADwMask      ( const DistParam& pcDtParam );
+#if ENABLE_8BIT_REFERENCES
+  static Distortion xGetSADRef8       ( const DistParam& pcDtParam );
+#endif
 
   static Distortion xGetMRSAD         ( const DistParam& pcDtParam );
   static Distortion xGetMRSAD4        ( const DistParam& pcDtParam );
@@ -406,6 +418,14 @@ private:
 #else
   template<X86_VEXT vext>
   static Distortion xGetHADs_SIMD   ( const DistParam& pcDtParam );
+#if WCG_EXT
+  template<X86_VEXT vext>
+  static Distortion xGetSSE_WTD_SIMD( const DistParam& pcDtParam );
+#endif
+#if ENABLE_8BIT_REFERENCES
+  template<X86_VEXT vext>
+  static Distortion xGetSADRef8_SIMD( const DistParam& pcDtParam );
+#endif
 #endif
 
   template< X86_VEXT vext >
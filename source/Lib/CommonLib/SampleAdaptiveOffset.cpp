@@ -113,15 +113,22 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
   m_numberOfComponents = 0;
+
+  m_offsetLineEO    = offsetLineEO;
+  m_offsetLineBO    = offsetLineBO;
+  m_calcStatsLineEO = calcStatsLineEO;
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  initSampleAdaptiveOffsetX86();
+#endif
+#endif
 }
 
 
 SampleAdaptiveOffset::~SampleAdaptiveOffset()
 {
   destroy();
-
-  m_signLineBuf1.clear();
-  m_signLineBuf2.clear();
 }
 
 void SampleAdaptiveOffset::create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift )
@@ -290,19 +297,57 @@ void SampleAdaptiveOffset::xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkP
 }
 
 
+void SampleAdaptiveOffset::offsetLineEO( const Pel* srcLine, Pel* resLine, const int offsetA, const int offsetB, const int startX, const int endX, const int* offset, const ClpRng& clpRng )
+{
+  for( int x = startX; x < endX; x++ )
+  {
+    const int edgeType = sgn( srcLine[x] - srcLine[x + offsetA] ) + sgn( srcLine[x] - srcLine[x + offsetB] );
+    resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng );
+  }
+}
+
+void SampleAdaptiveOffset::offsetLineBO( const Pel* srcLine, Pel* resLine, const int width, const int* offset, const int shiftBits, const ClpRng& clpRng )
+{
+  for( int x = 0; x < width; x++ )
+  {
+    resLine[x] = ClipPel<int>( srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
+  }
+}
+
+void SampleAdaptiveOffset::calcStatsLineEO( const Pel* srcLine, const Pel* orgLine, const int offsetA, const int offsetB, const int startX, const int endX, int64_t* diff, int64_t* count )
+{
+  for( int x = startX; x < endX; x++ )
+  {
+    const int edgeType = sgn( srcLine[x] - srcLine[x + offsetA] ) + sgn( srcLine[x] - srcLine[x + offsetB] );
+    diff [edgeType] += ( orgLine[x] - srcLine[x] );
+    count[edgeType] ++;
+  }
+}
+
 void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng& clpRng, int typeIdx, int* offset
                                           , const Pel* srcBlk, Pel* resBlk, int srcStride, int resStride,  int width, int height
                                           , bool isLeftAvail,  bool isRightAvail, bool isAboveAvail, bool isBelowAvail, bool isAboveLeftAvail, bool isAboveRightAvail, bool isBelowLeftAvail, bool isBelowRightAvail
                                           , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
   )
 {
-  int x,y, startX, startY, endX, endY, edgeType;
+  int y, startX, startY, endX, endY;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
-  int8_t signLeft, signRight, signDown;
+  const int numVer = isCtuCrossedByVirtualBoundaries ? numVerVirBndry : 0;
+  const int numHor = isCtuCrossedByVirtualBoundaries ? numHorVirBndry : 0;
 
   const Pel* srcLine = srcBlk;
         Pel* resLine = resBlk;
 
+  // the edge class of a sample follows from the signs towards its two neighbours at srcLine[x + offsetA] and
+  // srcLine[x + offsetB], samples next to a virtual boundary are left unchanged
+  auto offsetLine = [&]( const int lineY, const int lineStartX, const int lineEndX, const int offsetA, const int offsetB, const int lineNumVer, const int lineNumHor )
+  {
+    forEachEnabledSegment( lineY, lineStartX, lineEndX, lineNumVer, lineNumHor, verVirBndryPos, horVirBndryPos, [&]( const int segStartX, const int segEndX )
+    {
+      m_offsetLineEO( srcLine, resLine, offsetA, offsetB, segStartX, segEndX, offset, clpRng );
+    } );
+  };
+
   switch(typeIdx)
   {
   case SAO_TYPE_EO_0:
@@ -312,217 +357,65 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
       endX   = isRightAvail ? width : (width -1);
       for (y=0; y< height; y++)
       {
-        signLeft = (int8_t)sgn(srcLine[startX] - srcLine[startX-1]);
-        for (x=startX; x< endX; x++)
-        {
-          signRight = (int8_t)sgn(srcLine[x] - srcLine[x+1]);
-          if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y, numVerVirBndry, 0, verVirBndryPos, horVirBndryPos))
-          {
-            signLeft = -signRight;
-            continue;
-          }
-          edgeType =  signRight + signLeft;
-          signLeft  = -signRight;
-
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-        }
+        offsetLine( y, startX, endX, -1, 1, numVer, 0 );
         srcLine  += srcStride;
         resLine += resStride;
       }
-
     }
     break;
   case SAO_TYPE_EO_90:
     {
       offset += 2;
-      int8_t *signUpLine = &m_signLineBuf1[0];
-
       startY = isAboveAvail ? 0 : 1;
       endY   = isBelowAvail ? height : height-1;
-      if (!isAboveAvail)
-      {
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-
-      const Pel* srcLineAbove= srcLine- srcStride;
-      for (x=0; x< width; x++)
-      {
-        signUpLine[x] = (int8_t)sgn(srcLine[x] - srcLineAbove[x]);
-      }
-
-      const Pel* srcLineBelow;
+      srcLine += startY * srcStride;
+      resLine += startY * resStride;
       for (y=startY; y<endY; y++)
       {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=0; x< width; x++)
-        {
-          signDown  = (int8_t)sgn(srcLine[x] - srcLineBelow[x]);
-          if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y, 0, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-          {
-            signUpLine[x] = -signDown;
-            continue;
-          }
-          edgeType = signDown + signUpLine[x];
-          signUpLine[x]= -signDown;
-
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-        }
+        offsetLine( y, 0, width, -srcStride, srcStride, 0, numHor );
         srcLine += srcStride;
         resLine += resStride;
       }
-
     }
     break;
   case SAO_TYPE_EO_135:
     {
       offset += 2;
-      int8_t *signUpLine, *signDownLine, *signTmpLine;
-
-      signUpLine  = &m_signLineBuf1[0];
-      signDownLine= &m_signLineBuf2[0];
-
       startX = isLeftAvail ? 0 : 1 ;
       endX   = isRightAvail ? width : (width-1);
 
-      //prepare 2nd line's upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX; x< endX+1; x++)
-      {
-        signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x- 1]);
-      }
-
-      //1st line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveLeftAvail ? 0 : 1;
       firstLineEndX   = isAboveAvail? endX: 1;
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, 0, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-        {
-          continue;
-        }
-        edgeType  =  sgn(srcLine[x] - srcLineAbove[x- 1]) - signUpLine[x+1];
-
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine  += srcStride;
-      resLine  += resStride;
-
-
-      //middle lines
-      for (y= 1; y< height-1; y++)
+      lastLineStartX  = isBelowAvail ? startX : (width -1);
+      lastLineEndX    = isBelowRightAvail ? width : (width -1);
+      for (y=0; y< height; y++)
       {
-        srcLineBelow= srcLine+ srcStride;
-
-        for (x=startX; x<endX; x++)
-        {
-          signDown =  (int8_t)sgn(srcLine[x] - srcLineBelow[x+ 1]);
-          if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-          {
-            signDownLine[x + 1] = -signDown;
-            continue;
-          }
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-          signDownLine[x+1] = -signDown;
-        }
-        signDownLine[startX] = (int8_t)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-        signTmpLine  = signUpLine;
-        signUpLine   = signDownLine;
-        signDownLine = signTmpLine;
-
+        const int lineStartX = y == 0 ? firstLineStartX : ( y == height - 1 ? lastLineStartX : startX );
+        const int lineEndX   = y == 0 ? firstLineEndX   : ( y == height - 1 ? lastLineEndX   : endX   );
+        offsetLine( y, lineStartX, lineEndX, -srcStride - 1, srcStride + 1, numVer, numHor );
         srcLine += srcStride;
         resLine += resStride;
       }
-
-      //last line
-      srcLineBelow= srcLine+ srcStride;
-      lastLineStartX = isBelowAvail ? startX : (width -1);
-      lastLineEndX   = isBelowRightAvail ? width : (width -1);
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, height - 1, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-        {
-          continue;
-        }
-        edgeType =  sgn(srcLine[x] - srcLineBelow[x+ 1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng);
-
-      }
     }
     break;
   case SAO_TYPE_EO_45:
     {
       offset += 2;
-      int8_t *signUpLine = &m_signLineBuf1[1];
-
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
 
-      //prepare 2nd line upper sign
-      const Pel* srcLineBelow= srcLine+ srcStride;
-      for (x=startX-1; x< endX; x++)
-      {
-        signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x+1]);
-      }
-
-
-      //first line
-      const Pel* srcLineAbove= srcLine- srcStride;
       firstLineStartX = isAboveAvail ? startX : (width -1 );
       firstLineEndX   = isAboveRightAvail ? width : (width-1);
-      for(x= firstLineStartX; x< firstLineEndX; x++)
-      {
-        if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, 0, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-        {
-          continue;
-        }
-        edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) -signUpLine[x-1];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-      }
-      srcLine += srcStride;
-      resLine += resStride;
-
-      //middle lines
-      for (y= 1; y< height-1; y++)
+      lastLineStartX  = isBelowLeftAvail ? 0 : 1;
+      lastLineEndX    = isBelowAvail ? endX : 1;
+      for (y=0; y< height; y++)
       {
-        srcLineBelow= srcLine+ srcStride;
-
-        for(x= startX; x< endX; x++)
-        {
-          signDown =  (int8_t)sgn(srcLine[x] - srcLineBelow[x-1]);
-          if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-          {
-            signUpLine[x - 1] = -signDown;
-            continue;
-          }
-          edgeType =  signDown + signUpLine[x];
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-          signUpLine[x-1] = -signDown;
-        }
-        signUpLine[endX-1] = (int8_t)sgn(srcLineBelow[endX-1] - srcLine[endX]);
-        srcLine  += srcStride;
+        const int lineStartX = y == 0 ? firstLineStartX : ( y == height - 1 ? lastLineStartX : startX );
+        const int lineEndX   = y == 0 ? firstLineEndX   : ( y == height - 1 ? lastLineEndX   : endX   );
+        offsetLine( y, lineStartX, lineEndX, -srcStride + 1, srcStride - 1, numVer, numHor );
+        srcLine += srcStride;
         resLine += resStride;
       }
-
-      //last line
-      srcLineBelow= srcLine+ srcStride;
-      lastLineStartX = isBelowLeftAvail ? 0 : 1;
-      lastLineEndX   = isBelowAvail ? endX : 1;
-      for(x= lastLineStartX; x< lastLineEndX; x++)
-      {
-        if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, height - 1, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-        {
-          continue;
-        }
-        edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + signUpLine[x];
-        resLine[x] = ClipPel<int>(srcLine[x] + offset[edgeType], clpRng);
-
-      }
     }
     break;
   case SAO_TYPE_BO:
@@ -530,10 +423,7 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
       const int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
       for (y=0; y< height; y++)
       {
-        for (x=0; x< width; x++)
-        {
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
-        }
+        m_offsetLineBO( srcLine, resLine, width, offset, shiftBits, clpRng );
         srcLine += srcStride;
         resLine += resStride;
       }
@@ -567,13 +457,6 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
   //block boundary availability
   deriveLoopFilterBoundaryAvailibility(cs, area.Y(), isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
 
-  const size_t lineBufferSize = area.Y().width + 1;
-  if (m_signLineBuf1.size() < lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   int numHorVirBndry = 0, numVerVirBndry = 0;
   int horVirBndryPos[] = { -1,-1,-1 };
   int verVirBndryPos[] = { -1,-1,-1 };
@@ -617,54 +500,87 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
 
 void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                                       )
+{
+  if( !prepareCtuRows( cs, saoBlkParams ) )
+  {
+    return;
+  }
+
+  m_tempBuf.copyFrom( cs.getRecoBuf() );
+
+  for( int ctuRow = 0; ctuRow < cs.pcv->heightInCtus; ctuRow++ )
+  {
+    offsetCtuRow( cs, ctuRow );
+  }
+
+  DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", cs.slice->getPOC())));
+  DTRACE_PIC_COMP(D_REC_CB_LUMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Y);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cb);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cr);
+
+  DTRACE    ( g_trace_ctx, D_CRC, "SAO" );
+  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+
+}
+
+
+bool SampleAdaptiveOffset::prepareCtuRows( CodingStructure& cs, SAOBlkParam* saoBlkParams )
 {
   CHECK(!saoBlkParams, "No parameters present");
 
   xReconstructBlkSAOParams(cs, saoBlkParams);
 
   const uint32_t numberOfComponents = getNumberValidComponents(cs.area.chromaFormat);
-  bool bAllDisabled = true;
   for (uint32_t compIdx = 0; compIdx < numberOfComponents; compIdx++)
   {
     if (m_picSAOEnabled[compIdx])
     {
-      bAllDisabled = false;
+      return true;
     }
   }
-  if (bAllDisabled)
+  return false;
+}
+
+void SampleAdaptiveOffset::prepareCtuRow( CodingStructure& cs, SAOBlkParam* saoBlkParams, const int ctuRow )
+{
+  const int firstCtuRsAddr = ctuRow * cs.pcv->widthInCtus;
+  for( int ctuRsAddr = firstCtuRsAddr; ctuRsAddr < firstCtuRsAddr + cs.pcv->widthInCtus; ctuRsAddr++ )
   {
-    return;
+    SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
+    getMergeList( cs, ctuRsAddr, saoBlkParams, mergeList );
+
+    reconstructBlkSAOParam( saoBlkParams[ctuRsAddr], mergeList );
   }
+}
 
+void SampleAdaptiveOffset::copyCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const uint32_t yPos   = ctuRow * pcv.maxCUHeight;
+  const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+  const UnitArea rowArea( cs.area.chromaFormat, Area( 0, yPos, pcv.lumaWidth, height ) );
+
+  m_tempBuf.subBuf( rowArea ).copyFrom( cs.getRecoBuf( rowArea ) );
+}
+
+void SampleAdaptiveOffset::offsetCtuRow( CodingStructure& cs, const int ctuRow )
+{
   const PreCalcValues& pcv = *cs.pcv;
   PelUnitBuf rec = cs.getRecoBuf();
-  m_tempBuf.copyFrom( rec );
 
-  int ctuRsAddr = 0;
-  for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  const uint32_t yPos   = ctuRow * pcv.maxCUHeight;
+  const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+  int ctuRsAddr = ctuRow * pcv.widthInCtus;
+  for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
   {
-    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+    const uint32_t width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
 
-      offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
-      ctuRsAddr++;
-    }
+    offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
+    ctuRsAddr++;
   }
-
-  DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", cs.slice->getPOC())));
-  DTRACE_PIC_COMP(D_REC_CB_LUMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Y);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cb);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cr);
-
-  DTRACE    ( g_trace_ctx, D_CRC, "SAO" );
-  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
-
 }
 
-
 void SampleAdaptiveOffset::deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos,
   bool& isLeftAvail,
   bool& isRightAvail,
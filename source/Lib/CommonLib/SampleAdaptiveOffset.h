@@ -67,10 +67,23 @@ public:
   virtual ~SampleAdaptiveOffset();
   void SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                    );
+  /// CTU-row-wise SAO for filtering the rows of a picture on several threads, returns whether SAO is applied to the picture
+  bool prepareCtuRows( CodingStructure& cs, SAOBlkParam* saoBlkParams );
+  /// resolves the merged parameters of one CTU row instead, for rows filtered while the CTUs below are still decoded, the rows have to be prepared from the top
+  void prepareCtuRow ( CodingStructure& cs, SAOBlkParam* saoBlkParams, const int ctuRow );
+  /// copies a deblocked CTU row to the source buffer, the rows above and below an offset row have to be copied beforehand
+  void copyCtuRow    ( CodingStructure& cs, const int ctuRow );
+  void offsetCtuRow  ( CodingStructure& cs, const int ctuRow );
   void create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift );
   void destroy();
   static int getMaxOffsetQVal(const int channelBitDepth) { return (1<<(std::min<int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
   void setReshaper(Reshape * p) { m_pcReshape = p; }
+
+#ifdef TARGET_SIMD_X86
+  void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
 protected:
   void deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos,
     bool& isLeftAvail,
@@ -93,35 +106,56 @@ protected:
   void offsetCTU(const UnitArea& area, const CPelUnitBuf& src, PelUnitBuf& res, SAOBlkParam& saoblkParam, CodingStructure& cs);
   void xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkParam* saoBlkParams);
   bool isCrossedByVirtualBoundaries(const int xPos, const int yPos, const int width, const int height, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], const PicHeader* picHeader);
-  inline bool isProcessDisabled(int xPos, int yPos, int numVerVirBndry, int numHorVirBndry, int verVirBndryPos[], int horVirBndryPos[])
+  /// calls func( segStartX, segEndX ) for the parts of [startX, endX) in line y that are not next to a virtual boundary
+  template<typename F>
+  static void forEachEnabledSegment( const int y, const int startX, const int endX, const int numVerVirBndry, const int numHorVirBndry, const int verVirBndryPos[], const int horVirBndryPos[], F func )
   {
-    bool bDisabledFlag = false;
-    for (int i = 0; i < numVerVirBndry; i++)
+    for( int i = 0; i < numHorVirBndry; i++ )
     {
-      if ((xPos == verVirBndryPos[i]) || (xPos == verVirBndryPos[i] - 1))
+      if( ( y == horVirBndryPos[i] ) || ( y == horVirBndryPos[i] - 1 ) )
       {
-        bDisabledFlag = true;
-        break;
+        return;
       }
     }
-    for (int i = 0; i < numHorVirBndry; i++)
+    int segStartX = startX;
+    while( segStartX < endX )
     {
-      if ((yPos == horVirBndryPos[i]) || (yPos == horVirBndryPos[i] - 1))
+      int segEndX = endX;
+      for( int i = 0; i < numVerVirBndry; i++ )
+      {
+        for( int x = verVirBndryPos[i] - 1; x <= verVirBndryPos[i]; x++ )
+        {
+          if( x >= segStartX && x < segEndX )
+          {
+            segEndX = x;
+          }
+        }
+      }
+      if( segEndX > segStartX )
       {
-        bDisabledFlag = true;
-        break;
+        func( segStartX, segEndX );
       }
+      segStartX = segEndX + 1;
     }
-    return bDisabledFlag;
   }
+
+  static void offsetLineEO   ( const Pel* srcLine, Pel* resLine, const int offsetA, const int offsetB, const int startX, const int endX, const int* offset, const ClpRng& clpRng );
+  static void offsetLineBO   ( const Pel* srcLine, Pel* resLine, const int width, const int* offset, const int shiftBits, const ClpRng& clpRng );
+  static void calcStatsLineEO( const Pel* srcLine, const Pel* orgLine, const int offsetA, const int offsetB, const int startX, const int endX, int64_t* diff, int64_t* count );
+
+  /// edge offset of the samples [startX, endX) of a line, the neighbours of srcLine[x] are srcLine[x + offsetA] and srcLine[x + offsetB], offset is centred on the edge class 0
+  void ( *m_offsetLineEO    )( const Pel* srcLine, Pel* resLine, const int offsetA, const int offsetB, const int startX, const int endX, const int* offset, const ClpRng& clpRng );
+  /// band offset of the samples [0, width) of a line
+  void ( *m_offsetLineBO    )( const Pel* srcLine, Pel* resLine, const int width, const int* offset, const int shiftBits, const ClpRng& clpRng );
+  /// accumulates the edge offset statistics of the samples [startX, endX) of a line, diff and count are centred on the edge class 0
+  void ( *m_calcStatsLineEO )( const Pel* srcLine, const Pel* orgLine, const int offsetA, const int offsetB, const int startX, const int endX, int64_t* diff, int64_t* count );
+
   Reshape* m_pcReshape;
 protected:
   uint32_t m_offsetStepLog2[MAX_NUM_COMPONENT]; //offset step
   PelStorage m_tempBuf;
   uint32_t m_numberOfComponents;
 
-  std::vector<int8_t> m_signLineBuf1;
-  std::vector<int8_t> m_signLineBuf2;
 private:
   bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
@@ -79,12 +79,18 @@ public:
   );
   void getTrTypes(const TransformUnit tu, const ComponentID compID, int &trTypeHor, int &trTypeVer);
 
-  void fwdLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize );
-  void invLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize, const int maxLog2TrDynamicRange );
+  static void fwdLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize );
+  static void invLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize, const int maxLog2TrDynamicRange );
 
   uint32_t getLFNSTIntraMode( int wideAngPredMode );
   bool     getTransposeFlag ( uint32_t intraMode  );
 
+#ifdef TARGET_SIMD_X86
+  void initTrQuantX86();
+  template <X86_VEXT vext>
+  void _initTrQuantX86();
+#endif
+
 protected:
 
   void xFwdLfnst( const TransformUnit &tu, const ComponentID compID, const bool loadTr = false );
@@ -118,6 +124,12 @@ public:
 protected:
   TCoeff   m_tempCoeff[MAX_TB_SIZEY * MAX_TB_SIZEY];
 
+  FwdTrans* m_fwdTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];   ///< 1-D forward transforms, indexed by type and log2 size minus 1
+  InvTrans* m_invTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];   ///< 1-D inverse transforms, indexed by type and log2 size minus 1
+
+  void ( *m_fwdLfnst )( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize );                                  ///< forward LFNST matrix product
+  void ( *m_invLfnst )( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize, const int maxLog2TrDynamicRange ); ///< inverse LFNST matrix product
+
 private:
   DepQuant *m_quant;          //!< Quantizer
   TCoeff    m_mtsCoeffs[NUM_TRAFO_MODES_MTS][MAX_TB_SIZEY * MAX_TB_SIZEY];
@@ -47,6 +47,7 @@
 #include <sstream>
 #include <cstddef>
 #include <cstring>
+#include <new>
 #include <assert.h>
 #include <cassert>
 
@@ -125,6 +126,10 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_TRACING                                    0 // DISABLE by default (enable only when debugging, requires 15% run-time in decoding) -- see documentation in 'doc/DTrace for NextSoftware.pdf'
 #endif
 
+#ifndef ENABLE_8BIT_REFERENCES
+#define ENABLE_8BIT_REFERENCES                            0 // DISABLE by default, when enabled the encoder keeps the reference pictures of 8-bit sequences in 8-bit sample planes
+#endif
+
 #if ENABLE_TRACING
 #define K0149_BLOCK_STATISTICS                            1 // enables block statistics, which can be analysed with YUView (https://github.com/IENT/YUView)
 #if K0149_BLOCK_STATISTICS
@@ -201,6 +206,13 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_TRAFO                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the forward and inverse core transforms, no impact on RD performance
+#define ENABLE_SIMD_OPT_DBLF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for SAO offsetting and statistics, no impact on RD performance
+#define ENABLE_SIMD_OPT_INTRA                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for intra prediction, no impact on RD performance
+#define ENABLE_SIMD_OPT_MIP                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for matrix-based intra prediction, no impact on RD performance
+#define ENABLE_SIMD_OPT_DEPQUANT                        ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the dependent quantization trellis, no impact on RD performance
+#define ENABLE_SIMD_OPT_QUANT                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for quantization and dequantization, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for Bcw
 #endif
@@ -550,7 +562,8 @@ enum DFunc
   DF_SAD_INTERMEDIATE_BITDEPTH = 63,
 
   DF_SAD_WITH_MASK   = 64,
-  DF_TOTAL_FUNCTIONS = 65
+  DF_SAD_REF8        = 65,            ///< general size SAD against an 8-bit reference plane
+  DF_TOTAL_FUNCTIONS = 66
 };
 
 /// motion vector predictor direction used in AMVP
@@ -1237,6 +1250,12 @@ template<typename T>
 class dynamic_cache
 {
   std::vector<T*> m_cache;
+  std::vector<T*> m_chunks;
+  size_t          m_numConstructed = 0;   ///< objects constructed in the chunks so far
+  size_t          m_next           = 0;   ///< next object of the chunks to hand out, rewound by reset()
+
+  // objects are carved out of contiguous chunks of about 64 KiB instead of being allocated one by one
+  static size_t chunkSize() { return sizeof( T ) < ( 1 << 16 ) ? ( 1 << 16 ) / sizeof( T ) : 1; }
 
 public:
   ~dynamic_cache()
@@ -1244,17 +1263,31 @@ public:
     deleteEntries();
   }
 
+  // destroys all objects ever handed out, whether they have been returned to the cache or not
   void deleteEntries()
   {
-    for( auto &p : m_cache )
+    for( size_t n = 0; n < m_numConstructed; n++ )
     {
-      delete p;
-      p = nullptr;
+      m_chunks[n / chunkSize()][n % chunkSize()].~T();
+    }
+    for( T* chunk : m_chunks )
+    {
+      ::operator delete( chunk );
     }
 
+    m_chunks.clear();
+    m_numConstructed = 0;
+    m_next           = 0;
     m_cache.clear();
   }
 
+  // makes every object handed out available again in chunk order, no structure may hold one of them any more
+  void reset()
+  {
+    m_cache.clear();
+    m_next = 0;
+  }
+
   T* get()
   {
     T* ret;
@@ -1266,7 +1299,19 @@ public:
     }
     else
     {
-      ret = new T;
+      if( m_next == m_numConstructed )
+      {
+        if( m_numConstructed == m_chunks.size() * chunkSize() )
+        {
+          m_chunks.push_back( static_cast<T*>( ::operator new( chunkSize() * sizeof( T ) ) ) );
+        }
+
+        new( m_chunks.back() + m_numConstructed % chunkSize() ) T;
+        m_numConstructed++;
+      }
+
+      ret = m_chunks[m_next / chunkSize()] + m_next % chunkSize();
+      m_next++;
     }
 
     return ret;
@@ -1279,7 +1324,8 @@ public:
 
   void cache( std::vector<T*>& vel )
   {
-    m_cache.insert( m_cache.end(), vel.begin(), vel.end() );
+    // reversed, so the units of a structure are handed out again in their original (memory) order
+    m_cache.insert( m_cache.end(), vel.rbegin(), vel.rend() );
     vel.clear();
   }
 };
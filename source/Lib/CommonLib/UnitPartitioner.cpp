@@ -159,6 +159,8 @@ void Partitioner::copyState( const Partitioner& other )
   currImplicitBtDepth
               = other.currImplicitBtDepth;
   chType      = other.chType;
+  treeType    = other.treeType;
+  modeType    = other.modeType;
 #ifdef _DEBUG
   m_currArea  = other.m_currArea;
 #endif
@@ -962,7 +964,7 @@ void PartitionerImpl::getTUIntraSubPartitions( Partitioning &sub, const UnitArea
   uint32_t nPartitions;
   uint32_t splitDimensionSize = CU::getISPSplitDim( tuArea.lumaSize().width, tuArea.lumaSize().height, splitType );
 
-  bool isDualTree = CS::isDualITree( cs ) || cs.treeType != TREE_D;
+  bool isDualTree = CS::isDualITree( cs ) || cs.getTreeType() != TREE_D;
 
   if( splitType == TU_1D_HORZ_SPLIT )
   {
@@ -59,9 +59,15 @@ bool CS::isDualITree( const CodingStructure &cs )
   return cs.slice->isIntra() && !cs.pcv->ISingleTree;
 }
 
+// the encoder keeps the luma units of a local dual tree in its temporary structures while it searches the chroma
+const CodingStructure& CS::getLumaCS( const CodingStructure &cs )
+{
+  return cs.lumaCS ? *cs.lumaCS : *cs.picture->cs;
+}
+
 UnitArea CS::getArea( const CodingStructure &cs, const UnitArea &area, const ChannelType chType )
 {
-  return isDualITree( cs ) || cs.treeType != TREE_D ? area.singleChan( chType ) : area;
+  return isDualITree( cs ) || cs.getTreeType() != TREE_D ? area.singleChan( chType ) : area;
 }
 
 void CS::setRefinedMotionField(CodingStructure &cs)
@@ -399,7 +405,7 @@ void CU::saveMotionInHMVP( const CodingUnit& cu, const bool isToBeDone )
     bool enableHmvp = ((xBr >> log2ParallelMergeLevel) > (pu.cu->Y().x >> log2ParallelMergeLevel)) && ((yBr >> log2ParallelMergeLevel) > (pu.cu->Y().y >> log2ParallelMergeLevel));
     bool enableInsertion = CU::isIBC(cu) || enableHmvp;
     if (enableInsertion)
-    cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->motionLut.lutIbc : cu.cs->motionLut.lut, mi);
+    cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->getMotionLut().lutIbc : cu.cs->getMotionLut().lut, mi);
   }
 }
 
@@ -817,7 +823,7 @@ const PredictionUnit &PU::getCoLocatedLumaPU(const PredictionUnit &pu)
   Position              topLeftPos = pu.blocks[pu.chType].lumaPos();
   Position              refPos     = topLeftPos.offset(pu.blocks[pu.chType].lumaSize().width  >> 1,
                                                        pu.blocks[pu.chType].lumaSize().height >> 1);
-  const PredictionUnit &lumaPU     = pu.cu->isSepTree() ? *pu.cs->picture->cs->getPU(refPos, CHANNEL_TYPE_LUMA)
+  const PredictionUnit &lumaPU     = pu.cu->isSepTree() ? *CS::getLumaCS(*pu.cs).getPU(refPos, CHANNEL_TYPE_LUMA)
                                                         : *pu.cs->getPU(topLeftPos, CHANNEL_TYPE_LUMA);
 
   return lumaPU;
@@ -869,7 +875,7 @@ bool PU::addMergeHMVPCand(const CodingStructure &cs, MergeCtx &mrgCtx, const int
   const Slice& slice = *cs.slice;
   MotionInfo miNeighbor;
 
-  auto &lut = ibcFlag ? cs.motionLut.lutIbc : cs.motionLut.lut;
+  auto &lut = ibcFlag ? cs.getMotionLut().lutIbc : cs.getMotionLut().lut;
   int num_avai_candInLUT = (int)lut.size();
 
 #if GDR_ENABLED
@@ -2091,10 +2097,10 @@ void PU::getIbcMVPsEncOnly(PredictionUnit &pu, Mv* mvPred, int& nbPred)
     }
   }
 
-  size_t numAvaiCandInLUT = pu.cs->motionLut.lutIbc.size();
+  size_t numAvaiCandInLUT = pu.cs->getMotionLut().lutIbc.size();
   for (uint32_t cand = 0; cand < numAvaiCandInLUT && nbPred < IBC_NUM_CANDIDATES; cand++)
   {
-    MotionInfo neibMi = pu.cs->motionLut.lutIbc[cand];
+    MotionInfo neibMi = pu.cs->getMotionLut().lutIbc[cand];
     if (isAddNeighborMv(neibMi.bv, mvPred, nbPred))
     {
       mvPred[nbPred++] = neibMi.bv;
@@ -3079,7 +3085,7 @@ void PU::addAMVPHMVPCand(const PredictionUnit &pu, const RefPicList eRefPicList,
   const Slice &slice = *(*pu.cs).slice;
 
   MotionInfo neibMi;
-  auto &lut = CU::isIBC(*pu.cu) ? pu.cs->motionLut.lutIbc : pu.cs->motionLut.lut;
+  auto &lut = CU::isIBC(*pu.cu) ? pu.cs->getMotionLut().lutIbc : pu.cs->getMotionLut().lut;
   int num_avai_candInLUT = (int) lut.size();
   int num_allowedCand = std::min(MAX_NUM_HMVP_AVMPCANDS, num_avai_candInLUT);
   const RefPicList eRefPicList2nd = (eRefPicList == REF_PIC_LIST_0) ? REF_PIC_LIST_1 : REF_PIC_LIST_0;
@@ -49,6 +49,7 @@ namespace CS
   uint64_t getEstBits                   ( const CodingStructure &cs );
   UnitArea getArea                    ( const CodingStructure &cs, const UnitArea &area, const ChannelType chType );
   bool   isDualITree                  ( const CodingStructure &cs );
+  const CodingStructure& getLumaCS    ( const CodingStructure &cs );
   void   setRefinedMotionField(CodingStructure &cs);
 }
 
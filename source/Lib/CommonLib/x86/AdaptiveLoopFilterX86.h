@@ -1669,6 +1669,222 @@ static void simdFilter7x7Blk(AlfClassifier **classifier, const PelUnitBuf &recDs
     dst += dstStride * STEP_Y;
   }
 }
+
+#ifdef USE_AVX512
+template<X86_VEXT vext>
+static void simdFilter7x7Blk_AVX512(AlfClassifier **classifier, const PelUnitBuf &recDst, const CPelUnitBuf &recSrc,
+  const Area &blkDst, const Area &blk, const ComponentID compId, const short *filterSet,
+  const Pel *fClipSet, const ClpRng &clpRng, CodingStructure &cs, const int vbCTUHeight,
+  int vbPos)
+{
+  CHECK((vbCTUHeight & (vbCTUHeight - 1)) != 0, "vbCTUHeight must be a power of 2");
+  CHECK(isChroma(compId), "7x7 ALF filter is meant for luma only");
+
+
+  const CPelBuf srcBuffer = recSrc.get(compId);
+  PelBuf        dstBuffer = recDst.get(compId);
+
+  const size_t srcStride = srcBuffer.stride;
+  const size_t dstStride = dstBuffer.stride;
+
+  constexpr int SHIFT = AdaptiveLoopFilter::m_NUM_BITS - 1;
+  constexpr int ROUND = 1 << (SHIFT - 1);
+
+  constexpr size_t STEP_X = 32;
+  constexpr size_t STEP_Y = 4;
+
+  const size_t width  = blk.width & ~(STEP_X - 1);
+  const size_t height = blk.height;
+
+  CHECK(blk.y % STEP_Y, "Wrong startHeight in filtering");
+  CHECK(blk.x % 8, "Wrong startWidth in filtering");
+  CHECK(height % STEP_Y, "Wrong endHeight in filtering");
+  CHECK(blk.width % 8, "Wrong endWidth in filtering");
+
+  const Pel *src = srcBuffer.buf + blk.y * srcStride + blk.x;
+  Pel *      dst = dstBuffer.buf + blkDst.y * dstStride + blkDst.x;
+
+  const __m512i mmOffset = _mm512_set1_epi32(ROUND);
+  const __m512i mmOffset1 = _mm512_set1_epi32((1 << ((SHIFT + 3) - 1)) - ROUND);
+  const __m512i mmMin = _mm512_set1_epi16( clpRng.min );
+  const __m512i mmMax = _mm512_set1_epi16( clpRng.max );
+
+
+  for (size_t i = 0; i < height; i += STEP_Y)
+  {
+    const AlfClassifier *pClass = classifier[blkDst.y + i] + blkDst.x;
+
+    for (size_t j = 0; j < width; j += STEP_X)
+    {
+      // each 128-bit lane covers 8 pixels, i.e. two 4x4 classification blocks:
+      // the even block goes with the unpacklo half (A) and the odd one with the unpackhi half (B)
+      __m512i params[2][2][6];
+
+      for (int k = 0; k < 8; ++k)
+      {
+        const AlfClassifier &cl = pClass[j + 4 * k];
+
+        const int transposeIdx = cl.transposeIdx;
+        const int classIdx     = cl.classIdx;
+
+        static_assert(sizeof(*filterSet) == 2, "ALF coeffs must be 16-bit wide");
+        static_assert(sizeof(*fClipSet) == 2, "ALF clip values must be 16-bit wide");
+
+        const __m128i rawCoeff0 = _mm_loadu_si128((const __m128i *) (filterSet + classIdx * MAX_NUM_ALF_LUMA_COEFF));
+        const __m128i rawCoeff1 = _mm_loadl_epi64((const __m128i *) (filterSet + classIdx * MAX_NUM_ALF_LUMA_COEFF + 8));
+
+        const __m128i rawClip0 = _mm_loadu_si128((const __m128i *) (fClipSet + classIdx * MAX_NUM_ALF_LUMA_COEFF));
+        const __m128i rawClip1 = _mm_loadl_epi64((const __m128i *) (fClipSet + classIdx * MAX_NUM_ALF_LUMA_COEFF + 8));
+
+        const __m128i s0 = _mm_loadu_si128((const __m128i *) shuffleTab[transposeIdx][0]);
+        const __m128i s1 = _mm_xor_si128(s0, _mm_set1_epi8((char) 0x80));
+        const __m128i s2 = _mm_loadu_si128((const __m128i *) shuffleTab[transposeIdx][1]);
+        const __m128i s3 = _mm_xor_si128(s2, _mm_set1_epi8((char) 0x80));
+
+        const __m128i rawCoeffLo = _mm_or_si128(_mm_shuffle_epi8(rawCoeff0, s0), _mm_shuffle_epi8(rawCoeff1, s1));
+        const __m128i rawCoeffHi = _mm_or_si128(_mm_shuffle_epi8(rawCoeff0, s2), _mm_shuffle_epi8(rawCoeff1, s3));
+        const __m128i rawClipLo  = _mm_or_si128(_mm_shuffle_epi8(rawClip0, s0), _mm_shuffle_epi8(rawClip1, s1));
+        const __m128i rawClipHi  = _mm_or_si128(_mm_shuffle_epi8(rawClip0, s2), _mm_shuffle_epi8(rawClip1, s3));
+
+        const __m128i blkParams[2][6] = {
+          { _mm_shuffle_epi32(rawCoeffLo, 0x00), _mm_shuffle_epi32(rawCoeffLo, 0x55), _mm_shuffle_epi32(rawCoeffLo, 0xaa),
+            _mm_shuffle_epi32(rawCoeffLo, 0xff), _mm_shuffle_epi32(rawCoeffHi, 0x00), _mm_shuffle_epi32(rawCoeffHi, 0x55) },
+          { _mm_shuffle_epi32(rawClipLo, 0x00), _mm_shuffle_epi32(rawClipLo, 0x55), _mm_shuffle_epi32(rawClipLo, 0xaa),
+            _mm_shuffle_epi32(rawClipLo, 0xff), _mm_shuffle_epi32(rawClipHi, 0x00), _mm_shuffle_epi32(rawClipHi, 0x55) }
+        };
+
+        for (int p = 0; p < 2; p++)
+        {
+          for (int c = 0; c < 6; c++)
+          {
+            switch (k >> 1)
+            {
+            case 0: params[k & 1][p][c] = _mm512_castsi128_si512(blkParams[p][c]); break;
+            case 1: params[k & 1][p][c] = _mm512_inserti32x4(params[k & 1][p][c], blkParams[p][c], 1); break;
+            case 2: params[k & 1][p][c] = _mm512_inserti32x4(params[k & 1][p][c], blkParams[p][c], 2); break;
+            default: params[k & 1][p][c] = _mm512_inserti32x4(params[k & 1][p][c], blkParams[p][c], 3); break;
+            }
+          }
+        }
+      }
+
+      for (size_t ii = 0; ii < STEP_Y; ii++)
+      {
+        const Pel *pImg0, *pImg1, *pImg2, *pImg3, *pImg4, *pImg5, *pImg6;
+
+        pImg0 = src + j + ii * srcStride;
+        pImg1 = pImg0 + srcStride;
+        pImg2 = pImg0 - srcStride;
+        pImg3 = pImg1 + srcStride;
+        pImg4 = pImg2 - srcStride;
+        pImg5 = pImg3 + srcStride;
+        pImg6 = pImg4 - srcStride;
+
+        const int yVb = (blkDst.y + i + ii) & (vbCTUHeight - 1);
+        if (yVb < vbPos && (yVb >= vbPos - 4))   // above
+        {
+          pImg1 = (yVb == vbPos - 1) ? pImg0 : pImg1;
+          pImg3 = (yVb >= vbPos - 2) ? pImg1 : pImg3;
+          pImg5 = (yVb >= vbPos - 3) ? pImg3 : pImg5;
+
+          pImg2 = (yVb == vbPos - 1) ? pImg0 : pImg2;
+          pImg4 = (yVb >= vbPos - 2) ? pImg2 : pImg4;
+          pImg6 = (yVb >= vbPos - 3) ? pImg4 : pImg6;
+        }
+        else if (yVb >= vbPos && (yVb <= vbPos + 3))   // bottom
+        {
+          pImg2 = (yVb == vbPos) ? pImg0 : pImg2;
+          pImg4 = (yVb <= vbPos + 1) ? pImg2 : pImg4;
+          pImg6 = (yVb <= vbPos + 2) ? pImg4 : pImg6;
+
+          pImg1 = (yVb == vbPos) ? pImg0 : pImg1;
+          pImg3 = (yVb <= vbPos + 1) ? pImg1 : pImg3;
+          pImg5 = (yVb <= vbPos + 2) ? pImg3 : pImg5;
+        }
+        __m512i cur = _mm512_loadu_si512((const __m512i *) pImg0);
+
+        __m512i accumA = mmOffset;
+        __m512i accumB = mmOffset;
+
+        auto process2coeffs = [&](const int i, const Pel *ptr0, const Pel *ptr1, const Pel *ptr2, const Pel *ptr3) {
+          const __m512i val00 = _mm512_sub_epi16(_mm512_loadu_si512((const __m512i *) ptr0), cur);
+          const __m512i val10 = _mm512_sub_epi16(_mm512_loadu_si512((const __m512i *) ptr2), cur);
+          const __m512i val01 = _mm512_sub_epi16(_mm512_loadu_si512((const __m512i *) ptr1), cur);
+          const __m512i val11 = _mm512_sub_epi16(_mm512_loadu_si512((const __m512i *) ptr3), cur);
+
+          __m512i val01A = _mm512_unpacklo_epi16(val00, val10);
+          __m512i val01B = _mm512_unpackhi_epi16(val00, val10);
+          __m512i val01C = _mm512_unpacklo_epi16(val01, val11);
+          __m512i val01D = _mm512_unpackhi_epi16(val01, val11);
+
+          __m512i limit01A = params[0][1][i];
+          __m512i limit01B = params[1][1][i];
+
+          val01A = _mm512_min_epi16(val01A, limit01A);
+          val01B = _mm512_min_epi16(val01B, limit01B);
+          val01C = _mm512_min_epi16(val01C, limit01A);
+          val01D = _mm512_min_epi16(val01D, limit01B);
+
+          limit01A = _mm512_sub_epi16(_mm512_setzero_si512(), limit01A);
+          limit01B = _mm512_sub_epi16(_mm512_setzero_si512(), limit01B);
+
+          val01A = _mm512_max_epi16(val01A, limit01A);
+          val01B = _mm512_max_epi16(val01B, limit01B);
+          val01C = _mm512_max_epi16(val01C, limit01A);
+          val01D = _mm512_max_epi16(val01D, limit01B);
+
+          val01A = _mm512_add_epi16(val01A, val01C);
+          val01B = _mm512_add_epi16(val01B, val01D);
+
+          const __m512i coeff01A = params[0][0][i];
+          const __m512i coeff01B = params[1][0][i];
+
+          accumA = _mm512_add_epi32(accumA, _mm512_madd_epi16(val01A, coeff01A));
+          accumB = _mm512_add_epi32(accumB, _mm512_madd_epi16(val01B, coeff01B));
+        };
+
+
+        process2coeffs(0, pImg5 + 0, pImg6 + 0, pImg3 + 1, pImg4 - 1);
+        process2coeffs(1, pImg3 + 0, pImg4 + 0, pImg3 - 1, pImg4 + 1);
+        process2coeffs(2, pImg1 + 2, pImg2 - 2, pImg1 + 1, pImg2 - 1);
+        process2coeffs(3, pImg1 + 0, pImg2 + 0, pImg1 - 1, pImg2 + 1);
+        process2coeffs(4, pImg1 - 2, pImg2 + 2, pImg0 + 3, pImg0 - 3);
+        process2coeffs(5, pImg0 + 2, pImg0 - 2, pImg0 + 1, pImg0 - 1);
+
+
+        bool isNearVBabove = yVb < vbPos && (yVb >= vbPos - 1);
+        bool isNearVBbelow = yVb >= vbPos && (yVb <= vbPos);
+        if (!(isNearVBabove || isNearVBbelow))
+        {
+          accumA = _mm512_maskz_srai_epi32(0xFFFF, accumA, SHIFT);
+          accumB = _mm512_maskz_srai_epi32(0xFFFF, accumB, SHIFT);
+        }
+        else
+        {
+          accumA = _mm512_maskz_srai_epi32(0xFFFF, _mm512_add_epi32(accumA, mmOffset1), SHIFT + 3);
+          accumB = _mm512_maskz_srai_epi32(0xFFFF, _mm512_add_epi32(accumB, mmOffset1), SHIFT + 3);
+        }
+        accumA = _mm512_packs_epi32(accumA, accumB);
+        accumA = _mm512_add_epi16(accumA, cur);
+        accumA = _mm512_min_epi16(mmMax, _mm512_max_epi16(accumA, mmMin));
+
+        _mm512_storeu_si512((__m512i *) (dst + ii * dstStride + j), accumA);
+      }
+    }
+
+    src += srcStride * STEP_Y;
+    dst += dstStride * STEP_Y;
+  }
+
+  if (width < blk.width)
+  {
+    // remaining columns narrower than 32 go through the 8-wide version
+    const Area blkRem   ( blk.x    + (PosType) width, blk.y,    blk.width - (SizeType) width, blk.height );
+    const Area blkDstRem( blkDst.x + (PosType) width, blkDst.y, blk.width - (SizeType) width, blk.height );
+    simdFilter7x7Blk<vext>(classifier, recDst, recSrc, blkDstRem, blkRem, compId, filterSet, fClipSet, clpRng, cs, vbCTUHeight, vbPos);
+  }
+}
+#endif
 #endif
 template <X86_VEXT vext>
 void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
@@ -1691,6 +1907,12 @@ void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
   m_deriveClassificationBlk = simdDeriveClassificationBlk<vext>;
   m_filter5x5Blk = simdFilter5x5Blk<vext>;
   m_filter7x7Blk = simdFilter7x7Blk<vext>;
+#ifdef USE_AVX512
+  if (vext >= AVX512)
+  {
+    m_filter7x7Blk = simdFilter7x7Blk_AVX512<vext>;
+  }
+#endif
 #endif
 }
 
@@ -61,7 +61,31 @@ void addAvg_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int s
 
     for (int row = 0; row < height; row++)
     {
-      for (int col = 0; col < width; col += 8)
+      int col = 0;
+#ifdef USE_AVX512
+      if (vext >= AVX512)
+      {
+        const __m512i vibdimin512 = _mm512_set1_epi16(clpRng.min);
+        const __m512i vibdimax512 = _mm512_set1_epi16(clpRng.max);
+
+        for (; col + 32 <= width; col += 32)
+        {
+          __m512i vsrc0 = _mm512_loadu_si512((const __m512i *) &src0[col]);
+          __m512i vsrc1 = _mm512_loadu_si512((const __m512i *) &src1[col]);
+
+          vsrc0 = _mm512_xor_si512(vsrc0, _mm512_set1_epi16(0x7fff));
+          vsrc1 = _mm512_xor_si512(vsrc1, _mm512_set1_epi16(0x7fff));
+          vsrc0 = _mm512_avg_epu16(vsrc0, vsrc1);
+          vsrc0 = _mm512_xor_si512(vsrc0, _mm512_set1_epi16(0x7fff));
+          vsrc0 = _mm512_adds_epi16(vsrc0, _mm512_set1_epi16(offset >> 1));
+          vsrc0 = _mm512_sra_epi16(vsrc0, _mm_cvtsi32_si128(shift - 1));
+          vsrc0 = _mm512_max_epi16(vsrc0, vibdimin512);
+          vsrc0 = _mm512_min_epi16(vsrc0, vibdimax512);
+          _mm512_storeu_si512((__m512i *) &dst[col], vsrc0);
+        }
+      }
+#endif
+      for (; col < width; col += 8)
       {
         __m128i vsrc0 = _mm_loadu_si128((const __m128i *) &src0[col]);
         __m128i vsrc1 = _mm_loadu_si128((const __m128i *) &src1[col]);
@@ -917,18 +941,18 @@ void roundIntVector_SIMD(int* v, int size, unsigned int nShift, const int dmvLim
 #ifdef USE_AVX512
   if (vext >= AVX512 && size >= 16)
   {
-    __m512i dMvMin = _mm256_set1_epi32(-dmvLimit);
-    __m512i dMvMax = _mm256_set1_epi32( dmvLimit );
+    __m512i dMvMin = _mm512_set1_epi32(-dmvLimit);
+    __m512i dMvMax = _mm512_set1_epi32( dmvLimit );
     __m512i nOffset = _mm512_set1_epi32((1 << (nShift - 1)));
     __m512i vones = _mm512_set1_epi32(1);
     __m512i vzero = _mm512_setzero_si512();
     for (int i = 0; i < size; i += 16, v += 16)
     {
       __m512i src = _mm512_loadu_si512(v);
-      __mmask16 mask = _mm512_cmpge_epi32_mask(src, vzero);
-      src = __mm512_add_epi32(src, nOffset);
-      __mm512i dst = _mm512_srai_epi32(_mm512_mask_sub_epi32(src, mask, src, vones), nShift);
-      dst = _mm512_min_epi32(dMvMax, _mm512_max_epi32(dMvMin, dst));
+      __mmask16 mask = _mm512_cmpgt_epi32_mask(src, vzero);
+      src = _mm512_add_epi32(src, nOffset);
+      __m512i dst = _mm512_maskz_srai_epi32(0xFFFF, _mm512_mask_sub_epi32(src, mask, src, vones), nShift);
+      dst = _mm512_maskz_min_epi32(0xFFFF, dMvMax, _mm512_maskz_max_epi32(0xFFFF, dMvMin, dst));
       _mm512_storeu_si512(v, dst);
     }
   }
@@ -1793,6 +1817,217 @@ void linTf_SSE_entry( const Pel* src, int srcStride, Pel *dst, int dstStride, in
   }
 }
 
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+template<X86_VEXT vext>
+void applyLut_SIMD( Pel* ptr, int stride, int width, int height, const Pel* lut, int lutSize )
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 && lutSize >= 2 && ( width & 3 ) == 0 )
+  {
+    // gather the 32 bit words starting at the entries, the last entry is read as the upper half of the word of its predecessor
+    const __m256i vlast = _mm256_set1_epi32( lutSize - 2 );
+
+    for( int y = 0; y < height; y++ )
+    {
+      int x = 0;
+      for( ; x + 8 <= width; x += 8 )
+      {
+        const __m256i vidx = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &ptr[x] ) );
+        const __m256i vadr = _mm256_min_epi32( vidx, vlast );
+        __m256i       vval = _mm256_i32gather_epi32( ( const int* ) lut, vadr, 2 );
+        vval = _mm256_srai_epi32( _mm256_slli_epi32( _mm256_srlv_epi32( vval, _mm256_slli_epi32( _mm256_sub_epi32( vidx, vadr ), 4 ) ), 16 ), 16 );
+        _mm_storeu_si128( ( __m128i* ) &ptr[x], _mm_packs_epi32( _mm256_castsi256_si128( vval ), _mm256_extracti128_si256( vval, 1 ) ) );
+      }
+      if( x < width )
+      {
+        const __m128i vidx = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &ptr[x] ) );
+        const __m128i vadr = _mm_min_epi32( vidx, _mm256_castsi256_si128( vlast ) );
+        __m128i       vval = _mm_i32gather_epi32( ( const int* ) lut, vadr, 2 );
+        vval = _mm_srai_epi32( _mm_slli_epi32( _mm_srlv_epi32( vval, _mm_slli_epi32( _mm_sub_epi32( vidx, vadr ), 4 ) ), 16 ), 16 );
+        _mm_storel_epi64( ( __m128i* ) &ptr[x], _mm_packs_epi32( vval, vval ) );
+      }
+      ptr += stride;
+    }
+    return;
+  }
+#endif
+  // no gather below AVX2
+  applyLutCore( ptr, stride, width, height, lut, lutSize );
+}
+
+// ( ( |v| << CSCALE_FP_PREC ) + ( scale >> 1 ) ) / scale with the sign of v, the quotient of the
+// double precision division truncates to the exact integer quotient as all operands are below 2^31
+static inline __m128i scaleFwd4( const __m128i val, const __m128d vscale, const __m128i vrnd )
+{
+  const __m128i num = _mm_add_epi32( _mm_slli_epi32( _mm_abs_epi32( val ), CSCALE_FP_PREC ), vrnd );
+  const __m128i qlo = _mm_cvttpd_epi32( _mm_div_pd( _mm_cvtepi32_pd( num ), vscale ) );
+  const __m128i qhi = _mm_cvttpd_epi32( _mm_div_pd( _mm_cvtepi32_pd( _mm_unpackhi_epi64( num, num ) ), vscale ) );
+  return _mm_sign_epi32( _mm_unpacklo_epi64( qlo, qhi ), val );
+}
+
+template<X86_VEXT vext>
+void scaleSignalFwd_SIMD( Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng )
+{
+  if( width & 3 )
+  {
+    scaleSignalFwdCore( ptr, stride, width, height, scale, clpRng );
+    return;
+  }
+
+  const int     maxAbsclipBD = ( 1 << clpRng.bd ) - 1;
+  const __m128i vrnd         = _mm_set1_epi32( scale >> 1 );
+  const __m128i vmin         = _mm_set1_epi32( -maxAbsclipBD );
+  const __m128i vmax         = _mm_set1_epi32(  maxAbsclipBD );
+  const __m128d vscale       = _mm_set1_pd( scale );
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256d vscale256 = _mm256_set1_pd( scale );
+      const __m256i vrnd256   = _mm256_set1_epi32( scale >> 1 );
+
+      for( ; x + 8 <= width; x += 8 )
+      {
+        const __m256i val = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &ptr[x] ) );
+        const __m256i num = _mm256_add_epi32( _mm256_slli_epi32( _mm256_abs_epi32( val ), CSCALE_FP_PREC ), vrnd256 );
+        const __m128i qlo = _mm256_cvttpd_epi32( _mm256_div_pd( _mm256_cvtepi32_pd( _mm256_castsi256_si128( num ) ), vscale256 ) );
+        const __m128i qhi = _mm256_cvttpd_epi32( _mm256_div_pd( _mm256_cvtepi32_pd( _mm256_extracti128_si256( num, 1 ) ), vscale256 ) );
+        const __m128i rlo = _mm_min_epi32( vmax, _mm_max_epi32( vmin, _mm_sign_epi32( qlo, _mm256_castsi256_si128( val ) ) ) );
+        const __m128i rhi = _mm_min_epi32( vmax, _mm_max_epi32( vmin, _mm_sign_epi32( qhi, _mm256_extracti128_si256( val, 1 ) ) ) );
+        _mm_storeu_si128( ( __m128i* ) &ptr[x], _mm_packs_epi32( rlo, rhi ) );
+      }
+    }
+#endif
+    for( ; x < width; x += 4 )
+    {
+      const __m128i val = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &ptr[x] ) );
+      const __m128i res = _mm_min_epi32( vmax, _mm_max_epi32( vmin, scaleFwd4( val, vscale, vrnd ) ) );
+      _mm_storel_epi64( ( __m128i* ) &ptr[x], _mm_packs_epi32( res, res ) );
+    }
+    ptr += stride;
+  }
+}
+
+template<X86_VEXT vext>
+void scaleSignalInv_SIMD( Pel* ptr, int stride, int width, int height, int scale, const ClpRng& clpRng )
+{
+  if( width & 3 )
+  {
+    scaleSignalInvCore( ptr, stride, width, height, scale, clpRng );
+    return;
+  }
+
+  // clip to the residual range, scale the magnitude and saturate to 16 bit while packing
+  const int     maxAbsclipBD = ( 1 << clpRng.bd ) - 1;
+  const __m128i vmin         = _mm_set1_epi16( ( Pel ) ( -maxAbsclipBD - 1 ) );
+  const __m128i vmax         = _mm_set1_epi16( ( Pel ) maxAbsclipBD );
+  const __m128i vscale       = _mm_set1_epi32( scale );
+  const __m128i vrnd         = _mm_set1_epi32( 1 << ( CSCALE_FP_PREC - 1 ) );
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vmin256   = _mm256_set1_epi16( ( Pel ) ( -maxAbsclipBD - 1 ) );
+      const __m256i vmax256   = _mm256_set1_epi16( ( Pel ) maxAbsclipBD );
+      const __m256i vscale256 = _mm256_set1_epi32( scale );
+      const __m256i vrnd256   = _mm256_set1_epi32( 1 << ( CSCALE_FP_PREC - 1 ) );
+
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i val = _mm256_min_epi16( vmax256, _mm256_max_epi16( vmin256, _mm256_loadu_si256( ( const __m256i* ) &ptr[x] ) ) );
+        const __m256i vlo = _mm256_cvtepi16_epi32( _mm256_castsi256_si128( val ) );
+        const __m256i vhi = _mm256_cvtepi16_epi32( _mm256_extracti128_si256( val, 1 ) );
+        const __m256i rlo = _mm256_sign_epi32( _mm256_srai_epi32( _mm256_add_epi32( _mm256_mullo_epi32( _mm256_abs_epi32( vlo ), vscale256 ), vrnd256 ), CSCALE_FP_PREC ), vlo );
+        const __m256i rhi = _mm256_sign_epi32( _mm256_srai_epi32( _mm256_add_epi32( _mm256_mullo_epi32( _mm256_abs_epi32( vhi ), vscale256 ), vrnd256 ), CSCALE_FP_PREC ), vhi );
+        _mm256_storeu_si256( ( __m256i* ) &ptr[x], _mm256_permute4x64_epi64( _mm256_packs_epi32( rlo, rhi ), 0xD8 ) );
+      }
+    }
+#endif
+    for( ; x < width; x += 4 )
+    {
+      const __m128i val = _mm_cvtepi16_epi32( _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_loadl_epi64( ( const __m128i* ) &ptr[x] ) ) ) );
+      const __m128i res = _mm_sign_epi32( _mm_srai_epi32( _mm_add_epi32( _mm_mullo_epi32( _mm_abs_epi32( val ), vscale ), vrnd ), CSCALE_FP_PREC ), val );
+      _mm_storel_epi64( ( __m128i* ) &ptr[x], _mm_packs_epi32( res, res ) );
+    }
+    ptr += stride;
+  }
+}
+
+#if ENABLE_8BIT_REFERENCES
+template<X86_VEXT vext>
+void packTo8bit_SIMD( const Pel* src, int srcStride, uint8_t* dst, int dstStride, int width, int height )
+{
+  if( width & 15 )
+  {
+    const int width16 = width & ~15;
+    if( width16 )
+    {
+      packTo8bit_SIMD<vext>( src, srcStride, dst, dstStride, width16, height );
+    }
+    packTo8bitCore( src + width16, srcStride, dst + width16, dstStride, width - width16, height );
+    return;
+  }
+
+  for( int y = 0; y < height; y++ )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 32 <= width; x += 32 )
+      {
+        const __m256i lo = _mm256_loadu_si256( ( const __m256i* ) &src[x] );
+        const __m256i hi = _mm256_loadu_si256( ( const __m256i* ) &src[x + 16] );
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_permute4x64_epi64( _mm256_packus_epi16( lo, hi ), 0xD8 ) );
+      }
+    }
+#endif
+    for( ; x < width; x += 16 )
+    {
+      const __m128i lo = _mm_loadu_si128( ( const __m128i* ) &src[x] );
+      const __m128i hi = _mm_loadu_si128( ( const __m128i* ) &src[x + 8] );
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_packus_epi16( lo, hi ) );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext>
+void unpack8bit_SIMD( const uint8_t* src, int srcStride, Pel* dst, int dstStride, int width, int height )
+{
+  if( width & 7 )
+  {
+    const int width8 = width & ~7;
+    if( width8 )
+    {
+      unpack8bit_SIMD<vext>( src, srcStride, dst, dstStride, width8, height );
+    }
+    unpack8bitCore( src + width8, srcStride, dst + width8, dstStride, width - width8, height );
+    return;
+  }
+
+  const __m128i zero = _mm_setzero_si128();
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x += 8 )
+    {
+      const __m128i val = _mm_loadl_epi64( ( const __m128i* ) &src[x] );
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_unpacklo_epi8( val, zero ) );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+#endif
+#endif
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -1841,6 +2076,14 @@ void PelBufferOps::_initPelBufOpsX86()
 #endif
   profGradFilter = gradFilter_SSE<vext, false>;
   applyPROF      = applyPROF_SSE<vext>;
+
+  applyLut       = applyLut_SIMD<vext>;
+  scaleSignalFwd = scaleSignalFwd_SIMD<vext>;
+  scaleSignalInv = scaleSignalInv_SIMD<vext>;
+#if ENABLE_8BIT_REFERENCES
+  packTo8bit     = packTo8bit_SIMD<vext>;
+  unpack8bit     = unpack8bit_SIMD<vext>;
+#endif
 #endif
   roundIntVector = roundIntVector_SIMD<vext>;
 }
@@ -0,0 +1,491 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     DeblockingFilterX86.h
+    \brief    deblocking filter, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../DeblockingFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// The samples across an edge segment are kept in 32 bit lanes, one lane per line, so that the
+// filter equations can be evaluated exactly as in the scalar code. p[k] and q[k] hold the k-th
+// sample away from the edge on the P and Q side.
+
+static inline void transposeRowsToTaps( const __m128i r[4], __m128i col[8] )
+{
+  const __m128i t0 = _mm_unpacklo_epi16( r[0], r[1] );
+  const __m128i t1 = _mm_unpacklo_epi16( r[2], r[3] );
+  const __m128i t2 = _mm_unpackhi_epi16( r[0], r[1] );
+  const __m128i t3 = _mm_unpackhi_epi16( r[2], r[3] );
+  const __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+  const __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+  const __m128i u2 = _mm_unpacklo_epi32( t2, t3 );
+  const __m128i u3 = _mm_unpackhi_epi32( t2, t3 );
+  col[0] = _mm_cvtepi16_epi32( u0 );
+  col[1] = _mm_cvtepi16_epi32( _mm_srli_si128( u0, 8 ) );
+  col[2] = _mm_cvtepi16_epi32( u1 );
+  col[3] = _mm_cvtepi16_epi32( _mm_srli_si128( u1, 8 ) );
+  col[4] = _mm_cvtepi16_epi32( u2 );
+  col[5] = _mm_cvtepi16_epi32( _mm_srli_si128( u2, 8 ) );
+  col[6] = _mm_cvtepi16_epi32( u3 );
+  col[7] = _mm_cvtepi16_epi32( _mm_srli_si128( u3, 8 ) );
+}
+
+static inline void transposeTapsToRows( const __m128i col[8], __m128i r[4] )
+{
+  const __m128i v0 = _mm_packs_epi32( col[0], col[1] );
+  const __m128i v1 = _mm_packs_epi32( col[2], col[3] );
+  const __m128i v2 = _mm_packs_epi32( col[4], col[5] );
+  const __m128i v3 = _mm_packs_epi32( col[6], col[7] );
+  const __m128i w0 = _mm_unpacklo_epi16( v0, _mm_srli_si128( v0, 8 ) );
+  const __m128i w1 = _mm_unpacklo_epi16( v1, _mm_srli_si128( v1, 8 ) );
+  const __m128i w2 = _mm_unpacklo_epi16( v2, _mm_srli_si128( v2, 8 ) );
+  const __m128i w3 = _mm_unpacklo_epi16( v3, _mm_srli_si128( v3, 8 ) );
+  const __m128i x0 = _mm_unpacklo_epi32( w0, w1 );
+  const __m128i x1 = _mm_unpacklo_epi32( w2, w3 );
+  const __m128i x2 = _mm_unpackhi_epi32( w0, w1 );
+  const __m128i x3 = _mm_unpackhi_epi32( w2, w3 );
+  r[0] = _mm_unpacklo_epi64( x0, x1 );
+  r[1] = _mm_unpackhi_epi64( x0, x1 );
+  r[2] = _mm_unpacklo_epi64( x2, x3 );
+  r[3] = _mm_unpackhi_epi64( x2, x3 );
+}
+
+static inline __m128i loadLines( const Pel* src, const int numLines )
+{
+  if( numLines == 2 )
+  {
+    return _mm_cvtepi16_epi32( _mm_cvtsi32_si128( *(const int32_t*) src ) );
+  }
+  return _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*) src ) );
+}
+
+static inline void storeLines( Pel* dst, const __m128i& val, const int numLines )
+{
+  const __m128i packed = _mm_packs_epi32( val, val );
+  if( numLines == 2 )
+  {
+    *(int32_t*) dst = _mm_cvtsi128_si32( packed );
+  }
+  else
+  {
+    _mm_storel_epi64( (__m128i*) dst, packed );
+  }
+}
+
+// loads the numTaps (4 or 8) samples on one side of the edge, side is -1 for P and 1 for Q
+template<int numTaps>
+static inline void loadSide( const Pel* src, const int step, const int offset, const int numLines, const int side, __m128i* tap )
+{
+  if( offset == 1 )
+  {
+    const Pel* rowSrc = side < 0 ? src - numTaps : src;
+    __m128i    r[4]   = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+    for( int l = 0; l < numLines; l++ )
+    {
+      r[l] = numTaps == 8 ? _mm_loadu_si128( (const __m128i*) ( rowSrc + l * step ) ) : _mm_loadl_epi64( (const __m128i*) ( rowSrc + l * step ) );
+    }
+    __m128i col[8];
+    transposeRowsToTaps( r, col );
+    for( int k = 0; k < numTaps; k++ )
+    {
+      tap[k] = side < 0 ? col[numTaps - 1 - k] : col[k];
+    }
+  }
+  else
+  {
+    for( int k = 0; k < numTaps; k++ )
+    {
+      tap[k] = loadLines( side < 0 ? src - ( k + 1 ) * offset : src + k * offset, numLines );
+    }
+  }
+}
+
+// stores the first numStore samples on one side of the edge, the unchanged samples up to numTaps
+// are written back as well for a vertical edge
+template<int numTaps>
+static inline void storeSide( Pel* src, const int step, const int offset, const int numLines, const int side, const __m128i* tap, const int numStore )
+{
+  if( offset == 1 )
+  {
+    __m128i col[8];
+    for( int k = 0; k < 8; k++ )
+    {
+      col[k] = k < numTaps ? ( side < 0 ? tap[numTaps - 1 - k] : tap[k] ) : _mm_setzero_si128();
+    }
+    __m128i r[4];
+    transposeTapsToRows( col, r );
+    Pel* rowDst = side < 0 ? src - numTaps : src;
+    for( int l = 0; l < numLines; l++ )
+    {
+      if( numTaps == 8 )
+      {
+        _mm_storeu_si128( (__m128i*) ( rowDst + l * step ), r[l] );
+      }
+      else
+      {
+        _mm_storel_epi64( (__m128i*) ( rowDst + l * step ), r[l] );
+      }
+    }
+  }
+  else
+  {
+    for( int k = 0; k < numStore; k++ )
+    {
+      storeLines( side < 0 ? src - ( k + 1 ) * offset : src + k * offset, tap[k], numLines );
+    }
+  }
+}
+
+static inline __m128i clipAround( const __m128i& val, const __m128i& org, const __m128i& range )
+{
+  return _mm_min_epi32( _mm_max_epi32( val, _mm_sub_epi32( org, range ) ), _mm_add_epi32( org, range ) );
+}
+
+static inline __m128i sum3( const __m128i& a, const __m128i& b, const __m128i& c )
+{
+  return _mm_add_epi32( _mm_add_epi32( a, b ), c );
+}
+
+// long luma filter of xFilteringPandQ, numberPSide and numberQSide are 3, 5 or 7
+static inline void filterLongLuma( __m128i* p, __m128i* q, const int numberPSide, const int numberQSide, const int tc )
+{
+  static const int  dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
+  static const int  dbCoeffs3[3] = { 53, 32, 11 };
+  static const int  dbCoeffs5[5] = { 58, 45, 32, 19, 6 };
+  static const char tc7[7]       = { 6, 5, 4, 3, 2, 1, 1 };
+  static const char tc3[3]       = { 6, 4, 2 };
+
+  const __m128i one   = _mm_set1_epi32( 1 );
+  const __m128i refP  = _mm_srai_epi32( sum3( p[numberPSide - 1], p[numberPSide], one ), 1 );
+  const __m128i refQ  = _mm_srai_epi32( sum3( q[numberQSide - 1], q[numberQSide], one ), 1 );
+
+  __m128i refMiddle;
+  if( numberPSide == numberQSide )
+  {
+    __m128i sum2 = _mm_add_epi32( p[0], q[0] );
+    __m128i sum1 = _mm_setzero_si128();
+    const int numDouble = numberPSide == 5 ? 3 : 1;
+    for( int k = 1; k < numDouble; k++ )
+    {
+      sum2 = sum3( sum2, p[k], q[k] );
+    }
+    for( int k = numDouble; k < numberPSide; k++ )
+    {
+      sum1 = sum3( sum1, p[k], q[k] );
+    }
+    refMiddle = _mm_srai_epi32( sum3( _mm_slli_epi32( sum2, 1 ), sum1, _mm_set1_epi32( 8 ) ), 4 );
+  }
+  else
+  {
+    const __m128i* large = numberPSide > numberQSide ? p : q;
+    const __m128i* small = numberPSide > numberQSide ? q : p;
+    const int      numLarge = std::max( numberPSide, numberQSide );
+    const int      numSmall = std::min( numberPSide, numberQSide );
+
+    if( numLarge == 7 && numSmall == 5 )
+    {
+      const __m128i sum2 = _mm_add_epi32( _mm_add_epi32( p[0], q[0] ), _mm_add_epi32( p[1], q[1] ) );
+      __m128i       sum1 = _mm_setzero_si128();
+      for( int k = 2; k < 6; k++ )
+      {
+        sum1 = sum3( sum1, p[k], q[k] );
+      }
+      refMiddle = _mm_srai_epi32( sum3( _mm_slli_epi32( sum2, 1 ), sum1, _mm_set1_epi32( 8 ) ), 4 );
+    }
+    else if( numLarge == 7 )
+    {
+      // 2 * (P0 + Q0) + Q0 + 2 * (Q1 + Q2) + P1 + Q1 + P2 + ... + P6 with P the longer side
+      const __m128i sum2 = sum3( large[0], small[1], small[2] );
+      __m128i       sum1 = sum3( _mm_add_epi32( small[0], small[0] ), small[0], small[1] );
+      for( int k = 1; k < 7; k++ )
+      {
+        sum1 = _mm_add_epi32( sum1, large[k] );
+      }
+      refMiddle = _mm_srai_epi32( sum3( _mm_slli_epi32( sum2, 1 ), sum1, _mm_set1_epi32( 8 ) ), 4 );
+    }
+    else
+    {
+      __m128i sum1 = _mm_set1_epi32( 4 );
+      for( int k = 0; k < 4; k++ )
+      {
+        sum1 = sum3( sum1, p[k], q[k] );
+      }
+      refMiddle = _mm_srai_epi32( sum1, 3 );
+    }
+  }
+
+  const __m128i rnd = _mm_set1_epi32( 32 );
+  for( int side = 0; side < 2; side++ )
+  {
+    __m128i*      tap    = side ? q : p;
+    const int     num    = side ? numberQSide : numberPSide;
+    const __m128i ref    = side ? refQ : refP;
+    const int*    coeffs = num == 7 ? dbCoeffs7 : ( num == 5 ? dbCoeffs5 : dbCoeffs3 );
+    const char*   tcPos  = num == 3 ? tc3 : tc7;
+    for( int pos = 0; pos < num; pos++ )
+    {
+      const __m128i val = _mm_srai_epi32( sum3( _mm_mullo_epi32( refMiddle, _mm_set1_epi32( coeffs[pos] ) ), _mm_mullo_epi32( ref, _mm_set1_epi32( 64 - coeffs[pos] ) ), rnd ), 6 );
+      tap[pos] = clipAround( val, tap[pos], _mm_set1_epi32( ( tc * tcPos[pos] ) >> 1 ) );
+    }
+  }
+}
+
+template<X86_VEXT vext, int numTapsP, int numTapsQ>
+static void pelFilterLumaTaps_SIMD( Pel* src, const int step, const int offset, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng, const bool sidePisLarge, const bool sideQisLarge, const int maxFilterLengthP, const int maxFilterLengthQ )
+{
+  const int numLines = DEBLOCK_SMALLEST_BLOCK / 2;
+
+  __m128i p[numTapsP], q[numTapsQ];
+  loadSide<numTapsP>( src, step, offset, numLines, -1, p );
+  loadSide<numTapsQ>( src, step, offset, numLines,  1, q );
+
+  int numStoreP, numStoreQ;
+
+  if( sw && ( sidePisLarge || sideQisLarge ) )
+  {
+    numStoreP = sidePisLarge ? maxFilterLengthP : 3;
+    numStoreQ = sideQisLarge ? maxFilterLengthQ : 3;
+    filterLongLuma( p, q, numStoreP, numStoreQ, tc );
+  }
+  else if( sw )
+  {
+    const __m128i four   = _mm_set1_epi32( 4 );
+    const __m128i two    = _mm_set1_epi32( 2 );
+    const __m128i vtc    = _mm_set1_epi32( tc );
+    const __m128i p0q0   = _mm_add_epi32( p[0], q[0] );
+    const __m128i p0q0x2 = _mm_add_epi32( p0q0, p0q0 );
+
+    const __m128i p0 = _mm_srai_epi32( sum3( sum3( p[2], _mm_slli_epi32( p[1], 1 ), p0q0x2 ), q[1], four ), 3 );
+    const __m128i q0 = _mm_srai_epi32( sum3( sum3( p[1], p0q0x2, _mm_slli_epi32( q[1], 1 ) ), q[2], four ), 3 );
+    const __m128i p1 = _mm_srai_epi32( sum3( sum3( p[2], p[1], p0q0 ), two, _mm_setzero_si128() ), 2 );
+    const __m128i q1 = _mm_srai_epi32( sum3( sum3( p0q0, q[1], q[2] ), two, _mm_setzero_si128() ), 2 );
+    const __m128i p2 = _mm_srai_epi32( sum3( sum3( _mm_slli_epi32( p[3], 1 ), _mm_mullo_epi32( p[2], _mm_set1_epi32( 3 ) ), p[1] ), p0q0, four ), 3 );
+    const __m128i q2 = _mm_srai_epi32( sum3( sum3( p0q0, q[1], _mm_mullo_epi32( q[2], _mm_set1_epi32( 3 ) ) ), _mm_slli_epi32( q[3], 1 ), four ), 3 );
+
+    const __m128i tc1 = vtc;
+    const __m128i tc2 = _mm_add_epi32( vtc, vtc );
+    const __m128i tc3 = _mm_add_epi32( tc2, vtc );
+    p[0] = clipAround( p0, p[0], tc3 );
+    q[0] = clipAround( q0, q[0], tc3 );
+    p[1] = clipAround( p1, p[1], tc2 );
+    q[1] = clipAround( q1, q[1], tc2 );
+    p[2] = clipAround( p2, p[2], tc1 );
+    q[2] = clipAround( q2, q[2], tc1 );
+    numStoreP = numStoreQ = 3;
+  }
+  else
+  {
+    // weak filter, lanes with abs(delta) >= thrCut stay unchanged
+    __m128i delta = _mm_sub_epi32( _mm_mullo_epi32( _mm_sub_epi32( q[0], p[0] ), _mm_set1_epi32( 9 ) ), _mm_mullo_epi32( _mm_sub_epi32( q[1], p[1] ), _mm_set1_epi32( 3 ) ) );
+    delta               = _mm_srai_epi32( _mm_add_epi32( delta, _mm_set1_epi32( 8 ) ), 4 );
+    const __m128i apply = _mm_cmpgt_epi32( _mm_set1_epi32( thrCut ), _mm_abs_epi32( delta ) );
+    if( _mm_movemask_epi8( apply ) == 0 )
+    {
+      return;
+    }
+    const __m128i vmin = _mm_set1_epi32( clpRng.min );
+    const __m128i vmax = _mm_set1_epi32( clpRng.max );
+    delta              = _mm_min_epi32( _mm_max_epi32( delta, _mm_set1_epi32( -tc ) ), _mm_set1_epi32( tc ) );
+
+    const __m128i org0P = p[0];
+    const __m128i org0Q = q[0];
+    p[0] = _mm_blendv_epi8( p[0], _mm_min_epi32( _mm_max_epi32( _mm_add_epi32( org0P, delta ), vmin ), vmax ), apply );
+    q[0] = _mm_blendv_epi8( q[0], _mm_min_epi32( _mm_max_epi32( _mm_sub_epi32( org0Q, delta ), vmin ), vmax ), apply );
+
+    const int     tc2  = tc >> 1;
+    const __m128i vtc2 = _mm_set1_epi32( tc2 );
+    const __m128i one  = _mm_set1_epi32( 1 );
+    if( filterSecondP )
+    {
+      __m128i delta1 = _mm_srai_epi32( sum3( p[2], org0P, one ), 1 );
+      delta1         = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( delta1, p[1] ), delta ), 1 );
+      delta1         = _mm_min_epi32( _mm_max_epi32( delta1, _mm_set1_epi32( -tc2 ) ), vtc2 );
+      p[1] = _mm_blendv_epi8( p[1], _mm_min_epi32( _mm_max_epi32( _mm_add_epi32( p[1], delta1 ), vmin ), vmax ), apply );
+    }
+    if( filterSecondQ )
+    {
+      __m128i delta2 = _mm_srai_epi32( sum3( q[2], org0Q, one ), 1 );
+      delta2         = _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( delta2, q[1] ), delta ), 1 );
+      delta2         = _mm_min_epi32( _mm_max_epi32( delta2, _mm_set1_epi32( -tc2 ) ), vtc2 );
+      q[1] = _mm_blendv_epi8( q[1], _mm_min_epi32( _mm_max_epi32( _mm_add_epi32( q[1], delta2 ), vmin ), vmax ), apply );
+    }
+    numStoreP = filterSecondP ? 2 : 1;
+    numStoreQ = filterSecondQ ? 2 : 1;
+  }
+
+  if( !partPNoFilter )
+  {
+    storeSide<numTapsP>( src, step, offset, numLines, -1, p, numStoreP );
+  }
+  if( !partQNoFilter )
+  {
+    storeSide<numTapsQ>( src, step, offset, numLines,  1, q, numStoreQ );
+  }
+}
+
+template<X86_VEXT vext>
+static void pelFilterLuma_SIMD( Pel* src, const int step, const int offset, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng, const bool sidePisLarge, const bool sideQisLarge, const int maxFilterLengthP, const int maxFilterLengthQ )
+{
+  // the long filter reads up to 8 samples on a large side, the other filters 4 samples on each side
+  const bool longP = sw && sidePisLarge;
+  const bool longQ = sw && sideQisLarge;
+  if( longP && longQ )
+  {
+    pelFilterLumaTaps_SIMD<vext, 8, 8>( src, step, offset, tc, sw, partPNoFilter, partQNoFilter, thrCut, filterSecondP, filterSecondQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ );
+  }
+  else if( longP )
+  {
+    pelFilterLumaTaps_SIMD<vext, 8, 4>( src, step, offset, tc, sw, partPNoFilter, partQNoFilter, thrCut, filterSecondP, filterSecondQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ );
+  }
+  else if( longQ )
+  {
+    pelFilterLumaTaps_SIMD<vext, 4, 8>( src, step, offset, tc, sw, partPNoFilter, partQNoFilter, thrCut, filterSecondP, filterSecondQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ );
+  }
+  else
+  {
+    pelFilterLumaTaps_SIMD<vext, 4, 4>( src, step, offset, tc, sw, partPNoFilter, partQNoFilter, thrCut, filterSecondP, filterSecondQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ );
+  }
+}
+
+template<X86_VEXT vext>
+static void pelFilterChroma_SIMD( Pel* src, const int step, const int offset, const int numLines, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary )
+{
+  CHECKD( numLines != 2 && numLines != 4, "Unsupported number of chroma lines in an edge segment" );
+
+  __m128i p[4], q[4];
+  loadSide<4>( src, step, offset, numLines, -1, p );
+  loadSide<4>( src, step, offset, numLines,  1, q );
+
+  const __m128i orgP[3] = { p[0], p[1], p[2] };
+  const __m128i orgQ[3] = { q[0], q[1], q[2] };
+  const __m128i vtc     = _mm_set1_epi32( tc );
+  const __m128i four    = _mm_set1_epi32( 4 );
+
+  int numStoreP, numStoreQ;
+  if( sw )
+  {
+    const __m128i p0q0 = _mm_add_epi32( p[0], q[0] );
+    const __m128i q1x2 = _mm_slli_epi32( q[1], 1 );
+    const __m128i q2x2 = _mm_slli_epi32( q[2], 1 );
+    const __m128i q3x2 = _mm_slli_epi32( q[3], 1 );
+    const __m128i q3x3 = _mm_add_epi32( q3x2, q[3] );
+    if( isChromaHorCTBBoundary )
+    {
+      const __m128i p1x2 = _mm_slli_epi32( p[1], 1 );
+      const __m128i p0 = _mm_srai_epi32( sum3( sum3( _mm_add_epi32( p1x2, p[1] ), _mm_slli_epi32( p[0], 1 ), q[0] ), _mm_add_epi32( q[1], q[2] ), four ), 3 );
+      const __m128i q0 = _mm_srai_epi32( sum3( sum3( p1x2, p0q0, q[0] ), sum3( q[1], q[2], q[3] ), four ), 3 );
+      const __m128i q1 = _mm_srai_epi32( sum3( sum3( p[1], p0q0, q1x2 ), _mm_add_epi32( q[2], q3x2 ), four ), 3 );
+      const __m128i q2 = _mm_srai_epi32( sum3( sum3( p0q0, q[1], q2x2 ), q3x3, four ), 3 );
+      p[0] = clipAround( p0, p[0], vtc );
+      q[0] = clipAround( q0, q[0], vtc );
+      q[1] = clipAround( q1, q[1], vtc );
+      q[2] = clipAround( q2, q[2], vtc );
+      numStoreP = 1;
+    }
+    else
+    {
+      const __m128i p3x2 = _mm_slli_epi32( p[3], 1 );
+      const __m128i p3x3 = _mm_add_epi32( p3x2, p[3] );
+      const __m128i p2 = _mm_srai_epi32( sum3( sum3( p3x3, _mm_slli_epi32( p[2], 1 ), p[1] ), p0q0, four ), 3 );
+      const __m128i p1 = _mm_srai_epi32( sum3( sum3( p3x2, p[2], _mm_slli_epi32( p[1], 1 ) ), _mm_add_epi32( p0q0, q[1] ), four ), 3 );
+      const __m128i p0 = _mm_srai_epi32( sum3( sum3( p[3], p[2], p[1] ), sum3( p0q0, p[0], q[1] ), _mm_add_epi32( q[2], four ) ), 3 );
+      const __m128i q0 = _mm_srai_epi32( sum3( sum3( p[2], p[1], p0q0 ), sum3( q[0], q[1], q[2] ), _mm_add_epi32( q[3], four ) ), 3 );
+      const __m128i q1 = _mm_srai_epi32( sum3( sum3( p[1], p0q0, q1x2 ), _mm_add_epi32( q[2], q3x2 ), four ), 3 );
+      const __m128i q2 = _mm_srai_epi32( sum3( sum3( p0q0, q[1], q2x2 ), q3x3, four ), 3 );
+      p[2] = clipAround( p2, p[2], vtc );
+      p[1] = clipAround( p1, p[1], vtc );
+      p[0] = clipAround( p0, p[0], vtc );
+      q[0] = clipAround( q0, q[0], vtc );
+      q[1] = clipAround( q1, q[1], vtc );
+      q[2] = clipAround( q2, q[2], vtc );
+      numStoreP = 3;
+    }
+    numStoreQ = 3;
+  }
+  else
+  {
+    __m128i delta = sum3( _mm_slli_epi32( _mm_sub_epi32( q[0], p[0] ), 2 ), _mm_sub_epi32( p[1], q[1] ), four );
+    delta         = _mm_min_epi32( _mm_max_epi32( _mm_srai_epi32( delta, 3 ), _mm_set1_epi32( -tc ) ), vtc );
+    const __m128i vmin = _mm_set1_epi32( clpRng.min );
+    const __m128i vmax = _mm_set1_epi32( clpRng.max );
+    p[0] = _mm_min_epi32( _mm_max_epi32( _mm_add_epi32( p[0], delta ), vmin ), vmax );
+    q[0] = _mm_min_epi32( _mm_max_epi32( _mm_sub_epi32( q[0], delta ), vmin ), vmax );
+    numStoreP = numStoreQ = 1;
+  }
+
+  if( partPNoFilter )
+  {
+    if( largeBoundary )
+    {
+      p[2] = orgP[2];
+      p[1] = orgP[1];
+    }
+    p[0] = orgP[0];
+  }
+  if( partQNoFilter )
+  {
+    if( largeBoundary )
+    {
+      q[1] = orgQ[1];
+      q[2] = orgQ[2];
+    }
+    q[0] = orgQ[0];
+  }
+
+  storeSide<4>( src, step, offset, numLines, -1, p, numStoreP );
+  storeSide<4>( src, step, offset, numLines,  1, q, numStoreQ );
+}
+#endif
+
+template<X86_VEXT vext>
+void DeblockingFilter::_initDeblockingFilterX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_pelFilterLuma   = pelFilterLuma_SIMD<vext>;
+  m_pelFilterChroma = pelFilterChroma_SIMD<vext>;
+#endif
+}
+
+template void DeblockingFilter::_initDeblockingFilterX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+//! \}
@@ -0,0 +1,269 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     DepQuantX86.h
+    \brief    dependent quantization trellis, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../DepQuant.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+namespace DQIntern
+{
+  static inline int coeffFracBitsIdx( const TCoeff absLevel )
+  {
+    return absLevel < 4 ? absLevel : absLevel - ( ( ( absLevel - 4 ) >> 1 ) << 1 );
+  }
+
+  // rates of the levels A and B and of the zero level for the four states (one 32 bit lane per state),
+  // lanes in which the zero level may not be chosen are flagged in zeroOff
+  static inline void dqRates( const ScanPosType spt, const PQData* pqData, const StateMem& prev, __m128i& rateA, __m128i& rateB, __m128i& rateZ, __m128i& zeroOff )
+  {
+    const __m128i regular = _mm_cmpgt_epi32( _mm_loadu_si128( ( const __m128i* ) prev.remRegBins ), _mm_set1_epi32( 3 ) );
+    // states 0 and 1 use the levels of pqData[0] and pqData[2], states 2 and 3 those of pqData[3] and pqData[1]
+    const __m128i coeffA  = _mm_blend_epi16( _mm_loadu_si128( ( const __m128i* ) prev.coeffFracBits[coeffFracBitsIdx( pqData[0].absLevel )] ),
+                                             _mm_loadu_si128( ( const __m128i* ) prev.coeffFracBits[coeffFracBitsIdx( pqData[3].absLevel )] ), 0xF0 );
+    const __m128i coeffB  = _mm_blend_epi16( _mm_loadu_si128( ( const __m128i* ) prev.coeffFracBits[coeffFracBitsIdx( pqData[2].absLevel )] ),
+                                             _mm_loadu_si128( ( const __m128i* ) prev.coeffFracBits[coeffFracBitsIdx( pqData[1].absLevel )] ), 0xF0 );
+    const __m128i sig0    = _mm_loadu_si128( ( const __m128i* ) prev.sigFracBits[0] );
+    const __m128i sig1    = _mm_loadu_si128( ( const __m128i* ) prev.sigFracBits[1] );
+    __m128i       sigA    = sig1;
+    __m128i       sigZ    = sig0;
+    zeroOff               = _mm_setzero_si128();
+    if( spt == SCAN_SOCSBB )
+    {
+      const __m128i sbb1  = _mm_loadu_si128( ( const __m128i* ) prev.sbbFracBits[1] );
+      sigA                = _mm_add_epi32( sbb1, sig1 );
+      sigZ                = _mm_add_epi32( sbb1, sig0 );
+    }
+    else if( spt != SCAN_ISCSBB )
+    {
+      const __m128i noSig = _mm_cmpeq_epi32( _mm_loadu_si128( ( const __m128i* ) prev.numSigSbb ), _mm_setzero_si128() );
+      sigA                = _mm_andnot_si128( noSig, sig1 );
+      sigZ                = _mm_andnot_si128( noSig, sig0 );
+      zeroOff             = _mm_and_si128( noSig, regular );
+    }
+    rateA = _mm_and_si128( regular, _mm_add_epi32( coeffA, sigA ) );
+    rateB = _mm_and_si128( regular, _mm_add_epi32( coeffB, sigA ) );
+    rateZ = _mm_and_si128( regular, sigZ );
+
+    // rice parameter dependent parts, only needed for large levels or when the regular coded bins are used up
+    const TCoeff maxLevel = std::max( std::max( pqData[0].absLevel, pqData[1].absLevel ), std::max( pqData[2].absLevel, pqData[3].absLevel ) );
+    if( maxLevel >= 4 || _mm_movemask_epi8( regular ) != 0xFFFF )
+    {
+      int32_t riceA[4], riceB[4], riceZ[4];
+      for( int stateId = 0; stateId < 4; stateId++ )
+      {
+        const int32_t* goRiceTab  = g_goRiceBits[prev.goRicePar[stateId]];
+        const TCoeff   absA       = pqData[stateId < 2 ? 0 : 3].absLevel;
+        const TCoeff   absB       = pqData[stateId < 2 ? 2 : 1].absLevel;
+        if( prev.remRegBins[stateId] >= 4 )
+        {
+          const TCoeff valueA = ( absA - 4 ) >> 1;
+          const TCoeff valueB = ( absB - 4 ) >> 1;
+          riceA[stateId]      = absA < 4 ? 0 : goRiceTab[valueA < RICEMAX ? valueA : RICEMAX - 1];
+          riceB[stateId]      = absB < 4 ? 0 : goRiceTab[valueB < RICEMAX ? valueB : RICEMAX - 1];
+          riceZ[stateId]      = 0;
+        }
+        else
+        {
+          const int32_t goRiceZero = prev.goRiceZero[stateId];
+          riceA[stateId] = ( 1 << SCALE_BITS ) + goRiceTab[absA <= goRiceZero ? absA - 1 : ( absA < RICEMAX ? absA : RICEMAX - 1 )];
+          riceB[stateId] = ( 1 << SCALE_BITS ) + goRiceTab[absB <= goRiceZero ? absB - 1 : ( absB < RICEMAX ? absB : RICEMAX - 1 )];
+          riceZ[stateId] = goRiceTab[goRiceZero];
+        }
+      }
+      rateA = _mm_add_epi32( rateA, _mm_loadu_si128( ( const __m128i* ) riceA ) );
+      rateB = _mm_add_epi32( rateB, _mm_loadu_si128( ( const __m128i* ) riceB ) );
+      rateZ = _mm_add_epi32( rateZ, _mm_loadu_si128( ( const __m128i* ) riceZ ) );
+    }
+  }
+
+  // a < b for 64 bit lanes, the rd costs stay far enough from the int64 limits for the difference not to overflow
+  static inline __m128i dqCmpLt64( const __m128i& a, const __m128i& b )
+  {
+    return _mm_shuffle_epi32( _mm_srai_epi32( _mm_sub_epi64( a, b ), 31 ), 0xF5 );
+  }
+
+  // The candidates of the four decisions are evaluated in the lane order d0, d2, d1, d3. In this order
+  // decision k is updated first by the better of A and zero of state k/2 (d0, d1) or by B of state k/2
+  // (d2, d3), and second by B or the better of A and zero of the other state of the same pair. Each lane
+  // holds the rd cost and the ( absLevel, prevId ) pair of a decision, so it maps to a Decision directly.
+  template<X86_VEXT vext>
+  void checkAllRdCosts_SIMD( const ScanPosType spt, const PQData* pqData, const StateMem& prev, const StateMem* skip, Decision* decisions )
+  {
+    static_assert( sizeof( Decision ) == 16, "Decision has to consist of the 64 bit cost followed by two 32 bit values" );
+
+    __m128i rateA, rateB, rateZ, zeroOff;
+    dqRates( spt, pqData, prev, rateA, rateB, rateZ, zeroOff );
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i rdCost = _mm256_loadu_si256( ( const __m256i* ) prev.rdCost );
+      const __m256i costA  = _mm256_add_epi64( _mm256_add_epi64( rdCost, _mm256_setr_epi64x( pqData[0].deltaDist, pqData[0].deltaDist, pqData[3].deltaDist, pqData[3].deltaDist ) ), _mm256_cvtepi32_epi64( rateA ) );
+      const __m256i costB  = _mm256_add_epi64( _mm256_add_epi64( rdCost, _mm256_setr_epi64x( pqData[2].deltaDist, pqData[2].deltaDist, pqData[1].deltaDist, pqData[1].deltaDist ) ), _mm256_cvtepi32_epi64( rateB ) );
+      const __m256i costZ  = _mm256_add_epi64( rdCost, _mm256_cvtepi32_epi64( rateZ ) );
+      const __m256i levPrevA = _mm256_setr_epi32( pqData[0].absLevel, 0, pqData[0].absLevel, 1, pqData[3].absLevel, 2, pqData[3].absLevel, 3 );
+      const __m256i levPrevB = _mm256_setr_epi32( pqData[2].absLevel, 0, pqData[2].absLevel, 1, pqData[1].absLevel, 2, pqData[1].absLevel, 3 );
+      const __m256i levPrevZ = _mm256_setr_epi32( 0, 0, 0, 1, 0, 2, 0, 3 );
+
+      // zero level, if cheaper than level A
+      const __m256i useZ    = _mm256_andnot_si256( _mm256_cvtepi32_epi64( zeroOff ), _mm256_cmpgt_epi64( costA, costZ ) );
+      const __m256i costAZ  = _mm256_blendv_epi8( costA, costZ, useZ );
+      const __m256i lpAZ    = _mm256_blendv_epi8( levPrevA, levPrevZ, useZ );
+
+      // current decisions
+      const __m256i dec01   = _mm256_loadu_si256( ( const __m256i* ) &decisions[0] );
+      const __m256i dec23   = _mm256_loadu_si256( ( const __m256i* ) &decisions[2] );
+      __m256i       cost    = _mm256_unpacklo_epi64( dec01, dec23 );
+      __m256i       levPrev = _mm256_unpackhi_epi64( dec01, dec23 );
+
+      __m256i cand   = _mm256_unpacklo_epi64( costAZ, costB );
+      __m256i update = _mm256_cmpgt_epi64( cost, cand );
+      cost           = _mm256_blendv_epi8( cost, cand, update );
+      levPrev        = _mm256_blendv_epi8( levPrev, _mm256_unpacklo_epi64( lpAZ, levPrevB ), update );
+
+      cand           = _mm256_unpackhi_epi64( costB, costAZ );
+      update         = _mm256_cmpgt_epi64( cost, cand );
+      cost           = _mm256_blendv_epi8( cost, cand, update );
+      levPrev        = _mm256_blendv_epi8( levPrev, _mm256_unpackhi_epi64( levPrevB, lpAZ ), update );
+
+      if( skip )
+      {
+        cand    = _mm256_add_epi64( _mm256_loadu_si256( ( const __m256i* ) skip->rdCost ), _mm256_cvtepi32_epi64( _mm_loadu_si128( ( const __m128i* ) skip->sbbFracBits[0] ) ) );
+        cand    = _mm256_permute4x64_epi64( cand, 0xD8 );
+        update  = _mm256_cmpgt_epi64( cost, cand );
+        cost    = _mm256_blendv_epi8( cost, cand, update );
+        levPrev = _mm256_blendv_epi8( levPrev, _mm256_setr_epi32( 0, 4, 0, 6, 0, 5, 0, 7 ), update );
+      }
+
+      _mm256_storeu_si256( ( __m256i* ) &decisions[0], _mm256_unpacklo_epi64( cost, levPrev ) );
+      _mm256_storeu_si256( ( __m256i* ) &decisions[2], _mm256_unpackhi_epi64( cost, levPrev ) );
+    }
+    else
+#endif
+    {
+      const __m128i rdCost01 = _mm_loadu_si128( ( const __m128i* ) &prev.rdCost[0] );
+      const __m128i rdCost23 = _mm_loadu_si128( ( const __m128i* ) &prev.rdCost[2] );
+      const __m128i costA01  = _mm_add_epi64( _mm_add_epi64( rdCost01, _mm_set1_epi64x( pqData[0].deltaDist ) ), _mm_cvtepi32_epi64( rateA ) );
+      const __m128i costA23  = _mm_add_epi64( _mm_add_epi64( rdCost23, _mm_set1_epi64x( pqData[3].deltaDist ) ), _mm_cvtepi32_epi64( _mm_srli_si128( rateA, 8 ) ) );
+      const __m128i costB01  = _mm_add_epi64( _mm_add_epi64( rdCost01, _mm_set1_epi64x( pqData[2].deltaDist ) ), _mm_cvtepi32_epi64( rateB ) );
+      const __m128i costB23  = _mm_add_epi64( _mm_add_epi64( rdCost23, _mm_set1_epi64x( pqData[1].deltaDist ) ), _mm_cvtepi32_epi64( _mm_srli_si128( rateB, 8 ) ) );
+      const __m128i costZ01  = _mm_add_epi64( rdCost01, _mm_cvtepi32_epi64( rateZ ) );
+      const __m128i costZ23  = _mm_add_epi64( rdCost23, _mm_cvtepi32_epi64( _mm_srli_si128( rateZ, 8 ) ) );
+      const __m128i lpA01    = _mm_setr_epi32( pqData[0].absLevel, 0, pqData[0].absLevel, 1 );
+      const __m128i lpA23    = _mm_setr_epi32( pqData[3].absLevel, 2, pqData[3].absLevel, 3 );
+      const __m128i lpB01    = _mm_setr_epi32( pqData[2].absLevel, 0, pqData[2].absLevel, 1 );
+      const __m128i lpB23    = _mm_setr_epi32( pqData[1].absLevel, 2, pqData[1].absLevel, 3 );
+
+      // zero level, if cheaper than level A
+      const __m128i useZ01   = _mm_andnot_si128( _mm_cvtepi32_epi64( zeroOff ), dqCmpLt64( costZ01, costA01 ) );
+      const __m128i useZ23   = _mm_andnot_si128( _mm_cvtepi32_epi64( _mm_srli_si128( zeroOff, 8 ) ), dqCmpLt64( costZ23, costA23 ) );
+      const __m128i costAZ01 = _mm_blendv_epi8( costA01, costZ01, useZ01 );
+      const __m128i costAZ23 = _mm_blendv_epi8( costA23, costZ23, useZ23 );
+      const __m128i lpAZ01   = _mm_blendv_epi8( lpA01, _mm_setr_epi32( 0, 0, 0, 1 ), useZ01 );
+      const __m128i lpAZ23   = _mm_blendv_epi8( lpA23, _mm_setr_epi32( 0, 2, 0, 3 ), useZ23 );
+
+      // current decisions, lanes ( d0, d2 ) and ( d1, d3 )
+      const __m128i dec0     = _mm_loadu_si128( ( const __m128i* ) &decisions[0] );
+      const __m128i dec1     = _mm_loadu_si128( ( const __m128i* ) &decisions[1] );
+      const __m128i dec2     = _mm_loadu_si128( ( const __m128i* ) &decisions[2] );
+      const __m128i dec3     = _mm_loadu_si128( ( const __m128i* ) &decisions[3] );
+      __m128i       cost02   = _mm_unpacklo_epi64( dec0, dec2 );
+      __m128i       cost13   = _mm_unpacklo_epi64( dec1, dec3 );
+      __m128i       lp02     = _mm_unpackhi_epi64( dec0, dec2 );
+      __m128i       lp13     = _mm_unpackhi_epi64( dec1, dec3 );
+
+      __m128i cand   = _mm_unpacklo_epi64( costAZ01, costB01 );
+      __m128i update = dqCmpLt64( cand, cost02 );
+      cost02         = _mm_blendv_epi8( cost02, cand, update );
+      lp02           = _mm_blendv_epi8( lp02, _mm_unpacklo_epi64( lpAZ01, lpB01 ), update );
+      cand           = _mm_unpacklo_epi64( costAZ23, costB23 );
+      update         = dqCmpLt64( cand, cost13 );
+      cost13         = _mm_blendv_epi8( cost13, cand, update );
+      lp13           = _mm_blendv_epi8( lp13, _mm_unpacklo_epi64( lpAZ23, lpB23 ), update );
+
+      cand           = _mm_unpackhi_epi64( costB01, costAZ01 );
+      update         = dqCmpLt64( cand, cost02 );
+      cost02         = _mm_blendv_epi8( cost02, cand, update );
+      lp02           = _mm_blendv_epi8( lp02, _mm_unpackhi_epi64( lpB01, lpAZ01 ), update );
+      cand           = _mm_unpackhi_epi64( costB23, costAZ23 );
+      update         = dqCmpLt64( cand, cost13 );
+      cost13         = _mm_blendv_epi8( cost13, cand, update );
+      lp13           = _mm_blendv_epi8( lp13, _mm_unpackhi_epi64( lpB23, lpAZ23 ), update );
+
+      if( skip )
+      {
+        const __m128i sbb0      = _mm_loadu_si128( ( const __m128i* ) skip->sbbFracBits[0] );
+        const __m128i skipCost01 = _mm_add_epi64( _mm_loadu_si128( ( const __m128i* ) &skip->rdCost[0] ), _mm_cvtepi32_epi64( sbb0 ) );
+        const __m128i skipCost23 = _mm_add_epi64( _mm_loadu_si128( ( const __m128i* ) &skip->rdCost[2] ), _mm_cvtepi32_epi64( _mm_srli_si128( sbb0, 8 ) ) );
+        cand    = _mm_unpacklo_epi64( skipCost01, skipCost23 );
+        update  = dqCmpLt64( cand, cost02 );
+        cost02  = _mm_blendv_epi8( cost02, cand, update );
+        lp02    = _mm_blendv_epi8( lp02, _mm_setr_epi32( 0, 4, 0, 6 ), update );
+        cand    = _mm_unpackhi_epi64( skipCost01, skipCost23 );
+        update  = dqCmpLt64( cand, cost13 );
+        cost13  = _mm_blendv_epi8( cost13, cand, update );
+        lp13    = _mm_blendv_epi8( lp13, _mm_setr_epi32( 0, 5, 0, 7 ), update );
+      }
+
+      _mm_storeu_si128( ( __m128i* ) &decisions[0], _mm_unpacklo_epi64( cost02, lp02 ) );
+      _mm_storeu_si128( ( __m128i* ) &decisions[1], _mm_unpacklo_epi64( cost13, lp13 ) );
+      _mm_storeu_si128( ( __m128i* ) &decisions[2], _mm_unpackhi_epi64( cost02, lp02 ) );
+      _mm_storeu_si128( ( __m128i* ) &decisions[3], _mm_unpackhi_epi64( cost13, lp13 ) );
+    }
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void DepQuant::_initDepQuantX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_checkAllRdCosts = DQIntern::checkAllRdCosts_SIMD<vext>;
+#endif
+}
+
+template void DepQuant::_initDepQuantX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+
+//! \}
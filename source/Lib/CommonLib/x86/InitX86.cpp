@@ -48,6 +48,18 @@
 
 #include "CommonLib/AdaptiveLoopFilter.h"
 
+#include "CommonLib/DeblockingFilter.h"
+
+#include "CommonLib/SampleAdaptiveOffset.h"
+
+#include "CommonLib/IntraPrediction.h"
+
+#include "CommonLib/MatrixIntraPrediction.h"
+
+#include "CommonLib/Quant.h"
+
+#include "CommonLib/DepQuant.h"
+
 #include "CommonLib/IbcHashMap.h"
 
 #ifdef TARGET_SIMD_X86
@@ -59,6 +71,8 @@ void InterpolationFilter::initInterpolationFilterX86( /*int iBitDepthY, int iBit
   auto vext = read_x86_extension_flags();
   switch (vext){
   case AVX512:
+    _initInterpolationFilterX86<AVX512>(/*iBitDepthY, iBitDepthC*/);
+    break;
   case AVX2:
     _initInterpolationFilterX86<AVX2>(/*iBitDepthY, iBitDepthC*/);
     break;
@@ -81,6 +95,8 @@ void PelBufferOps::initPelBufOpsX86()
   auto vext = read_x86_extension_flags();
   switch (vext){
     case AVX512:
+      _initPelBufOpsX86<AVX512>();
+      break;
     case AVX2:
       _initPelBufOpsX86<AVX2>();
       break;
@@ -106,6 +122,8 @@ void RdCost::initRdCostX86()
   auto vext = read_x86_extension_flags();
   switch (vext){
     case AVX512:
+      _initRdCostX86<AVX512>();
+      break;
     case AVX2:
       _initRdCostX86<AVX2>();
       break;
@@ -151,6 +169,8 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
   switch ( vext )
   {
   case AVX512:
+    _initAdaptiveLoopFilterX86<AVX512>();
+    break;
   case AVX2:
     _initAdaptiveLoopFilterX86<AVX2>();
     break;
@@ -167,6 +187,167 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_TRAFO
+void TrQuant::initTrQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initTrQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initTrQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initTrQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DBLF
+void DeblockingFilter::initDeblockingFilterX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initDeblockingFilterX86<AVX2>();
+    break;
+  case AVX:
+    _initDeblockingFilterX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initDeblockingFilterX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+void SampleAdaptiveOffset::initSampleAdaptiveOffsetX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initSampleAdaptiveOffsetX86<AVX2>();
+    break;
+  case AVX:
+    _initSampleAdaptiveOffsetX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initSampleAdaptiveOffsetX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_INTRA
+void IntraPrediction::initIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+    _initIntraPredictionX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_MIP
+void MatrixIntraPrediction::initMatrixIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initMatrixIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+    _initMatrixIntraPredictionX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initMatrixIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DEPQUANT
+void DepQuant::initDepQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initDepQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initDepQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initDepQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_QUANT
+void Quant::initQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_IBC
 void IbcHashMap::initIbcHashMapX86()
 {
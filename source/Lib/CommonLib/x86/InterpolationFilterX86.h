@@ -549,6 +549,95 @@ static void simdInterpolateHorM16_AVX2( const int16_t* src, int srcStride, int16
 }
 
 
+template<X86_VEXT vext, int N, bool shiftBack>
+static void simdInterpolateHorM32_AVX512( const int16_t* src, int srcStride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, int16_t const *coeff )
+{
+#ifdef USE_AVX512
+  const int filterSpan = ( N-1 );
+  _mm_prefetch( (const char*)( src+srcStride ), _MM_HINT_T0 );
+  _mm_prefetch( (const char*)( src+( width>>1 )+srcStride ), _MM_HINT_T0 );
+  _mm_prefetch( (const char*)( src+width+filterSpan+srcStride ), _MM_HINT_T0 );
+
+  __m512i voffset    = _mm512_set1_epi32( offset );
+  __m512i vibdimin   = _mm512_set1_epi16( clpRng.min );
+  __m512i vibdimax   = _mm512_set1_epi16( clpRng.max );
+  __m512i vzero      = _mm512_setzero_si512();
+  __m512i vsum, vsuma, vsumb;
+
+  // same in-lane pairing as the AVX2 version, repeated over the four 128-bit lanes
+  __m512i vshuf0 = _mm512_maskz_broadcast_i32x4( 0xFFFF, _mm_set_epi8( 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4, 0x5, 0x4, 0x3, 0x2, 0x3, 0x2, 0x1, 0x0 ) );
+  __m512i vshuf1 = _mm512_maskz_broadcast_i32x4( 0xFFFF, _mm_set_epi8( 0xd, 0xc, 0xb, 0xa, 0xb, 0xa, 0x9, 0x8, 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4 ) );
+  __m512i vcoeff[N/2];
+  for( int i=0; i<N; i+=2 )
+  {
+    vcoeff[i/2] = _mm512_unpacklo_epi16( _mm512_set1_epi16( coeff[i] ), _mm512_set1_epi16( coeff[i+1] ) );
+  }
+
+  for( int row = 0; row < height; row++ )
+  {
+    _mm_prefetch( (const char*)( src+2*srcStride ), _MM_HINT_T0 );
+    _mm_prefetch( (const char*)( src+( width>>1 )+2*srcStride ), _MM_HINT_T0 );
+    _mm_prefetch( (const char*)( src+width+filterSpan + 2*srcStride ), _MM_HINT_T0 );
+
+    for( int col = 0; col < width; col+=32 )
+    {
+      __m512i vsrc[3];
+      for( int i=0; i<3; i++ )
+      {
+        vsrc[i] = _mm512_loadu_si512( ( const __m512i * )&src[col+i*4] );
+      }
+      if( N==8 )
+      {
+        vsuma = vsumb = vzero;
+        for( int i=0; i<2; i++ )
+        {
+          __m512i vsrca0 = _mm512_shuffle_epi8( vsrc[i], vshuf0 );
+          __m512i vsrca1 = _mm512_shuffle_epi8( vsrc[i], vshuf1 );
+          __m512i vsrcb0 = _mm512_shuffle_epi8( vsrc[i+1], vshuf0 );
+          __m512i vsrcb1 = _mm512_shuffle_epi8( vsrc[i+1], vshuf1 );
+          vsuma  = _mm512_add_epi32( vsuma, _mm512_add_epi32( _mm512_madd_epi16( vsrca0, vcoeff[2*i] ), _mm512_madd_epi16( vsrca1, vcoeff[2*i+1] ) ) );
+          vsumb  = _mm512_add_epi32( vsumb, _mm512_add_epi32( _mm512_madd_epi16( vsrcb0, vcoeff[2*i] ), _mm512_madd_epi16( vsrcb1, vcoeff[2*i+1] ) ) );
+        }
+      }
+      else
+      {
+        __m512i vtmp00, vtmp01, vtmp10, vtmp11;
+        {
+          vtmp00 = _mm512_shuffle_epi8( vsrc[0], vshuf0 );
+          vtmp01 = _mm512_shuffle_epi8( vsrc[0], vshuf1 );
+          vtmp10 = _mm512_shuffle_epi8( vsrc[1], vshuf0 );
+          vtmp11 = _mm512_shuffle_epi8( vsrc[1], vshuf1 );
+        }
+        vtmp00 = _mm512_madd_epi16( vtmp00, vcoeff[0] );
+        vtmp01 = _mm512_madd_epi16( vtmp01, vcoeff[1] );
+        vtmp10 = _mm512_madd_epi16( vtmp10, vcoeff[0] );
+        vtmp11 = _mm512_madd_epi16( vtmp11, vcoeff[1] );
+
+        vsuma = _mm512_add_epi32( vtmp00, vtmp01 );
+        vsumb = _mm512_add_epi32( vtmp10, vtmp11 );
+      }
+
+      {
+        vsuma = _mm512_add_epi32( vsuma, voffset );
+        vsumb = _mm512_add_epi32( vsumb, voffset );
+        vsuma = _mm512_maskz_srai_epi32( 0xFFFF, vsuma, shift );
+        vsumb = _mm512_maskz_srai_epi32( 0xFFFF, vsumb, shift );
+        vsum  = _mm512_packs_epi32( vsuma, vsumb );
+      }
+
+      if( shiftBack )
+      { //clip
+        vsum = _mm512_min_epi16( vibdimax, _mm512_max_epi16( vibdimin, vsum ) );
+      }
+      _mm512_storeu_si512( ( __m512i * )&dst[col], vsum );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+#endif
+}
+
+
 template<X86_VEXT vext, int N, bool shiftBack>
 static void simdInterpolateVerM4( const int16_t *src, int srcStride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, int16_t const *coeff )
 {
@@ -832,6 +921,73 @@ static void simdInterpolateVerM16_AVX2( const int16_t *src, int srcStride, int16
 }
 
 
+template<X86_VEXT vext, int N, bool shiftBack>
+static void simdInterpolateVerM32_AVX512( const int16_t *src, int srcStride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, int16_t const *coeff )
+{
+#ifdef USE_AVX512
+  __m512i voffset    = _mm512_set1_epi32( offset );
+  __m512i vibdimin   = _mm512_set1_epi16( clpRng.min );
+  __m512i vibdimax   = _mm512_set1_epi16( clpRng.max );
+  __m512i vzero      = _mm512_setzero_si512();
+  __m512i vsum, vsuma, vsumb;
+
+  __m512i vsrc[N];
+  __m512i vcoeff[N/2];
+  for( int i=0; i<N; i+=2 )
+  {
+    vcoeff[i/2] = _mm512_unpacklo_epi16( _mm512_set1_epi16( coeff[i] ), _mm512_set1_epi16( coeff[i+1] ) );
+  }
+
+  const short *srcOrig = src;
+  int16_t *dstOrig = dst;
+
+  for( int col = 0; col < width; col+=32 )
+  {
+    for( int i=0; i<N-1; i++ )
+    {
+      vsrc[i] = _mm512_loadu_si512( ( const __m512i * )&src[col + i * srcStride] );
+    }
+    for( int row = 0; row < height; row++ )
+    {
+      vsrc[N-1]= _mm512_loadu_si512( ( const __m512i * )&src[col + ( N-1 ) * srcStride] );
+      vsuma = vsumb = vzero;
+      for( int i=0; i<N; i+=2 )
+      {
+        __m512i vsrca = _mm512_unpacklo_epi16( vsrc[i], vsrc[i+1] );
+        __m512i vsrcb = _mm512_unpackhi_epi16( vsrc[i], vsrc[i+1] );
+        vsuma  = _mm512_add_epi32( vsuma, _mm512_madd_epi16( vsrca, vcoeff[i/2] ) );
+        vsumb  = _mm512_add_epi32( vsumb, _mm512_madd_epi16( vsrcb, vcoeff[i/2] ) );
+      }
+      for( int i=0; i<N-1; i++ )
+      {
+        vsrc[i] = vsrc[i+1];
+      }
+
+      {
+        vsuma = _mm512_add_epi32( vsuma, voffset );
+        vsumb = _mm512_add_epi32( vsumb, voffset );
+        vsuma = _mm512_maskz_srai_epi32( 0xFFFF, vsuma, shift );
+        vsumb = _mm512_maskz_srai_epi32( 0xFFFF, vsumb, shift );
+        vsum  = _mm512_packs_epi32( vsuma, vsumb );
+      }
+
+      if( shiftBack )
+      { //clip
+        vsum = _mm512_min_epi16( vibdimax, _mm512_max_epi16( vibdimin, vsum ) );
+      }
+
+      _mm512_storeu_si512( ( __m512i * )&dst[col], vsum );
+
+      src += srcStride;
+      dst += dstStride;
+    }
+    src= srcOrig;
+    dst= dstOrig;
+  }
+#endif
+}
+
+
 template<int N, bool isLast>
 inline void interpolate( const int16_t* src, int cStride, int16_t *dst, int width, int shift, int offset, int bitdepth, int maxVal, int16_t const *c )
 {
@@ -2208,7 +2364,9 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
           simdInterpolateHorM8_HBD<vext, 8, isLast>(src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c);
         }
 #else
-        if( vext>= AVX2 )
+        if( vext >= AVX512 && !( width & 0x1f ) )
+          simdInterpolateHorM32_AVX512<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+        else if( vext>= AVX2 )
           simdInterpolateHorM8_AVX2<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
         else
           simdInterpolateHorM8<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
@@ -2226,7 +2384,9 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
           simdInterpolateVerM8_HBD<vext, 8, isLast>(src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c);
         }
 #else
-        if( vext>= AVX2 )
+        if( vext >= AVX512 && !( width & 0x1f ) )
+          simdInterpolateVerM32_AVX512<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+        else if( vext>= AVX2 )
           simdInterpolateVerM8_AVX2<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
         else
           simdInterpolateVerM8<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
@@ -2372,6 +2532,126 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
   }
 }
 
+#if ENABLE_8BIT_REFERENCES && !RExt__HIGH_BIT_DEPTH_SUPPORT
+// first filtering operation on 8-bit samples of bit depth 8: the sums of the products fit into 16 bit, so two taps at a
+// time are applied by multiplying the unsigned sample bytes with the signed tap bytes and adding the pairs
+template<int N>
+static inline void simdFilter8bitTaps( TFilterCoeff const *coeff, __m128i *vcoeff )
+{
+  for( int k = 0; k < N; k += 2 )
+  {
+    vcoeff[k >> 1] = _mm_set1_epi16( ( short ) ( ( coeff[k] & 0xff ) | ( ( coeff[k + 1] & 0xff ) << 8 ) ) );
+  }
+}
+
+template<bool isLast>
+static inline void simdFilter8bitStore( __m128i vsum, const __m128i& voffset, const __m128i& vmin, const __m128i& vmax, Pel* dst, const int num )
+{
+  vsum = _mm_add_epi16( vsum, voffset );
+  if( isLast )
+  {
+    vsum = _mm_min_epi16( vmax, _mm_max_epi16( vmin, _mm_srai_epi16( vsum, IF_FILTER_PREC ) ) );
+  }
+  if( num >= 8 )
+  {
+    _mm_storeu_si128( ( __m128i* ) dst, vsum );
+  }
+  else
+  {
+    _mm_storel_epi64( ( __m128i* ) dst, vsum );
+  }
+}
+
+template<X86_VEXT vext, int N, bool isLast>
+static void simdInterpolateHor8bit( const uint8_t* src, int srcStride, Pel* dst, int dstStride, int width, int height, const ClpRng& clpRng, TFilterCoeff const *coeff )
+{
+  __m128i vcoeff[N / 2];
+  __m128i vshuf [N / 2];
+  simdFilter8bitTaps<N>( coeff, vcoeff );
+  for( int k = 0; k < N; k += 2 )
+  {
+    vshuf[k >> 1] = _mm_setr_epi8( k, k + 1, k + 1, k + 2, k + 2, k + 3, k + 3, k + 4, k + 4, k + 5, k + 5, k + 6, k + 6, k + 7, k + 7, k + 8 );
+  }
+  const __m128i voffset = _mm_set1_epi16( isLast ? 1 << ( IF_FILTER_PREC - 1 ) : -IF_INTERNAL_OFFS );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+  for( int row = 0; row < height; row++ )
+  {
+    for( int col = 0; col < width; col += 8 )
+    {
+      const __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[col] );
+      __m128i       vsum = _mm_maddubs_epi16( _mm_shuffle_epi8( vsrc, vshuf[0] ), vcoeff[0] );
+      for( int k = 1; k < N / 2; k++ )
+      {
+        vsum = _mm_add_epi16( vsum, _mm_maddubs_epi16( _mm_shuffle_epi8( vsrc, vshuf[k] ), vcoeff[k] ) );
+      }
+      simdFilter8bitStore<isLast>( vsum, voffset, vmin, vmax, &dst[col], width - col );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext, int N, bool isLast>
+static void simdInterpolateVer8bit( const uint8_t* src, int srcStride, Pel* dst, int dstStride, int width, int height, const ClpRng& clpRng, TFilterCoeff const *coeff )
+{
+  __m128i vcoeff[N / 2];
+  simdFilter8bitTaps<N>( coeff, vcoeff );
+  const __m128i voffset = _mm_set1_epi16( isLast ? 1 << ( IF_FILTER_PREC - 1 ) : -IF_INTERNAL_OFFS );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+
+  for( int row = 0; row < height; row++ )
+  {
+    for( int col = 0; col < width; col += 8 )
+    {
+      __m128i vsum = _mm_setzero_si128();
+      for( int k = 0; k < N; k += 2 )
+      {
+        const __m128i va = _mm_loadl_epi64( ( const __m128i* ) &src[col +   k       * srcStride] );
+        const __m128i vb = _mm_loadl_epi64( ( const __m128i* ) &src[col + ( k + 1 ) * srcStride] );
+        vsum = _mm_add_epi16( vsum, _mm_maddubs_epi16( _mm_unpacklo_epi8( va, vb ), vcoeff[k >> 1] ) );
+      }
+      simdFilter8bitStore<isLast>( vsum, voffset, vmin, vmax, &dst[col], width - col );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext, int N, bool isVertical, bool isLast>
+static void simdFilter8bit( const ClpRng& clpRng, uint8_t const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR )
+{
+  if( biMCForDMVR || clpRng.bd != 8 || ( width & 3 ) )
+  {
+    InterpolationFilter::filter<N, isVertical, true, isLast, uint8_t>( clpRng, src, srcStride, dst, dstStride, width, height, coeff, biMCForDMVR );
+    return;
+  }
+
+  if( isVertical )
+  {
+    simdInterpolateVer8bit<vext, N, isLast>( src - ( N / 2 - 1 ) * srcStride, srcStride, dst, dstStride, width, height, clpRng, coeff );
+  }
+  else
+  {
+    simdInterpolateHor8bit<vext, N, isLast>( src - ( N / 2 - 1 ), srcStride, dst, dstStride, width, height, clpRng, coeff );
+  }
+}
+
+template<X86_VEXT vext, bool isLast>
+static void simdFilterCopy8bit( const ClpRng& clpRng, const uint8_t* src, int srcStride, Pel* dst, int dstStride, int width, int height, bool biMCForDMVR )
+{
+  if( biMCForDMVR || ( width & 7 ) )
+  {
+    InterpolationFilter::filterCopy<true, isLast, uint8_t>( clpRng, src, srcStride, dst, dstStride, width, height, biMCForDMVR );
+    return;
+  }
+
+  fullPelCopySSE<uint8_t, 8, true, isLast>( clpRng, src, srcStride, dst, dstStride, width, height );
+}
+#endif
+
 template< X86_VEXT vext >
 void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1)
 {
@@ -2670,6 +2950,22 @@ void InterpolationFilter::_initInterpolationFilterX86()
   m_filterCopy[1][0]   = simdFilterCopy<vext, true, false>;
   m_filterCopy[1][1]   = simdFilterCopy<vext, true, true>;
 
+#if ENABLE_8BIT_REFERENCES
+  // [taps][bLast], the bilinear filter stays scalar
+  m_filterHor8[0][0]   = simdFilter8bit<vext, 8, false, false>;
+  m_filterHor8[0][1]   = simdFilter8bit<vext, 8, false, true>;
+  m_filterHor8[1][0]   = simdFilter8bit<vext, 4, false, false>;
+  m_filterHor8[1][1]   = simdFilter8bit<vext, 4, false, true>;
+
+  m_filterVer8[0][0]   = simdFilter8bit<vext, 8, true, false>;
+  m_filterVer8[0][1]   = simdFilter8bit<vext, 8, true, true>;
+  m_filterVer8[1][0]   = simdFilter8bit<vext, 4, true, false>;
+  m_filterVer8[1][1]   = simdFilter8bit<vext, 4, true, true>;
+
+  m_filterCopy8[0]     = simdFilterCopy8bit<vext, false>;
+  m_filterCopy8[1]     = simdFilterCopy8bit<vext, true>;
+#endif
+
   m_weightedGeoBlk = xWeightedGeoBlk_SSE<vext>;
 #endif
 }
@@ -0,0 +1,600 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     IntraPredictionX86.h
+    \brief    intra prediction, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+#include "../InterpolationFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// planar samples x..x+3 of a row from the running vertical sums and the row's horizontal base and slope
+static inline __m128i planarQuad( const int* vertPred, const int x, const __m128i& horBase, const __m128i& horSlope, const int log2W, const int log2H, const __m128i& offset, const int finalShift )
+{
+  const __m128i xPos    = _mm_add_epi32( _mm_set1_epi32( x ), _mm_setr_epi32( 1, 2, 3, 4 ) );
+  const __m128i horPred = _mm_add_epi32( horBase, _mm_mullo_epi32( xPos, horSlope ) );
+  const __m128i verPred = _mm_loadu_si128( ( const __m128i* ) &vertPred[x] );
+  __m128i sum           = _mm_add_epi32( _mm_slli_epi32( horPred, log2H ), _mm_slli_epi32( verPred, log2W ) );
+  return _mm_srai_epi32( _mm_add_epi32( sum, offset ), finalShift );
+}
+
+#ifdef USE_AVX2
+static inline __m256i planarOct( const int* vertPred, const int x, const __m256i& horBase, const __m256i& horSlope, const int log2W, const int log2H, const __m256i& offset, const int finalShift )
+{
+  const __m256i xPos    = _mm256_add_epi32( _mm256_set1_epi32( x ), _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 ) );
+  const __m256i horPred = _mm256_add_epi32( horBase, _mm256_mullo_epi32( xPos, horSlope ) );
+  const __m256i verPred = _mm256_loadu_si256( ( const __m256i* ) &vertPred[x] );
+  __m256i sum           = _mm256_add_epi32( _mm256_slli_epi32( horPred, log2H ), _mm256_slli_epi32( verPred, log2W ) );
+  return _mm256_srai_epi32( _mm256_add_epi32( sum, offset ), finalShift );
+}
+#endif
+
+template<X86_VEXT vext>
+static void predIntraPlanar_SIMD( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const int width  = pDst.width;
+  const int height = pDst.height;
+  const int log2W  = floorLog2( width );
+  const int log2H  = floorLog2( height );
+
+  CHECK( width > MAX_CU_SIZE, "width greater than limit" );
+  CHECK( height > MAX_CU_SIZE, "height greater than limit" );
+
+  const Pel* top        = pSrc.bufAt( 1, 0 );
+  const Pel* left       = pSrc.bufAt( 1, 1 );
+  const int  bottomLeft = left[height];
+  const int  topRight   = top[width];
+
+  // vertPred[x] holds ( topRow[x] << log2H ) + ( y + 1 ) * bottomRow[x] for the current row y
+  int vertPred[MAX_CU_SIZE], bottomRow[MAX_CU_SIZE];
+  for( int x = 0; x < width; x++ )
+  {
+    bottomRow[x] = bottomLeft - top[x];
+    vertPred[x]  = ( top[x] << log2H ) + bottomRow[x];
+  }
+
+  const int     finalShift = 1 + log2W + log2H;
+  const __m128i offset     = _mm_set1_epi32( 1 << ( log2W + log2H ) );
+  Pel*          pred       = pDst.buf;
+
+  for( int y = 0; y < height; y++, pred += pDst.stride )
+  {
+    const int horBase  = left[y] << log2W;
+    const int horSlope = topRight - left[y];
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vhorBase  = _mm256_set1_epi32( horBase );
+      const __m256i vhorSlope = _mm256_set1_epi32( horSlope );
+      const __m256i voffset   = _mm256_set1_epi32( 1 << ( log2W + log2H ) );
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i lo  = planarOct( vertPred, x,     vhorBase, vhorSlope, log2W, log2H, voffset, finalShift );
+        const __m256i hi  = planarOct( vertPred, x + 8, vhorBase, vhorSlope, log2W, log2H, voffset, finalShift );
+        const __m256i res = _mm256_permute4x64_epi64( _mm256_packs_epi32( lo, hi ), 0xd8 );
+        _mm256_storeu_si256( ( __m256i* ) &pred[x], res );
+      }
+    }
+#endif
+    const __m128i vhorBase  = _mm_set1_epi32( horBase );
+    const __m128i vhorSlope = _mm_set1_epi32( horSlope );
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i lo = planarQuad( vertPred, x,     vhorBase, vhorSlope, log2W, log2H, offset, finalShift );
+      const __m128i hi = planarQuad( vertPred, x + 4, vhorBase, vhorSlope, log2W, log2H, offset, finalShift );
+      _mm_storeu_si128( ( __m128i* ) &pred[x], _mm_packs_epi32( lo, hi ) );
+    }
+    for( ; x + 4 <= width; x += 4 )
+    {
+      const __m128i res = planarQuad( vertPred, x, vhorBase, vhorSlope, log2W, log2H, offset, finalShift );
+      _mm_storel_epi64( ( __m128i* ) &pred[x], _mm_packs_epi32( res, res ) );
+    }
+    for( ; x < width; x++ )
+    {
+      pred[x] = ( ( ( horBase + ( x + 1 ) * horSlope ) << log2H ) + ( vertPred[x] << log2W ) + ( 1 << ( log2W + log2H ) ) ) >> finalShift;
+    }
+
+    x = 0;
+    for( ; x + 4 <= width; x += 4 )
+    {
+      const __m128i vert = _mm_add_epi32( _mm_loadu_si128( ( const __m128i* ) &vertPred[x] ), _mm_loadu_si128( ( const __m128i* ) &bottomRow[x] ) );
+      _mm_storeu_si128( ( __m128i* ) &vertPred[x], vert );
+    }
+    for( ; x < width; x++ )
+    {
+      vertPred[x] += bottomRow[x];
+    }
+  }
+}
+
+static inline int sumSamples( const Pel* src, const int num )
+{
+  __m128i acc = _mm_setzero_si128();
+  int     idx = 0;
+  for( ; idx + 8 <= num; idx += 8 )
+  {
+    acc = _mm_add_epi32( acc, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &src[idx] ), _mm_set1_epi16( 1 ) ) );
+  }
+  for( ; idx + 4 <= num; idx += 4 )
+  {
+    acc = _mm_add_epi32( acc, _mm_madd_epi16( _mm_loadl_epi64( ( const __m128i* ) &src[idx] ), _mm_set1_epi16( 1 ) ) );
+  }
+  acc     = _mm_add_epi32( acc, _mm_shuffle_epi32( acc, 0x4e ) );
+  acc     = _mm_add_epi32( acc, _mm_shuffle_epi32( acc, 0xb1 ) );
+  int sum = _mm_cvtsi128_si32( acc );
+  for( ; idx < num; idx++ )
+  {
+    sum += src[idx];
+  }
+  return sum;
+}
+
+template<X86_VEXT vext>
+static void predIntraDc_SIMD( const Pel* refAbove, const Pel* refLeft, PelBuf &pDst )
+{
+  const int width     = pDst.width;
+  const int height    = pDst.height;
+  const int denom     = ( width == height ) ? ( width << 1 ) : std::max( width, height );
+  const int divShift  = floorLog2( denom );
+  const int divOffset = denom >> 1;
+
+  int sum = 0;
+  if( width >= height )
+  {
+    sum += sumSamples( refAbove, width );
+  }
+  if( width <= height )
+  {
+    sum += sumSamples( refLeft, height );
+  }
+
+  const Pel dcVal = ( sum + divOffset ) >> divShift;
+  const __m128i vdc = _mm_set1_epi16( dcVal );
+#ifdef USE_AVX2
+  const __m256i vdc256 = _mm256_set1_epi16( dcVal );
+#endif
+  Pel* dst = pDst.buf;
+
+  for( int y = 0; y < height; y++, dst += pDst.stride )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], vdc256 );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      _mm_storeu_si128( ( __m128i* ) &dst[x], vdc );
+    }
+    for( ; x + 4 <= width; x += 4 )
+    {
+      _mm_storel_epi64( ( __m128i* ) &dst[x], vdc );
+    }
+    for( ; x < width; x++ )
+    {
+      dst[x] = dcVal;
+    }
+  }
+}
+
+// 4-tap filtering of 8 samples starting at ref, coefficients as interleaved pairs { f0, f1 } and { f2, f3 }
+static inline __m128i filter4Tap( const Pel* ref, const __m128i& f01, const __m128i& f23 )
+{
+  const __m128i r0 = _mm_loadu_si128( ( const __m128i* ) &ref[0] );
+  const __m128i r1 = _mm_loadu_si128( ( const __m128i* ) &ref[1] );
+  const __m128i r2 = _mm_loadu_si128( ( const __m128i* ) &ref[2] );
+  const __m128i r3 = _mm_loadu_si128( ( const __m128i* ) &ref[3] );
+  __m128i lo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( r0, r1 ), f01 ), _mm_madd_epi16( _mm_unpacklo_epi16( r2, r3 ), f23 ) );
+  __m128i hi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( r0, r1 ), f01 ), _mm_madd_epi16( _mm_unpackhi_epi16( r2, r3 ), f23 ) );
+  lo = _mm_srai_epi32( _mm_add_epi32( lo, _mm_set1_epi32( 32 ) ), 6 );
+  hi = _mm_srai_epi32( _mm_add_epi32( hi, _mm_set1_epi32( 32 ) ), 6 );
+  return _mm_packs_epi32( lo, hi );
+}
+
+// same for 4 samples, the result is in the lower half
+static inline __m128i filter4TapQuad( const Pel* ref, const __m128i& f01, const __m128i& f23 )
+{
+  const __m128i r0 = _mm_loadl_epi64( ( const __m128i* ) &ref[0] );
+  const __m128i r1 = _mm_loadl_epi64( ( const __m128i* ) &ref[1] );
+  const __m128i r2 = _mm_loadl_epi64( ( const __m128i* ) &ref[2] );
+  const __m128i r3 = _mm_loadl_epi64( ( const __m128i* ) &ref[3] );
+  __m128i sum = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( r0, r1 ), f01 ), _mm_madd_epi16( _mm_unpacklo_epi16( r2, r3 ), f23 ) );
+  sum = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 32 ) ), 6 );
+  return _mm_packs_epi32( sum, sum );
+}
+
+#ifdef USE_AVX2
+static inline __m256i filter4Tap( const Pel* ref, const __m256i& f01, const __m256i& f23 )
+{
+  const __m256i r0 = _mm256_loadu_si256( ( const __m256i* ) &ref[0] );
+  const __m256i r1 = _mm256_loadu_si256( ( const __m256i* ) &ref[1] );
+  const __m256i r2 = _mm256_loadu_si256( ( const __m256i* ) &ref[2] );
+  const __m256i r3 = _mm256_loadu_si256( ( const __m256i* ) &ref[3] );
+  __m256i lo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( r0, r1 ), f01 ), _mm256_madd_epi16( _mm256_unpacklo_epi16( r2, r3 ), f23 ) );
+  __m256i hi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( r0, r1 ), f01 ), _mm256_madd_epi16( _mm256_unpackhi_epi16( r2, r3 ), f23 ) );
+  lo = _mm256_srai_epi32( _mm256_add_epi32( lo, _mm256_set1_epi32( 32 ) ), 6 );
+  hi = _mm256_srai_epi32( _mm256_add_epi32( hi, _mm256_set1_epi32( 32 ) ), 6 );
+  return _mm256_packs_epi32( lo, hi );
+}
+#endif
+
+static inline int coeffPair( const int c0, const int c1 )
+{
+  return ( c0 & 0xffff ) | ( c1 << 16 );
+}
+
+template<X86_VEXT vext>
+static void predIntraAngLuma_SIMD( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, int deltaPos, const int intraPredAngle, const bool useCubicFilter, const ClpRng& clpRng )
+{
+  const __m128i vmin = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax = _mm_set1_epi16( clpRng.max );
+
+  for( int y = 0; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride )
+  {
+    const int deltaInt   = deltaPos >> 5;
+    const int deltaFract = deltaPos & 31;
+
+    const TFilterCoeff  intraSmoothingFilter[4] = { TFilterCoeff( 16 - ( deltaFract >> 1 ) ), TFilterCoeff( 32 - ( deltaFract >> 1 ) ), TFilterCoeff( 16 + ( deltaFract >> 1 ) ), TFilterCoeff( deltaFract >> 1 ) };
+    const TFilterCoeff* f                       = useCubicFilter ? InterpolationFilter::getChromaFilterTable( deltaFract ) : intraSmoothingFilter;
+
+    const Pel* ref = refMain + deltaInt;
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i f01  = _mm256_set1_epi32( coeffPair( f[0], f[1] ) );
+      const __m256i f23  = _mm256_set1_epi32( coeffPair( f[2], f[3] ) );
+      const __m256i min  = _mm256_set1_epi16( clpRng.min );
+      const __m256i max  = _mm256_set1_epi16( clpRng.max );
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i val = _mm256_min_epi16( max, _mm256_max_epi16( min, filter4Tap( &ref[x], f01, f23 ) ) );
+        _mm256_storeu_si256( ( __m256i* ) &pDst[x], val );
+      }
+    }
+#endif
+    const __m128i f01 = _mm_set1_epi32( coeffPair( f[0], f[1] ) );
+    const __m128i f23 = _mm_set1_epi32( coeffPair( f[2], f[3] ) );
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i val = _mm_min_epi16( vmax, _mm_max_epi16( vmin, filter4Tap( &ref[x], f01, f23 ) ) );
+      _mm_storeu_si128( ( __m128i* ) &pDst[x], val );
+    }
+    for( ; x + 4 <= width; x += 4 )
+    {
+      const __m128i val = _mm_min_epi16( vmax, _mm_max_epi16( vmin, filter4TapQuad( &ref[x], f01, f23 ) ) );
+      _mm_storel_epi64( ( __m128i* ) &pDst[x], val );
+    }
+    for( ; x < width; x++ )
+    {
+      const Pel val = ( f[0] * ref[x] + f[1] * ref[x + 1] + f[2] * ref[x + 2] + f[3] * ref[x + 3] + 32 ) >> 6;
+      pDst[x] = ClipPel( val, clpRng );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void predIntraAngChroma_SIMD( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, int deltaPos, const int intraPredAngle )
+{
+  for( int y = 0; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride )
+  {
+    const int deltaInt   = deltaPos >> 5;
+    const int deltaFract = deltaPos & 31;
+
+    // p0 + ( ( f * ( p1 - p0 ) + 16 ) >> 5 ) == ( ( 32 - f ) * p0 + f * p1 + 16 ) >> 5
+    const Pel* ref = refMain + deltaInt + 1;
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i coeff = _mm256_set1_epi32( coeffPair( 32 - deltaFract, deltaFract ) );
+      const __m256i rnd   = _mm256_set1_epi32( 16 );
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i p0 = _mm256_loadu_si256( ( const __m256i* ) &ref[x] );
+        const __m256i p1 = _mm256_loadu_si256( ( const __m256i* ) &ref[x + 1] );
+        const __m256i lo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( p0, p1 ), coeff ), rnd ), 5 );
+        const __m256i hi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( p0, p1 ), coeff ), rnd ), 5 );
+        _mm256_storeu_si256( ( __m256i* ) &pDst[x], _mm256_packs_epi32( lo, hi ) );
+      }
+    }
+#endif
+    const __m128i coeff = _mm_set1_epi32( coeffPair( 32 - deltaFract, deltaFract ) );
+    const __m128i rnd   = _mm_set1_epi32( 16 );
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i p0 = _mm_loadu_si128( ( const __m128i* ) &ref[x] );
+      const __m128i p1 = _mm_loadu_si128( ( const __m128i* ) &ref[x + 1] );
+      const __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( p0, p1 ), coeff ), rnd ), 5 );
+      const __m128i hi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( p0, p1 ), coeff ), rnd ), 5 );
+      _mm_storeu_si128( ( __m128i* ) &pDst[x], _mm_packs_epi32( lo, hi ) );
+    }
+    for( ; x + 4 <= width; x += 4 )
+    {
+      const __m128i p0  = _mm_loadl_epi64( ( const __m128i* ) &ref[x] );
+      const __m128i p1  = _mm_loadl_epi64( ( const __m128i* ) &ref[x + 1] );
+      const __m128i val = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( p0, p1 ), coeff ), rnd ), 5 );
+      _mm_storel_epi64( ( __m128i* ) &pDst[x], _mm_packs_epi32( val, val ) );
+    }
+    for( ; x < width; x++ )
+    {
+      pDst[x] = ref[x] + ( ( deltaFract * ( ref[x + 1] - ref[x] ) + 16 ) >> 5 );
+    }
+  }
+}
+
+// val + ( ( wL * ( left - val ) + wT * ( top - val ) + 32 ) >> 6 ) for samples given as interleaved differences and weights
+static inline __m128i pdpcCombine( const __m128i& val, const __m128i& left, const __m128i& top, const __m128i& wL, const __m128i& wT )
+{
+  const __m128i dL = _mm_sub_epi16( left, val );
+  const __m128i dT = _mm_sub_epi16( top, val );
+  __m128i lo = _mm_madd_epi16( _mm_unpacklo_epi16( dL, dT ), _mm_unpacklo_epi16( wL, wT ) );
+  __m128i hi = _mm_madd_epi16( _mm_unpackhi_epi16( dL, dT ), _mm_unpackhi_epi16( wL, wT ) );
+  lo = _mm_srai_epi32( _mm_add_epi32( lo, _mm_set1_epi32( 32 ) ), 6 );
+  hi = _mm_srai_epi32( _mm_add_epi32( hi, _mm_set1_epi32( 32 ) ), 6 );
+  return _mm_add_epi16( val, _mm_packs_epi32( lo, hi ) );
+}
+
+#ifdef USE_AVX2
+static inline __m256i pdpcCombine( const __m256i& val, const __m256i& left, const __m256i& top, const __m256i& wL, const __m256i& wT )
+{
+  const __m256i dL = _mm256_sub_epi16( left, val );
+  const __m256i dT = _mm256_sub_epi16( top, val );
+  __m256i lo = _mm256_madd_epi16( _mm256_unpacklo_epi16( dL, dT ), _mm256_unpacklo_epi16( wL, wT ) );
+  __m256i hi = _mm256_madd_epi16( _mm256_unpackhi_epi16( dL, dT ), _mm256_unpackhi_epi16( wL, wT ) );
+  lo = _mm256_srai_epi32( _mm256_add_epi32( lo, _mm256_set1_epi32( 32 ) ), 6 );
+  hi = _mm256_srai_epi32( _mm256_add_epi32( hi, _mm256_set1_epi32( 32 ) ), 6 );
+  return _mm256_add_epi16( val, _mm256_packs_epi32( lo, hi ) );
+}
+#endif
+
+template<X86_VEXT vext>
+static void predIntraPdpcPlanarDc_SIMD( const CPelBuf &pSrc, PelBuf &pDst, const int scale )
+{
+  const int width  = pDst.width;
+  const int height = pDst.height;
+  const Pel* top   = pSrc.bufAt( 1, 0 );
+  const Pel* left  = pSrc.bufAt( 1, 1 );
+
+  CHECK( width > MAX_CU_SIZE, "width greater than limit" );
+
+  Pel weightLeft[MAX_CU_SIZE];
+  for( int x = 0; x < width; x++ )
+  {
+    weightLeft[x] = 32 >> std::min( 31, ( ( x << 1 ) >> scale ) );
+  }
+
+  Pel* dst = pDst.buf;
+  for( int y = 0; y < height; y++, dst += pDst.stride )
+  {
+    const int wT = 32 >> std::min( 31, ( ( y << 1 ) >> scale ) );
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vleft = _mm256_set1_epi16( left[y] );
+      const __m256i vwT   = _mm256_set1_epi16( wT );
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i val = _mm256_loadu_si256( ( const __m256i* ) &dst[x] );
+        const __m256i vtop = _mm256_loadu_si256( ( const __m256i* ) &top[x] );
+        const __m256i vwL = _mm256_loadu_si256( ( const __m256i* ) &weightLeft[x] );
+        _mm256_storeu_si256( ( __m256i* ) &dst[x], pdpcCombine( val, vleft, vtop, vwL, vwT ) );
+      }
+    }
+#endif
+    const __m128i vleft = _mm_set1_epi16( left[y] );
+    const __m128i vwT   = _mm_set1_epi16( wT );
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i val  = _mm_loadu_si128( ( const __m128i* ) &dst[x] );
+      const __m128i vtop = _mm_loadu_si128( ( const __m128i* ) &top[x] );
+      const __m128i vwL  = _mm_loadu_si128( ( const __m128i* ) &weightLeft[x] );
+      _mm_storeu_si128( ( __m128i* ) &dst[x], pdpcCombine( val, vleft, vtop, vwL, vwT ) );
+    }
+    for( ; x + 4 <= width; x += 4 )
+    {
+      const __m128i val  = _mm_loadl_epi64( ( const __m128i* ) &dst[x] );
+      const __m128i vtop = _mm_loadl_epi64( ( const __m128i* ) &top[x] );
+      const __m128i vwL  = _mm_loadl_epi64( ( const __m128i* ) &weightLeft[x] );
+      _mm_storel_epi64( ( __m128i* ) &dst[x], pdpcCombine( val, vleft, vtop, vwL, vwT ) );
+    }
+    for( ; x < width; x++ )
+    {
+      const Pel val = dst[x];
+      dst[x] = val + ( ( weightLeft[x] * ( left[y] - val ) + wT * ( top[x] - val ) + 32 ) >> 6 );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void filterReferenceLine_SIMD( const Pel* refUnfiltered, Pel* refFiltered, const int length )
+{
+  const __m128i rnd = _mm_set1_epi16( 2 );
+  int i = 1;
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i rnd256 = _mm256_set1_epi16( 2 );
+    for( ; i + 16 <= length; i += 16 )
+    {
+      const __m256i a   = _mm256_loadu_si256( ( const __m256i* ) &refUnfiltered[i - 1] );
+      const __m256i b   = _mm256_loadu_si256( ( const __m256i* ) &refUnfiltered[i] );
+      const __m256i c   = _mm256_loadu_si256( ( const __m256i* ) &refUnfiltered[i + 1] );
+      const __m256i sum = _mm256_add_epi16( _mm256_add_epi16( a, c ), _mm256_add_epi16( _mm256_slli_epi16( b, 1 ), rnd256 ) );
+      _mm256_storeu_si256( ( __m256i* ) &refFiltered[i], _mm256_srli_epi16( sum, 2 ) );
+    }
+  }
+#endif
+  for( ; i + 8 <= length; i += 8 )
+  {
+    const __m128i a   = _mm_loadu_si128( ( const __m128i* ) &refUnfiltered[i - 1] );
+    const __m128i b   = _mm_loadu_si128( ( const __m128i* ) &refUnfiltered[i] );
+    const __m128i c   = _mm_loadu_si128( ( const __m128i* ) &refUnfiltered[i + 1] );
+    const __m128i sum = _mm_add_epi16( _mm_add_epi16( a, c ), _mm_add_epi16( _mm_slli_epi16( b, 1 ), rnd ) );
+    _mm_storeu_si128( ( __m128i* ) &refFiltered[i], _mm_srli_epi16( sum, 2 ) );
+  }
+  for( ; i < length; i++ )
+  {
+    refFiltered[i] = ( refUnfiltered[i - 1] + 2 * refUnfiltered[i] + refUnfiltered[i + 1] + 2 ) >> 2;
+  }
+}
+
+// centreWeight * row[2i+2k] + row[2i+2k+1] + row[2i+2k-1] for k = 0..3, centreWeight given as pairs { w, 1 }
+static inline __m128i cclmRowTaps( const Pel* row, const int i, const bool leftPadding, const __m128i& centreWeight )
+{
+  const __m128i cur  = _mm_loadu_si128( ( const __m128i* ) &row[2 * i] );
+  const __m128i left = i > 0 ? _mm_loadu_si128( ( const __m128i* ) &row[2 * i - 1] )
+                             : _mm_insert_epi16( _mm_slli_si128( cur, 2 ), leftPadding ? row[0] : row[-1], 0 );
+  return _mm_add_epi32( _mm_madd_epi16( cur, centreWeight ), _mm_madd_epi16( left, _mm_set1_epi32( 1 ) ) );
+}
+
+// row[2i+2k] for k = 0..3
+static inline __m128i cclmCentreTap( const Pel* row, const int i )
+{
+  return _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &row[2 * i] ), _mm_set1_epi32( 1 ) );
+}
+
+template<int filter>
+static inline __m128i cclmDownsampleQuad( const Pel* pSrc, const Pel* above, const ptrdiff_t srcStride, const int i, const bool leftPadding )
+{
+  if( filter == CCLM_FILTER_HOR_3TAP )
+  {
+    const __m128i sum = cclmRowTaps( pSrc, i, leftPadding, _mm_set1_epi32( 2 | ( 1 << 16 ) ) );
+    return _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 2 ) ), 2 );
+  }
+  else if( filter == CCLM_FILTER_COLLOC )
+  {
+    __m128i sum = cclmRowTaps( pSrc, i, leftPadding, _mm_set1_epi32( 4 | ( 1 << 16 ) ) );
+    sum = _mm_add_epi32( sum, _mm_add_epi32( cclmCentreTap( above, i ), cclmCentreTap( pSrc + srcStride, i ) ) );
+    return _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 4 ) ), 3 );
+  }
+  else
+  {
+    __m128i sum = cclmRowTaps( pSrc, i, leftPadding, _mm_set1_epi32( 2 | ( 1 << 16 ) ) );
+    sum = _mm_add_epi32( sum, cclmRowTaps( pSrc + srcStride, i, leftPadding, _mm_set1_epi32( 2 | ( 1 << 16 ) ) ) );
+    return _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 4 ) ), 3 );
+  }
+}
+
+template<X86_VEXT vext, int filter>
+static void lumaDownsample_SIMD( Pel* pDst, const ptrdiff_t dstStride, const Pel* pSrc, const ptrdiff_t srcStride, const int width, const int height, const bool leftPadding, const bool abovePadding )
+{
+  const ptrdiff_t srcStep = filter == CCLM_FILTER_COLLOC || filter == CCLM_FILTER_6TAP ? 2 * srcStride : srcStride;
+
+  for( int j = 0; j < height; j++, pDst += dstStride, pSrc += srcStep )
+  {
+    int i = 0;
+    if( filter == CCLM_FILTER_COPY )
+    {
+      for( ; i + 8 <= width; i += 8 )
+      {
+        _mm_storeu_si128( ( __m128i* ) &pDst[i], _mm_loadu_si128( ( const __m128i* ) &pSrc[i] ) );
+      }
+      for( ; i < width; i++ )
+      {
+        pDst[i] = pSrc[i];
+      }
+      continue;
+    }
+
+    const Pel* above = pSrc - ( j == 0 && abovePadding ? 0 : srcStride );
+    for( ; i + 8 <= width; i += 8 )
+    {
+      const __m128i lo = cclmDownsampleQuad<filter>( pSrc, above, srcStride, i,     leftPadding );
+      const __m128i hi = cclmDownsampleQuad<filter>( pSrc, above, srcStride, i + 4, leftPadding );
+      _mm_storeu_si128( ( __m128i* ) &pDst[i], _mm_packs_epi32( lo, hi ) );
+    }
+    for( ; i + 4 <= width; i += 4 )
+    {
+      const __m128i val = cclmDownsampleQuad<filter>( pSrc, above, srcStride, i, leftPadding );
+      _mm_storel_epi64( ( __m128i* ) &pDst[i], _mm_packs_epi32( val, val ) );
+    }
+    for( ; i < width; i++ )
+    {
+      const ptrdiff_t left = i == 0 && leftPadding ? 0 : 1;
+      if( filter == CCLM_FILTER_HOR_3TAP )
+      {
+        pDst[i] = ( pSrc[2 * i] * 2 + pSrc[2 * i - left] + pSrc[2 * i + 1] + 2 ) >> 2;
+      }
+      else if( filter == CCLM_FILTER_COLLOC )
+      {
+        pDst[i] = ( above[2 * i] + pSrc[2 * i] * 4 + pSrc[2 * i - left] + pSrc[2 * i + 1] + pSrc[2 * i + srcStride] + 4 ) >> 3;
+      }
+      else
+      {
+        pDst[i] = ( pSrc[2 * i] * 2 + pSrc[2 * i + 1] + pSrc[2 * i - left]
+                  + pSrc[2 * i + srcStride] * 2 + pSrc[2 * i + 1 + srcStride] + pSrc[2 * i + srcStride - left] + 4 ) >> 3;
+      }
+    }
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void IntraPrediction::_initIntraPredictionX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_predIntraPlanar       = predIntraPlanar_SIMD<vext>;
+  m_predIntraDc           = predIntraDc_SIMD<vext>;
+  m_predIntraAngLuma      = predIntraAngLuma_SIMD<vext>;
+  m_predIntraAngChroma    = predIntraAngChroma_SIMD<vext>;
+  m_predIntraPdpcPlanarDc = predIntraPdpcPlanarDc_SIMD<vext>;
+  m_filterReferenceLine   = filterReferenceLine_SIMD<vext>;
+
+  m_lumaDownsample[CCLM_FILTER_COPY]     = lumaDownsample_SIMD<vext, CCLM_FILTER_COPY>;
+  m_lumaDownsample[CCLM_FILTER_HOR_3TAP] = lumaDownsample_SIMD<vext, CCLM_FILTER_HOR_3TAP>;
+  m_lumaDownsample[CCLM_FILTER_COLLOC]   = lumaDownsample_SIMD<vext, CCLM_FILTER_COLLOC>;
+  m_lumaDownsample[CCLM_FILTER_6TAP]     = lumaDownsample_SIMD<vext, CCLM_FILTER_6TAP>;
+#endif
+}
+
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+
+//! \}
@@ -0,0 +1,258 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     MatrixIntraPredictionX86.h
+    \brief    matrix-based intra prediction, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../MatrixIntraPrediction.h"
+#include "../MipData.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// ( ( sum + offset ) >> MIP_SHIFT_MATRIX ) + inputOffset clipped to the bit depth
+static inline __m128i mipFinalize( const __m128i& sum, const __m128i& offset, const __m128i& inputOffset, const __m128i& maxVal )
+{
+  const __m128i val = _mm_add_epi32( _mm_srai_epi32( _mm_add_epi32( sum, offset ), MIP_SHIFT_MATRIX ), inputOffset );
+  return _mm_min_epi32( _mm_max_epi32( val, _mm_setzero_si128() ), maxVal );
+}
+
+// dot products of 8 weights with the 8 inputs as 4 partial sums
+static inline __m128i mipRowPartials( const uint8_t* weight, const __m128i& input )
+{
+  return _mm_madd_epi16( _mm_cvtepu8_epi16( _mm_loadl_epi64( ( const __m128i* ) weight ) ), input );
+}
+
+template<X86_VEXT vext, int sizeId>
+static void computeReducedPred_SIMD( int* const result, const int* const input, const uint8_t* matrix, const int inputOffset, const int bitDepth )
+{
+  const int inputSize       = sizeId == 0 ? 4 : 8;
+  const int reducedPredSize = sizeId < 2 ? 4 : 8;
+  const int numOutputs      = reducedPredSize * reducedPredSize;
+
+  int sum = 0;
+  for( int i = 0; i < inputSize; i++ ) { sum += input[i]; }
+
+  const __m128i offset  = _mm_set1_epi32( ( 1 << ( MIP_SHIFT_MATRIX - 1 ) ) - MIP_OFFSET_MATRIX * sum );
+  const __m128i inOffs  = _mm_set1_epi32( inputOffset );
+  const __m128i maxVal  = _mm_set1_epi32( ( 1 << bitDepth ) - 1 );
+
+  // the rebased boundary fits into 16 bit
+  const __m128i in0     = _mm_loadu_si128( ( const __m128i* ) &input[0] );
+  const __m128i in1     = sizeId == 0 ? in0 : _mm_loadu_si128( ( const __m128i* ) &input[4] );
+  const __m128i in      = _mm_packs_epi32( in0, in1 );
+
+  if( sizeId == 0 )
+  {
+    // 4 weights per output, 4 outputs per 16 bytes of the matrix
+    for( int k = 0; k < numOutputs; k += 4 )
+    {
+      const __m128i w  = _mm_loadu_si128( ( const __m128i* ) &matrix[k * inputSize] );
+      const __m128i m0 = _mm_madd_epi16( _mm_cvtepu8_epi16( w ), in );
+      const __m128i m1 = _mm_madd_epi16( _mm_cvtepu8_epi16( _mm_srli_si128( w, 8 ) ), in );
+      _mm_storeu_si128( ( __m128i* ) &result[k], mipFinalize( _mm_hadd_epi32( m0, m1 ), offset, inOffs, maxVal ) );
+    }
+    return;
+  }
+
+  // with the large matrices the first input is not used and each output has 7 weights: output k uses the
+  // weights k * 7 .. k * 7 + 6 for the inputs 1..7, the last output loads one byte ahead to stay inside the matrix
+  const int     rowStride = sizeId == 2 ? 7 : 8;
+  const __m128i inShift   = sizeId == 2 ? _mm_srli_si128( in, 2 ) : in;
+  const __m128i inLast    = _mm_insert_epi16( in, 0, 0 );
+
+  int k = 0;
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i in256   = _mm256_broadcastsi128_si256( inShift );
+    const __m256i perm    = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+    const __m256i offs256 = _mm256_set1_epi32( ( 1 << ( MIP_SHIFT_MATRIX - 1 ) ) - MIP_OFFSET_MATRIX * sum );
+    const __m256i inOff256 = _mm256_set1_epi32( inputOffset );
+    const __m256i max256  = _mm256_set1_epi32( ( 1 << bitDepth ) - 1 );
+    const int     numAvx2 = sizeId == 2 ? numOutputs - 8 : numOutputs;
+
+    for( ; k < numAvx2; k += 8 )
+    {
+      __m256i m[4];
+      for( int i = 0; i < 4; i++ )
+      {
+        const uint8_t* w   = &matrix[( k + 2 * i ) * rowStride];
+        const __m128i  w01 = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) w ), _mm_loadl_epi64( ( const __m128i* ) ( w + rowStride ) ) );
+        m[i] = _mm256_madd_epi16( _mm256_cvtepu8_epi16( w01 ), in256 );
+      }
+      // lanes hold the even and the odd outputs after the reduction
+      __m256i sum8 = _mm256_hadd_epi32( _mm256_hadd_epi32( m[0], m[1] ), _mm256_hadd_epi32( m[2], m[3] ) );
+      sum8 = _mm256_permutevar8x32_epi32( sum8, perm );
+      sum8 = _mm256_add_epi32( _mm256_srai_epi32( _mm256_add_epi32( sum8, offs256 ), MIP_SHIFT_MATRIX ), inOff256 );
+      sum8 = _mm256_min_epi32( _mm256_max_epi32( sum8, _mm256_setzero_si256() ), max256 );
+      _mm256_storeu_si256( ( __m256i* ) &result[k], sum8 );
+    }
+  }
+#endif
+  for( ; k < numOutputs; k += 4 )
+  {
+    const __m128i m0 = mipRowPartials( &matrix[( k + 0 ) * rowStride], inShift );
+    const __m128i m1 = mipRowPartials( &matrix[( k + 1 ) * rowStride], inShift );
+    const __m128i m2 = mipRowPartials( &matrix[( k + 2 ) * rowStride], inShift );
+    const __m128i m3 = sizeId == 2 && k + 4 == numOutputs ? mipRowPartials( &matrix[( k + 3 ) * rowStride - 1], inLast )
+                                                          : mipRowPartials( &matrix[( k + 3 ) * rowStride], inShift );
+    const __m128i sum4 = _mm_hadd_epi32( _mm_hadd_epi32( m0, m1 ), _mm_hadd_epi32( m2, m3 ) );
+    _mm_storeu_si128( ( __m128i* ) &result[k], mipFinalize( sum4, offset, inOffs, maxVal ) );
+  }
+}
+
+#endif
+
+template<X86_VEXT vext>
+static void predictionUpsampling1D_SIMD( int* const dst, const int* const src, const int* const bndry,
+                                         const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
+                                         const SizeType srcStep, const SizeType srcStride,
+                                         const SizeType dstStep, const SizeType dstStride,
+                                         const SizeType bndryStep,
+                                         const unsigned int upsmpFactor )
+{
+  const int log2UpsmpFactor = floorLog2( upsmpFactor );
+  CHECKD( upsmpFactor <= 1, "Upsampling factor must be at least 2." );
+  const __m128i rnd = _mm_set1_epi32( 1 << ( log2UpsmpFactor - 1 ) );
+
+  if( srcStride == 1 && dstStride == 1 && bndryStep == 1 && ( srcSizeOrthDim & 3 ) == 0 )
+  {
+    // vertical upsampling, the lines of the orthogonal dimension are contiguous
+    for( SizeType idxOrthDim = 0; idxOrthDim < srcSizeOrthDim; idxOrthDim += 4 )
+    {
+      const int* before  = bndry + idxOrthDim;
+      const int* behind  = src + idxOrthDim;
+      int*       currDst = dst + idxOrthDim;
+      for( SizeType idxUpsmpDim = 0; idxUpsmpDim < srcSizeUpsmpDim; idxUpsmpDim++ )
+      {
+        const __m128i vbefore      = _mm_loadu_si128( ( const __m128i* ) before );
+        const __m128i vbehind      = _mm_loadu_si128( ( const __m128i* ) behind );
+        __m128i       scaledBefore = _mm_slli_epi32( vbefore, log2UpsmpFactor );
+        __m128i       scaledBehind = _mm_setzero_si128();
+        for( unsigned pos = 1; pos <= upsmpFactor; pos++ )
+        {
+          scaledBefore = _mm_sub_epi32( scaledBefore, vbefore );
+          scaledBehind = _mm_add_epi32( scaledBehind, vbehind );
+          const __m128i val = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( scaledBefore, scaledBehind ), rnd ), log2UpsmpFactor );
+          _mm_storeu_si128( ( __m128i* ) currDst, val );
+          currDst += dstStep;
+        }
+        before = behind;
+        behind += srcStep;
+      }
+    }
+  }
+  else if( srcStep == 1 && dstStep == 1 && upsmpFactor >= 4 )
+  {
+    // horizontal upsampling, 4 interpolated samples at once
+    const int* bndryLine = bndry + bndryStep - 1;
+    for( SizeType idxOrthDim = 0; idxOrthDim < srcSizeOrthDim; idxOrthDim++ )
+    {
+      const int* srcLine = src + idxOrthDim * srcStride;
+      int*       dstLine = dst + idxOrthDim * dstStride;
+      int        before  = *bndryLine;
+      for( SizeType idxUpsmpDim = 0; idxUpsmpDim < srcSizeUpsmpDim; idxUpsmpDim++ )
+      {
+        const int behind = srcLine[idxUpsmpDim];
+        for( unsigned pos = 1; pos <= upsmpFactor; pos += 4 )
+        {
+          // ( before << log2 ) - pos * before + pos * behind
+          const __m128i vpos = _mm_add_epi32( _mm_set1_epi32( pos ), _mm_setr_epi32( 0, 1, 2, 3 ) );
+          const __m128i val  = _mm_add_epi32( _mm_set1_epi32( before << log2UpsmpFactor ), _mm_mullo_epi32( vpos, _mm_set1_epi32( behind - before ) ) );
+          _mm_storeu_si128( ( __m128i* ) &dstLine[pos - 1], _mm_srai_epi32( _mm_add_epi32( val, rnd ), log2UpsmpFactor ) );
+        }
+        dstLine += upsmpFactor;
+        before = behind;
+      }
+      bndryLine += bndryStep;
+    }
+  }
+  else
+  {
+    MatrixIntraPrediction::predictionUpsampling1D( dst, src, bndry, srcSizeUpsmpDim, srcSizeOrthDim, srcStep, srcStride,
+                                                   dstStep, dstStride, bndryStep, upsmpFactor );
+  }
+}
+
+template<X86_VEXT vext>
+static void boundaryDownsampling1D_SIMD( int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen )
+{
+  if( dstLen < srcLen && srcLen >= 4 * dstLen )
+  {
+    const SizeType downsmpFactor     = srcLen / dstLen;
+    const int      log2DownsmpFactor = floorLog2( downsmpFactor );
+    const int      roundingOffset    = 1 << ( log2DownsmpFactor - 1 );
+
+    const int* src = fullSrc;
+    for( SizeType dstIdx = 0; dstIdx < dstLen; dstIdx++ )
+    {
+      __m128i acc = _mm_setzero_si128();
+      for( SizeType k = 0; k < downsmpFactor; k += 4, src += 4 )
+      {
+        acc = _mm_add_epi32( acc, _mm_loadu_si128( ( const __m128i* ) src ) );
+      }
+      acc = _mm_hadd_epi32( acc, acc );
+      acc = _mm_hadd_epi32( acc, acc );
+      reducedDst[dstIdx] = ( _mm_cvtsi128_si32( acc ) + roundingOffset ) >> log2DownsmpFactor;
+    }
+  }
+  else
+  {
+    MatrixIntraPrediction::boundaryDownsampling1D( reducedDst, fullSrc, srcLen, dstLen );
+  }
+}
+
+template <X86_VEXT vext>
+void MatrixIntraPrediction::_initMatrixIntraPredictionX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_computeReducedPred[0]  = computeReducedPred_SIMD<vext, 0>;
+  m_computeReducedPred[1]  = computeReducedPred_SIMD<vext, 1>;
+  m_computeReducedPred[2]  = computeReducedPred_SIMD<vext, 2>;
+#endif
+  m_predictionUpsampling1D = predictionUpsampling1D_SIMD<vext>;
+  m_boundaryDownsampling1D = boundaryDownsampling1D_SIMD<vext>;
+}
+
+template void MatrixIntraPrediction::_initMatrixIntraPredictionX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+
+//! \}
@@ -0,0 +1,287 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file     QuantX86.h
+    \brief    quantization and dequantization, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../Quant.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// the 64 bit products |src| * scale are computed separately for the even and the odd 32 bit lanes
+static inline void quantProducts( const __m128i vabs, const __m128i vscale, __m128i& prodEven, __m128i& prodOdd )
+{
+  prodEven = _mm_mul_epu32( vabs, vscale );
+  prodOdd  = _mm_mul_epu32( _mm_srli_epi64( vabs, 32 ), _mm_srli_epi64( vscale, 32 ) );
+}
+
+// the low 32 bits of the 64 bit lanes of even and odd back in one register
+static inline __m128i quantJoinLow( const __m128i even, const __m128i odd )
+{
+  return _mm_blend_epi16( even, _mm_slli_epi64( odd, 32 ), 0xCC );
+}
+
+template<X86_VEXT vext>
+void quantCore_SIMD( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int* quantCoeff, const int scale, const int numCoeff, const int64_t add, const int qBits, const TCoeff minCoeff, const TCoeff maxCoeff, TCoeff& absSum )
+{
+  // the remainders fit into 32 bits only for qBits up to 31
+  if( qBits < 8 || qBits > 31 || ( numCoeff & 3 ) )
+  {
+    Quant::quantCore( src, dst, deltaU, quantCoeff, scale, numCoeff, add, qBits, minCoeff, maxCoeff, absSum );
+    return;
+  }
+
+  const __m128i vqBits  = _mm_cvtsi32_si128( qBits );
+  const __m128i vqBits8 = _mm_cvtsi32_si128( qBits - 8 );
+  int n = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vadd   = _mm256_set1_epi64x( add );
+    const __m256i vmin   = _mm256_set1_epi32( minCoeff );
+    const __m256i vmax   = _mm256_set1_epi32( maxCoeff );
+    __m256i       vsum   = _mm256_setzero_si256();
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      const __m256i vsrc   = _mm256_loadu_si256( ( const __m256i* ) &src[n] );
+      const __m256i vabs   = _mm256_abs_epi32( vsrc );
+      const __m256i vscale = quantCoeff ? _mm256_loadu_si256( ( const __m256i* ) &quantCoeff[n] ) : _mm256_set1_epi32( scale );
+
+      const __m256i prodEven = _mm256_mul_epu32( vabs, vscale );
+      const __m256i prodOdd  = _mm256_mul_epu32( _mm256_srli_epi64( vabs, 32 ), _mm256_srli_epi64( vscale, 32 ) );
+      const __m256i magEven  = _mm256_srl_epi64( _mm256_add_epi64( prodEven, vadd ), vqBits );
+      const __m256i magOdd   = _mm256_srl_epi64( _mm256_add_epi64( prodOdd,  vadd ), vqBits );
+      const __m256i remEven  = _mm256_sub_epi64( prodEven, _mm256_sll_epi64( magEven, vqBits ) );
+      const __m256i remOdd   = _mm256_sub_epi64( prodOdd,  _mm256_sll_epi64( magOdd,  vqBits ) );
+
+      const __m256i vmag   = _mm256_blend_epi32( magEven, _mm256_slli_epi64( magOdd, 32 ), 0xAA );
+      const __m256i vrem   = _mm256_blend_epi32( remEven, _mm256_slli_epi64( remOdd, 32 ), 0xAA );
+
+      _mm256_storeu_si256( ( __m256i* ) &deltaU[n], _mm256_sra_epi32( vrem, vqBits8 ) );
+      _mm256_storeu_si256( ( __m256i* ) &dst[n], _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, _mm256_sign_epi32( vmag, vsrc ) ) ) );
+      vsum = _mm256_add_epi32( vsum, vmag );
+    }
+
+    __m128i vsum128 = _mm_add_epi32( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+    vsum128 = _mm_add_epi32( vsum128, _mm_shuffle_epi32( vsum128, 0x4E ) );
+    vsum128 = _mm_add_epi32( vsum128, _mm_shuffle_epi32( vsum128, 0xB1 ) );
+    absSum += _mm_cvtsi128_si32( vsum128 );
+  }
+#endif
+
+  const __m128i vadd = _mm_set1_epi64x( add );
+  const __m128i vmin = _mm_set1_epi32( minCoeff );
+  const __m128i vmax = _mm_set1_epi32( maxCoeff );
+  __m128i       vsum = _mm_setzero_si128();
+
+  for( ; n < numCoeff; n += 4 )
+  {
+    const __m128i vsrc   = _mm_loadu_si128( ( const __m128i* ) &src[n] );
+    const __m128i vabs   = _mm_abs_epi32( vsrc );
+    const __m128i vscale = quantCoeff ? _mm_loadu_si128( ( const __m128i* ) &quantCoeff[n] ) : _mm_set1_epi32( scale );
+
+    __m128i prodEven, prodOdd;
+    quantProducts( vabs, vscale, prodEven, prodOdd );
+    const __m128i magEven = _mm_srl_epi64( _mm_add_epi64( prodEven, vadd ), vqBits );
+    const __m128i magOdd  = _mm_srl_epi64( _mm_add_epi64( prodOdd,  vadd ), vqBits );
+    const __m128i remEven = _mm_sub_epi64( prodEven, _mm_sll_epi64( magEven, vqBits ) );
+    const __m128i remOdd  = _mm_sub_epi64( prodOdd,  _mm_sll_epi64( magOdd,  vqBits ) );
+
+    const __m128i vmag    = quantJoinLow( magEven, magOdd );
+
+    _mm_storeu_si128( ( __m128i* ) &deltaU[n], _mm_sra_epi32( quantJoinLow( remEven, remOdd ), vqBits8 ) );
+    _mm_storeu_si128( ( __m128i* ) &dst[n], _mm_min_epi32( vmax, _mm_max_epi32( vmin, _mm_sign_epi32( vmag, vsrc ) ) ) );
+    vsum = _mm_add_epi32( vsum, vmag );
+  }
+
+  vsum = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0x4E ) );
+  vsum = _mm_add_epi32( vsum, _mm_shuffle_epi32( vsum, 0xB1 ) );
+  absSum += _mm_cvtsi128_si32( vsum );
+}
+
+template<X86_VEXT vext>
+void dequantCore_SIMD( const TCoeff* src, TCoeff* dst, const int* dequantCoeff, const int scale, const int numCoeff, const int rightShift, const Intermediate_Int minInput, const Intermediate_Int maxInput, const TCoeff minCoeff, const TCoeff maxCoeff )
+{
+  if( numCoeff & 3 )
+  {
+    Quant::dequantCore( src, dst, dequantCoeff, scale, numCoeff, rightShift, minInput, maxInput, minCoeff, maxCoeff );
+    return;
+  }
+
+  const int     add    = rightShift > 0 ? 1 << ( rightShift - 1 ) : 0;
+  const __m128i vshift = _mm_cvtsi32_si128( rightShift > 0 ? rightShift : -rightShift );
+  int n = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vminIn  = _mm256_set1_epi32( minInput );
+    const __m256i vmaxIn  = _mm256_set1_epi32( maxInput );
+    const __m256i vminOut = _mm256_set1_epi32( minCoeff );
+    const __m256i vmaxOut = _mm256_set1_epi32( maxCoeff );
+    const __m256i vadd    = _mm256_set1_epi32( add );
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      const __m256i vsrc   = _mm256_min_epi32( vmaxIn, _mm256_max_epi32( vminIn, _mm256_loadu_si256( ( const __m256i* ) &src[n] ) ) );
+      const __m256i vscale = dequantCoeff ? _mm256_loadu_si256( ( const __m256i* ) &dequantCoeff[n] ) : _mm256_set1_epi32( scale );
+      const __m256i vprod  = _mm256_mullo_epi32( vsrc, vscale );
+      const __m256i vres   = rightShift > 0 ? _mm256_sra_epi32( _mm256_add_epi32( vprod, vadd ), vshift ) : _mm256_sll_epi32( vprod, vshift );
+
+      _mm256_storeu_si256( ( __m256i* ) &dst[n], _mm256_min_epi32( vmaxOut, _mm256_max_epi32( vminOut, vres ) ) );
+    }
+  }
+#endif
+
+  const __m128i vminIn  = _mm_set1_epi32( minInput );
+  const __m128i vmaxIn  = _mm_set1_epi32( maxInput );
+  const __m128i vminOut = _mm_set1_epi32( minCoeff );
+  const __m128i vmaxOut = _mm_set1_epi32( maxCoeff );
+  const __m128i vadd    = _mm_set1_epi32( add );
+
+  for( ; n < numCoeff; n += 4 )
+  {
+    const __m128i vsrc   = _mm_min_epi32( vmaxIn, _mm_max_epi32( vminIn, _mm_loadu_si128( ( const __m128i* ) &src[n] ) ) );
+    const __m128i vscale = dequantCoeff ? _mm_loadu_si128( ( const __m128i* ) &dequantCoeff[n] ) : _mm_set1_epi32( scale );
+    const __m128i vprod  = _mm_mullo_epi32( vsrc, vscale );
+    const __m128i vres   = rightShift > 0 ? _mm_sra_epi32( _mm_add_epi32( vprod, vadd ), vshift ) : _mm_sll_epi32( vprod, vshift );
+
+    _mm_storeu_si128( ( __m128i* ) &dst[n], _mm_min_epi32( vmaxOut, _mm_max_epi32( vminOut, vres ) ) );
+  }
+}
+
+template<X86_VEXT vext>
+bool preQuantCore_SIMD( const TCoeff* src, const int* quantCoeff, const int scale, const int numCoeff, const int64_t thres, uint8_t* sig )
+{
+  if( numCoeff & 3 )
+  {
+    return Quant::preQuantCore( src, quantCoeff, scale, numCoeff, thres, sig );
+  }
+
+  // a product reaches thres if the sign bit of product - thres is not set
+  int n = 0;
+  __m128i vany = _mm_setzero_si128();
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vthres = _mm256_set1_epi64x( thres );
+    __m256i       vany256 = _mm256_setzero_si256();
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      const __m256i vabs   = _mm256_abs_epi32( _mm256_loadu_si256( ( const __m256i* ) &src[n] ) );
+      const __m256i vscale = quantCoeff ? _mm256_loadu_si256( ( const __m256i* ) &quantCoeff[n] ) : _mm256_set1_epi32( scale );
+
+      const __m256i diffEven = _mm256_sub_epi64( _mm256_mul_epu32( vabs, vscale ), vthres );
+      const __m256i diffOdd  = _mm256_sub_epi64( _mm256_mul_epu32( _mm256_srli_epi64( vabs, 32 ), _mm256_srli_epi64( vscale, 32 ) ), vthres );
+      // the high halves of the differences hold the signs, 0 for the significant coefficients
+      const __m256i vbelow   = _mm256_srai_epi32( _mm256_blend_epi32( _mm256_srli_epi64( diffEven, 32 ), diffOdd, 0xAA ), 31 );
+      const __m256i vsig     = _mm256_andnot_si256( vbelow, _mm256_set1_epi32( 1 ) );
+
+      if( !sig )
+      {
+        if( !_mm256_testz_si256( vsig, vsig ) )
+        {
+          return true;
+        }
+        continue;
+      }
+
+      const __m128i vsig16 = _mm_packs_epi32( _mm256_castsi256_si128( vsig ), _mm256_extracti128_si256( vsig, 1 ) );
+      _mm_storel_epi64( ( __m128i* ) &sig[n], _mm_packs_epi16( vsig16, vsig16 ) );
+      vany256 = _mm256_or_si256( vany256, vsig );
+    }
+
+    vany = _mm_or_si128( _mm256_castsi256_si128( vany256 ), _mm256_extracti128_si256( vany256, 1 ) );
+  }
+#endif
+
+  const __m128i vthres = _mm_set1_epi64x( thres );
+
+  for( ; n < numCoeff; n += 4 )
+  {
+    const __m128i vabs   = _mm_abs_epi32( _mm_loadu_si128( ( const __m128i* ) &src[n] ) );
+    const __m128i vscale = quantCoeff ? _mm_loadu_si128( ( const __m128i* ) &quantCoeff[n] ) : _mm_set1_epi32( scale );
+
+    __m128i prodEven, prodOdd;
+    quantProducts( vabs, vscale, prodEven, prodOdd );
+    const __m128i diffEven = _mm_sub_epi64( prodEven, vthres );
+    const __m128i diffOdd  = _mm_sub_epi64( prodOdd,  vthres );
+    const __m128i vbelow   = _mm_srai_epi32( _mm_blend_epi16( _mm_srli_epi64( diffEven, 32 ), diffOdd, 0xCC ), 31 );
+    const __m128i vsig     = _mm_andnot_si128( vbelow, _mm_set1_epi32( 1 ) );
+
+    if( !sig )
+    {
+      if( !_mm_testz_si128( vsig, vsig ) )
+      {
+        return true;
+      }
+      continue;
+    }
+
+    const __m128i vsig16 = _mm_packs_epi32( vsig, vsig );
+    const int     sig4   = _mm_cvtsi128_si32( _mm_packs_epi16( vsig16, vsig16 ) );
+    memcpy( &sig[n], &sig4, sizeof( sig4 ) );
+    vany = _mm_or_si128( vany, vsig );
+  }
+
+  return !_mm_testz_si128( vany, vany );
+}
+#endif
+
+template <X86_VEXT vext>
+void Quant::_initQuantX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_quantCore    = quantCore_SIMD<vext>;
+  m_dequantCore  = dequantCore_SIMD<vext>;
+  m_preQuantCore = preQuantCore_SIMD<vext>;
+#endif
+}
+
+template void Quant::_initQuantX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+
+//! \}
@@ -46,6 +46,19 @@
 typedef Pel Torg;
 typedef Pel Tcur;
 
+#ifdef USE_AVX512
+// horizontal sum of the 32-bit lanes, zero-masked extracts instead of _mm512_reduce_add_epi32() whose
+// undefined pass-through operand trips -Wmaybe-uninitialized
+static inline int xReduceAddEpi32_AVX512( const __m512i v )
+{
+  __m256i vsum256 = _mm256_add_epi32( _mm512_maskz_extracti64x4_epi64( 0xF, v, 0 ), _mm512_maskz_extracti64x4_epi64( 0xF, v, 1 ) );
+  __m128i vsum128 = _mm_add_epi32( _mm256_castsi256_si128( vsum256 ), _mm256_extracti128_si256( vsum256, 1 ) );
+  vsum128 = _mm_hadd_epi32( vsum128, vsum128 );
+  vsum128 = _mm_hadd_epi32( vsum128, vsum128 );
+  return _mm_cvtsi128_si32( vsum128 );
+}
+#endif
+
 template<X86_VEXT vext >
 Distortion RdCost::xGetSSE_SIMD( const DistParam &rcDtParam )
 {
@@ -223,7 +236,30 @@ Distortion RdCost::xGetSAD_SIMD( const DistParam &rcDtParam )
   const int iStrideSrc2 = rcDtParam.cur.stride * iSubStep;
 
   uint32_t uiSum = 0;
-  if( vext >= AVX2 && ( iCols & 15 ) == 0 )
+  if( vext >= AVX512 && ( iCols & 31 ) == 0 )
+  {
+#ifdef USE_AVX512
+    // Do for width that multiple of 32
+    __m512i vzero  = _mm512_setzero_si512();
+    __m512i vone   = _mm512_set1_epi16( 1 );
+    __m512i vsum32 = vzero;
+    for( int iY = 0; iY < iRows; iY+=iSubStep )
+    {
+      __m512i vsum16 = vzero;
+      for( int iX = 0; iX < iCols; iX+=32 )
+      {
+        __m512i vsrc1 = _mm512_loadu_si512( ( const __m512i* )( &pSrc1[iX] ) );
+        __m512i vsrc2 = _mm512_loadu_si512( ( const __m512i* )( &pSrc2[iX] ) );
+        vsum16 = _mm512_add_epi16( vsum16, _mm512_abs_epi16( _mm512_sub_epi16( vsrc1, vsrc2 ) ) );
+      }
+      vsum32 = _mm512_add_epi32( vsum32, _mm512_madd_epi16( vsum16, vone ) );
+      pSrc1   += iStrideSrc1;
+      pSrc2   += iStrideSrc2;
+    }
+    uiSum = xReduceAddEpi32_AVX512( vsum32 );
+#endif
+  }
+  else if( vext >= AVX2 && ( iCols & 15 ) == 0 )
   {
 #ifdef USE_AVX2
     // Do for width that multiple of 16
@@ -401,7 +437,30 @@ Distortion RdCost::xGetSAD_NxN_SIMD( const DistParam &rcDtParam )
   }
   else
   {
-    if( vext >= AVX2 && iWidth >= 16 )
+    if( vext >= AVX512 && iWidth >= 32 )
+    {
+#ifdef USE_AVX512
+      // Do for width that multiple of 32
+      __m512i vzero  = _mm512_setzero_si512();
+      __m512i vone   = _mm512_set1_epi16( 1 );
+      __m512i vsum32 = vzero;
+      for( int iY = 0; iY < iRows; iY+=iSubStep )
+      {
+        __m512i vsum16 = vzero;
+        for( int iX = 0; iX < iWidth; iX+=32 )
+        {
+          __m512i vsrc1 = _mm512_loadu_si512( ( const __m512i* )( &pSrc1[iX] ) );
+          __m512i vsrc2 = _mm512_loadu_si512( ( const __m512i* )( &pSrc2[iX] ) );
+          vsum16 = _mm512_add_epi16( vsum16, _mm512_abs_epi16( _mm512_sub_epi16( vsrc1, vsrc2 ) ) );
+        }
+        vsum32 = _mm512_add_epi32( vsum32, _mm512_madd_epi16( vsum16, vone ) );
+        pSrc1   += iStrideSrc1;
+        pSrc2   += iStrideSrc2;
+      }
+      uiSum = xReduceAddEpi32_AVX512( vsum32 );
+#endif
+    }
+    else if( vext >= AVX2 && iWidth >= 16 )
     {
 #ifdef USE_AVX2
       // Do for width that multiple of 16
@@ -3096,6 +3155,143 @@ static uint32_t xCalcHAD4x8_SSE( const Torg *piOrg, const Tcur *piCur, const int
 }
 
 
+static uint32_t xCalcHAD32x8_AVX512( const Torg *piOrg, const Tcur *piCur, const int iStrideOrg, const int iStrideCur, const int iBitDepth )
+{
+  uint32_t sad = 0;
+
+#ifdef USE_AVX512
+  // four 8x8 transforms side by side, each 256-bit half of a register holds one row of one 8x8 block
+  __m512i m1[2][8], m2[2][8];
+
+  for( int k = 0; k < 8; k++ )
+  {
+    __m512i r0 = _mm512_loadu_si512( ( const __m512i* ) piOrg );
+    __m512i r1 = _mm512_loadu_si512( ( const __m512i* ) piCur );
+    __m512i rd = _mm512_sub_epi16( r0, r1 );
+    m2[0][k] = _mm512_maskz_cvtepi16_epi32( 0xFFFF, _mm512_maskz_extracti64x4_epi64( 0xF, rd, 0 ) );
+    m2[1][k] = _mm512_maskz_cvtepi16_epi32( 0xFFFF, _mm512_maskz_extracti64x4_epi64( 0xF, rd, 1 ) );
+    piCur += iStrideCur;
+    piOrg += iStrideOrg;
+  }
+
+  const __m512i perm_unpacklo_epi128 = _mm512_set_epi64( 13, 12, 5, 4, 9, 8, 1, 0 );
+  const __m512i perm_unpackhi_epi128 = _mm512_set_epi64( 15, 14, 7, 6, 11, 10, 3, 2 );
+
+  for( int i = 0; i < 2; i++ )
+  {
+    m1[i][0] = _mm512_add_epi32( m2[i][0], m2[i][4] );
+    m1[i][1] = _mm512_add_epi32( m2[i][1], m2[i][5] );
+    m1[i][2] = _mm512_add_epi32( m2[i][2], m2[i][6] );
+    m1[i][3] = _mm512_add_epi32( m2[i][3], m2[i][7] );
+    m1[i][4] = _mm512_sub_epi32( m2[i][0], m2[i][4] );
+    m1[i][5] = _mm512_sub_epi32( m2[i][1], m2[i][5] );
+    m1[i][6] = _mm512_sub_epi32( m2[i][2], m2[i][6] );
+    m1[i][7] = _mm512_sub_epi32( m2[i][3], m2[i][7] );
+
+    m2[i][0] = _mm512_add_epi32( m1[i][0], m1[i][2] );
+    m2[i][1] = _mm512_add_epi32( m1[i][1], m1[i][3] );
+    m2[i][2] = _mm512_sub_epi32( m1[i][0], m1[i][2] );
+    m2[i][3] = _mm512_sub_epi32( m1[i][1], m1[i][3] );
+    m2[i][4] = _mm512_add_epi32( m1[i][4], m1[i][6] );
+    m2[i][5] = _mm512_add_epi32( m1[i][5], m1[i][7] );
+    m2[i][6] = _mm512_sub_epi32( m1[i][4], m1[i][6] );
+    m2[i][7] = _mm512_sub_epi32( m1[i][5], m1[i][7] );
+
+    m1[i][0] = _mm512_add_epi32( m2[i][0], m2[i][1] );
+    m1[i][1] = _mm512_sub_epi32( m2[i][0], m2[i][1] );
+    m1[i][2] = _mm512_add_epi32( m2[i][2], m2[i][3] );
+    m1[i][3] = _mm512_sub_epi32( m2[i][2], m2[i][3] );
+    m1[i][4] = _mm512_add_epi32( m2[i][4], m2[i][5] );
+    m1[i][5] = _mm512_sub_epi32( m2[i][4], m2[i][5] );
+    m1[i][6] = _mm512_add_epi32( m2[i][6], m2[i][7] );
+    m1[i][7] = _mm512_sub_epi32( m2[i][6], m2[i][7] );
+
+    // transpose
+    // 8x8 within each 256-bit half
+    m2[i][0] = _mm512_maskz_unpacklo_epi32( 0xFFFF, m1[i][0], m1[i][1] );
+    m2[i][1] = _mm512_maskz_unpacklo_epi32( 0xFFFF, m1[i][2], m1[i][3] );
+    m2[i][2] = _mm512_maskz_unpacklo_epi32( 0xFFFF, m1[i][4], m1[i][5] );
+    m2[i][3] = _mm512_maskz_unpacklo_epi32( 0xFFFF, m1[i][6], m1[i][7] );
+    m2[i][4] = _mm512_maskz_unpackhi_epi32( 0xFFFF, m1[i][0], m1[i][1] );
+    m2[i][5] = _mm512_maskz_unpackhi_epi32( 0xFFFF, m1[i][2], m1[i][3] );
+    m2[i][6] = _mm512_maskz_unpackhi_epi32( 0xFFFF, m1[i][4], m1[i][5] );
+    m2[i][7] = _mm512_maskz_unpackhi_epi32( 0xFFFF, m1[i][6], m1[i][7] );
+
+    m1[i][0] = _mm512_maskz_unpacklo_epi64( 0xFF, m2[i][0], m2[i][1] );
+    m1[i][1] = _mm512_maskz_unpackhi_epi64( 0xFF, m2[i][0], m2[i][1] );
+    m1[i][2] = _mm512_maskz_unpacklo_epi64( 0xFF, m2[i][2], m2[i][3] );
+    m1[i][3] = _mm512_maskz_unpackhi_epi64( 0xFF, m2[i][2], m2[i][3] );
+    m1[i][4] = _mm512_maskz_unpacklo_epi64( 0xFF, m2[i][4], m2[i][5] );
+    m1[i][5] = _mm512_maskz_unpackhi_epi64( 0xFF, m2[i][4], m2[i][5] );
+    m1[i][6] = _mm512_maskz_unpacklo_epi64( 0xFF, m2[i][6], m2[i][7] );
+    m1[i][7] = _mm512_maskz_unpackhi_epi64( 0xFF, m2[i][6], m2[i][7] );
+
+    m2[i][0] = _mm512_permutex2var_epi64( m1[i][0], perm_unpacklo_epi128, m1[i][2] );
+    m2[i][1] = _mm512_permutex2var_epi64( m1[i][0], perm_unpackhi_epi128, m1[i][2] );
+    m2[i][2] = _mm512_permutex2var_epi64( m1[i][1], perm_unpacklo_epi128, m1[i][3] );
+    m2[i][3] = _mm512_permutex2var_epi64( m1[i][1], perm_unpackhi_epi128, m1[i][3] );
+    m2[i][4] = _mm512_permutex2var_epi64( m1[i][4], perm_unpacklo_epi128, m1[i][6] );
+    m2[i][5] = _mm512_permutex2var_epi64( m1[i][4], perm_unpackhi_epi128, m1[i][6] );
+    m2[i][6] = _mm512_permutex2var_epi64( m1[i][5], perm_unpacklo_epi128, m1[i][7] );
+    m2[i][7] = _mm512_permutex2var_epi64( m1[i][5], perm_unpackhi_epi128, m1[i][7] );
+
+    m1[i][0] = _mm512_add_epi32( m2[i][0], m2[i][4] );
+    m1[i][1] = _mm512_add_epi32( m2[i][1], m2[i][5] );
+    m1[i][2] = _mm512_add_epi32( m2[i][2], m2[i][6] );
+    m1[i][3] = _mm512_add_epi32( m2[i][3], m2[i][7] );
+    m1[i][4] = _mm512_sub_epi32( m2[i][0], m2[i][4] );
+    m1[i][5] = _mm512_sub_epi32( m2[i][1], m2[i][5] );
+    m1[i][6] = _mm512_sub_epi32( m2[i][2], m2[i][6] );
+    m1[i][7] = _mm512_sub_epi32( m2[i][3], m2[i][7] );
+
+    m2[i][0] = _mm512_add_epi32( m1[i][0], m1[i][2] );
+    m2[i][1] = _mm512_add_epi32( m1[i][1], m1[i][3] );
+    m2[i][2] = _mm512_sub_epi32( m1[i][0], m1[i][2] );
+    m2[i][3] = _mm512_sub_epi32( m1[i][1], m1[i][3] );
+    m2[i][4] = _mm512_add_epi32( m1[i][4], m1[i][6] );
+    m2[i][5] = _mm512_add_epi32( m1[i][5], m1[i][7] );
+    m2[i][6] = _mm512_sub_epi32( m1[i][4], m1[i][6] );
+    m2[i][7] = _mm512_sub_epi32( m1[i][5], m1[i][7] );
+
+    m1[i][0] = _mm512_maskz_abs_epi32( 0xFFFF, _mm512_add_epi32( m2[i][0], m2[i][1] ) );
+    m1[i][1] = _mm512_maskz_abs_epi32( 0xFFFF, _mm512_sub_epi32( m2[i][0], m2[i][1] ) );
+    m1[i][2] = _mm512_maskz_abs_epi32( 0xFFFF, _mm512_add_epi32( m2[i][2], m2[i][3] ) );
+    m1[i][3] = _mm512_maskz_abs_epi32( 0xFFFF, _mm512_sub_epi32( m2[i][2], m2[i][3] ) );
+    m1[i][4] = _mm512_maskz_abs_epi32( 0xFFFF, _mm512_add_epi32( m2[i][4], m2[i][5] ) );
+    m1[i][5] = _mm512_maskz_abs_epi32( 0xFFFF, _mm512_sub_epi32( m2[i][4], m2[i][5] ) );
+    m1[i][6] = _mm512_maskz_abs_epi32( 0xFFFF, _mm512_add_epi32( m2[i][6], m2[i][7] ) );
+    m1[i][7] = _mm512_maskz_abs_epi32( 0xFFFF, _mm512_sub_epi32( m2[i][6], m2[i][7] ) );
+
+    __m512i iSum = _mm512_add_epi32( _mm512_add_epi32( _mm512_add_epi32( m1[i][0], m1[i][1] ), _mm512_add_epi32( m1[i][2], m1[i][3] ) ),
+                                     _mm512_add_epi32( _mm512_add_epi32( m1[i][4], m1[i][5] ), _mm512_add_epi32( m1[i][6], m1[i][7] ) ) );
+
+    // one 8x8 block per 256-bit half, its DC coefficient is the first element of that half of m1[i][0]
+    const __m256i iSumBlk[2] = { _mm512_maskz_extracti64x4_epi64( 0xF, iSum, 0 ), _mm512_maskz_extracti64x4_epi64( 0xF, iSum, 1 ) };
+#if JVET_R0164_MEAN_SCALED_SATD
+    const __m256i absDcBlk[2] = { _mm512_maskz_extracti64x4_epi64( 0xF, m1[i][0], 0 ), _mm512_maskz_extracti64x4_epi64( 0xF, m1[i][0], 1 ) };
+#endif
+
+    for( int b = 0; b < 2; b++ )
+    {
+      __m128i iSum128 = _mm_add_epi32( _mm256_castsi256_si128( iSumBlk[b] ), _mm256_extracti128_si256( iSumBlk[b], 1 ) );
+      iSum128 = _mm_hadd_epi32( iSum128, iSum128 );
+      iSum128 = _mm_hadd_epi32( iSum128, iSum128 );
+
+      uint32_t tmp = _mm_cvtsi128_si32( iSum128 );
+#if JVET_R0164_MEAN_SCALED_SATD
+      uint32_t absDc = _mm_cvtsi128_si32( _mm256_castsi256_si128( absDcBlk[b] ) );
+      tmp -= absDc;
+      tmp += absDc >> 2;
+#endif
+      tmp  = ( ( tmp + 2 ) >> 2 );
+      sad += tmp;
+    }
+  }
+
+#endif
+  return ( sad );
+}
+
 static uint32_t xCalcHAD16x16_AVX2( const Torg *piOrg, const Tcur *piCur, const int iStrideOrg, const int iStrideCur, const int iBitDepth )
 {
   uint32_t sad = 0;
@@ -4397,6 +4593,20 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
       piCur += iStrideCur * 8;
     }
   }
+  else if( vext >= AVX512 && ( ( ( iRows | iCols ) & 31 ) == 0 ) && ( iRows == iCols ) )
+  {
+    int  iOffsetOrg = iStrideOrg << 3;
+    int  iOffsetCur = iStrideCur << 3;
+    for( y = 0; y < iRows; y += 8 )
+    {
+      for( x = 0; x < iCols; x += 32 )
+      {
+        uiSum += xCalcHAD32x8_AVX512( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+      }
+      piOrg += iOffsetOrg;
+      piCur += iOffsetCur;
+    }
+  }
   else if( vext >= AVX2 && ( ( ( iRows | iCols ) & 15 ) == 0 ) && ( iRows == iCols ) )
   {
     int  iOffsetOrg = iStrideOrg << 4;
@@ -4462,6 +4672,152 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
 
   return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
 }
+
+#if WCG_EXT
+template<X86_VEXT vext>
+Distortion RdCost::xGetSSE_WTD_SIMD( const DistParam &rcDtParam )
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 && !rcDtParam.applyWeight && ( rcDtParam.org.width & 3 ) == 0 && rcDtParam.cShiftX <= 1 )
+  {
+    const Pel*   piOrg          = rcDtParam.org.buf;
+    const Pel*   piCur          = rcDtParam.cur.buf;
+    const Pel*   piOrgLuma      = rcDtParam.orgLuma.buf;
+    const int    iRows          = rcDtParam.org.height;
+    const int    iCols          = rcDtParam.org.width;
+    const int    iStrideOrg     = rcDtParam.org.stride;
+    const int    iStrideCur     = rcDtParam.cur.stride;
+    const int    iStrideOrgLuma = rcDtParam.orgLuma.stride << rcDtParam.cShiftY;
+    const size_t cShift         = rcDtParam.cShiftX;
+    const bool   useLumaWeight  = rcDtParam.compID == COMPONENT_Y || !( m_signalType == RESHAPE_SIGNAL_SDR || m_signalType == RESHAPE_SIGNAL_HLG );
+    const double*  pLumaWeight  = m_reshapeLumaLevelToWeightPLUT.data();
+    const uint32_t uiShift      = DISTORTION_PRECISION_ADJUSTMENT( rcDtParam.bitDepth ) << 1;
+
+    // same fixed-point weighting as getWeightedMSE(): the 64-bit products are rounded, truncated to
+    // Intermediate_Int and shifted in 32-bit lanes, then sign-extended into the 64-bit accumulator
+    __m256d vscale  = _mm256_set1_pd( ( double ) ( 1 << 16 ) );
+    __m256d vgather = _mm256_castsi256_pd( _mm256_set1_epi64x( -1 ) ); // all lanes, masked gather with a zero source
+    __m256i vround  = _mm256_set1_epi64x( 1 << 15 );
+    __m256i vpack   = _mm256_setr_epi32( 0, 2, 4, 6, 1, 3, 5, 7 );
+    __m128i vshift  = _mm_cvtsi32_si128( uiShift );
+    __m256i vwgt    = _mm256_set1_epi64x( ( int64_t ) ( m_chromaWeight * ( double ) ( 1 << 16 ) ) );
+    __m256i vsum    = _mm256_setzero_si256();
+
+    for( int iY = 0; iY < iRows; iY++ )
+    {
+      for( int iX = 0; iX < iCols; iX += 4 )
+      {
+        __m128i vorg  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &piOrg[iX] ) );
+        __m128i vcur  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &piCur[iX] ) );
+        __m128i vdiff = _mm_sub_epi32( vorg, vcur );
+        __m256i vsq   = _mm256_cvtepi32_epi64( _mm_mullo_epi32( vdiff, vdiff ) );
+
+        if( useLumaWeight )
+        {
+          __m128i vidx = cShift == 0 ? _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &piOrgLuma[iX] ) )
+                                     : _mm_srai_epi32( _mm_slli_epi32( _mm_loadu_si128( ( const __m128i* ) &piOrgLuma[iX << 1] ), 16 ), 16 );
+          vwgt = _mm256_cvtepi32_epi64( _mm256_cvttpd_epi32( _mm256_mul_pd( _mm256_mask_i32gather_pd( _mm256_setzero_pd(), pLumaWeight, vidx, vgather, 8 ), vscale ) ) );
+        }
+
+        __m256i vmse = _mm256_srli_epi64( _mm256_add_epi64( _mm256_mul_epu32( vwgt, vsq ), vround ), 16 );
+        __m128i vlo  = _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( vmse, vpack ) );
+        vsum = _mm256_add_epi64( vsum, _mm256_cvtepi32_epi64( _mm_sra_epi32( vlo, vshift ) ) );
+      }
+      piOrg     += iStrideOrg;
+      piCur     += iStrideCur;
+      piOrgLuma += iStrideOrgLuma;
+    }
+
+    __m128i vsum64 = _mm_add_epi64( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+    vsum64 = _mm_add_epi64( vsum64, _mm_unpackhi_epi64( vsum64, vsum64 ) );
+    return ( Distortion ) _mm_cvtsi128_si64( vsum64 );
+  }
+#endif
+  return RdCost::xGetSSE_WTD( rcDtParam );
+}
+#endif
+
+#if ENABLE_8BIT_REFERENCES
+template<X86_VEXT vext>
+Distortion RdCost::xGetSADRef8_SIMD( const DistParam &rcDtParam )
+{
+  if( rcDtParam.org.width < 4 || rcDtParam.applyWeight )
+  {
+    return RdCost::xGetSADRef8( rcDtParam );
+  }
+
+  const short*   pSrc1       = (const short*)rcDtParam.org.buf;
+  const uint8_t* pSrc2       = rcDtParam.cur8;
+  const int      iRows       = rcDtParam.org.height;
+  const int      iCols       = rcDtParam.org.width;
+  const int      iSubShift   = rcDtParam.subShift;
+  const int      iSubStep    = ( 1 << iSubShift );
+  const int      iStrideSrc1 = rcDtParam.org.stride * iSubStep;
+  const int      iStrideSrc2 = rcDtParam.cur.stride * iSubStep;
+
+  CHECK( ( iCols & 3 ) != 0, "Not divisible by 4: " << iCols );
+
+  uint32_t uiSum = 0;
+  if( vext >= AVX2 && ( iCols & 15 ) == 0 )
+  {
+#ifdef USE_AVX2
+    // Do for width that multiple of 16, widening 16 reference samples per step
+    __m256i vzero  = _mm256_setzero_si256();
+    __m256i vone   = _mm256_set1_epi16( 1 );
+    __m256i vsum32 = vzero;
+    for( int iY = 0; iY < iRows; iY += iSubStep )
+    {
+      __m256i vsum16 = vzero;
+      for( int iX = 0; iX < iCols; iX += 16 )
+      {
+        __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i* )( &pSrc1[iX] ) );
+        __m256i vsrc2 = _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* )( &pSrc2[iX] ) ) );
+        vsum16 = _mm256_add_epi16( vsum16, _mm256_abs_epi16( _mm256_sub_epi16( vsrc1, vsrc2 ) ) );
+      }
+      vsum32 = _mm256_add_epi32( vsum32, _mm256_madd_epi16( vsum16, vone ) );
+      pSrc1 += iStrideSrc1;
+      pSrc2 += iStrideSrc2;
+    }
+    vsum32 = _mm256_hadd_epi32( vsum32, vzero );
+    vsum32 = _mm256_hadd_epi32( vsum32, vzero );
+    uiSum  = _mm_cvtsi128_si32( _mm256_castsi256_si128( vsum32 ) ) + _mm_cvtsi128_si32( _mm256_extracti128_si256( vsum32, 1 ) );
+#endif
+  }
+  else
+  {
+    // Do with step of 8 and a 4-sample tail
+    __m128i vzero  = _mm_setzero_si128();
+    __m128i vone   = _mm_set1_epi16( 1 );
+    __m128i vsum32 = vzero;
+    for( int iY = 0; iY < iRows; iY += iSubStep )
+    {
+      __m128i vsum16 = vzero;
+      int iX = 0;
+      for( ; iX + 8 <= iCols; iX += 8 )
+      {
+        __m128i vsrc1 = _mm_loadu_si128( ( const __m128i* )( &pSrc1[iX] ) );
+        __m128i vsrc2 = _mm_cvtepu8_epi16( _mm_loadl_epi64( ( const __m128i* )( &pSrc2[iX] ) ) );
+        vsum16 = _mm_add_epi16( vsum16, _mm_abs_epi16( _mm_sub_epi16( vsrc1, vsrc2 ) ) );
+      }
+      if( iX < iCols )
+      {
+        __m128i vsrc1 = _mm_loadl_epi64( ( const __m128i* )( &pSrc1[iX] ) );
+        __m128i vsrc2 = _mm_cvtepu8_epi16( _mm_cvtsi32_si128( *( const int32_t* )( &pSrc2[iX] ) ) );
+        vsum16 = _mm_add_epi16( vsum16, _mm_unpacklo_epi64( _mm_abs_epi16( _mm_sub_epi16( vsrc1, vsrc2 ) ), vzero ) );
+      }
+      vsum32 = _mm_add_epi32( vsum32, _mm_madd_epi16( vsum16, vone ) );
+      pSrc1 += iStrideSrc1;
+      pSrc2 += iStrideSrc2;
+    }
+    vsum32 = _mm_hadd_epi32( vsum32, vzero );
+    vsum32 = _mm_hadd_epi32( vsum32, vzero );
+    uiSum  = _mm_cvtsi128_si32( vsum32 );
+  }
+
+  uiSum <<= iSubShift;
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+}
+#endif
 #endif
 template <X86_VEXT vext>
 void RdCost::_initRdCostX86()
@@ -4536,6 +4892,23 @@ void RdCost::_initRdCostX86()
   m_afpDistortFunc[DF_SAD_INTERMEDIATE_BITDEPTH] = RdCost::xGetSAD_IBD_SIMD<vext>;
 
   m_afpDistortFunc[DF_SAD_WITH_MASK] = xGetSADwMask_SIMD<vext>;
+
+#if WCG_EXT
+  // the weighted SSE needs the AVX2 gathers for the per-sample weight lookup
+  if( vext >= AVX2 )
+  {
+    m_afpDistortFunc[DF_SSE_WTD   ] = RdCost::xGetSSE_WTD_SIMD<vext>;
+    m_afpDistortFunc[DF_SSE4_WTD  ] = RdCost::xGetSSE_WTD_SIMD<vext>;
+    m_afpDistortFunc[DF_SSE8_WTD  ] = RdCost::xGetSSE_WTD_SIMD<vext>;
+    m_afpDistortFunc[DF_SSE16_WTD ] = RdCost::xGetSSE_WTD_SIMD<vext>;
+    m_afpDistortFunc[DF_SSE32_WTD ] = RdCost::xGetSSE_WTD_SIMD<vext>;
+    m_afpDistortFunc[DF_SSE64_WTD ] = RdCost::xGetSSE_WTD_SIMD<vext>;
+    m_afpDistortFunc[DF_SSE16N_WTD] = RdCost::xGetSSE_WTD_SIMD<vext>;
+  }
+#endif
+#if ENABLE_8BIT_REFERENCES
+  m_afpDistortFunc[DF_SAD_REF8] = RdCost::xGetSADRef8_SIMD<vext>;
+#endif
 #endif
 }
 
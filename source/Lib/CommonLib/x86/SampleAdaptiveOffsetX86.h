@@ -0,0 +1,290 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     SampleAdaptiveOffsetX86.h
+    \brief    sample adaptive offset, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// edge class of 8 samples as 0..4, i.e. sgn( cur - a ) + sgn( cur - b ) + 2
+static inline __m128i calcEdgeClass( const __m128i& cur, const __m128i& a, const __m128i& b )
+{
+  const __m128i signA = _mm_sub_epi16( _mm_cmpgt_epi16( a, cur ), _mm_cmpgt_epi16( cur, a ) );
+  const __m128i signB = _mm_sub_epi16( _mm_cmpgt_epi16( b, cur ), _mm_cmpgt_epi16( cur, b ) );
+  return _mm_add_epi16( _mm_add_epi16( signA, signB ), _mm_set1_epi16( 2 ) );
+}
+
+#ifdef USE_AVX2
+static inline __m256i calcEdgeClass( const __m256i& cur, const __m256i& a, const __m256i& b )
+{
+  const __m256i signA = _mm256_sub_epi16( _mm256_cmpgt_epi16( a, cur ), _mm256_cmpgt_epi16( cur, a ) );
+  const __m256i signB = _mm256_sub_epi16( _mm256_cmpgt_epi16( b, cur ), _mm256_cmpgt_epi16( cur, b ) );
+  return _mm256_add_epi16( _mm256_add_epi16( signA, signB ), _mm256_set1_epi16( 2 ) );
+}
+#endif
+
+static inline int horizontalSum32( const __m128i& val )
+{
+  __m128i sum = _mm_add_epi32( val, _mm_shuffle_epi32( val, 0x4e ) );
+  sum         = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+  return _mm_cvtsi128_si32( sum );
+}
+
+template<X86_VEXT vext>
+static void offsetLineEO_SIMD( const Pel* srcLine, Pel* resLine, const int offsetA, const int offsetB, const int startX, const int endX, const int* offset, const ClpRng& clpRng )
+{
+  if( endX - startX < 8 )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int edgeType = sgn( srcLine[x] - srcLine[x + offsetA] ) + sgn( srcLine[x] - srcLine[x + offsetB] );
+      resLine[x] = ClipPel<int>( srcLine[x] + offset[edgeType], clpRng );
+    }
+    return;
+  }
+
+  // the 5 offsets are looked up with a byte shuffle, the control of the 16 bit entry e is the byte pair ( 2e, 2e + 1 )
+  const __m128i offsetTable = _mm_setr_epi16( offset[-2], offset[-1], offset[0], offset[1], offset[2], 0, 0, 0 );
+
+  // the samples of a line are independent, the last block of 8 or 16 samples is aligned to endX and may overlap
+#ifdef USE_AVX2
+  if( vext >= AVX2 && endX - startX >= 16 )
+  {
+    const __m256i table   = _mm256_broadcastsi128_si256( offsetTable );
+    const __m256i vmin    = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax    = _mm256_set1_epi16( clpRng.max );
+    const __m256i ctrlMul = _mm256_set1_epi16( 0x0202 );
+    const __m256i ctrlAdd = _mm256_set1_epi16( 0x0100 );
+    for( int x = startX; x < endX; x += 16 )
+    {
+      const int     pos  = std::min( x, endX - 16 );
+      const __m256i cur  = _mm256_loadu_si256( (const __m256i*) &srcLine[pos] );
+      const __m256i edge = calcEdgeClass( cur, _mm256_loadu_si256( (const __m256i*) &srcLine[pos + offsetA] ), _mm256_loadu_si256( (const __m256i*) &srcLine[pos + offsetB] ) );
+      const __m256i off  = _mm256_shuffle_epi8( table, _mm256_add_epi16( _mm256_mullo_epi16( edge, ctrlMul ), ctrlAdd ) );
+      _mm256_storeu_si256( (__m256i*) &resLine[pos], _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( cur, off ), vmin ), vmax ) );
+    }
+    return;
+  }
+#endif
+
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+  const __m128i ctrlMul = _mm_set1_epi16( 0x0202 );
+  const __m128i ctrlAdd = _mm_set1_epi16( 0x0100 );
+  for( int x = startX; x < endX; x += 8 )
+  {
+    const int     pos  = std::min( x, endX - 8 );
+    const __m128i cur  = _mm_loadu_si128( (const __m128i*) &srcLine[pos] );
+    const __m128i edge = calcEdgeClass( cur, _mm_loadu_si128( (const __m128i*) &srcLine[pos + offsetA] ), _mm_loadu_si128( (const __m128i*) &srcLine[pos + offsetB] ) );
+    const __m128i off  = _mm_shuffle_epi8( offsetTable, _mm_add_epi16( _mm_mullo_epi16( edge, ctrlMul ), ctrlAdd ) );
+    _mm_storeu_si128( (__m128i*) &resLine[pos], _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( cur, off ), vmin ), vmax ) );
+  }
+}
+
+template<X86_VEXT vext>
+static void offsetLineBO_SIMD( const Pel* srcLine, Pel* resLine, const int width, const int* offset, const int shiftBits, const ClpRng& clpRng )
+{
+  if( width < 8 )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      resLine[x] = ClipPel<int>( srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
+    }
+    return;
+  }
+
+  // the low and high bytes of the 32 band offsets are looked up separately, bands 16..31 in a second table
+  int8_t lo[NUM_SAO_BO_CLASSES], hi[NUM_SAO_BO_CLASSES];
+  for( int i = 0; i < NUM_SAO_BO_CLASSES; i++ )
+  {
+    lo[i] = int8_t( offset[i] & 0xff );
+    hi[i] = int8_t( ( offset[i] >> 8 ) & 0xff );
+  }
+  const __m128i lo0 = _mm_loadu_si128( (const __m128i*) &lo[0] );
+  const __m128i lo1 = _mm_loadu_si128( (const __m128i*) &lo[16] );
+  const __m128i hi0 = _mm_loadu_si128( (const __m128i*) &hi[0] );
+  const __m128i hi1 = _mm_loadu_si128( (const __m128i*) &hi[16] );
+  const __m128i shift = _mm_cvtsi32_si128( shiftBits );
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    const __m256i tabLo0 = _mm256_broadcastsi128_si256( lo0 );
+    const __m256i tabLo1 = _mm256_broadcastsi128_si256( lo1 );
+    const __m256i tabHi0 = _mm256_broadcastsi128_si256( hi0 );
+    const __m256i tabHi1 = _mm256_broadcastsi128_si256( hi1 );
+    const __m256i vmin   = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax   = _mm256_set1_epi16( clpRng.max );
+    const __m256i mask   = _mm256_set1_epi8( 15 );
+    for( int x = 0; x < width; x += 16 )
+    {
+      const int     pos  = std::min( x, width - 16 );
+      const __m256i cur  = _mm256_loadu_si256( (const __m256i*) &srcLine[pos] );
+      const __m256i band = _mm256_packus_epi16( _mm256_srl_epi16( cur, shift ), _mm256_setzero_si256() );
+      const __m256i idx  = _mm256_and_si256( band, mask );
+      const __m256i high = _mm256_cmpgt_epi8( band, mask );
+      const __m256i offLo = _mm256_blendv_epi8( _mm256_shuffle_epi8( tabLo0, idx ), _mm256_shuffle_epi8( tabLo1, idx ), high );
+      const __m256i offHi = _mm256_blendv_epi8( _mm256_shuffle_epi8( tabHi0, idx ), _mm256_shuffle_epi8( tabHi1, idx ), high );
+      const __m256i off   = _mm256_unpacklo_epi8( offLo, offHi );
+      _mm256_storeu_si256( (__m256i*) &resLine[pos], _mm256_min_epi16( _mm256_max_epi16( _mm256_add_epi16( cur, off ), vmin ), vmax ) );
+    }
+    return;
+  }
+#endif
+
+  const __m128i vmin = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax = _mm_set1_epi16( clpRng.max );
+  const __m128i mask = _mm_set1_epi8( 15 );
+  for( int x = 0; x < width; x += 8 )
+  {
+    const int     pos   = std::min( x, width - 8 );
+    const __m128i cur   = _mm_loadu_si128( (const __m128i*) &srcLine[pos] );
+    const __m128i band  = _mm_packus_epi16( _mm_srl_epi16( cur, shift ), _mm_setzero_si128() );
+    const __m128i idx   = _mm_and_si128( band, mask );
+    const __m128i high  = _mm_cmpgt_epi8( band, mask );
+    const __m128i offLo = _mm_blendv_epi8( _mm_shuffle_epi8( lo0, idx ), _mm_shuffle_epi8( lo1, idx ), high );
+    const __m128i offHi = _mm_blendv_epi8( _mm_shuffle_epi8( hi0, idx ), _mm_shuffle_epi8( hi1, idx ), high );
+    const __m128i off   = _mm_unpacklo_epi8( offLo, offHi );
+    _mm_storeu_si128( (__m128i*) &resLine[pos], _mm_min_epi16( _mm_max_epi16( _mm_add_epi16( cur, off ), vmin ), vmax ) );
+  }
+}
+
+template<X86_VEXT vext>
+static void calcStatsLineEO_SIMD( const Pel* srcLine, const Pel* orgLine, const int offsetA, const int offsetB, const int startX, const int endX, int64_t* diff, int64_t* count )
+{
+  // the sums of the classes 0, 1, 3 and 4 are accumulated per lane, class 2 follows from the totals
+  static const int classes[4] = { 0, 1, 3, 4 };
+
+  __m128i diffSum[4], countSum[4];
+  for( int k = 0; k < 4; k++ )
+  {
+    diffSum [k] = _mm_setzero_si128();
+    countSum[k] = _mm_setzero_si128();
+  }
+  __m128i   diffTotal = _mm_setzero_si128();
+  const __m128i ones  = _mm_set1_epi16( 1 );
+
+  int x = startX;
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    __m256i diffSum256[4], countSum256[4];
+    for( int k = 0; k < 4; k++ )
+    {
+      diffSum256 [k] = _mm256_setzero_si256();
+      countSum256[k] = _mm256_setzero_si256();
+    }
+    __m256i       diffTotal256 = _mm256_setzero_si256();
+    const __m256i ones256      = _mm256_set1_epi16( 1 );
+    for( ; x + 16 <= endX; x += 16 )
+    {
+      const __m256i cur  = _mm256_loadu_si256( (const __m256i*) &srcLine[x] );
+      const __m256i edge = calcEdgeClass( cur, _mm256_loadu_si256( (const __m256i*) &srcLine[x + offsetA] ), _mm256_loadu_si256( (const __m256i*) &srcLine[x + offsetB] ) );
+      const __m256i d    = _mm256_sub_epi16( _mm256_loadu_si256( (const __m256i*) &orgLine[x] ), cur );
+      diffTotal256       = _mm256_add_epi32( diffTotal256, _mm256_madd_epi16( d, ones256 ) );
+      for( int k = 0; k < 4; k++ )
+      {
+        const __m256i inClass = _mm256_cmpeq_epi16( edge, _mm256_set1_epi16( classes[k] ) );
+        diffSum256 [k] = _mm256_add_epi32( diffSum256[k], _mm256_madd_epi16( _mm256_and_si256( d, inClass ), ones256 ) );
+        countSum256[k] = _mm256_sub_epi16( countSum256[k], inClass );
+      }
+    }
+    diffTotal = _mm_add_epi32( _mm256_castsi256_si128( diffTotal256 ), _mm256_extracti128_si256( diffTotal256, 1 ) );
+    for( int k = 0; k < 4; k++ )
+    {
+      diffSum [k] = _mm_add_epi32( _mm256_castsi256_si128( diffSum256[k] ), _mm256_extracti128_si256( diffSum256[k], 1 ) );
+      countSum[k] = _mm_add_epi16( _mm256_castsi256_si128( countSum256[k] ), _mm256_extracti128_si256( countSum256[k], 1 ) );
+    }
+  }
+#endif
+  for( ; x + 8 <= endX; x += 8 )
+  {
+    const __m128i cur  = _mm_loadu_si128( (const __m128i*) &srcLine[x] );
+    const __m128i edge = calcEdgeClass( cur, _mm_loadu_si128( (const __m128i*) &srcLine[x + offsetA] ), _mm_loadu_si128( (const __m128i*) &srcLine[x + offsetB] ) );
+    const __m128i d    = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*) &orgLine[x] ), cur );
+    diffTotal          = _mm_add_epi32( diffTotal, _mm_madd_epi16( d, ones ) );
+    for( int k = 0; k < 4; k++ )
+    {
+      const __m128i inClass = _mm_cmpeq_epi16( edge, _mm_set1_epi16( classes[k] ) );
+      diffSum [k] = _mm_add_epi32( diffSum[k], _mm_madd_epi16( _mm_and_si128( d, inClass ), ones ) );
+      countSum[k] = _mm_sub_epi16( countSum[k], inClass );
+    }
+  }
+
+  const int numVector = x - startX;
+  int64_t   diffRest  = horizontalSum32( diffTotal );
+  int64_t   countRest = numVector;
+  for( int k = 0; k < 4; k++ )
+  {
+    const int d = horizontalSum32( diffSum[k] );
+    const int c = horizontalSum32( _mm_madd_epi16( countSum[k], ones ) );
+    diff [classes[k] - 2] += d;
+    count[classes[k] - 2] += c;
+    diffRest  -= d;
+    countRest -= c;
+  }
+  diff [0] += diffRest;
+  count[0] += countRest;
+
+  for( ; x < endX; x++ )
+  {
+    const int edgeType = sgn( srcLine[x] - srcLine[x + offsetA] ) + sgn( srcLine[x] - srcLine[x + offsetB] );
+    diff [edgeType] += ( orgLine[x] - srcLine[x] );
+    count[edgeType] ++;
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_offsetLineEO    = offsetLineEO_SIMD<vext>;
+  m_offsetLineBO    = offsetLineBO_SIMD<vext>;
+  m_calcStatsLineEO = calcStatsLineEO_SIMD<vext>;
+#endif
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+//! \}
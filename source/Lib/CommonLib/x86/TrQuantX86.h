@@ -0,0 +1,677 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TrQuantX86.h
+    \brief    forward and inverse core transforms, SIMD version
+*/
+
+#include "CommonDefX86.h"
+#include "../Rom.h"
+#include "../TrQuant.h"
+
+#include <memory.h>
+#include <limits>
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+static inline const TMatrixCoeff* getTrCoreMatrix( const int trType, const int trSize, const int dir )
+{
+  switch( trType )
+  {
+  case DCT2:
+    switch( trSize )
+    {
+    case  8: return g_trCoreDCT2P8 [dir][0];
+    case 16: return g_trCoreDCT2P16[dir][0];
+    case 32: return g_trCoreDCT2P32[dir][0];
+    case 64: return g_trCoreDCT2P64[dir][0];
+    }
+    break;
+  case DCT8:
+    switch( trSize )
+    {
+    case  8: return g_trCoreDCT8P8 [dir][0];
+    case 16: return g_trCoreDCT8P16[dir][0];
+    case 32: return g_trCoreDCT8P32[dir][0];
+    }
+    break;
+  case DST7:
+    switch( trSize )
+    {
+    case  8: return g_trCoreDST7P8 [dir][0];
+    case 16: return g_trCoreDST7P16[dir][0];
+    case 32: return g_trCoreDST7P32[dir][0];
+    }
+    break;
+  }
+  THROW( "Unsupported transform" );
+  return nullptr;
+}
+
+// Matrix multiplication counterparts of the partial butterflies in TrQuant_EMT.cpp. Both evaluate the same integer
+// sums with wrap-around 32-bit arithmetic before the rounding shift, so the results are identical.
+template<X86_VEXT vext, int trSize>
+static void fastForwardMM_SIMD( const TCoeff *src, TCoeff *dst, int shift, int line, int iSkipLine, int numRows, const TMatrixCoeff *iT )
+{
+  const int    reducedLine = line - iSkipLine;
+  const TCoeff rnd_factor  = ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0;
+
+  // transpose the input, so that the vectors run along the lines of the output
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, TCoeff srcT[trSize * MAX_TB_SIZEY] );
+
+  for( int j = 0; j < reducedLine; j++ )
+  {
+    for( int n = 0; n < trSize; n++ )
+    {
+      srcT[n * reducedLine + j] = src[j * trSize + n];
+    }
+  }
+
+  const __m128i vrnd   = _mm_set1_epi32( rnd_factor );
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+
+  for( int k = 0; k < numRows; k++ )
+  {
+    const TMatrixCoeff *c = iT + k * trSize;
+    int j = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vrnd256 = _mm256_set1_epi32( rnd_factor );
+
+      for( ; j + 8 <= reducedLine; j += 8 )
+      {
+        __m256i vsum = _mm256_setzero_si256();
+
+        for( int n = 0; n < trSize; n++ )
+        {
+          __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) &srcT[n * reducedLine + j] );
+          vsum = _mm256_add_epi32( vsum, _mm256_mullo_epi32( vsrc, _mm256_set1_epi32( c[n] ) ) );
+        }
+
+        vsum = _mm256_sra_epi32( _mm256_add_epi32( vsum, vrnd256 ), vshift );
+        _mm256_storeu_si256( ( __m256i* ) &dst[j], vsum );
+      }
+    }
+#endif
+    for( ; j + 4 <= reducedLine; j += 4 )
+    {
+      __m128i vsum = _mm_setzero_si128();
+
+      for( int n = 0; n < trSize; n++ )
+      {
+        __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &srcT[n * reducedLine + j] );
+        vsum = _mm_add_epi32( vsum, _mm_mullo_epi32( vsrc, _mm_set1_epi32( c[n] ) ) );
+      }
+
+      vsum = _mm_sra_epi32( _mm_add_epi32( vsum, vrnd ), vshift );
+      _mm_storeu_si128( ( __m128i* ) &dst[j], vsum );
+    }
+    for( ; j < reducedLine; j++ )
+    {
+      TCoeff iSum = 0;
+
+      for( int n = 0; n < trSize; n++ )
+      {
+        iSum += srcT[n * reducedLine + j] * c[n];
+      }
+
+      dst[j] = ( iSum + rnd_factor ) >> shift;
+    }
+
+    if( iSkipLine )
+    {
+      memset( dst + reducedLine, 0, sizeof( TCoeff ) * iSkipLine );
+    }
+
+    dst += line;
+  }
+
+  if( numRows < trSize )
+  {
+    memset( dst, 0, sizeof( TCoeff ) * line * ( trSize - numRows ) );
+  }
+}
+
+template<X86_VEXT vext, int trSize>
+static void fastInverseMM_SIMD( const TCoeff *src, TCoeff *dst, int shift, int line, int iSkipLine, int numTerms, const TCoeff outputMinimum, const TCoeff outputMaximum, const TMatrixCoeff *iT )
+{
+  const int    reducedLine = line - iSkipLine;
+  const TCoeff rnd_factor  = TCoeff( 1 ) << ( shift - 1 );
+
+  const __m128i vrnd   = _mm_set1_epi32( rnd_factor );
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+  const __m128i vmin   = _mm_set1_epi32( outputMinimum );
+  const __m128i vmax   = _mm_set1_epi32( outputMaximum );
+
+  for( int i = 0; i < reducedLine; i++ )
+  {
+    int n = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && trSize >= 8 )
+    {
+      const __m256i vrnd256 = _mm256_set1_epi32( rnd_factor );
+      const __m256i vmin256 = _mm256_set1_epi32( outputMinimum );
+      const __m256i vmax256 = _mm256_set1_epi32( outputMaximum );
+
+      for( ; n < trSize; n += 8 )
+      {
+        __m256i vsum = _mm256_setzero_si256();
+
+        for( int k = 0; k < numTerms; k++ )
+        {
+          __m256i vcoef = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &iT[k * trSize + n] ) );
+          vsum = _mm256_add_epi32( vsum, _mm256_mullo_epi32( vcoef, _mm256_set1_epi32( src[k * line] ) ) );
+        }
+
+        vsum = _mm256_sra_epi32( _mm256_add_epi32( vsum, vrnd256 ), vshift );
+        vsum = _mm256_min_epi32( vmax256, _mm256_max_epi32( vmin256, vsum ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[n], vsum );
+      }
+    }
+#endif
+    for( ; n < trSize; n += 4 )
+    {
+      __m128i vsum = _mm_setzero_si128();
+
+      for( int k = 0; k < numTerms; k++ )
+      {
+        __m128i vcoef = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &iT[k * trSize + n] ) );
+        vsum = _mm_add_epi32( vsum, _mm_mullo_epi32( vcoef, _mm_set1_epi32( src[k * line] ) ) );
+      }
+
+      vsum = _mm_sra_epi32( _mm_add_epi32( vsum, vrnd ), vshift );
+      vsum = _mm_min_epi32( vmax, _mm_max_epi32( vmin, vsum ) );
+      _mm_storeu_si128( ( __m128i* ) &dst[n], vsum );
+    }
+
+    src++;
+    dst += trSize;
+  }
+
+  if( iSkipLine )
+  {
+    memset( dst, 0, sizeof( TCoeff ) * trSize * iSkipLine );
+  }
+}
+
+// Inverse transform matrix with the rows interleaved pairwise, as the second operand of _mm_madd_epi16
+template<int trType, int trSize>
+static const int32_t* getTrCorePairs()
+{
+  struct TrCorePairs
+  {
+    int32_t c[trSize / 2 * trSize];
+
+    TrCorePairs()
+    {
+      const TMatrixCoeff *iT = getTrCoreMatrix( trType, trSize, TRANSFORM_INVERSE );
+
+      for( int q = 0; q < trSize / 2; q++ )
+      {
+        for( int n = 0; n < trSize; n++ )
+        {
+          c[q * trSize + n] = int32_t( uint32_t( uint16_t( iT[2 * q * trSize + n] ) ) | ( uint32_t( uint16_t( iT[( 2 * q + 1 ) * trSize + n] ) ) << 16 ) );
+        }
+      }
+    }
+  };
+
+  static const TrCorePairs trCorePairs;
+
+  return trCorePairs.c;
+}
+
+static inline bool isInt16Range( const __m128i &vmin, const __m128i &vmax )
+{
+  const __m128i vout = _mm_or_si128( _mm_cmplt_epi32( vmin, _mm_set1_epi32( std::numeric_limits<int16_t>::min() ) ),
+                                     _mm_cmpgt_epi32( vmax, _mm_set1_epi32( std::numeric_limits<int16_t>::max() ) ) );
+  return _mm_movemask_epi8( vout ) == 0;
+}
+
+// Same as fastForwardMM_SIMD with the input packed to 16 bit, which takes half the multiplications. Returns false
+// without writing the output if the input does not fit into 16 bit.
+template<X86_VEXT vext, int trSize>
+static bool fastForwardMM16_SIMD( const TCoeff *src, TCoeff *dst, int shift, int line, int iSkipLine, int numRows, const TMatrixCoeff *iT )
+{
+  const int    reducedLine = line - iSkipLine;
+  const int    numPairs    = trSize >> 1;
+  const TCoeff rnd_factor  = ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0;
+
+  // pack the input to 16 bit, two neighbouring samples of a line per 32 bit
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int32_t srcPairs [MAX_TB_SIZEY / 2 * MAX_TB_SIZEY] );
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int32_t srcPairsT[MAX_TB_SIZEY / 2 * MAX_TB_SIZEY] );
+
+  __m128i vmin = _mm_setzero_si128();
+  __m128i vmax = _mm_setzero_si128();
+
+  for( int i = 0; i < reducedLine * trSize; i += 4 )
+  {
+    __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &src[i] );
+    vmin = _mm_min_epi32( vmin, vsrc );
+    vmax = _mm_max_epi32( vmax, vsrc );
+    _mm_storel_epi64( ( __m128i* ) &srcPairs[i >> 1], _mm_packs_epi32( vsrc, vsrc ) );
+  }
+
+  if( !isInt16Range( vmin, vmax ) )
+  {
+    return false;
+  }
+
+  // transpose, so that the vectors run along the lines of the output
+  if( numPairs >= 4 && ( reducedLine & 3 ) == 0 )
+  {
+    for( int j = 0; j < reducedLine; j += 4 )
+    {
+      for( int p = 0; p < numPairs; p += 4 )
+      {
+        __m128i T[4];
+
+        for( int r = 0; r < 4; r++ )
+        {
+          T[r] = _mm_loadu_si128( ( const __m128i* ) &srcPairs[( j + r ) * numPairs + p] );
+        }
+
+        TRANSPOSE4x4( T );
+
+        for( int r = 0; r < 4; r++ )
+        {
+          _mm_storeu_si128( ( __m128i* ) &srcPairsT[( p + r ) * reducedLine + j], T[r] );
+        }
+      }
+    }
+  }
+  else
+  {
+    for( int j = 0; j < reducedLine; j++ )
+    {
+      for( int p = 0; p < numPairs; p++ )
+      {
+        srcPairsT[p * reducedLine + j] = srcPairs[j * numPairs + p];
+      }
+    }
+  }
+
+  const __m128i vrnd   = _mm_set1_epi32( rnd_factor );
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+
+  for( int k = 0; k < numRows; k++ )
+  {
+    const TMatrixCoeff *c = iT + k * trSize;
+    int32_t cPairs[trSize >> 1];
+    memcpy( cPairs, c, sizeof( cPairs ) );
+
+    int j = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vrnd256 = _mm256_set1_epi32( rnd_factor );
+
+      for( ; j + 8 <= reducedLine; j += 8 )
+      {
+        __m256i vsum = _mm256_setzero_si256();
+
+        for( int p = 0; p < numPairs; p++ )
+        {
+          __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) &srcPairsT[p * reducedLine + j] );
+          vsum = _mm256_add_epi32( vsum, _mm256_madd_epi16( vsrc, _mm256_set1_epi32( cPairs[p] ) ) );
+        }
+
+        vsum = _mm256_sra_epi32( _mm256_add_epi32( vsum, vrnd256 ), vshift );
+        _mm256_storeu_si256( ( __m256i* ) &dst[j], vsum );
+      }
+    }
+#endif
+    for( ; j + 4 <= reducedLine; j += 4 )
+    {
+      __m128i vsum = _mm_setzero_si128();
+
+      for( int p = 0; p < numPairs; p++ )
+      {
+        __m128i vsrc = _mm_loadu_si128( ( const __m128i* ) &srcPairsT[p * reducedLine + j] );
+        vsum = _mm_add_epi32( vsum, _mm_madd_epi16( vsrc, _mm_set1_epi32( cPairs[p] ) ) );
+      }
+
+      vsum = _mm_sra_epi32( _mm_add_epi32( vsum, vrnd ), vshift );
+      _mm_storeu_si128( ( __m128i* ) &dst[j], vsum );
+    }
+    for( ; j < reducedLine; j++ )
+    {
+      TCoeff iSum = 0;
+
+      for( int n = 0; n < trSize; n++ )
+      {
+        iSum += src[j * trSize + n] * c[n];
+      }
+
+      dst[j] = ( iSum + rnd_factor ) >> shift;
+    }
+
+    if( iSkipLine )
+    {
+      memset( dst + reducedLine, 0, sizeof( TCoeff ) * iSkipLine );
+    }
+
+    dst += line;
+  }
+
+  if( numRows < trSize )
+  {
+    memset( dst, 0, sizeof( TCoeff ) * line * ( trSize - numRows ) );
+  }
+
+  return true;
+}
+
+// Same as fastInverseMM_SIMD with the input packed to 16 bit, which takes half the multiplications. Returns false
+// without writing the output if the input does not fit into 16 bit.
+template<X86_VEXT vext, int trSize>
+static bool fastInverseMM16_SIMD( const TCoeff *src, TCoeff *dst, int shift, int line, int iSkipLine, int numTerms, const TCoeff outputMinimum, const TCoeff outputMaximum, const int32_t *iTPairs )
+{
+  const int    reducedLine = line - iSkipLine;
+  const int    numPairs    = ( numTerms + 1 ) >> 1;
+  const TCoeff rnd_factor  = TCoeff( 1 ) << ( shift - 1 );
+
+  // pack the input to 16 bit, the samples of two neighbouring input rows interleaved
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int32_t srcPairs[MAX_TB_SIZEY / 2 * MAX_TB_SIZEY] );
+
+  __m128i vmin = _mm_setzero_si128();
+  __m128i vmax = _mm_setzero_si128();
+
+  for( int q = 0; q < numPairs; q++ )
+  {
+    const TCoeff *src0 = src + 2 * q * line;
+    const TCoeff *src1 = 2 * q + 1 < numTerms ? src0 + line : nullptr;
+    int i = 0;
+
+    for( ; i + 4 <= reducedLine; i += 4 )
+    {
+      __m128i vsrc0 = _mm_loadu_si128( ( const __m128i* ) &src0[i] );
+      __m128i vsrc1 = src1 ? _mm_loadu_si128( ( const __m128i* ) &src1[i] ) : _mm_setzero_si128();
+      vmin = _mm_min_epi32( vmin, _mm_min_epi32( vsrc0, vsrc1 ) );
+      vmax = _mm_max_epi32( vmax, _mm_max_epi32( vsrc0, vsrc1 ) );
+      _mm_storeu_si128( ( __m128i* ) &srcPairs[q * reducedLine + i], _mm_unpacklo_epi16( _mm_packs_epi32( vsrc0, vsrc0 ), _mm_packs_epi32( vsrc1, vsrc1 ) ) );
+    }
+    for( ; i < reducedLine; i++ )
+    {
+      const TCoeff s0 = src0[i];
+      const TCoeff s1 = src1 ? src1[i] : 0;
+      vmin = _mm_min_epi32( vmin, _mm_set_epi32( 0, 0, s1, s0 ) );
+      vmax = _mm_max_epi32( vmax, _mm_set_epi32( 0, 0, s1, s0 ) );
+      srcPairs[q * reducedLine + i] = int32_t( uint32_t( uint16_t( s0 ) ) | ( uint32_t( uint16_t( s1 ) ) << 16 ) );
+    }
+  }
+
+  if( !isInt16Range( vmin, vmax ) )
+  {
+    return false;
+  }
+
+  const __m128i vrnd   = _mm_set1_epi32( rnd_factor );
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+  const __m128i vmin32 = _mm_set1_epi32( outputMinimum );
+  const __m128i vmax32 = _mm_set1_epi32( outputMaximum );
+
+  for( int i = 0; i < reducedLine; i++ )
+  {
+    int n = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && trSize >= 8 )
+    {
+      const __m256i vrnd256 = _mm256_set1_epi32( rnd_factor );
+      const __m256i vmin256 = _mm256_set1_epi32( outputMinimum );
+      const __m256i vmax256 = _mm256_set1_epi32( outputMaximum );
+
+      for( ; n < trSize; n += 8 )
+      {
+        __m256i vsum = _mm256_setzero_si256();
+
+        for( int q = 0; q < numPairs; q++ )
+        {
+          __m256i vcoef = _mm256_loadu_si256( ( const __m256i* ) &iTPairs[q * trSize + n] );
+          vsum = _mm256_add_epi32( vsum, _mm256_madd_epi16( vcoef, _mm256_set1_epi32( srcPairs[q * reducedLine + i] ) ) );
+        }
+
+        vsum = _mm256_sra_epi32( _mm256_add_epi32( vsum, vrnd256 ), vshift );
+        vsum = _mm256_min_epi32( vmax256, _mm256_max_epi32( vmin256, vsum ) );
+        _mm256_storeu_si256( ( __m256i* ) &dst[n], vsum );
+      }
+    }
+#endif
+    for( ; n < trSize; n += 4 )
+    {
+      __m128i vsum = _mm_setzero_si128();
+
+      for( int q = 0; q < numPairs; q++ )
+      {
+        __m128i vcoef = _mm_loadu_si128( ( const __m128i* ) &iTPairs[q * trSize + n] );
+        vsum = _mm_add_epi32( vsum, _mm_madd_epi16( vcoef, _mm_set1_epi32( srcPairs[q * reducedLine + i] ) ) );
+      }
+
+      vsum = _mm_sra_epi32( _mm_add_epi32( vsum, vrnd ), vshift );
+      vsum = _mm_min_epi32( vmax32, _mm_max_epi32( vmin32, vsum ) );
+      _mm_storeu_si128( ( __m128i* ) &dst[n], vsum );
+    }
+
+    dst += trSize;
+  }
+
+  if( iSkipLine )
+  {
+    memset( dst, 0, sizeof( TCoeff ) * trSize * iSkipLine );
+  }
+
+  return true;
+}
+
+template<X86_VEXT vext, int trType, int trSize>
+static void fastForwardTrans_SIMD( const TCoeff *src, TCoeff *dst, int shift, int line, int iSkipLine, int iSkipLine2 )
+{
+  // like the C versions, only the 64-point DCT-II and the DST-VII/DCT-VIII of 8 points and above zero out the high frequencies
+  const bool zeroOut = trSize == 64 || ( trType != DCT2 && trSize > 4 );
+
+  const int  numRows = zeroOut ? trSize - iSkipLine2 : trSize;
+  const TMatrixCoeff *iT = getTrCoreMatrix( trType, trSize, TRANSFORM_FORWARD );
+
+  if( !fastForwardMM16_SIMD<vext, trSize>( src, dst, shift, line, iSkipLine, numRows, iT ) )
+  {
+    fastForwardMM_SIMD<vext, trSize>( src, dst, shift, line, iSkipLine, numRows, iT );
+  }
+}
+
+template<X86_VEXT vext, int trType, int trSize>
+static void fastInverseTrans_SIMD( const TCoeff *src, TCoeff *dst, int shift, int line, int iSkipLine, int iSkipLine2, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  // like the C versions, only the 64-point DCT-II and the 8-point DST-VII/DCT-VIII skip the zeroed out input rows
+  const int numTerms = trSize == 64 ? ( iSkipLine2 >= 32 ? 32 : 64 ) : ( trType != DCT2 && trSize == 8 ) ? trSize - iSkipLine2 : trSize;
+
+  if( !fastInverseMM16_SIMD<vext, trSize>( src, dst, shift, line, iSkipLine, numTerms, outputMinimum, outputMaximum, getTrCorePairs<trType, trSize>() ) )
+  {
+    fastInverseMM_SIMD<vext, trSize>( src, dst, shift, line, iSkipLine, numTerms, outputMinimum, outputMaximum, getTrCoreMatrix( trType, trSize, TRANSFORM_INVERSE ) );
+  }
+}
+
+template<X86_VEXT vext>
+static void fwdLfnstNxN_SIMD( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
+{
+  const int8_t* trMat  = ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
+  const int     trSize = ( size > 4 ) ? 48 : 16;
+  CHECKD( zeroOutSize & 3, "LFNST output size has to be a multiple of four" );
+
+  for( int j = 0; j < zeroOutSize; j += 4, trMat += 4 * trSize )
+  {
+    __m128i sum;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      __m256i acc[4];
+      for( int k = 0; k < 4; k++ )
+      {
+        acc[k] = _mm256_setzero_si256();
+        for( int i = 0; i < trSize; i += 16 )
+        {
+          const __m128i w  = _mm_loadu_si128( ( const __m128i* ) &trMat[k * trSize + i] );
+          const __m256i s0 = _mm256_loadu_si256( ( const __m256i* ) &src[i] );
+          const __m256i s1 = _mm256_loadu_si256( ( const __m256i* ) &src[i + 8] );
+          acc[k] = _mm256_add_epi32( acc[k], _mm256_mullo_epi32( s0, _mm256_cvtepi8_epi32( w ) ) );
+          acc[k] = _mm256_add_epi32( acc[k], _mm256_mullo_epi32( s1, _mm256_cvtepi8_epi32( _mm_srli_si128( w, 8 ) ) ) );
+        }
+      }
+      const __m256i h = _mm256_hadd_epi32( _mm256_hadd_epi32( acc[0], acc[1] ), _mm256_hadd_epi32( acc[2], acc[3] ) );
+      sum = _mm_add_epi32( _mm256_castsi256_si128( h ), _mm256_extracti128_si256( h, 1 ) );
+    }
+    else
+#endif
+    {
+      __m128i acc[4];
+      for( int k = 0; k < 4; k++ )
+      {
+        acc[k] = _mm_setzero_si128();
+        for( int i = 0; i < trSize; i += 16 )
+        {
+          const __m128i w = _mm_loadu_si128( ( const __m128i* ) &trMat[k * trSize + i] );
+          for( int q = 0; q < 4; q++ )
+          {
+            const __m128i s = _mm_loadu_si128( ( const __m128i* ) &src[i + 4 * q] );
+            const __m128i c = _mm_cvtepi8_epi32( q == 0 ? w : q == 1 ? _mm_srli_si128( w, 4 ) : q == 2 ? _mm_srli_si128( w, 8 ) : _mm_srli_si128( w, 12 ) );
+            acc[k] = _mm_add_epi32( acc[k], _mm_mullo_epi32( s, c ) );
+          }
+        }
+      }
+      sum = _mm_hadd_epi32( _mm_hadd_epi32( acc[0], acc[1] ), _mm_hadd_epi32( acc[2], acc[3] ) );
+    }
+    _mm_storeu_si128( ( __m128i* ) &dst[j], _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 64 ) ), 7 ) );
+  }
+
+  std::fill_n( dst + zeroOutSize, trSize - zeroOutSize, 0 );
+}
+
+template<X86_VEXT vext>
+static void invLfnstNxN_SIMD( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize, const int maxLog2TrDynamicRange )
+{
+  const int8_t* trMat  = ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
+  const int     trSize = ( size > 4 ) ? 48 : 16;
+
+  const __m128i vmin = _mm_set1_epi32( -( 1 << maxLog2TrDynamicRange ) );
+  const __m128i vmax = _mm_set1_epi32( ( 1 << maxLog2TrDynamicRange ) - 1 );
+  const __m128i rnd  = _mm_set1_epi32( 64 );
+
+  // 16 outputs at once, each input coefficient scales one row of the matrix
+  for( int j = 0; j < trSize; j += 16 )
+  {
+    __m128i res[4];
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      __m256i acc0 = _mm256_setzero_si256();
+      __m256i acc1 = _mm256_setzero_si256();
+      for( int i = 0; i < zeroOutSize; i++ )
+      {
+        const __m256i s = _mm256_set1_epi32( src[i] );
+        const __m128i w = _mm_loadu_si128( ( const __m128i* ) &trMat[i * trSize + j] );
+        acc0 = _mm256_add_epi32( acc0, _mm256_mullo_epi32( s, _mm256_cvtepi8_epi32( w ) ) );
+        acc1 = _mm256_add_epi32( acc1, _mm256_mullo_epi32( s, _mm256_cvtepi8_epi32( _mm_srli_si128( w, 8 ) ) ) );
+      }
+      res[0] = _mm256_castsi256_si128( acc0 );
+      res[1] = _mm256_extracti128_si256( acc0, 1 );
+      res[2] = _mm256_castsi256_si128( acc1 );
+      res[3] = _mm256_extracti128_si256( acc1, 1 );
+    }
+    else
+#endif
+    {
+      res[0] = res[1] = res[2] = res[3] = _mm_setzero_si128();
+      for( int i = 0; i < zeroOutSize; i++ )
+      {
+        const __m128i s = _mm_set1_epi32( src[i] );
+        const __m128i w = _mm_loadu_si128( ( const __m128i* ) &trMat[i * trSize + j] );
+        res[0] = _mm_add_epi32( res[0], _mm_mullo_epi32( s, _mm_cvtepi8_epi32( w ) ) );
+        res[1] = _mm_add_epi32( res[1], _mm_mullo_epi32( s, _mm_cvtepi8_epi32( _mm_srli_si128( w, 4 ) ) ) );
+        res[2] = _mm_add_epi32( res[2], _mm_mullo_epi32( s, _mm_cvtepi8_epi32( _mm_srli_si128( w, 8 ) ) ) );
+        res[3] = _mm_add_epi32( res[3], _mm_mullo_epi32( s, _mm_cvtepi8_epi32( _mm_srli_si128( w, 12 ) ) ) );
+      }
+    }
+    for( int k = 0; k < 4; k++ )
+    {
+      const __m128i val = _mm_srai_epi32( _mm_add_epi32( res[k], rnd ), 7 );
+      _mm_storeu_si128( ( __m128i* ) &dst[j + 4 * k], _mm_min_epi32( vmax, _mm_max_epi32( vmin, val ) ) );
+    }
+  }
+}
+#endif
+
+template <X86_VEXT vext>
+void TrQuant::_initTrQuantX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  // the 2- and 4-point transforms stay with the C butterflies, which take fewer operations there
+  m_fwdTrans[DCT2][2] = fastForwardTrans_SIMD<vext, DCT2,  8>;
+  m_fwdTrans[DCT2][3] = fastForwardTrans_SIMD<vext, DCT2, 16>;
+  m_fwdTrans[DCT2][4] = fastForwardTrans_SIMD<vext, DCT2, 32>;
+  m_fwdTrans[DCT2][5] = fastForwardTrans_SIMD<vext, DCT2, 64>;
+  m_fwdTrans[DCT8][2] = fastForwardTrans_SIMD<vext, DCT8,  8>;
+  m_fwdTrans[DCT8][3] = fastForwardTrans_SIMD<vext, DCT8, 16>;
+  m_fwdTrans[DCT8][4] = fastForwardTrans_SIMD<vext, DCT8, 32>;
+  m_fwdTrans[DST7][2] = fastForwardTrans_SIMD<vext, DST7,  8>;
+  m_fwdTrans[DST7][3] = fastForwardTrans_SIMD<vext, DST7, 16>;
+  m_fwdTrans[DST7][4] = fastForwardTrans_SIMD<vext, DST7, 32>;
+
+  m_invTrans[DCT2][2] = fastInverseTrans_SIMD<vext, DCT2,  8>;
+  m_invTrans[DCT2][3] = fastInverseTrans_SIMD<vext, DCT2, 16>;
+  m_invTrans[DCT2][4] = fastInverseTrans_SIMD<vext, DCT2, 32>;
+  m_invTrans[DCT2][5] = fastInverseTrans_SIMD<vext, DCT2, 64>;
+  m_invTrans[DCT8][2] = fastInverseTrans_SIMD<vext, DCT8,  8>;
+  m_invTrans[DCT8][3] = fastInverseTrans_SIMD<vext, DCT8, 16>;
+  m_invTrans[DCT8][4] = fastInverseTrans_SIMD<vext, DCT8, 32>;
+  m_invTrans[DST7][2] = fastInverseTrans_SIMD<vext, DST7,  8>;
+  m_invTrans[DST7][3] = fastInverseTrans_SIMD<vext, DST7, 16>;
+  m_invTrans[DST7][4] = fastInverseTrans_SIMD<vext, DST7, 32>;
+
+  m_fwdLfnst = fwdLfnstNxN_SIMD<vext>;
+  m_invLfnst = invLfnstNxN_SIMD<vext>;
+#endif
+}
+
+template void TrQuant::_initTrQuantX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+//! \}
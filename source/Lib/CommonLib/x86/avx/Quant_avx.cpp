@@ -0,0 +1 @@
+#include "../QuantX86.h"
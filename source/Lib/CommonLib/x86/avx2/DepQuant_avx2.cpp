@@ -0,0 +1 @@
+#include "../DepQuantX86.h"
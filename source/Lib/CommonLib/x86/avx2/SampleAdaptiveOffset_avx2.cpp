@@ -0,0 +1 @@
+#include "../SampleAdaptiveOffsetX86.h"
@@ -145,8 +145,10 @@ void CABACReader::coding_tree_unit( CodingStructure& cs, const UnitArea& area, i
   QTBTPartitioner partitioner;
 
   partitioner.initCtu(area, CH_L, *cs.slice);
-  cs.treeType = partitioner.treeType = TREE_D;
-  cs.modeType = partitioner.modeType = MODE_TYPE_ALL;
+  partitioner.treeType = TREE_D;
+  partitioner.modeType = MODE_TYPE_ALL;
+  cs.setTreeType( partitioner.treeType );
+  cs.setModeType( partitioner.modeType );
 
 
   sao( cs, ctuRsAddr );
@@ -585,13 +587,15 @@ void CABACReader::coding_tree( CodingStructure& cs, Partitioner& partitioner, CU
     else
     {
       const ModeType modeTypeParent = partitioner.modeType;
-      cs.modeType = partitioner.modeType = mode_constraint(cs, partitioner, splitMode);   // change for child nodes
+      partitioner.modeType = mode_constraint(cs, partitioner, splitMode);   // change for child nodes
+      cs.setModeType( partitioner.modeType );
       // decide chroma split or not
       bool chromaNotSplit = modeTypeParent == MODE_TYPE_ALL && partitioner.modeType == MODE_TYPE_INTRA;
       CHECK(chromaNotSplit && partitioner.chType != CHANNEL_TYPE_LUMA, "chType must be luma");
       if (partitioner.treeType == TREE_D)
       {
-        cs.treeType = partitioner.treeType = chromaNotSplit ? TREE_L : TREE_D;
+        partitioner.treeType = chromaNotSplit ? TREE_L : TREE_D;
+        cs.setTreeType( partitioner.treeType );
       }
       partitioner.splitCurrArea( splitMode, cs );
       do
@@ -607,7 +611,8 @@ void CABACReader::coding_tree( CodingStructure& cs, Partitioner& partitioner, CU
       {
         CHECK( partitioner.chType != CHANNEL_TYPE_LUMA, "must be luma status" );
         partitioner.chType = CHANNEL_TYPE_CHROMA;
-        cs.treeType = partitioner.treeType = TREE_C;
+        partitioner.treeType = TREE_C;
+        cs.setTreeType( partitioner.treeType );
 
         if( cs.picture->blocks[partitioner.chType].contains( partitioner.currArea().blocks[partitioner.chType].pos() ) )
         {
@@ -616,11 +621,13 @@ void CABACReader::coding_tree( CodingStructure& cs, Partitioner& partitioner, CU
 
         //recover treeType
         partitioner.chType = CHANNEL_TYPE_LUMA;
-        cs.treeType = partitioner.treeType = TREE_D;
+        partitioner.treeType = TREE_D;
+        cs.setTreeType( partitioner.treeType );
       }
 
       //recover ModeType
-      cs.modeType = partitioner.modeType = modeTypeParent;
+      partitioner.modeType = modeTypeParent;
+      cs.setModeType( partitioner.modeType );
     }
     return;
   }
@@ -630,7 +637,7 @@ void CABACReader::coding_tree( CodingStructure& cs, Partitioner& partitioner, CU
   partitioner.setCUData( cu );
   cu.slice   = cs.slice;
   cu.tileIdx = cs.pps->getTileIdx( currArea.lumaPos() );
-  CHECK( cu.cs->treeType != partitioner.treeType, "treeType mismatch" );
+  CHECK( cu.cs->getTreeType() != partitioner.treeType, "treeType mismatch" );
   int lumaQPinLocalDualTree = -1;
 
   // Predict QP on start of quantization group
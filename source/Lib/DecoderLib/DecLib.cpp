@@ -44,7 +44,9 @@
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/ProfileLevelTier.h"
 
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <set>
 #include <stdio.h>
 #include <fcntl.h>
@@ -408,17 +410,26 @@ DecLib::DecLib()
   , m_SEIs()
   , m_sdiSEIInFirstAU(NULL)
   , m_maiSEIInFirstAU(NULL)
-  , m_cIntraPred()
-  , m_cInterPred()
-  , m_cTrQuant()
+  , m_cIntraPred( nullptr )
+  , m_cInterPred( nullptr )
+  , m_cTrQuant( nullptr )
   , m_cSliceDecoder()
   , m_cTrQuantScalingList()
-  , m_cCuDecoder()
+  , m_cCuDecoder( nullptr )
   , m_HLSReader()
+  , m_CABACDecoder( nullptr )
+  , m_numSubstreamThreads( 1 )
+  , m_numCuDecStacks( 0 )
+  , m_parseAhead( false )
   , m_seiReader()
-  , m_deblockingFilter()
-  , m_cSAO()
-  , m_cReshaper()
+  , m_deblockingFilter( nullptr )
+  , m_numLoopFilterThreads( 1 )
+  , m_filterAlongRecon( false )
+  , m_postFilterSet( 0 )
+  , m_picturePipeline( false )
+  , m_postFilterPic( nullptr )
+  , m_postFilterPcv( nullptr )
+  , m_cReshaper( nullptr )
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
 #endif
@@ -484,18 +495,45 @@ DecLib::DecLib()
 
 DecLib::~DecLib()
 {
+  if( m_postFilterThread.joinable() )
+  {
+    m_postFilterThread.join();
+  }
+
   while (!m_prefixSEINALUs.empty())
   {
     delete m_prefixSEINALUs.front();
     m_prefixSEINALUs.pop_front();
   }
 
+  delete[] m_cIntraPred;    m_cIntraPred   = nullptr;
+  delete[] m_cInterPred;    m_cInterPred   = nullptr;
+  delete[] m_cTrQuant;      m_cTrQuant     = nullptr;
+  delete[] m_cCuDecoder;    m_cCuDecoder   = nullptr;
+  delete[] m_CABACDecoder;  m_CABACDecoder = nullptr;
+  delete[] m_cReshaper;     m_cReshaper    = nullptr;
+  delete[] m_deblockingFilter; m_deblockingFilter = nullptr;
 }
 
 void DecLib::create()
 {
   m_apcSlicePilot = new Slice;
   m_uiSliceSegmentIdx = 0;
+
+  if( m_numCuDecStacks == 0 )
+  {
+    m_numCuDecStacks = std::max( 1, m_numSubstreamThreads );
+    m_cIntraPred     = new IntraPrediction[m_numCuDecStacks];
+    m_cInterPred     = new InterPrediction[m_numCuDecStacks];
+    m_cTrQuant       = new TrQuant        [m_numCuDecStacks];
+    m_cCuDecoder     = new DecCu          [m_numCuDecStacks];
+    m_CABACDecoder   = new CABACDecoder   [m_numCuDecStacks];
+    m_cReshaper      = new Reshape        [m_numCuDecStacks];
+  }
+  if( m_deblockingFilter == nullptr )
+  {
+    m_deblockingFilter = new DeblockingFilter[m_numLoopFilterThreads];
+  }
 }
 
 void DecLib::destroy()
@@ -518,17 +556,22 @@ void DecLib::init(
 #endif
 )
 {
-  m_cSliceDecoder.init( &m_CABACDecoder, &m_cCuDecoder );
+  m_cSliceDecoder.init( m_CABACDecoder, m_cCuDecoder, m_numCuDecStacks, m_parseAhead );
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.create( cacheCfgFileName );
   m_cacheModel.clear( );
-  m_cInterPred.cacheAssign( &m_cacheModel );
+  for( int jId = 0; jId < m_numCuDecStacks; jId++ )
+  {
+    m_cInterPred[jId].cacheAssign( &m_cacheModel );
+  }
 #endif
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "final", 1 ) );
 }
 
 void DecLib::deletePicBuffer ( )
 {
+  waitForPostFilter();
+
   PicList::iterator  iterPic   = m_cListPic.begin();
   int iSize = int( m_cListPic.size() );
 
@@ -540,26 +583,101 @@ void DecLib::deletePicBuffer ( )
     delete pcPic;
     pcPic = NULL;
   }
-  m_cALF.destroy();
-  m_cSAO.destroy();
-  m_deblockingFilter.destroy();
+  while( Picture* pcPic = m_picPool.takeAny() )
+  {
+    pcPic->destroy();
+    delete pcPic;
+  }
+  for( int i = 0; i < 2; i++ )
+  {
+    m_cALF[i].destroy();
+    m_cSAO[i].destroy();
+  }
+  for( int i = 0; i < m_numLoopFilterThreads; i++ )
+  {
+    m_deblockingFilter[i].destroy();
+  }
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.reportSequence( );
   m_cacheModel.destroy( );
 #endif
-  m_cCuDecoder.destoryDecCuReshaprBuf();
-  m_cReshaper.destroy();
+  for( int jId = 0; jId < m_numCuDecStacks; jId++ )
+  {
+    m_cCuDecoder[jId].destoryDecCuReshaprBuf();
+    m_cReshaper[jId].destroy();
+  }
+}
+
+void DecLib::releasePicBuffer( Picture* pic )
+{
+  if( pic == m_postFilterPic )
+  {
+    waitForPostFilter();
+  }
+
+  Picture* evicted = m_picPool.giveBack( pic );
+
+  if( evicted )
+  {
+    evicted->destroy();
+    delete evicted;
+  }
+}
+
+Picture* DecLib::xLeasePicBuffer( const SPS &sps, const PPS &pps, const int layerId )
+{
+  const Size picSize( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() );
+
+  Picture* pcPic = m_picPool.lease( sps.getChromaFormatIdc(), picSize, sps.getMaxCUWidth() );
+
+  if( pcPic )
+  {
+    // same state as a newly created picture
+    pcPic->layerId         = layerId;
+    pcPic->referenced      = false;
+    pcPic->longTerm        = false;
+    pcPic->reconstructed   = false;
+    pcPic->neededForOutput = false;
+#if GDR_ENABLED // picHeader should be deleted in case pcPic slot gets reused
+    if( pcPic->cs && pcPic->cs->picHeader )
+    {
+      delete pcPic->cs->picHeader;
+      pcPic->cs->picHeader = nullptr;
+    }
+#endif
+  }
+  else
+  {
+    pcPic = new Picture();
+    pcPic->create( sps.getChromaFormatIdc(), picSize, sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true, layerId );
+  }
+
+  return pcPic;
 }
 
 Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_t temporalLayer, const int layerId )
 {
   Picture * pcPic = nullptr;
   m_iMaxRefPicNum = ( m_vps == nullptr || m_vps->m_numLayersInOls[m_vps->m_targetOlsIdx] == 1 ) ? sps.getMaxDecPicBuffering( temporalLayer ) : m_vps->getMaxDecPicBuffering( temporalLayer );     // m_uiMaxDecPicBuffering has the space for the picture currently being decoded
-  if (m_cListPic.size() < (uint32_t)m_iMaxRefPicNum)
+  const int maxDecPicBuffering = ( m_vps == nullptr || m_vps->m_numLayersInOls[m_vps->m_targetOlsIdx] == 1 ) ? sps.getMaxDecPicBuffering( MAX_TLAYER - 1 ) : m_vps->getMaxDecPicBuffering( MAX_TLAYER - 1 );
+  m_picPool.setCapacity( maxDecPicBuffering );
+
+  if( m_cListPic.empty() )
   {
-    pcPic = new Picture();
+    // allocate the pictures of the DPB up front
+    const Size picSize( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() );
+
+    for( int n = m_picPool.numFree( sps.getChromaFormatIdc(), picSize, sps.getMaxCUWidth() ); n < maxDecPicBuffering; n++ )
+    {
+      Picture* pic = new Picture();
+      pic->create( sps.getChromaFormatIdc(), picSize, sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true, layerId );
+      releasePicBuffer( pic );
+    }
+  }
 
-    pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true, layerId );
+  if (m_cListPic.size() < (uint32_t)m_iMaxRefPicNum)
+  {
+    pcPic = xLeasePicBuffer( sps, pps, layerId );
 
     m_cListPic.push_back( pcPic );
 
@@ -567,9 +685,10 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
   }
 
   bool bBufferIsAvailable = false;
-  for(auto * p: m_cListPic)
+  PicList::iterator iterPic = m_cListPic.begin();
+  for( ; iterPic != m_cListPic.end(); iterPic++ )
   {
-    pcPic = p;  // workaround because range-based for-loops don't work with existing variables
+    pcPic = *iterPic;
     if ( pcPic->reconstructed == false && ! pcPic->neededForOutput )
     {
       pcPic->neededForOutput = false;
@@ -586,31 +705,40 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
     }
   }
 
+  if( bBufferIsAvailable && pcPic == m_postFilterPic )
+  {
+    waitForPostFilter();
+  }
+
   if( ! bBufferIsAvailable )
   {
     //There is no room for this picture, either because of faulty encoder or dropped NAL. Extend the buffer.
     m_iMaxRefPicNum++;
 
-    pcPic = new Picture();
+    pcPic = xLeasePicBuffer( sps, pps, layerId );
 
     m_cListPic.push_back( pcPic );
-
-    pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true, layerId );
   }
   else
   {
-    if( !pcPic->Y().Size::operator==( Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ) ) || pps.pcv->maxCUWidth != sps.getMaxCUWidth() || pps.pcv->maxCUHeight != sps.getMaxCUHeight() || pcPic->layerId != layerId )
+    if( !pcPic->Y().Size::operator==( Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ) ) || pcPic->chromaFormat != sps.getChromaFormatIdc() || pcPic->getMaxCUSize() != sps.getMaxCUWidth() )
     {
-      pcPic->destroy();
-      pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true, layerId );
+      // keep the buffer for a later picture of its size class and take one that fits this picture
+      releasePicBuffer( pcPic );
+      pcPic = xLeasePicBuffer( sps, pps, layerId );
+      *iterPic = pcPic;
     }
+    else
+    {
+      pcPic->layerId = layerId;
 #if GDR_ENABLED // picHeader should be deleted in case pcPic slot gets reused
-    if (pcPic && pcPic->cs && pcPic->cs->picHeader)
-    {          
-      delete pcPic->cs->picHeader;
-      pcPic->cs->picHeader = nullptr;    
-    }
+      if (pcPic && pcPic->cs && pcPic->cs->picHeader)
+      {
+        delete pcPic->cs->picHeader;
+        pcPic->cs->picHeader = nullptr;
+      }
 #endif
+    }
   }
 
   pcPic->setBorderExtension( false );
@@ -634,41 +762,78 @@ void DecLib::executeLoopFilters()
 
   if (cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag())
   {
-      const PreCalcValues& pcv = *cs.pcv;
-      for (uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight)
+      // with several loop filter threads each CTU row is inverse mapped right before it is deblocked
+      for( int ctuRow = 0; ctuRow < cs.pcv->heightInCtus && m_numLoopFilterThreads == 1; ctuRow++ )
       {
-        for (uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth)
-        {
-          const CodingUnit* cu = cs.getCU(Position(xPos, yPos), CHANNEL_TYPE_LUMA);
-          if (cu->slice->getLmcsEnabledFlag())
-          {
-            const uint32_t width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
-            const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-            const UnitArea area(cs.area.chromaFormat, Area(xPos, yPos, width, height));
-            cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(m_cReshaper.getInvLUT());
-          }
-        }
+        xInverseMapCtuRow( cs, ctuRow );
       }
-      m_cReshaper.setRecReshaped(false);
-      m_cSAO.setReshaper(&m_cReshaper);
+      m_cReshaper[0].setRecReshaped(false);
+      m_cSAO[m_postFilterSet].setReshaper(&m_cReshaper[0]);
   }
   // deblocking filter
-  m_deblockingFilter.deblockingFilterPic( cs );
+  if( m_filterAlongRecon )
+  {
+    // the wavefront has been running behind the reconstruction of the picture
+    m_filterAlongRecon = false;
+    xWaitForLoopFilter();
+  }
+  else if( m_numLoopFilterThreads > 1 )
+  {
+    // unless the post-filter stage applies them, SAO and ALF follow the deblocking of the CTU rows in the same wavefront
+    xFilterCtuRows( cs, m_postFilterSet, true, !m_picturePipeline );
+  }
+  else
+  {
+    m_deblockingFilter[0].deblockingFilterPic( cs );
+  }
   CS::setRefinedMotionField(cs);
-  if( cs.sps->getSAOEnabledFlag() )
+
+  if( m_picturePipeline )
+  {
+    // the remaining filters are applied by the post-filter stage started in finishPicture()
+    return;
+  }
+
+  if( m_numLoopFilterThreads > 1 )
   {
-    m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
+    xMaskNonTargetSubPics( cs );
   }
+  else
+  {
+    xApplyPostFilters( cs, m_postFilterSet );
+  }
+
+  m_pcPic->cs->slice->stopProcessingTimer();
+}
 
-  if( cs.sps->getALFEnabledFlag() )
+void DecLib::xApplyPostFilters( CodingStructure& cs, const int filterSet, const bool publishRows )
+{
+  if( m_numLoopFilterThreads > 1 || publishRows )
+  {
+    xFilterCtuRows( cs, filterSet, false, true, publishRows );
+  }
+  else
   {
-    m_cALF.getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
-    // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
-    // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
-    // copy in case the APS gets used more than once.
-    m_cALF.ALFProcess(cs);
+    if( cs.sps->getSAOEnabledFlag() )
+    {
+      m_cSAO[filterSet].SAOProcess( cs, cs.picture->getSAO() );
+    }
+
+    if( cs.sps->getALFEnabledFlag() )
+    {
+      m_cALF[filterSet].getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
+      // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
+      // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
+      // copy in case the APS gets used more than once.
+      m_cALF[filterSet].ALFProcess(cs);
+    }
   }
 
+  xMaskNonTargetSubPics( cs );
+}
+
+void DecLib::xMaskNonTargetSubPics( CodingStructure& cs )
+{
   for (int i = 0; i < cs.pps->getNumSubPics() && m_targetSubPicIdx; i++)
   {
     // keep target subpic samples untouched, for other subpics mask their output sample value to 0
@@ -692,8 +857,337 @@ void DecLib::executeLoopFilters()
       }
     }
   }
+}
 
-  m_pcPic->cs->slice->stopProcessingTimer();
+void DecLib::xInverseMapCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const uint32_t yPos = ctuRow * pcv.maxCUHeight;
+  for (uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth)
+  {
+    const CodingUnit* cu = cs.getCU(Position(xPos, yPos), CHANNEL_TYPE_LUMA);
+    if (cu->slice->getLmcsEnabledFlag())
+    {
+      const uint32_t width = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
+      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+      const UnitArea area(cs.area.chromaFormat, Area(xPos, yPos, width, height));
+      cs.getRecoBuf(area).get(COMPONENT_Y).rspSignal(m_cReshaper[0].getInvLUT());
+    }
+  }
+}
+
+// stages each CTU row passes in order in the loop filter wavefront
+enum CtuRowFilterStage
+{
+  ROW_DEBLOCK_VER = 0,                              // inverse luma mapping and deblocking of the vertical edges
+  ROW_DEBLOCK_HOR,                                  // horizontal edges, the bottom lines of the row above are filtered too
+  ROW_SAO_COPY,                                     // the deblocked row becomes SAO input
+  ROW_SAO,
+  ROW_ALF_COPY,                                     // the row becomes ALF input with its border extended
+  ROW_ALF,
+  ROW_PUBLISH,                                      // the row is final, its picture border is extended and references may read it
+  NUM_ROW_FILTER_STAGES
+};
+
+void DecLib::xFilterCtuRows( CodingStructure& cs, const int filterSet, const bool deblock, const bool postFilters, const bool publishRows, CtuRowReconProgress* reconProgress )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const int numRows    = pcv.heightInCtus;
+  const int firstStage = deblock ? ROW_DEBLOCK_VER : ROW_SAO_COPY;
+  const int endStage   = postFilters ? ( publishRows ? NUM_ROW_FILTER_STAGES : ROW_PUBLISH ) : ROW_SAO_COPY;
+  const bool lmcs      = deblock && cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag();
+
+  // along the reconstruction the picture has a single slice, the SAO parameters and ALF coefficients of a row are prepared
+  // when it reaches the post-filters, the CTUs further down may not be parsed yet
+  const bool rowWise = reconProgress != nullptr;
+  if( deblock && !rowWise )
+  {
+    // the picture is left with the slice of the last CTU, like after the picture-wise deblocking
+    cs.slice = cs.getCU( Position( ( pcv.widthInCtus - 1 ) << pcv.maxCUWidthLog2, ( numRows - 1 ) << pcv.maxCUHeightLog2 ), CH_L )->slice;
+  }
+  bool sao = postFilters && cs.sps->getSAOEnabledFlag();
+  if( sao )
+  {
+    sao = rowWise ? cs.slice->getSaoEnabledFlag( CHANNEL_TYPE_LUMA ) || cs.slice->getSaoEnabledFlag( CHANNEL_TYPE_CHROMA ) : m_cSAO[filterSet].prepareCtuRows( cs, cs.picture->getSAO() );
+  }
+  const bool alf = postFilters && cs.sps->getALFEnabledFlag();
+  if( alf )
+  {
+    m_cALF[filterSet].getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
+    m_cALF[filterSet].prepareCtuRows( cs, rowWise );
+  }
+
+  std::vector<int>        rowStage( numRows, firstStage );
+  std::vector<bool>       rowBusy ( numRows, false );
+  int                     numRowsDone = 0;
+  bool                    abortRows   = false;
+  std::exception_ptr      rowError;
+  std::mutex              filterMutex;
+  std::condition_variable filterCond;
+  // along the reconstruction the wavefront is also woken up by the rows it finishes
+  std::mutex&              rowMutex = rowWise ? reconProgress->getMutex() : filterMutex;
+  std::condition_variable& rowCond  = rowWise ? reconProgress->getCond()  : filterCond;
+
+  // a stage of a row can start once the neighbouring rows have passed the stages it reads from or writes into
+  auto isReady = [&]( const int row, const int stage )
+  {
+    auto passed = [&]( const int r, const int s ) { return r < 0 || r >= numRows || rowStage[r] > s; };
+    switch( stage )
+    {
+    // the intra prediction and the chroma residual scaling of the row below read the row before it is inverse mapped and filtered
+    case ROW_DEBLOCK_VER: return !rowWise || reconProgress->getNumFinishedRows() >= std::min( row + 2, numRows );
+    case ROW_DEBLOCK_HOR: return passed( row - 1, ROW_DEBLOCK_VER );
+    // the merged SAO parameters and the ALF coefficients of the rows are prepared from the top
+    case ROW_SAO_COPY:    return passed( row + 1, ROW_DEBLOCK_HOR ) && ( !rowWise || passed( row - 1, ROW_SAO_COPY ) );
+    case ROW_SAO:         return passed( row - 1, ROW_SAO_COPY ) && passed( row + 1, ROW_SAO_COPY );
+    case ROW_ALF_COPY:    return !rowWise || passed( row - 1, ROW_ALF_COPY );
+    case ROW_ALF:         return passed( row - 1, ROW_ALF_COPY ) && passed( row + 1, ROW_ALF_COPY );
+    case ROW_PUBLISH:     return passed( row - 1, ROW_PUBLISH );
+    default:              return true;
+    }
+  };
+
+  auto runStage = [&]( const int row, const int stage, DeblockingFilter& deblockingFilter, AdaptiveLoopFilter::CtuRowScratch& alfScratch )
+  {
+    switch( stage )
+    {
+    case ROW_DEBLOCK_VER:
+      if( lmcs )
+      {
+        xInverseMapCtuRow( cs, row );
+      }
+      deblockingFilter.deblockCtuRow( cs, EDGE_VER, row );
+      break;
+    case ROW_DEBLOCK_HOR:
+      deblockingFilter.deblockCtuRow( cs, EDGE_HOR, row );
+      break;
+    case ROW_SAO_COPY:
+      if( sao )
+      {
+        if( rowWise )
+        {
+          m_cSAO[filterSet].prepareCtuRow( cs, cs.picture->getSAO(), row );
+        }
+        m_cSAO[filterSet].copyCtuRow( cs, row );
+      }
+      break;
+    case ROW_SAO:
+      if( sao )
+      {
+        m_cSAO[filterSet].offsetCtuRow( cs, row );
+      }
+      break;
+    case ROW_ALF_COPY:
+      if( alf )
+      {
+        if( rowWise )
+        {
+          m_cALF[filterSet].prepareCtuRow( cs, row );
+        }
+        m_cALF[filterSet].copyCtuRow( cs, row );
+      }
+      break;
+    case ROW_ALF:
+      if( alf )
+      {
+        m_cALF[filterSet].filterCtuRow( cs, row, alfScratch );
+      }
+      break;
+    case ROW_PUBLISH:
+      cs.picture->extendCtuRowBorder( row );
+      cs.picture->ctuRowProgress.setFinished( row + 1 );
+      break;
+    default:
+      THROW( "Invalid CTU row filter stage" );
+    }
+  };
+
+  auto runRows = [&]( const int threadIdx )
+  {
+    AdaptiveLoopFilter::CtuRowScratch alfScratch;
+    if( alf )
+    {
+      m_cALF[filterSet].createCtuRowScratch( alfScratch );
+    }
+
+    std::unique_lock<std::mutex> lock( rowMutex );
+    while( numRowsDone < numRows && !abortRows && !( rowWise && reconProgress->isAborted() ) )
+    {
+      // the upper rows first, so that the rows leave the wavefront in order
+      int row = 0;
+      while( row < numRows && ( rowBusy[row] || rowStage[row] == endStage || !isReady( row, rowStage[row] ) ) )
+      {
+        row++;
+      }
+      if( row == numRows )
+      {
+        rowCond.wait( lock );
+        continue;
+      }
+
+      const int stage = rowStage[row];
+      rowBusy[row] = true;
+      lock.unlock();
+      std::exception_ptr error;
+      try
+      {
+        runStage( row, stage, m_deblockingFilter[threadIdx], alfScratch );
+      }
+      catch( ... )
+      {
+        error = std::current_exception();
+      }
+      lock.lock();
+
+      rowBusy[row] = false;
+      if( error )
+      {
+        rowError  = rowError ? rowError : error;
+        abortRows = true;
+      }
+      else if( ++rowStage[row] == endStage )
+      {
+        numRowsDone++;
+      }
+      rowCond.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for( int threadIdx = 1; threadIdx < std::min( m_numLoopFilterThreads, numRows ); threadIdx++ )
+  {
+    threads.push_back( std::thread( runRows, threadIdx ) );
+  }
+  runRows( 0 );
+  for( auto& thread : threads )
+  {
+    thread.join();
+  }
+  if( rowError )
+  {
+    std::rethrow_exception( rowError );
+  }
+}
+
+void DecLib::xFilterAlongRecon( Picture* pic, const int filterSet )
+{
+  try
+  {
+    // the coding structure is set up for the slice when its decoding starts
+    if( m_reconProgress.waitForStart() )
+    {
+      // unless the post-filter stage applies them, SAO and ALF follow the deblocking of the CTU rows in the same wavefront
+      xFilterCtuRows( *pic->cs, filterSet, true, !m_picturePipeline, false, &m_reconProgress );
+    }
+  }
+  catch( ... )
+  {
+    m_loopFilterError = std::current_exception();
+  }
+}
+
+void DecLib::xWaitForLoopFilter()
+{
+  if( m_loopFilterThread.joinable() )
+  {
+    m_loopFilterThread.join();
+  }
+
+  if( m_loopFilterError )
+  {
+    std::exception_ptr error = m_loopFilterError;
+    m_loopFilterError        = nullptr;
+    std::rethrow_exception( error );
+  }
+}
+
+void DecLib::xStartPostFilter( const char sliceTypeChar, const MsgLevel msgl )
+{
+  // one picture at a time is in the post-filter stage, it uses the filter set the next picture is not set up with
+  waitForPostFilter();
+
+  m_postFilterPic = m_pcPic;
+
+  // APSs arriving with the next picture may replace the ones referenced by the slices of this picture
+  for( Slice* slice : m_pcPic->slices )
+  {
+    APS** apss = slice->getAlfAPSs();
+    for( int i = 0; i < ALF_CTB_MAX_NUM_APS; i++ )
+    {
+      if( apss[i] != nullptr && apss[i] != &m_postFilterAlfAps[i] )
+      {
+        m_postFilterAlfAps[i] = *apss[i];
+        apss[i]               = &m_postFilterAlfAps[i];
+      }
+    }
+  }
+#if !GDR_ENABLED
+  // the picture header object is reused for the next picture
+  m_postFilterPicHeader = *m_pcPic->cs->picHeader;
+  m_pcPic->cs->picHeader->initPicHeader();
+  m_pcPic->cs->picHeader = &m_postFilterPicHeader;
+#endif
+
+  m_pcPic->destroyTempBuffers();
+  m_pcPic->cs->destroyCoeffs();
+
+  // the border is extended by the post-filter stage, references only wait for the rows they read
+  m_pcPic->setBorderExtension( true );
+  m_pcPic->ctuRowProgress.start( floorLog2( m_pcPic->cs->pcv->maxCUHeight ) );
+
+  m_postFilterThread = std::thread( &DecLib::xPostFilterPicture, this, m_pcPic, m_postFilterSet, sliceTypeChar, msgl );
+  m_postFilterSet    = 1 - m_postFilterSet;
+}
+
+void DecLib::xPostFilterPicture( Picture* pic, const int filterSet, const char sliceTypeChar, const MsgLevel msgl )
+{
+  try
+  {
+    CodingStructure& cs = *pic->cs;
+
+    // the CTU rows are published as they leave the filter wavefront, unless the whole picture is rewritten afterwards
+    const bool publishRows = !m_targetSubPicIdx && !pic->isWrapAroundEnabled( cs.pps );
+    xApplyPostFilters( cs, filterSet, publishRows );
+    pic->extendPicBorderSamples( cs.pps, publishRows );
+
+    cs.slice->stopProcessingTimer();
+    // the hash has to be checked before the picture is released as a reference, the next picture pads subpicture borders inside of it
+    xPrintPictureInfo( pic, sliceTypeChar, msgl );
+    pic->ctuRowProgress.setFinished( MAX_INT );
+  }
+  catch( ... )
+  {
+    m_postFilterError = std::current_exception();
+    pic->ctuRowProgress.setFinished( MAX_INT );
+  }
+}
+
+void DecLib::waitForPostFilter()
+{
+  // the loop filters of the current picture may still run behind its reconstruction
+  xWaitForLoopFilter();
+
+  if( m_postFilterThread.joinable() )
+  {
+    m_postFilterThread.join();
+  }
+
+  if( m_postFilterPic != nullptr )
+  {
+    m_postFilterPic->cs->releaseIntermediateData();
+    m_postFilterPic->cs->picHeader->initPicHeader();
+    m_postFilterPic = nullptr;
+  }
+
+  delete m_postFilterPcv;
+  m_postFilterPcv = nullptr;
+
+  if( m_postFilterError )
+  {
+    std::exception_ptr error = m_postFilterError;
+    m_postFilterError        = nullptr;
+    std::rethrow_exception( error );
+  }
 }
 
 void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
@@ -737,31 +1231,15 @@ void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
   m_puCounter++;
 }
 
-void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool associatedWithNewClvs)
+void DecLib::xPrintPictureInfo( Picture* pic, const char sliceTypeChar, const MsgLevel msgl )
 {
-#if RExt__DECODER_DEBUG_TOOL_STATISTICS
-  CodingStatistics::StatTool& s = CodingStatistics::GetStatisticTool( STATS__TOOL_TOTAL_FRAME );
-  s.count++;
-  s.pixels = s.count * m_pcPic->Y().width * m_pcPic->Y().height;
-#endif
-
-  Slice*  pcSlice = m_pcPic->cs->slice;
-  m_prevPicPOC = pcSlice->getPOC();
-
-  char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!m_pcPic->referenced)
-  {
-    c += 32;  // tolower
-  }
-
-  if (pcSlice->isDRAP()) c = 'D';
-  if (pcSlice->getEdrapRapId() > 0) c = 'E';
+  Slice* pcSlice = pic->cs->slice;
 
   //-- For time output for each slice
   msg( msgl, "POC %4d LId: %2d TId: %1d ( %s, %c-SLICE, QP%3d ) ", pcSlice->getPOC(), pcSlice->getPic()->layerId,
          pcSlice->getTLayer(),
          nalUnitTypeToString(pcSlice->getNalUnitType()),
-         c,
+         sliceTypeChar,
          pcSlice->getSliceQp() );
   msg( msgl, "[DT %6.3f] ", pcSlice->getProcessingTime() );
 
@@ -772,7 +1250,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
     {
       const std::pair<int, int>& scaleRatio = pcSlice->getScalingRatio( RefPicList( iRefList ), iRefIndex );
 
-      if( pcSlice->getPicHeader()->getEnableTMVPFlag() && pcSlice->getColFromL0Flag() == bool(1 - iRefList) && pcSlice->getColRefIdx() == iRefIndex )
+      if( pic->cs->picHeader->getEnableTMVPFlag() && pcSlice->getColFromL0Flag() == bool(1 - iRefList) && pcSlice->getColRefIdx() == iRefIndex )
       {
         if( scaleRatio.first != 1 << SCALE_RATIO_BITS || scaleRatio.second != 1 << SCALE_RATIO_BITS )
         {
@@ -804,15 +1282,15 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   }
   if (m_decodedPictureHashSEIEnabled)
   {
-    SEIMessages pictureHashes = getSeisByType(m_pcPic->SEIs, SEI::DECODED_PICTURE_HASH );
+    SEIMessages pictureHashes = getSeisByType(pic->SEIs, SEI::DECODED_PICTURE_HASH );
     const SEIDecodedPictureHash *hash = ( pictureHashes.size() > 0 ) ? (SEIDecodedPictureHash*) *(pictureHashes.begin()) : NULL;
     if (pictureHashes.size() > 1)
     {
       msg( WARNING, "Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
-    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) m_pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
+    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) pic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
 
-    SEIMessages scalableNestingSeis = getSeisByType(m_pcPic->SEIs, SEI::SCALABLE_NESTING );
+    SEIMessages scalableNestingSeis = getSeisByType(pic->SEIs, SEI::SCALABLE_NESTING );
     for (auto seiIt : scalableNestingSeis)
     {
       SEIScalableNesting *nestingSei = dynamic_cast<SEIScalableNesting*>(seiIt);
@@ -824,7 +1302,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
         {
           const SubPic& subpic = pcSlice->getPPS()->getSubPic(subpicId);
           const UnitArea area = UnitArea(pcSlice->getSPS()->getChromaFormatIdc(), Area(subpic.getSubPicLeft(), subpic.getSubPicTop(), subpic.getSubPicWidthInLumaSample(), subpic.getSubPicHeightInLumaSample()));
-          PelUnitBuf recoBuf = m_pcPic->cs->getRecoBuf(area);
+          PelUnitBuf recoBuf = pic->cs->getRecoBuf(area);
           m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(recoBuf, dynamic_cast<SEIDecodedPictureHash*>(decPicHash), pcSlice->getSPS()->getBitDepths(), msgl);
         }
       }
@@ -832,6 +1310,33 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   }
 
   msg( msgl, "\n");
+}
+
+void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool associatedWithNewClvs)
+{
+#if RExt__DECODER_DEBUG_TOOL_STATISTICS
+  CodingStatistics::StatTool& s = CodingStatistics::GetStatisticTool( STATS__TOOL_TOTAL_FRAME );
+  s.count++;
+  s.pixels = s.count * m_pcPic->Y().width * m_pcPic->Y().height;
+#endif
+
+  Slice*  pcSlice = m_pcPic->cs->slice;
+  m_prevPicPOC = pcSlice->getPOC();
+
+  char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
+  if (!m_pcPic->referenced)
+  {
+    c += 32;  // tolower
+  }
+
+  if (pcSlice->isDRAP()) c = 'D';
+  if (pcSlice->getEdrapRapId() > 0) c = 'E';
+
+  // with the picture pipeline the post-filter stage prints the information once it has checked the picture hash
+  if( !m_picturePipeline )
+  {
+    xPrintPictureInfo( m_pcPic, c, msgl );
+  }
 
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
     m_cacheModel.reportFrame();
@@ -902,10 +1407,17 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   m_maxDecSubPicIdx = 0;
   m_maxDecSliceAddrInSubPic = -1;
 
-  m_pcPic->destroyTempBuffers();
-  m_pcPic->cs->destroyCoeffs();
-  m_pcPic->cs->releaseIntermediateData();
-  m_pcPic->cs->picHeader->initPicHeader();
+  if( m_picturePipeline )
+  {
+    xStartPostFilter( c, msgl );
+  }
+  else
+  {
+    m_pcPic->destroyTempBuffers();
+    m_pcPic->cs->destroyCoeffs();
+    m_pcPic->cs->releaseIntermediateData();
+    m_pcPic->cs->picHeader->initPicHeader();
+  }
   m_puCounter++;
 }
 
@@ -945,6 +1457,8 @@ void DecLib::xUpdateRasInit(Slice* slice)
 void DecLib::xCreateLostPicture( int iLostPoc, const int layerId )
 {
   msg( INFO, "\ninserting lost poc : %d\n",iLostPoc);
+  // the lost picture is concealed with the samples of another one
+  waitForPostFilter();
   Picture *cFillPic = xGetNewPicBuffer( *( m_parameterSetManager.getFirstSPS() ), *( m_parameterSetManager.getFirstPPS() ), 0, layerId );
 
   CHECK( !cFillPic->slices.size(), "No slices in picture" );
@@ -1620,7 +2134,16 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
 
     if( nullptr != pps->pcv )
     {
-      delete m_parameterSetManager.getPPS( m_picHeader.getPPSId() )->pcv;
+      if( m_postFilterPic != nullptr && m_postFilterPic->cs->pcv == pps->pcv )
+      {
+        // still used by the post-filter stage, released when it is joined
+        CHECK( m_postFilterPcv != nullptr, "Pre-calculated values of the post-filter stage replaced twice" );
+        m_postFilterPcv = m_parameterSetManager.getPPS( m_picHeader.getPPSId() )->pcv;
+      }
+      else
+      {
+        delete m_parameterSetManager.getPPS( m_picHeader.getPPSId() )->pcv;
+      }
     }
     m_parameterSetManager.getPPS( m_picHeader.getPPSId() )->pcv = new PreCalcValues( *sps, *pps, false );
     m_parameterSetManager.clearSPSChangedFlag(sps->getSPSId());
@@ -1714,17 +2237,23 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
     const int maxDepth = floorLog2(sps->getMaxCUWidth()) - pps->pcv->minCUWidthLog2;
     const uint32_t  log2SaoOffsetScaleLuma   = (uint32_t) std::max(0, sps->getBitDepth(CHANNEL_TYPE_LUMA  ) - MAX_SAO_TRUNCATED_BITDEPTH);
     const uint32_t  log2SaoOffsetScaleChroma = (uint32_t) std::max(0, sps->getBitDepth(CHANNEL_TYPE_CHROMA) - MAX_SAO_TRUNCATED_BITDEPTH);
-    m_cSAO.create( pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(),
+    m_cSAO[m_postFilterSet].create( pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(),
                    sps->getChromaFormatIdc(),
                    sps->getMaxCUWidth(), sps->getMaxCUHeight(),
                    maxDepth,
                    log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma );
-    m_deblockingFilter.create(maxDepth);
-    m_cIntraPred.init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
-    m_cInterPred.init( &m_cRdCost, sps->getChromaFormatIdc(), sps->getMaxCUHeight() );
+    for( int i = 0; i < m_numLoopFilterThreads; i++ )
+    {
+      m_deblockingFilter[i].create(maxDepth);
+    }
+    for( int jId = 0; jId < m_numCuDecStacks; jId++ )
+    {
+      m_cIntraPred[jId].init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
+      m_cInterPred[jId].init( &m_cRdCost, sps->getChromaFormatIdc(), sps->getMaxCUHeight() );
+    }
     if (sps->getUseLmcs())
     {
-      m_cReshaper.createDec(sps->getBitDepth(CHANNEL_TYPE_LUMA));
+      m_cReshaper[0].createDec(sps->getBitDepth(CHANNEL_TYPE_LUMA));
     }
 
     bool isField = false;
@@ -1761,12 +2290,16 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
     m_SEIs.clear();
 
     // Recursive structure
-    m_cCuDecoder.init( &m_cTrQuant, &m_cIntraPred, &m_cInterPred );
-    if (sps->getUseLmcs())
+    for( int jId = 0; jId < m_numCuDecStacks; jId++ )
     {
-      m_cCuDecoder.initDecCuReshaper(&m_cReshaper, sps->getChromaFormatIdc());
+      m_cCuDecoder[jId].init( &m_cTrQuant[jId], &m_cIntraPred[jId], &m_cInterPred[jId] );
+      if (sps->getUseLmcs())
+      {
+        m_cCuDecoder[jId].initDecCuReshaper(&m_cReshaper[jId], sps->getChromaFormatIdc());
+      }
+      // the scaling list tables are shared, all stacks dequantise with the tables set up through the first one
+      m_cTrQuant[jId].init(m_cTrQuantScalingList.getQuant(), sps->getMaxTbSize(), false, false, false, false);
     }
-    m_cTrQuant.init(m_cTrQuantScalingList.getQuant(), sps->getMaxTbSize(), false, false, false, false);
 
     // RdCost
     m_cRdCost.setCostMode ( COST_STANDARD_LOSSY ); // not used in decoder side RdCost stuff -> set to default
@@ -1776,10 +2309,10 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
     if( sps->getALFEnabledFlag() )
     {
       const int maxDepth = floorLog2(sps->getMaxCUWidth()) - sps->getLog2MinCodingBlockSize();
-      m_cALF.create( pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), maxDepth, sps->getBitDepths().recon);
+      m_cALF[m_postFilterSet].create( pps->getPicWidthInLumaSamples(), pps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), maxDepth, sps->getBitDepths().recon);
     }
-    pSlice->m_ccAlfFilterControl[0] = m_cALF.getCcAlfControlIdc(COMPONENT_Cb);
-    pSlice->m_ccAlfFilterControl[1] = m_cALF.getCcAlfControlIdc(COMPONENT_Cr);
+    pSlice->m_ccAlfFilterControl[0] = m_cALF[m_postFilterSet].getCcAlfControlIdc(COMPONENT_Cb);
+    pSlice->m_ccAlfFilterControl[1] = m_cALF[m_postFilterSet].getCcAlfControlIdc(COMPONENT_Cr);
   }
   else
   {
@@ -2327,7 +2860,7 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
   }
 
   m_HLSReader.setBitstream( &nalu.getBitstream() );
-  m_apcSlicePilot->m_ccAlfFilterParam = m_cALF.getCcAlfFilterParam();
+  m_apcSlicePilot->m_ccAlfFilterParam = m_cALF[m_postFilterSet].getCcAlfFilterParam();
   m_HLSReader.parseSliceHeader( m_apcSlicePilot, &m_picHeader, &m_parameterSetManager, m_prevTid0POC, m_prevPicPOC );
 
   if (m_picHeader.getGdrOrIrapPicFlag() && m_bFirstSliceInPicture)
@@ -2888,7 +3421,7 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
     }
     pcSlice->checkConformanceForEDRAP(nalu.m_temporalId);
 
-  Quant *quant = m_cTrQuant.getQuant();
+  Quant *quant = m_cTrQuant[0].getQuant();
 
   if (pcSlice->getExplicitScalingListUsed())
   {
@@ -2962,7 +3495,7 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
         }
       }
       SliceReshapeInfo& sInfo = lmcsAPS->getReshaperAPSInfo();
-      SliceReshapeInfo& tInfo = m_cReshaper.getSliceReshaperInfo();
+      SliceReshapeInfo& tInfo = m_cReshaper[0].getSliceReshaperInfo();
       tInfo.reshaperModelMaxBinIdx = sInfo.reshaperModelMaxBinIdx;
       tInfo.reshaperModelMinBinIdx = sInfo.reshaperModelMinBinIdx;
       memcpy(tInfo.reshaperModelBinCWDelta, sInfo.reshaperModelBinCWDelta, sizeof(int)*(PIC_CODE_CW_BINS));
@@ -2974,43 +3507,53 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
     }
     else
     {
-      SliceReshapeInfo& tInfo = m_cReshaper.getSliceReshaperInfo();
+      SliceReshapeInfo& tInfo = m_cReshaper[0].getSliceReshaperInfo();
       tInfo.setUseSliceReshaper(false);
       tInfo.setSliceReshapeChromaAdj(false);
       tInfo.setSliceReshapeModelPresentFlag(false);
     }
     if (pcSlice->getLmcsEnabledFlag())
     {
-      m_cReshaper.constructReshaper();
+      m_cReshaper[0].constructReshaper();
     }
     else
     {
-      m_cReshaper.setReshapeFlag(false);
+      m_cReshaper[0].setReshapeFlag(false);
     }
-    if ((pcSlice->getSliceType() == I_SLICE) && m_cReshaper.getSliceReshaperInfo().getUseSliceReshaper())
+    if ((pcSlice->getSliceType() == I_SLICE) && m_cReshaper[0].getSliceReshaperInfo().getUseSliceReshaper())
     {
-      m_cReshaper.setCTUFlag(false);
-      m_cReshaper.setRecReshaped(true);
+      m_cReshaper[0].setCTUFlag(false);
+      m_cReshaper[0].setRecReshaped(true);
     }
     else
     {
-      if (m_cReshaper.getSliceReshaperInfo().getUseSliceReshaper())
+      if (m_cReshaper[0].getSliceReshaperInfo().getUseSliceReshaper())
       {
-        m_cReshaper.setCTUFlag(true);
-        m_cReshaper.setRecReshaped(true);
+        m_cReshaper[0].setCTUFlag(true);
+        m_cReshaper[0].setRecReshaped(true);
       }
       else
       {
-        m_cReshaper.setCTUFlag(false);
-        m_cReshaper.setRecReshaped(false);
+        m_cReshaper[0].setCTUFlag(false);
+        m_cReshaper[0].setRecReshaped(false);
       }
     }
-    m_cReshaper.setVPDULoc(-1, -1);
+    m_cReshaper[0].setVPDULoc(-1, -1);
   }
   else
   {
-    m_cReshaper.setCTUFlag(false);
-    m_cReshaper.setRecReshaped(false);
+    m_cReshaper[0].setCTUFlag(false);
+    m_cReshaper[0].setRecReshaped(false);
+  }
+
+  // the other CU decoding stacks start from the slice settings of the first one
+  for( int jId = 1; jId < m_numCuDecStacks; jId++ )
+  {
+    m_cTrQuant[jId].getQuant()->setUseScalingList( pcSlice->getExplicitScalingListUsed() );
+    if( pcSlice->getSPS()->getUseLmcs() )
+    {
+      m_cReshaper[jId] = m_cReshaper[0];
+    }
   }
 
 #if GDR_LEAK_TEST
@@ -3033,8 +3576,32 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
     }
   }
 #endif // GDR_LEAK_TEST
+  // when the slice is the whole picture, the loop filter wavefront follows the reconstruction of its CTU rows
+  const bool filterAlongRecon = m_numLoopFilterThreads > 1 && getDebugCTU() < 0 && pcSlice->getNumCtuInSlice() == pcSlice->getPPS()->pcv->sizeInCtus;
+  if( filterAlongRecon )
+  {
+    m_filterAlongRecon = true;
+    m_reconProgress.reset();
+    m_loopFilterThread = std::thread( &DecLib::xFilterAlongRecon, this, m_pcPic, m_postFilterSet );
+  }
+  m_cSliceDecoder.setReconProgress( filterAlongRecon ? &m_reconProgress : nullptr );
+
   //  Decode a picture
-  m_cSliceDecoder.decompressSlice( pcSlice, &( nalu.getBitstream() ), ( m_pcPic->poc == getDebugPOC() ? getDebugCTU() : -1 ) );
+  try
+  {
+    m_cSliceDecoder.decompressSlice( pcSlice, &( nalu.getBitstream() ), ( m_pcPic->poc == getDebugPOC() ? getDebugCTU() : -1 ) );
+  }
+  catch( ... )
+  {
+    if( filterAlongRecon )
+    {
+      m_reconProgress.abort();
+      m_loopFilterThread.join();
+      m_loopFilterError  = nullptr;
+      m_filterAlongRecon = false;
+    }
+    throw;
+  }
 
   m_bFirstSliceInPicture = false;
   m_uiSliceSegmentIdx++;
@@ -3101,6 +3668,9 @@ void DecLib::xDecodeOPI( InputNALUnit& nalu )
 
 void DecLib::xDecodeVPS( InputNALUnit& nalu )
 {
+  // parameter sets may be replaced while the post-filter stage still uses them
+  waitForPostFilter();
+
   VPS* vps = new VPS();
   m_HLSReader.setBitstream( &nalu.getBitstream() );
 
@@ -3140,6 +3710,9 @@ void DecLib::xDecodeDCI(InputNALUnit& nalu)
 
 void DecLib::xDecodeSPS( InputNALUnit& nalu )
 {
+  // parameter sets may be replaced while the post-filter stage still uses them
+  waitForPostFilter();
+
   SPS* sps = new SPS();
   m_HLSReader.setBitstream( &nalu.getBitstream() );
 
@@ -3153,6 +3726,9 @@ void DecLib::xDecodeSPS( InputNALUnit& nalu )
 
 void DecLib::xDecodePPS( InputNALUnit& nalu )
 {
+  // parameter sets may be replaced while the post-filter stage still uses them
+  waitForPostFilter();
+
   PPS* pps = new PPS();
   m_HLSReader.setBitstream( &nalu.getBitstream() );
   m_HLSReader.parsePPS( pps );
@@ -55,6 +55,9 @@
 #include "CommonLib/Unit.h"
 #include "CommonLib/Reshape.h"
 
+#include <exception>
+#include <thread>
+
 class InputNALUnit;
 
 //! \ingroup DecoderLib
@@ -89,6 +92,7 @@ private:
   bool                    m_prevEOS[MAX_VPS_LAYERS];
 
   PicList                 m_cListPic;         //  Dynamic buffer
+  PicturePool             m_picPool;          ///< pictures dropped from the list, kept for a later picture of their size class
   ParameterSetManager     m_parameterSetManager;  // storage for parameter sets
   PicHeader               m_picHeader;            // picture header
   Slice*                  m_apcSlicePilot;
@@ -100,22 +104,40 @@ private:
 
 
   // functional classes
-  IntraPrediction         m_cIntraPred;
-  InterPrediction         m_cInterPred;
-  TrQuant                 m_cTrQuant;
+  IntraPrediction        *m_cIntraPred;                   ///< one per CU decoding stack
+  InterPrediction        *m_cInterPred;                   ///< one per CU decoding stack
+  TrQuant                *m_cTrQuant;                     ///< one per CU decoding stack
   DecSlice                m_cSliceDecoder;
   TrQuant                 m_cTrQuantScalingList;
-  DecCu                   m_cCuDecoder;
+  DecCu                  *m_cCuDecoder;                   ///< one per CU decoding stack
   HLSyntaxReader          m_HLSReader;
-  CABACDecoder            m_CABACDecoder;
+  CABACDecoder           *m_CABACDecoder;                 ///< one per CU decoding stack
+  int                     m_numSubstreamThreads;          ///< number of threads decoding the substreams of a slice
+  int                     m_numCuDecStacks;               ///< number of CU decoding stacks (one per substream thread)
+  bool                    m_parseAhead;                   ///< parse the CTUs of a slice on a separate thread ahead of their reconstruction
   SEIReader               m_seiReader;
 #if JVET_S0257_DUMP_360SEI_MESSAGE
   SeiCfgFileDump          m_seiCfgDump;
 #endif
-  DeblockingFilter        m_deblockingFilter;
-  SampleAdaptiveOffset    m_cSAO;
-  AdaptiveLoopFilter      m_cALF;
-  Reshape                 m_cReshaper;                        ///< reshaper class
+  DeblockingFilter       *m_deblockingFilter;             ///< one per loop filter thread
+  int                     m_numLoopFilterThreads;         ///< number of threads filtering the CTU rows of a picture in a wavefront
+  bool                    m_filterAlongRecon;             ///< the loop filters of the current picture have been started along its reconstruction
+  CtuRowReconProgress     m_reconProgress;                ///< reconstructed CTU rows of a single slice picture, its loop filter wavefront runs behind them
+  std::thread             m_loopFilterThread;             ///< loop filter wavefront running along the decoding of the picture
+  std::exception_ptr      m_loopFilterError;
+  SampleAdaptiveOffset    m_cSAO[2];                      ///< one per post-filter set
+  AdaptiveLoopFilter      m_cALF[2];                      ///< one per post-filter set, also holds the CC-ALF control parsed for the picture
+  int                     m_postFilterSet;                ///< post-filter set of the picture being decoded, the other one may be busy in the post-filter stage
+  bool                    m_picturePipeline;              ///< run SAO, ALF and border extension of a picture on the post-filter thread while the next picture is decoded
+  std::thread             m_postFilterThread;
+  std::exception_ptr      m_postFilterError;
+  Picture*                m_postFilterPic;                ///< picture in the post-filter stage, nullptr when the stage is idle
+  PreCalcValues*          m_postFilterPcv;                ///< pre-calculated values replaced while the post-filter stage still used them
+  APS                     m_postFilterAlfAps[ALF_CTB_MAX_NUM_APS]; ///< ALF APSs of the picture in the post-filter stage, new APSs with the same id may arrive meanwhile
+#if !GDR_ENABLED
+  PicHeader               m_postFilterPicHeader;
+#endif
+  Reshape                *m_cReshaper;                        ///< reshaper class, the first one holds the slice state that is copied to the other CU decoding stacks
   HRD                     m_HRD;
   // decoder side RD cost computation
   RdCost                  m_cRdCost;                      ///< RD cost computation class
@@ -222,6 +244,14 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  /// number of threads decoding the WPP rows or tiles of a slice in parallel, must be set before create()
+  void  setNumSubstreamThreads(int n)                { m_numSubstreamThreads = n; }
+  /// parse the CTUs of a slice on a separate thread ahead of their reconstruction, must be set before init()
+  void  setParseAhead(bool b)                        { m_parseAhead = b; }
+  /// in-loop filter each picture on the post-filter thread while the next picture is decoded, pictures wait for the reference CTU rows they use
+  void  setPicturePipeline(bool b)                   { m_picturePipeline = b; }
+  /// number of threads applying deblocking, SAO and ALF to the CTU rows of a picture in a wavefront, must be set before create()
+  void  setNumLoopFilterThreads(int n)               { m_numLoopFilterThreads = n; }
 
   void  init(
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -230,8 +260,10 @@ public:
   );
   bool  decode(InputNALUnit& nalu, int& iSkipFrame, int& iPOCLastDisplay, int iTargetOlsIdx);
   void  deletePicBuffer();
+  void  releasePicBuffer( Picture* pic );
 
   void  executeLoopFilters();
+  void  waitForPostFilter();
   void finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl = INFO, bool associatedWithNewClvs = false);
   void  finishPictureLight(int& poc, PicList*& rpcListPic );
   void  checkNoOutputPriorPics (PicList* rpcListPic);
@@ -306,6 +338,16 @@ protected:
   void  xUpdateRasInit(Slice* slice);
 
   Picture * xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_t temporalLayer, const int layerId );
+  Picture * xLeasePicBuffer ( const SPS &sps, const PPS &pps, const int layerId );
+  void  xApplyPostFilters( CodingStructure& cs, const int filterSet, const bool publishRows = false );
+  void  xInverseMapCtuRow( CodingStructure& cs, const int ctuRow );
+  void  xFilterCtuRows( CodingStructure& cs, const int filterSet, const bool deblock, const bool postFilters, const bool publishRows = false, CtuRowReconProgress* reconProgress = nullptr );
+  void  xFilterAlongRecon( Picture* pic, const int filterSet );
+  void  xWaitForLoopFilter();
+  void  xMaskNonTargetSubPics( CodingStructure& cs );
+  void  xStartPostFilter( const char sliceTypeChar, const MsgLevel msgl );
+  void  xPostFilterPicture( Picture* pic, const int filterSet, const char sliceTypeChar, const MsgLevel msgl );
+  void  xPrintPictureInfo( Picture* pic, const char sliceTypeChar, const MsgLevel msgl );
   void  xCreateLostPicture( int iLostPOC, const int layerId );
   void  xCreateUnavailablePicture( const PPS *pps, const int iUnavailablePoc, const bool longTermFlag, const int temporalId, const int layerId, const bool interLayerRefPicFlag );
   void  checkParameterSetsInclusionSEIconstraints(const InputNALUnit nalu);
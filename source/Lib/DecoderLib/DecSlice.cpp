@@ -40,15 +40,75 @@
 #include "CommonLib/dtrace_next.h"
 
 #include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 //! \ingroup DecoderLib
 //! \{
 
+void CtuRowReconProgress::reset()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_numFinishedRows = -1;
+  m_aborted         = false;
+}
+
+void CtuRowReconProgress::start( const int widthInCtus, const int heightInCtus )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_widthInCtus     = widthInCtus;
+    m_numRowCtus.assign( heightInCtus, 0 );
+    m_numFinishedRows = 0;
+  }
+  m_cond.notify_all();
+}
+
+void CtuRowReconProgress::ctuFinished( const int ctuRsAddr )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    const int numRows = (int) m_numRowCtus.size();
+    const int prevRows = m_numFinishedRows;
+    m_numRowCtus[ctuRsAddr / m_widthInCtus]++;
+    // with tiles or WPP the rows may be completed out of order
+    while( m_numFinishedRows < numRows && m_numRowCtus[m_numFinishedRows] == m_widthInCtus )
+    {
+      m_numFinishedRows++;
+    }
+    if( m_numFinishedRows == prevRows )
+    {
+      return;
+    }
+  }
+  m_cond.notify_all();
+}
+
+void CtuRowReconProgress::abort()
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_aborted = true;
+  }
+  m_cond.notify_all();
+}
+
+bool CtuRowReconProgress::waitForStart()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [&]() { return m_aborted || m_numFinishedRows >= 0; } );
+  return !m_aborted;
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
 DecSlice::DecSlice()
+  : m_reconProgress( nullptr )
 {
 }
 
@@ -64,10 +124,12 @@ void DecSlice::destroy()
 {
 }
 
-void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder )
+void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder, const int numCuDecStacks, const bool parseAhead )
 {
   m_CABACDecoder    = cabacDecoder;
   m_pcCuDecoder     = pcCuDecoder;
+  m_numCuDecStacks  = numCuDecStacks;
+  m_parseAhead      = parseAhead;
 }
 
 void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int debugCTU )
@@ -117,16 +179,8 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   const bool     wavefrontsEnabled           = cs.sps->getEntropyCodingSyncEnabledFlag();
   const bool     entryPointPresent           = cs.sps->getEntryPointsPresentFlag();
 
-  cabacReader.initBitstream( ppcSubstreams[0] );
-  cabacReader.initCtxModels( *slice );
-
-  // Quantization parameter
-    pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
-  CHECK( pic->m_prevQP[0] == std::numeric_limits<int>::max(), "Invalid previous QP" );
-
   DTRACE( g_trace_ctx, D_HEADER, "=========== POC: %d ===========\n", slice->getPOC() );
 
-
   if( slice->getSliceType() != I_SLICE && slice->getRefPic( REF_PIC_LIST_0, 0 )->subPictures.size() > 1 )
   {
     clipMv = clipMvInSubpic;
@@ -135,164 +189,538 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   {
     clipMv = clipMvInPic;
   }
-  // for every CTU in the slice segment...
-  unsigned subStrmId = 0;
-  for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
+
+  if( m_reconProgress )
+  {
+    // the loop filters running along the reconstruction look up the units of the finished rows
+    xReserveUnits( cs );
+    m_reconProgress->start( widthInCtus, cs.pcv->heightInCtus );
+  }
+
+  if( debugCTU < 0 && xCanDecodeSubstreamsParallel( slice, numSubstreams ) )
+  {
+    xDecodeSubstreamsParallel( slice, ppcSubstreams );
+
+    for( auto substr: ppcSubstreams )
+    {
+      delete substr;
+    }
+    slice->stopProcessingTimer();
+    return;
+  }
+
+  cabacReader.initBitstream( ppcSubstreams[0] );
+  cabacReader.initCtxModels( *slice );
+
+  // Quantization parameter
+    pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
+  CHECK( pic->m_prevQP[0] == std::numeric_limits<int>::max(), "Invalid previous QP" );
+
+  const unsigned  maxCUSize   = sps->getMaxCUWidth();
+  const bool      parseAhead  = m_parseAhead && debugCTU < 0 && slice->getNumCtuInSlice() > 1;
+
+  std::mutex              parsedMutex;
+  std::condition_variable parsedCond;
+  unsigned                numParsedCtus = 0;      // CTUs handed over from the parse to the reconstruction stage
+  bool                    abortParsing  = false;
+  std::exception_ptr      parseError;
+
+  // the parser keeps the local dual tree state and the unit chaining apart from the reconstruction,
+  // the units of a CTU are linked among themselves only, so that traversing a reconstructed CTU never runs into the next one
+  CtuLineState            parseState;
+
+  // prediction and reconstruction of a parsed CTU
+  auto reconstructCtu = [&]( const unsigned ctuIdx )
   {
     const unsigned  ctuRsAddr       = slice->getCtuAddrInSlice(ctuIdx);
     const unsigned  ctuXPosInCtus   = ctuRsAddr % widthInCtus;
     const unsigned  ctuYPosInCtus   = ctuRsAddr / widthInCtus;
-    const unsigned  tileColIdx      = slice->getPPS()->ctuToTileCol( ctuXPosInCtus );
-    const unsigned  tileRowIdx      = slice->getPPS()->ctuToTileRow( ctuYPosInCtus );
-    const unsigned  tileXPosInCtus  = slice->getPPS()->getTileColumnBd( tileColIdx );
-    const unsigned  tileYPosInCtus  = slice->getPPS()->getTileRowBd( tileRowIdx );
-    const unsigned  tileColWidth    = slice->getPPS()->getTileColumnWidth( tileColIdx );
-    const unsigned  tileRowHeight   = slice->getPPS()->getTileRowHeight( tileRowIdx );
-    const unsigned  tileIdx         = slice->getPPS()->getTileIdx( ctuXPosInCtus, ctuYPosInCtus);
-    const unsigned  maxCUSize             = sps->getMaxCUWidth();
-    Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
-    UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
-    const SubPic &curSubPic = slice->getPPS()->getSubPicFromPos(pos);
-    // padding/restore at slice level
-    if (slice->getPPS()->getNumSubPics()>=2 && curSubPic.getTreatedAsPicFlag() && ctuIdx==0)
+    UnitArea ctuArea(cs.area.chromaFormat, Area( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize, maxCUSize, maxCUSize ) );
+
+    if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && slice->getPPS()->ctuIsTileColBd( ctuXPosInCtus ))
+    {
+      cs.motionLut.lut.resize(0);
+      cs.motionLut.lutIbc.resize(0);
+      cs.resetIBCBuffer = true;
+    }
+
+    m_pcCuDecoder->decompressCtu( cs, ctuArea );
+
+    if( m_reconProgress )
     {
-      int subPicX      = (int)curSubPic.getSubPicLeft();
-      int subPicY      = (int)curSubPic.getSubPicTop();
-      int subPicWidth  = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+      m_reconProgress->ctuFinished( ctuRsAddr );
+    }
+  };
+
+  // for every CTU in the slice segment...
+  auto parseCtus = [&]()
+  {
+    unsigned subStrmId = 0;
+    for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
+    {
+      const unsigned  ctuRsAddr       = slice->getCtuAddrInSlice(ctuIdx);
+      const unsigned  ctuXPosInCtus   = ctuRsAddr % widthInCtus;
+      const unsigned  ctuYPosInCtus   = ctuRsAddr / widthInCtus;
+      const unsigned  tileColIdx      = slice->getPPS()->ctuToTileCol( ctuXPosInCtus );
+      const unsigned  tileRowIdx      = slice->getPPS()->ctuToTileRow( ctuYPosInCtus );
+      const unsigned  tileXPosInCtus  = slice->getPPS()->getTileColumnBd( tileColIdx );
+      const unsigned  tileYPosInCtus  = slice->getPPS()->getTileRowBd( tileRowIdx );
+      const unsigned  tileColWidth    = slice->getPPS()->getTileColumnWidth( tileColIdx );
+      const unsigned  tileRowHeight   = slice->getPPS()->getTileRowHeight( tileRowIdx );
+      const unsigned  tileIdx         = slice->getPPS()->getTileIdx( ctuXPosInCtus, ctuYPosInCtus);
+      Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
+      UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+      const SubPic &curSubPic = slice->getPPS()->getSubPicFromPos(pos);
+      // padding/restore at slice level
+      if (slice->getPPS()->getNumSubPics()>=2 && curSubPic.getTreatedAsPicFlag() && ctuIdx==0)
       {
-        int n = slice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
+        int subPicX      = (int)curSubPic.getSubPicLeft();
+        int subPicY      = (int)curSubPic.getSubPicTop();
+        int subPicWidth  = (int)curSubPic.getSubPicWidthInLumaSample();
+        int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+        for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
         {
-          Picture *refPic = slice->getRefPic((RefPicList)rlist, idx);
+          int n = slice->getNumRefIdx((RefPicList)rlist);
+          for (int idx = 0; idx < n; idx++)
+          {
+            Picture *refPic = slice->getRefPic((RefPicList)rlist, idx);
+
+            if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+            {
+              refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+              refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+              refPic->setSubPicSaved(true);
+            }
+          }
+        }
+      }
+
+      DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
+
+      cabacReader.initBitstream( ppcSubstreams[subStrmId] );
+
+      // set up CABAC contexts' state for this CTU
+      if( ctuXPosInCtus == tileXPosInCtus && ctuYPosInCtus == tileYPosInCtus )
+      {
+        if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+        {
+          cabacReader.initCtxModels( *slice );
+          cs.resetPrevPLT(cs.prevPLT);
+        }
+        pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
+      }
+      else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+      {
+        // Synchronize cabac probabilities with top CTU if it's available and at the start of a line.
+        if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+        {
+          cabacReader.initCtxModels( *slice );
+          cs.resetPrevPLT(cs.prevPLT);
+        }
+        if( cs.getCURestricted( pos.offset(0, -1), pos, slice->getIndependentSliceIdx(), tileIdx, CH_L ) )
+        {
+          // Top is available, so use it.
+          cabacReader.getCtx() = m_entropyCodingSyncContextState;
+          cs.setPrevPLT(m_palettePredictorSyncState);
+        }
+        pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
+      }
 
-          if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+      bool updateBcwCodingOrder = cs.slice->getSliceType() == B_SLICE && ctuIdx == 0;
+      if(updateBcwCodingOrder)
+      {
+        resetBcwCodingOrder(true, cs);
+      }
+
+      if( !cs.slice->isIntra() )
+      {
+        pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
+      }
+
+      if( ctuRsAddr == debugCTU )
+      {
+        break;
+      }
+      if( parseAhead )
+      {
+        parseState.lastCU = nullptr;
+        parseState.lastPU = nullptr;
+        parseState.lastTU = nullptr;
+      }
+
+      cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+
+      if( parseAhead )
+      {
+        {
+          std::lock_guard<std::mutex> lock( parsedMutex );
+          if( abortParsing )
           {
-            refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(true);
+            return;
           }
+          numParsedCtus = ctuIdx + 1;
         }
+        parsedCond.notify_one();
+      }
+      else
+      {
+        reconstructCtu( ctuIdx );
       }
-    }
 
-    DTRACE_UPDATE( g_trace_ctx, std::make_pair( "ctu", ctuRsAddr ) );
+      if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+      {
+        m_entropyCodingSyncContextState = cabacReader.getCtx();
+        cs.storePrevPLT(m_palettePredictorSyncState);
+      }
 
-    cabacReader.initBitstream( ppcSubstreams[subStrmId] );
 
-    // set up CABAC contexts' state for this CTU
-    if( ctuXPosInCtus == tileXPosInCtus && ctuYPosInCtus == tileYPosInCtus )
-    {
-      if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+      if( ctuIdx == slice->getNumCtuInSlice()-1 )
+      {
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+        cabacReader.remaining_bytes( false );
+#endif
+      }
+      else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + tileColWidth ) &&
+               ( ctuYPosInCtus + 1 == tileYPosInCtus + tileRowHeight || wavefrontsEnabled ) )
       {
-        cabacReader.initCtxModels( *slice );
-        cs.resetPrevPLT(cs.prevPLT);
+        // The sub-stream/stream should be terminated after this CTU.
+        // (end of slice-segment, end of tile, end of wavefront-CTU-row)
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
+        if( entryPointPresent )
+        {
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+          cabacReader.remaining_bytes( true );
+#endif
+          subStrmId++;
+        }
       }
-      pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
     }
-    else if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+  };
+
+  if( parseAhead )
+  {
+    // the unit vectors of the picture must not be reallocated while the reconstruction is reading from them
+    xReserveUnits( cs );
+
+    std::thread parseThread( [&]()
     {
-      // Synchronize cabac probabilities with top CTU if it's available and at the start of a line.
-      if( ctuIdx != 0 ) // if it is the first CTU, then the entropy coder has already been reset
+      CodingStructure::setCtuLineState( &parseState );
+      try
       {
-        cabacReader.initCtxModels( *slice );
-        cs.resetPrevPLT(cs.prevPLT);
+        parseCtus();
       }
-      if( cs.getCURestricted( pos.offset(0, -1), pos, slice->getIndependentSliceIdx(), tileIdx, CH_L ) )
+      catch( ... )
       {
-        // Top is available, so use it.
-        cabacReader.getCtx() = m_entropyCodingSyncContextState;
-        cs.setPrevPLT(m_palettePredictorSyncState);
+        {
+          std::lock_guard<std::mutex> lock( parsedMutex );
+          parseError   = std::current_exception();
+          abortParsing = true;
+        }
+        parsedCond.notify_one();
       }
-      pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
-    }
+      CodingStructure::setCtuLineState( nullptr );
+    } );
 
-    bool updateBcwCodingOrder = cs.slice->getSliceType() == B_SLICE && ctuIdx == 0;
-    if(updateBcwCodingOrder)
+    try
     {
-      resetBcwCodingOrder(true, cs);
+      for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
+      {
+        {
+          std::unique_lock<std::mutex> lock( parsedMutex );
+          parsedCond.wait( lock, [&]() { return abortParsing || numParsedCtus > ctuIdx; } );
+          if( abortParsing )
+          {
+            break;
+          }
+        }
+        reconstructCtu( ctuIdx );
+      }
     }
-
-    if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == tileXPosInCtus)
+    catch( ... )
     {
-      cs.motionLut.lut.resize(0);
-      cs.motionLut.lutIbc.resize(0);
-      cs.resetIBCBuffer = true;
+      {
+        std::lock_guard<std::mutex> lock( parsedMutex );
+        abortParsing = true;
+      }
+      parseThread.join();
+      throw;
     }
-
-    if( !cs.slice->isIntra() )
+    parseThread.join();
+    if( parseError )
     {
-      pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
+      std::rethrow_exception( parseError );
     }
+  }
+  else
+  {
+    parseCtus();
+  }
 
-    if( ctuRsAddr == debugCTU )
+  // restore the subpicture borders of the reference pictures
+  const unsigned lastCtuRsAddr = slice->getCtuAddrInSlice( slice->getNumCtuInSlice() - 1 );
+  const SubPic&  curSubPic     = slice->getPPS()->getSubPicFromPos( Position( ( lastCtuRsAddr % widthInCtus ) * maxCUSize, ( lastCtuRsAddr / widthInCtus ) * maxCUSize ) );
+  if( slice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() )
+  {
+    int subPicX = (int)curSubPic.getSubPicLeft();
+    int subPicY = (int)curSubPic.getSubPicTop();
+    int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
+    int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
+    for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
     {
-      break;
+      int n = slice->getNumRefIdx((RefPicList)rlist);
+      for (int idx = 0; idx < n; idx++)
+      {
+        Picture *refPic = slice->getRefPic((RefPicList)rlist, idx);
+        if (refPic->getSubPicSaved())
+        {
+          refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+          refPic->setSubPicSaved(false);
+        }
+      }
     }
-    cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+  }
 
-    m_pcCuDecoder->decompressCtu( cs, ctuArea );
+  // deallocate all created substreams, including internal buffers.
+  for( auto substr: ppcSubstreams )
+  {
+    delete substr;
+  }
+  slice->stopProcessingTimer();
+}
+
+void DecSlice::xReserveUnits( CodingStructure& cs ) const
+{
+  const size_t maxNumUnits = 2 * cs.unitScale[COMPONENT_Y].scale( cs.area.blocks[COMPONENT_Y].size() ).area();
+  cs.cus.reserve( maxNumUnits );
+  cs.pus.reserve( maxNumUnits );
+  cs.tus.reserve( maxNumUnits );
+}
+
+bool DecSlice::xCanDecodeSubstreamsParallel( const Slice* slice, const unsigned numSubstreams ) const
+{
+  const SPS* sps = slice->getSPS();
+
+  // the palette predictor, the IBC reference buffer and the chroma QP adjustment are kept in picture level state
+  return m_numCuDecStacks > 1 && numSubstreams > 1 && sps->getEntryPointsPresentFlag()
+      && !sps->getPLTMode() && !sps->getIBCFlag() && !slice->getUseChromaQpAdj();
+}
 
-    if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+void DecSlice::xDecodeSubstreamsParallel( Slice* slice, std::vector<InputBitstream*>& substreams )
+{
+  CodingStructure&     cs          = *slice->getPic()->cs;
+  const PreCalcValues& pcv         = *cs.pcv;
+  const PPS*           pps         = slice->getPPS();
+  const unsigned       widthInCtus = pcv.widthInCtus;
+  const bool           wavefronts  = cs.sps->getEntropyCodingSyncEnabledFlag();
+
+  // every substream is a CTU line: a CTU row inside of a tile with WPP, a whole tile otherwise
+  std::vector<unsigned> lineStart;
+  std::vector<bool>     lineAboveAvail;
+  for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
+  {
+    const unsigned ctuRsAddr     = slice->getCtuAddrInSlice( ctuIdx );
+    const bool     tileColStart  = pps->ctuIsTileColBd( ctuRsAddr % widthInCtus );
+    const bool     tileRowStart  = pps->ctuIsTileRowBd( ctuRsAddr / widthInCtus );
+    if( ctuIdx == 0 || ( tileColStart && ( wavefronts || tileRowStart ) ) )
     {
-      m_entropyCodingSyncContextState = cabacReader.getCtx();
-      cs.storePrevPLT(m_palettePredictorSyncState);
+      // only WPP rows depend on the row above, provided it belongs to the same slice and tile
+      lineAboveAvail.push_back( wavefronts && ctuIdx > 0 && !tileRowStart );
+      lineStart.push_back( ctuIdx );
     }
+  }
+  const int numLines = (int) lineStart.size();
+  lineStart.push_back( slice->getNumCtuInSlice() );
+  CHECK( numLines != (int) substreams.size(), "Number of substreams does not match the CTU lines of the slice" );
+
+  const int numThreads = std::min( m_numCuDecStacks, numLines );
 
+  // the unit vectors of the picture must not be reallocated while other threads are reading from them
+  xReserveUnits( cs );
 
-    if( ctuIdx == slice->getNumCtuInSlice()-1 )
+  // padding/restore at slice level
+  const unsigned firstCtuRsAddr = slice->getCtuAddrInSlice( 0 );
+  const SubPic&  curSubPic      = pps->getSubPicFromPos( Position( ( firstCtuRsAddr % widthInCtus ) * pcv.maxCUWidth, ( firstCtuRsAddr / widthInCtus ) * pcv.maxCUHeight ) );
+  const bool     padSubPic      = pps->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag();
+  if( padSubPic )
+  {
+    for( int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++ )
     {
-      unsigned binVal = cabacReader.terminating_bit();
-      CHECK( !binVal, "Expecting a terminating bit" );
-#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
-      cabacReader.remaining_bytes( false );
-#endif
+      for( int idx = 0; idx < slice->getNumRefIdx( (RefPicList) rlist ); idx++ )
+      {
+        Picture *refPic = slice->getRefPic( (RefPicList) rlist, idx );
+        if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+        {
+          refPic->saveSubPicBorder( refPic->getPOC(), curSubPic.getSubPicLeft(), curSubPic.getSubPicTop(), curSubPic.getSubPicWidthInLumaSample(), curSubPic.getSubPicHeightInLumaSample() );
+          refPic->extendSubPicBorder( refPic->getPOC(), curSubPic.getSubPicLeft(), curSubPic.getSubPicTop(), curSubPic.getSubPicWidthInLumaSample(), curSubPic.getSubPicHeightInLumaSample() );
+          refPic->setSubPicSaved( true );
+        }
+      }
     }
-    else if( ( ctuXPosInCtus + 1 == tileXPosInCtus + tileColWidth ) &&
-             ( ctuYPosInCtus + 1 == tileYPosInCtus + tileRowHeight || wavefrontsEnabled ) )
+  }
+
+  if( slice->getSliceType() == B_SLICE )
+  {
+    resetBcwCodingOrder( true, cs );
+  }
+
+  std::mutex              unitMutex;
+  std::mutex              progressMutex;
+  std::condition_variable progressCond;
+  std::vector<unsigned>   lineProgress( numLines, 0 );  // number of finished CTUs in each line
+  std::vector<Ctx>        lineSyncCtx ( numLines );     // contexts after the first CTU of each line
+  std::atomic<int>        nextLine    ( 0 );
+  bool                    abortLines  = false;
+  std::exception_ptr      lineError;
+
+  auto decodeLines = [&]( const int jId, CtuLineState& lineState )
+  {
+    CABACReader& cabacReader = *m_CABACDecoder[jId].getCABACReader( 0 );
+    DecCu&       cuDecoder   = m_pcCuDecoder[jId];
+    int          prevQP[2];
+
+    for( int line = nextLine++; line < numLines; line = nextLine++ )
     {
-      // The sub-stream/stream should be terminated after this CTU.
-      // (end of slice-segment, end of tile, end of wavefront-CTU-row)
-      unsigned binVal = cabacReader.terminating_bit();
-      CHECK( !binVal, "Expecting a terminating bit" );
-      if( entryPointPresent )
+      lineState.lastCU = nullptr;
+      lineState.lastPU = nullptr;
+      lineState.lastTU = nullptr;
+
+      cabacReader.initBitstream( substreams[line] );
+      cabacReader.initCtxModels( *slice );
+      prevQP[0] = prevQP[1] = slice->getSliceQp();
+
+      for( unsigned ctuIdx = lineStart[line]; ctuIdx < lineStart[line + 1]; ctuIdx++ )
       {
+        const unsigned ctuInLine = ctuIdx - lineStart[line];
+
+        if( lineAboveAvail[line] )
+        {
+          // wait for the top-right CTU, or the top CTU at the end of the line
+          const unsigned neededAbove = std::min( ctuInLine + 2, lineStart[line] - lineStart[line - 1] );
+          std::unique_lock<std::mutex> lock( progressMutex );
+          progressCond.wait( lock, [&]() { return abortLines || lineProgress[line - 1] >= neededAbove; } );
+          if( abortLines )
+          {
+            return;
+          }
+          if( ctuInLine == 0 )
+          {
+            cabacReader.getCtx() = lineSyncCtx[line - 1];
+          }
+        }
+
+        const unsigned ctuRsAddr     = slice->getCtuAddrInSlice( ctuIdx );
+        const unsigned ctuXPosInCtus = ctuRsAddr % widthInCtus;
+        const Position pos( ctuXPosInCtus * pcv.maxCUWidth, ( ctuRsAddr / widthInCtus ) * pcv.maxCUHeight );
+        const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight ) );
+
+        if( pps->ctuIsTileColBd( ctuXPosInCtus ) && !slice->isIntra() )
+        {
+          lineState.motionLut.lut.resize( 0 );
+          lineState.motionLut.lutIbc.resize( 0 );
+        }
+
+        cabacReader.coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr );
+
+        cuDecoder.decompressCtu( cs, ctuArea );
+
+        if( m_reconProgress )
+        {
+          m_reconProgress->ctuFinished( ctuRsAddr );
+        }
+
+        if( ctuIdx + 1 == lineStart[line + 1] )
+        {
+          // end of slice, end of tile or end of WPP row
+          unsigned binVal = cabacReader.terminating_bit();
+          CHECK( !binVal, "Expecting a terminating bit" );
 #if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
-        cabacReader.remaining_bytes( true );
+          cabacReader.remaining_bytes( line + 1 < numLines );
 #endif
-        subStrmId++;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock( progressMutex );
+          if( ctuInLine == 0 && wavefronts )
+          {
+            lineSyncCtx[line] = cabacReader.getCtx();
+          }
+          lineProgress[line]++;
+        }
+        progressCond.notify_all();
       }
     }
-    if (slice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == (slice->getNumCtuInSlice() - 1))
-    // for last Ctu in the slice
+  };
+
+  auto runLines = [&]( const int jId )
+  {
+    // the prediction and residual buffers of the picture only cover one CTU
+#if KEEP_PRED_AND_RESI_SIGNALS
+    const UnitArea lineBufArea( cs.area.chromaFormat, Area( Position(), cs.picture->lumaSize() ) );
+#else
+    const UnitArea lineBufArea( cs.area.chromaFormat, Area( 0, 0, pcv.maxCUWidth, pcv.maxCUHeight ) );
+#endif
+    PelStorage linePred;
+    PelStorage lineResi;
+    linePred.create( lineBufArea );
+    lineResi.create( lineBufArea );
+
+    CtuLineState lineState;
+    lineState.unitMutex = &unitMutex;
+    lineState.predBuf   = &linePred;
+    lineState.resiBuf   = &lineResi;
+    CodingStructure::setCtuLineState( &lineState );
+    try
+    {
+      decodeLines( jId, lineState );
+    }
+    catch( ... )
     {
-      int subPicX = (int)curSubPic.getSubPicLeft();
-      int subPicY = (int)curSubPic.getSubPicTop();
-      int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
       {
-        int n = slice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
+        std::lock_guard<std::mutex> lock( progressMutex );
+        if( !lineError )
         {
-          Picture *refPic = slice->getRefPic((RefPicList)rlist, idx);
-          if (refPic->getSubPicSaved())
-          {
-            refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(false);
-          }
+          lineError = std::current_exception();
         }
+        abortLines = true;
       }
+      progressCond.notify_all();
     }
+    CodingStructure::setCtuLineState( nullptr );
+  };
+
+  std::vector<std::thread> threads;
+  for( int jId = 1; jId < numThreads; jId++ )
+  {
+    threads.push_back( std::thread( runLines, jId ) );
+  }
+  runLines( 0 );
+  for( auto& thread : threads )
+  {
+    thread.join();
+  }
+  if( lineError )
+  {
+    std::rethrow_exception( lineError );
   }
 
-  // deallocate all created substreams, including internal buffers.
-  for( auto substr: ppcSubstreams )
+  if( padSubPic )
   {
-    delete substr;
+    for( int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++ )
+    {
+      for( int idx = 0; idx < slice->getNumRefIdx( (RefPicList) rlist ); idx++ )
+      {
+        Picture *refPic = slice->getRefPic( (RefPicList) rlist, idx );
+        if( refPic->getSubPicSaved() )
+        {
+          refPic->restoreSubPicBorder( refPic->getPOC(), curSubPic.getSubPicLeft(), curSubPic.getSubPicTop(), curSubPic.getSubPicWidthInLumaSample(), curSubPic.getSubPicHeightInLumaSample() );
+          refPic->setSubPicSaved( false );
+        }
+      }
+    }
   }
-  slice->stopProcessingTimer();
 }
 
 //! \}
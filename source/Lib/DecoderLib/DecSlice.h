@@ -47,6 +47,10 @@
 #include "DecCu.h"
 #include "CABACReader.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 //! \ingroup DecoderLib
 //! \{
 
@@ -54,13 +58,43 @@
 // Class definition
 // ====================================================================================================================
 
+/// counts the reconstructed CTUs of each CTU row of a picture, the loop filter wavefront follows the rows that are complete
+class CtuRowReconProgress
+{
+public:
+  CtuRowReconProgress() : m_widthInCtus( 0 ), m_numFinishedRows( -1 ), m_aborted( false ) {}
+
+  void reset       ();
+  void start       ( const int widthInCtus, const int heightInCtus );
+  void ctuFinished ( const int ctuRsAddr );
+  void abort       ();
+  bool waitForStart();                                  ///< returns false if the decoding of the slice has been aborted
+
+  // the row counts are read with the mutex held, the loop filter wavefront waits on the condition variable
+  int                      getNumFinishedRows() const { return m_numFinishedRows; }
+  bool                     isAborted         () const { return m_aborted; }
+  std::mutex&              getMutex          ()       { return m_mutex; }
+  std::condition_variable& getCond           ()       { return m_cond; }
+
+private:
+  std::vector<int>        m_numRowCtus;                 ///< reconstructed CTUs of each row
+  int                     m_widthInCtus;
+  int                     m_numFinishedRows;            ///< rows from the top that are reconstructed, -1 until the slice decoding has set up the picture
+  bool                    m_aborted;
+  std::mutex              m_mutex;
+  std::condition_variable m_cond;
+};
+
 /// slice decoder class
 class DecSlice
 {
 private:
   // access channel
-  CABACDecoder*   m_CABACDecoder;
-  DecCu*          m_pcCuDecoder;
+  CABACDecoder*   m_CABACDecoder;                       ///< one per CU decoding stack
+  DecCu*          m_pcCuDecoder;                        ///< one per CU decoding stack
+  int             m_numCuDecStacks;
+  bool            m_parseAhead;                         ///< parse the CTUs of a slice on a separate thread ahead of their reconstruction
+  CtuRowReconProgress* m_reconProgress;                 ///< reports the reconstructed CTUs to the loop filters running along, nullptr if they run afterwards
 
   Ctx             m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
   PLTBuf          m_palettePredictorSyncState;      /// palette predictor storage at wavefront/WPP
@@ -69,11 +103,17 @@ public:
   DecSlice();
   virtual ~DecSlice();
 
-  void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder );
+  void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder, const int numCuDecStacks = 1, const bool parseAhead = false );
   void  create            ();
   void  destroy           ();
 
   void  decompressSlice   ( Slice* slice, InputBitstream* bitstream, int debugCTU );
+  void  setReconProgress  ( CtuRowReconProgress* reconProgress ) { m_reconProgress = reconProgress; }
+
+private:
+  void  xReserveUnits               ( CodingStructure& cs ) const;
+  bool  xCanDecodeSubstreamsParallel( const Slice* slice, const unsigned numSubstreams ) const;
+  void  xDecodeSubstreamsParallel   ( Slice* slice, std::vector<InputBitstream*>& substreams );
 };
 
 //! \}
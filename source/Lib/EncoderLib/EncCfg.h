@@ -177,6 +177,7 @@ protected:
   bool      m_printMSSSIM;
   bool      m_printWPSNR;
   bool      m_cabacZeroWordPaddingEnabled;
+  bool      m_cabacInitPresent;                               ///< signal cabac_init_flag and pick the initialization table of a slice from the previous slice
 
   bool      m_gciPresentFlag;
   bool      m_onePictureOnlyConstraintFlag;
@@ -551,6 +552,13 @@ protected:
   bool      m_singleSlicePerSubPicFlag;
   bool      m_entropyCodingSyncEnabledFlag;
   bool      m_entryPointPresentFlag;                           ///< flag for the presence of entry points
+  int       m_numWppThreads;                                   ///< number of threads encoding CTU rows in parallel when entropy coding sync is enabled
+  int       m_numSplitThreads;                                 ///< number of threads evaluating sibling split modes of a CU in parallel
+  int       m_numFrameThreads;                                 ///< number of threads encoding pictures of a GOP in parallel
+  bool      m_lowMemoryMode;                                   ///< allocate auxiliary picture planes on demand and release the originals once a picture is encoded
+#if ENABLE_8BIT_REFERENCES
+  bool      m_use8bitRefPics;                                  ///< keep the finished pictures in 8-bit planes, which motion compensation and estimation read directly
+#endif
 
   HashType  m_decodedPictureHashSEIType;
   HashType  m_subpicDecodedPictureHashType;
@@ -1064,6 +1072,8 @@ public:
 
   bool      getCabacZeroWordPaddingEnabled()           const { return m_cabacZeroWordPaddingEnabled;  }
   void      setCabacZeroWordPaddingEnabled(bool value)       { m_cabacZeroWordPaddingEnabled = value; }
+  bool      getCabacInitPresent()                      const { return m_cabacInitPresent;             }
+  void      setCabacInitPresent(bool value)                  { m_cabacInitPresent = value;            }
 
   //====== Coding Structure ========
   void      setIntraPeriod                  (int   i)        { m_intraPeriod = i;                   }
@@ -1672,6 +1682,18 @@ public:
   void  setEntropyCodingSyncEnabledFlag(bool b)                      { m_entropyCodingSyncEnabledFlag = b; }
   bool  getEntropyCodingSyncEnabledFlag() const                      { return m_entropyCodingSyncEnabledFlag; }
   void  setEntryPointPresentFlag(bool b)                             { m_entryPointPresentFlag = b; }
+  void  setNumWppThreads(int i)                                      { m_numWppThreads = i; }
+  int   getNumWppThreads() const                                     { return m_numWppThreads; }
+  void  setNumSplitThreads(int i)                                    { m_numSplitThreads = i; }
+  int   getNumSplitThreads() const                                   { return m_numSplitThreads; }
+  void  setNumFrameThreads(int i)                                    { m_numFrameThreads = i; }
+  int   getNumFrameThreads() const                                   { return m_numFrameThreads; }
+  void  setLowMemoryMode(bool b)                                     { m_lowMemoryMode = b; }
+  bool  getLowMemoryMode() const                                     { return m_lowMemoryMode; }
+#if ENABLE_8BIT_REFERENCES
+  void  setUse8bitRefPics(bool b)                                    { m_use8bitRefPics = b; }
+  bool  getUse8bitRefPics() const                                    { return m_use8bitRefPics; }
+#endif
   void  setDecodedPictureHashSEIType(HashType m)                     { m_decodedPictureHashSEIType = m; }
   HashType getDecodedPictureHashSEIType() const                      { return m_decodedPictureHashSEIType; }
   void  setSubpicDecodedPictureHashType(HashType m)                  { m_subpicDecodedPictureHashType = m; }
@@ -52,6 +52,8 @@
 #include <stdio.h>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <exception>
 
 
 
@@ -140,6 +142,7 @@ void EncCu::create( EncCfg* encCfg )
   {
     m_acGeoWeightedBuffer[ui].create( chromaFormat, Area( 0, 0, uiMaxWidth, uiMaxHeight ) );
   }
+  xInitGeoSadMaskRanges();
 
   m_CtxBuffer.resize( maxDepth );
   m_CurrCtx = 0;
@@ -227,21 +230,23 @@ EncCu::~EncCu()
 
 /** \param    pcEncLib      pointer of encoder class
  */
-void EncCu::init( EncLib* pcEncLib, const SPS& sps )
+void EncCu::init( EncLib* pcEncLib, const SPS& sps, const int jId )
 {
   m_pcEncCfg           = pcEncLib;
-  m_pcIntraSearch      = pcEncLib->getIntraSearch();
-  m_pcInterSearch      = pcEncLib->getInterSearch();
-  m_pcTrQuant          = pcEncLib->getTrQuant();
-  m_pcRdCost           = pcEncLib->getRdCost ();
-  m_CABACEstimator     = pcEncLib->getCABACEncoder()->getCABACEstimator( &sps );
+  m_pcEncLib           = pcEncLib;
+  m_pcIntraSearch      = pcEncLib->getIntraSearch( jId );
+  m_pcInterSearch      = pcEncLib->getInterSearch( jId );
+  m_pcTrQuant          = pcEncLib->getTrQuant( jId );
+  m_pcRdCost           = pcEncLib->getRdCost ( jId );
+  m_CABACEstimator     = pcEncLib->getCABACEncoder( jId )->getCABACEstimator( &sps );
   m_CABACEstimator->setEncCu(this);
-  m_CtxCache           = pcEncLib->getCtxCache();
+  m_CtxCache           = pcEncLib->getCtxCache( jId );
   m_pcRateCtrl         = pcEncLib->getRateCtrl();
   m_pcSliceEncoder     = pcEncLib->getSliceEncoder();
   m_deblockingFilter   = pcEncLib->getDeblockingFilter();
   m_GeoCostList.init(GEO_NUM_PARTITION_MODE, m_pcEncCfg->getMaxNumGeoCand());
   m_AFFBestSATDCost = MAX_DOUBLE;
+  m_picCsMutex      = nullptr;
 
   DecCu::init( m_pcTrQuant, m_pcIntraSearch, m_pcInterSearch );
 
@@ -259,10 +264,17 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps )
 void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsigned ctuRsAddr, const int prevQP[], const int currQP[] )
 {
   m_modeCtrl->initCTUEncoding( *cs.slice );
-  cs.treeType = TREE_D;
 
-  cs.slice->m_mapPltCost[0].clear();
-  cs.slice->m_mapPltCost[1].clear();
+  for( int jobId = 1; jobId <= cs.picture->scheduler.getNumSplitJobs(); jobId++ )
+  {
+    m_pcEncLib->getCuEncoder( jobId )->m_modeCtrl->initCTUEncoding( *cs.slice );
+  }
+
+  if( m_pcEncCfg->getPLTMode() )
+  {
+    cs.slice->m_mapPltCost[0].clear();
+    cs.slice->m_mapPltCost[1].clear();
+  }
   // init the partitioning manager
   QTBTPartitioner partitioner;
   partitioner.initCtu(area, CH_L, *cs.slice);
@@ -296,19 +308,39 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
   CodingStructure *tempCS = m_pTempCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
   CodingStructure *bestCS = m_pBestCS[gp_sizeIdxInfo->idxFrom( area.lumaSize().width )][gp_sizeIdxInfo->idxFrom( area.lumaSize().height )];
 
-  cs.initSubStructure(*tempCS, partitioner.chType, partitioner.currArea(), false);
-  cs.initSubStructure(*bestCS, partitioner.chType, partitioner.currArea(), false);
+  {
+    std::unique_lock<std::mutex> picCsLock = xLockPicCs();
+    cs.treeType = TREE_D;
+    cs.initSubStructure(*tempCS, partitioner.chType, partitioner.currArea(), false);
+    cs.initSubStructure(*bestCS, partitioner.chType, partitioner.currArea(), false);
+  }
+  if( m_picCsMutex )
+  {
+    // the picture-level HMVP candidates belong to whichever CTU row was stored last
+    tempCS->motionLut = bestCS->motionLut = m_rowMotionLut;
+  }
   tempCS->currQP[CH_L] = bestCS->currQP[CH_L] =
   tempCS->baseQP       = bestCS->baseQP       = currQP[CH_L];
   tempCS->prevQP[CH_L] = bestCS->prevQP[CH_L] = prevQP[CH_L];
 
   xCompressCU(tempCS, bestCS, partitioner);
-  cs.slice->m_mapPltCost[0].clear();
-  cs.slice->m_mapPltCost[1].clear();
+  if( m_pcEncCfg->getPLTMode() )
+  {
+    cs.slice->m_mapPltCost[0].clear();
+    cs.slice->m_mapPltCost[1].clear();
+  }
   // all signals were already copied during compression if the CTU was split - at this point only the structures are copied to the top level CS
   const bool copyUnsplitCTUSignals = bestCS->cus.size() == 1;
-  cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType), copyUnsplitCTUSignals,
-                     false, false, copyUnsplitCTUSignals, true);
+  {
+    std::unique_lock<std::mutex> picCsLock = xLockPicCs();
+    xCheckPicUnitCapacity( cs, *bestCS );
+    cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType), copyUnsplitCTUSignals,
+                       false, false, copyUnsplitCTUSignals, true);
+  }
+  if( m_picCsMutex && ( !cs.slice->isIntra() || cs.slice->getSPS()->getIBCFlag() ) )
+  {
+    m_rowMotionLut = bestCS->motionLut;
+  }
 
   if (CS::isDualITree (cs) && isChromaEnabled (cs.pcv->chrFormat))
   {
@@ -316,8 +348,15 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
 
     partitioner.initCtu(area, CH_C, *cs.slice);
 
-    cs.initSubStructure(*tempCS, partitioner.chType, partitioner.currArea(), false);
-    cs.initSubStructure(*bestCS, partitioner.chType, partitioner.currArea(), false);
+    {
+      std::unique_lock<std::mutex> picCsLock = xLockPicCs();
+      cs.initSubStructure(*tempCS, partitioner.chType, partitioner.currArea(), false);
+      cs.initSubStructure(*bestCS, partitioner.chType, partitioner.currArea(), false);
+    }
+    if( m_picCsMutex )
+    {
+      tempCS->motionLut = bestCS->motionLut = m_rowMotionLut;
+    }
     tempCS->currQP[CH_C] = bestCS->currQP[CH_C] =
     tempCS->baseQP       = bestCS->baseQP       = currQP[CH_C];
     tempCS->prevQP[CH_C] = bestCS->prevQP[CH_C] = prevQP[CH_C];
@@ -325,6 +364,8 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
     xCompressCU(tempCS, bestCS, partitioner);
 
     const bool copyUnsplitCTUSignals = bestCS->cus.size() == 1;
+    std::unique_lock<std::mutex> picCsLock = xLockPicCs();
+    xCheckPicUnitCapacity( cs, *bestCS );
     cs.useSubStructure(*bestCS, partitioner.chType, CS::getArea(*bestCS, area, partitioner.chType),
                        copyUnsplitCTUSignals, false, false, copyUnsplitCTUSignals, true);
   }
@@ -343,12 +384,194 @@ void EncCu::compressCtu( CodingStructure& cs, const UnitArea& area, const unsign
   CHECK( bestCS->cus.empty()                                   , "No possible encoding found" );
   CHECK( bestCS->cus[0]->predMode == NUMBER_OF_PREDICTION_MODES, "No possible encoding found" );
   CHECK( bestCS->cost             == MAX_DOUBLE                , "No possible encoding found" );
+
+  // the units of the CTU have been copied to the picture, the next CTU allocates its units from the start of the caches again
+  xResetUnitCache();
+  for( int jobId = 1; jobId <= cs.picture->scheduler.getNumSplitJobs(); jobId++ )
+  {
+    m_pcEncLib->getCuEncoder( jobId )->xResetUnitCache();
+  }
 }
 
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
 
+void EncCu::xResetUnitCache()
+{
+  for( unsigned w = 0; w < gp_sizeIdxInfo->numWidths(); w++ )
+  {
+    for( unsigned h = 0; h < gp_sizeIdxInfo->numHeights(); h++ )
+    {
+      if( m_pTempCS[w][h] )
+      {
+        m_pTempCS [w][h]->clearUnits();
+        m_pBestCS [w][h]->clearUnits();
+        m_pTempCS2[w][h]->clearUnits();
+        m_pBestCS2[w][h]->clearUnits();
+      }
+    }
+  }
+
+  m_unitCache.cuCache.reset();
+  m_unitCache.puCache.reset();
+  m_unitCache.tuCache.reset();
+
+  m_pcIntraSearch->resetUnitCache();
+}
+
+void EncCu::xCopySplitJobNeighbours( Picture& picture, const Area& area, const int jobId )
+{
+  // four lines cover the multiple reference lines of the intra prediction and the luma taps of the cross-component prediction
+  const int margin = 4;
+
+  auto copyBand = [&]( int x0, int y0, int x1, int y1 )
+  {
+    x0 = std::max( x0, 0 );
+    y0 = std::max( y0, 0 );
+    x1 = std::min( x1, int( picture.lwidth() ) );
+    y1 = std::min( y1, int( picture.lheight() ) );
+    if( x0 < x1 && y0 < y1 )
+    {
+      picture.copySplitRecoBuf( UnitArea( picture.chromaFormat, Area( x0, y0, x1 - x0, y1 - y0 ) ), jobId );
+    }
+  };
+
+  copyBand( area.x - margin, area.y - margin, area.x + 2 * area.width + margin, area.y );
+  copyBand( area.x - margin, area.y, area.x, area.y + 2 * area.height + margin );
+}
+
+void EncCu::xCompressCUParallel( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& partitioner, const PartSplit jobs[], const int numJobs, const double maxCostAllowed )
+{
+  Picture*             picture  = tempCS->picture;
+  const PreCalcValues& pcv      = *tempCS->pcv;
+  const UnitArea&      currArea = partitioner.currArea();
+  const ChannelType    chType   = partitioner.chType;
+  const unsigned       wIdx     = gp_sizeIdxInfo->idxFrom( currArea.lwidth () );
+  const unsigned       hIdx     = gp_sizeIdxInfo->idxFrom( currArea.lheight() );
+  const int            vpduSize = std::min<int>( pcv.maxCUWidth, 64 );
+  const Area           vpduArea ( currArea.lx() & ~( vpduSize - 1 ), currArea.ly() & ~( vpduSize - 1 ), vpduSize, vpduSize );
+
+  CHECK( numJobs > picture->scheduler.getNumSplitJobs(), "Not enough split job buffers" );
+
+  double lambdas[MAX_NUM_COMPONENT];
+  m_pcTrQuant->getLambdas( lambdas );
+
+  EncCu*           jobCu    [PARL_SPLIT_MAX_NUM_JOBS];
+  CodingStructure* jobTempCS[PARL_SPLIT_MAX_NUM_JOBS];
+  CodingStructure* jobBestCS[PARL_SPLIT_MAX_NUM_JOBS];
+  QTBTPartitioner  jobPartitioner[PARL_SPLIT_MAX_NUM_JOBS];
+
+  // hand the current encoder state over to the job stacks, job k is processed by stack k + 1
+  for( int k = 0; k < numJobs; k++ )
+  {
+    const int jobId = k + 1;
+    EncCu*    cu    = jobCu[k] = m_pcEncLib->getCuEncoder( jobId );
+
+    xCopySplitJobNeighbours( *picture, currArea.Y(), jobId );
+    if( currArea.lwidth() < vpduSize || currArea.lheight() < vpduSize )
+    {
+      // the chroma residual scaling averages the luma neighbours of the whole VPDU
+      xCopySplitJobNeighbours( *picture, vpduArea, jobId );
+    }
+    if( isChroma( chType ) )
+    {
+      // the cross-component prediction of a separate chroma tree reads the final luma of the area
+      picture->copySplitRecoBuf( clipArea( currArea, *picture ), jobId );
+    }
+
+    jobTempCS[k] = cu->m_pTempCS[wIdx][hIdx];
+    jobBestCS[k] = cu->m_pBestCS[wIdx][hIdx];
+    tempCS->initSubStructure( *jobTempCS[k], chType, currArea, false );
+    tempCS->initSubStructure( *jobBestCS[k], chType, currArea, false );
+    jobTempCS[k]->bestParent = jobBestCS[k]->bestParent = tempCS->bestParent;
+
+    jobPartitioner[k].copyState( partitioner );
+
+    cu->m_modeCtrl->copyState( *m_modeCtrl, currArea.Y() );
+    cu->m_modeCtrl->setParallelSplitJob( jobs[k] );
+    cu->m_pcInterSearch->copyState( *m_pcInterSearch );
+    cu->m_pcIntraSearch->setSaveCuCostInSCIPU( false );
+    *cu->m_pcRdCost = *m_pcRdCost;
+    cu->m_pcTrQuant->setLambdas( lambdas );
+    cu->m_CABACEstimator->getCtx() = m_CABACEstimator->getCtx();
+    cu->m_CurrCtx                  = cu->m_CtxBuffer.data();
+    cu->m_cuChromaQpOffsetIdxPlus1 = m_cuChromaQpOffsetIdxPlus1;
+  }
+
+  std::atomic<int>   nextJob( 0 );
+  std::mutex         jobErrorMutex;
+  std::exception_ptr jobError;
+
+  auto processJobs = [&]()
+  {
+    for( int k = nextJob++; k < numJobs; k = nextJob++ )
+    {
+      Scheduler::setSplitJobId( k + 1 );
+      try
+      {
+        jobCu[k]->xCompressCU( jobTempCS[k], jobBestCS[k], jobPartitioner[k], maxCostAllowed );
+      }
+      catch( ... )
+      {
+        std::lock_guard<std::mutex> lock( jobErrorMutex );
+        if( !jobError )
+        {
+          jobError = std::current_exception();
+        }
+      }
+    }
+    Scheduler::setSplitJobId( 0 );
+  };
+
+  m_pcEncLib->getSplitThreadPool()->run( processJobs, std::min( m_pcEncCfg->getNumSplitThreads(), numJobs ) );
+  if( jobError )
+  {
+    std::rethrow_exception( jobError );
+  }
+
+  // pick the cheapest job, ties are resolved in job order to stay independent of the thread timing
+  int bestJob = -1;
+  for( int k = 0; k < numJobs; k++ )
+  {
+    if( jobBestCS[k]->cost != MAX_DOUBLE && !jobBestCS[k]->cus.empty() && ( bestJob < 0 || jobBestCS[k]->cost < jobBestCS[bestJob]->cost ) )
+    {
+      bestJob = k;
+    }
+  }
+
+  if( bestJob >= 0 )
+  {
+    EncCu*           cu    = jobCu[bestJob];
+    CodingStructure* jobCS = jobBestCS[bestJob];
+
+    bestCS->useSubStructure( *jobCS, chType, CS::getArea( *bestCS, bestCS->area, chType ), true, true, KEEP_PRED_AND_RESI_SIGNALS, KEEP_PRED_AND_RESI_SIGNALS, false );
+    bestCS->cost          = jobCS->cost;
+    bestCS->fracBits      = jobCS->fracBits;
+    bestCS->dist          = jobCS->dist;
+    bestCS->lumaCost      = jobCS->lumaCost;
+    bestCS->costDbOffset  = jobCS->costDbOffset;
+    bestCS->useDbCost     = jobCS->useDbCost;
+    bestCS->interHad      = jobCS->interHad;
+    bestCS->features      = jobCS->features;
+    bestCS->prevPLT       = jobCS->prevPLT;
+    bestCS->prevQP[chType] = jobCS->prevQP[chType];
+    bestCS->currQP[chType] = jobCS->currQP[chType];
+
+    m_CABACEstimator->getCtx() = cu->m_CABACEstimator->getCtx();
+    m_modeCtrl->copyState( *cu->m_modeCtrl, currArea.Y() );
+    m_pcInterSearch->copyState( *cu->m_pcInterSearch );
+  }
+
+  for( int k = 0; k < numJobs; k++ )
+  {
+    jobCu[k]->m_modeCtrl->resetParallelSplitJob();
+    jobCu[k]->m_CurrCtx = 0;
+    jobTempCS[k]->releaseIntermediateData();
+    jobBestCS[k]->releaseIntermediateData();
+  }
+}
+
 static int xCalcHADs8x8_ISlice(const Pel *piOrg, const int iStrideOrg)
 {
   int k, i, j, jj;
@@ -554,6 +777,21 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
   const ChannelType chTypeParent = partitioner.chType;
   const UnitArea currCsArea = clipArea( CS::getArea( *bestCS, bestCS->area, partitioner.chType ), *tempCS->picture );
 
+  // evaluate the split modes of the first CU offering a choice in parallel, each on its own CU encoder stack
+  if( tempCS->picture->scheduler.getNumSplitJobs() > 0 && Scheduler::getSplitJobId() == 0
+    && partitioner.getImplicitSplit( *tempCS ) == CU_DONT_SPLIT && partitioner.modeType == MODE_TYPE_ALL
+    && !m_pcIntraSearch->getSaveCuCostInSCIPU() && !( pps.getUseDQP() && partitioner.currQgEnable() ) )
+  {
+    PartSplit jobs[PARL_SPLIT_MAX_NUM_JOBS];
+    const int numJobs = m_modeCtrl->getParallelSplitJobs( *tempCS, partitioner, jobs );
+
+    if( numJobs > 1 )
+    {
+      xCompressCUParallel( tempCS, bestCS, partitioner, jobs, numJobs, maxCostAllowed );
+      return;
+    }
+  }
+
   m_modeCtrl->initCULevel( partitioner, *tempCS );
 #if GDR_ENABLED
   if (m_pcEncCfg->getGdrEnabled())
@@ -918,7 +1156,7 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
 #if GDR_ENABLED
       if (bestCS->cus.size() > 0 && splitmode != bestCS->cus[0]->splitSeries)
 #else
-      if (splitmode != bestCS->cus[0]->splitSeries)
+      if (!bestCS->cus.empty() && splitmode != bestCS->cus[0]->splitSeries)
 #endif
       {
         splitmode = bestCS->cus[0]->splitSeries;
@@ -1320,9 +1558,14 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       }
     }
     assert( tempCS->treeType == TREE_L );
-    uint32_t numCuPuTu[6];
-    tempCS->picture->cs->getNumCuPuTuOffset( numCuPuTu );
-    tempCS->picture->cs->useSubStructure( *tempCS, partitioner.chType, CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType ), false, true, false, false, false );
+    // the chroma search finds the collocated luma units in tempCS, the picture-level structure shared with the other CTU rows
+    // only gets the decomposition of the area; the luma reconstruction goes to the picture for the cross-component prediction
+    const UnitArea lumaArea = clipArea( CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType ), *tempCS->picture );
+    {
+      std::unique_lock<std::mutex> picCsLock = xLockPicCs();
+      tempCS->picture->cs->setDecomp( lumaArea );
+    }
+    tempCS->picture->getRecoBuf( lumaArea ).copyFrom( tempCS->getRecoBuf( lumaArea ) );
 
     if (isChromaEnabled(tempCS->pcv->chrFormat))
     {
@@ -1337,6 +1580,7 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       CodingStructure *bestCSChroma = m_pBestCS2[wIdx][hIdx];
       tempCS->initSubStructure(*tempCSChroma, partitioner.chType, partitioner.currArea(), false);
       tempCS->initSubStructure(*bestCSChroma, partitioner.chType, partitioner.currArea(), false);
+      tempCSChroma->lumaCS = bestCSChroma->lumaCS = tempCS;
       tempCS->treeType = TREE_D;
       xCompressCU(tempCSChroma, bestCSChroma, partitioner);
 
@@ -1354,7 +1598,6 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       // tempCS->picture->cs->releaseIntermediateData();
       m_CurrCtx--;
     }
-    tempCS->picture->cs->clearCuPuTuIdxMap( partitioner.currArea(), numCuPuTu[0], numCuPuTu[1], numCuPuTu[2], numCuPuTu + 3 );
 
 
     //recover luma tree status
@@ -2839,6 +3082,73 @@ void EncCu::xCheckRDCostMerge2Nx2N( CodingStructure *&tempCS, CodingStructure *&
   }
 }
 
+static const Pel* getGeoEncSADmask( const int splitDir, const int hIdx, const int wIdx, const int width, int& maskStride, int& maskStride2, int& stepX )
+{
+  const int16_t  angle  = g_GeoParams[splitDir][0];
+  const int16_t* offset = g_weightOffset[splitDir][hIdx][wIdx];
+  stepX = 1;
+  if (g_angle2mirror[angle] == 2)
+  {
+    maskStride = -GEO_WEIGHT_MASK_SIZE;
+    maskStride2 = -width;
+    return &g_globalGeoEncSADmask[g_angle2mask[angle]][(GEO_WEIGHT_MASK_SIZE - 1 - offset[1]) * GEO_WEIGHT_MASK_SIZE + offset[0]];
+  }
+  else if (g_angle2mirror[angle] == 1)
+  {
+    stepX = -1;
+    maskStride2 = width;
+    maskStride = GEO_WEIGHT_MASK_SIZE;
+    return &g_globalGeoEncSADmask[g_angle2mask[angle]][offset[1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - offset[0])];
+  }
+  else
+  {
+    maskStride = GEO_WEIGHT_MASK_SIZE;
+    maskStride2 = -width;
+    return &g_globalGeoEncSADmask[g_angle2mask[angle]][offset[1] * GEO_WEIGHT_MASK_SIZE + offset[0]];
+  }
+}
+
+void EncCu::xInitGeoSadMaskRanges()
+{
+  // the binary SAD masks are split by a straight line, thus each of their rows is one run of ones. The masked
+  // SAD of a split direction is the sum of the row sums over these runs, which are read from prefix sums.
+  for (int hIdx = 0; hIdx < GEO_NUM_CU_SIZE; hIdx++)
+  {
+    const int height = 1 << (hIdx + GEO_MIN_CU_LOG2);
+    for (int wIdx = 0; wIdx < GEO_NUM_CU_SIZE; wIdx++)
+    {
+      const int width = 1 << (wIdx + GEO_MIN_CU_LOG2);
+      for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
+      {
+        int maskStride, maskStride2, stepX;
+        const Pel* mask    = getGeoEncSADmask(splitDir, hIdx, wIdx, width, maskStride, maskStride2, stepX);
+        bool&      isRange = m_geoSadMaskIsRange[hIdx][wIdx][splitDir];
+        isRange = true;
+        for (int y = 0; y < height; y++)
+        {
+          int start = 0, end = 0, numOnes = 0;
+          for (int x = 0; x < width; x++)
+          {
+            if (*mask)
+            {
+              start = numOnes ? start : x;
+              end   = x + 1;
+              numOnes++;
+            }
+            isRange &= *mask == 0 || *mask == 1;
+            mask += stepX;
+          }
+          isRange &= end - start == numOnes;
+          m_geoSadMaskRange[hIdx][wIdx][splitDir][y][0] = start;
+          m_geoSadMaskRange[hIdx][wIdx][splitDir][y][1] = end;
+          mask += maskStride;
+          mask += maskStride2;
+        }
+      }
+    }
+  }
+}
+
 void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode)
 {
   const Slice &slice = *tempCS->slice;
@@ -2989,42 +3299,56 @@ void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure
 
   int wIdx = floorLog2(cu.lwidth()) - GEO_MIN_CU_LOG2;
   int hIdx = floorLog2(cu.lheight()) - GEO_MIN_CU_LOG2;
+  const int geoWidth  = cu.lwidth();
+  const int geoHeight = cu.lheight();
+  for (uint8_t mergeCand = 0; mergeCand < maxNumMergeCandidates; mergeCand++)
+  {
+    const CPelBuf org    = tempCS->getOrgBuf().Y();
+    const CPelBuf cur    = geoTempBuf[mergeCand].Y();
+    int*          rowSum = m_geoRowAbsDiffSum[mergeCand];
+    for (int y = 0; y < geoHeight; y++, rowSum += geoWidth + 1)
+    {
+      const Pel* orgRow = org.bufAt(0, y);
+      const Pel* curRow = cur.bufAt(0, y);
+      rowSum[0] = 0;
+      for (int x = 0; x < geoWidth; x++)
+      {
+        rowSum[x + 1] = rowSum[x] + abs(orgRow[x] - curRow[x]);
+      }
+    }
+  }
+  const uint32_t geoDistShift = DISTORTION_PRECISION_ADJUSTMENT(sps.getBitDepth(CHANNEL_TYPE_LUMA));
   for (int splitDir = 0; splitDir < GEO_NUM_PARTITION_MODE; splitDir++)
   {
+    const uint8_t (*maskRange)[2] = m_geoSadMaskRange[hIdx][wIdx][splitDir];
+    const bool     useMaskRange   = m_geoSadMaskIsRange[hIdx][wIdx][splitDir];
     int maskStride = 0, maskStride2 = 0;
     int stepX = 1;
-    Pel* SADmask;
-    int16_t angle = g_GeoParams[splitDir][0];
-    if (g_angle2mirror[angle] == 2)
-    {
-      maskStride = -GEO_WEIGHT_MASK_SIZE;
-      maskStride2 = -(int)cu.lwidth();
-      SADmask = &g_globalGeoEncSADmask[g_angle2mask[g_GeoParams[splitDir][0]]][(GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][1]) * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
-    else if (g_angle2mirror[angle] == 1)
-    {
-      stepX = -1;
-      maskStride2 = cu.lwidth();
-      maskStride = GEO_WEIGHT_MASK_SIZE;
-      SADmask = &g_globalGeoEncSADmask[g_angle2mask[g_GeoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + (GEO_WEIGHT_MASK_SIZE - 1 - g_weightOffset[splitDir][hIdx][wIdx][0])];
-    }
-    else
-    {
-      maskStride = GEO_WEIGHT_MASK_SIZE;
-      maskStride2 = -(int)cu.lwidth();
-      SADmask = &g_globalGeoEncSADmask[g_angle2mask[g_GeoParams[splitDir][0]]][g_weightOffset[splitDir][hIdx][wIdx][1] * GEO_WEIGHT_MASK_SIZE + g_weightOffset[splitDir][hIdx][wIdx][0]];
-    }
+    const Pel* SADmask = getGeoEncSADmask(splitDir, hIdx, wIdx, geoWidth, maskStride, maskStride2, stepX);
     Distortion sadSmall = 0, sadLarge = 0;
     for (uint8_t mergeCand = 0; mergeCand < maxNumMergeCandidates; mergeCand++)
     {
       int bitsCand = mergeCand + 1;
+      if (useMaskRange)
+      {
+        const int* rowSum = m_geoRowAbsDiffSum[mergeCand];
+        sadLarge = 0;
+        for (int y = 0; y < geoHeight; y++, rowSum += geoWidth + 1)
+        {
+          sadLarge += rowSum[maskRange[y][1]] - rowSum[maskRange[y][0]];
+        }
+        sadLarge >>= geoDistShift;
+      }
+      else
+      {
+        m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, SADmask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
+        sadLarge = distParam.distFunc(distParam);
+      }
 #if GDR_ENABLED
       if (isEncodeGdrClean)
       {
         double cost0, cost1;
 
-        m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, SADmask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
-        sadLarge = distParam.distFunc(distParam);
         sadSmall = sadWholeBlk[mergeCand] - sadLarge;
 
         if (MrgSolid[mergeCand] && MrgValid[mergeCand])
@@ -3043,15 +3367,11 @@ void EncCu::xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure
       }
       else
       {
-        m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, SADmask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
-        sadLarge = distParam.distFunc(distParam);
         m_GeoCostList.insert(splitDir, 0, mergeCand, (double)sadLarge + (double)bitsCand * sqrtLambdaForFirstPass);
         sadSmall = sadWholeBlk[mergeCand] - sadLarge;
         m_GeoCostList.insert(splitDir, 1, mergeCand, (double)sadSmall + (double)bitsCand * sqrtLambdaForFirstPass);
       }
 #else
-      m_pcRdCost->setDistParam(distParam, tempCS->getOrgBuf().Y(), geoTempBuf[mergeCand].Y().buf, geoTempBuf[mergeCand].Y().stride, SADmask, maskStride, stepX, maskStride2, sps.getBitDepth(CHANNEL_TYPE_LUMA), COMPONENT_Y);
-      sadLarge = distParam.distFunc(distParam);
       m_GeoCostList.insert(splitDir, 0, mergeCand, (double)sadLarge + (double)bitsCand * sqrtLambdaForFirstPass);
       sadSmall = sadWholeBlk[mergeCand] - sadLarge;
       m_GeoCostList.insert(splitDir, 1, mergeCand, (double)sadSmall + (double)bitsCand * sqrtLambdaForFirstPass);
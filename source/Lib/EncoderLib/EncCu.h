@@ -55,6 +55,8 @@
 #include "InterSearch.h"
 #include "RateCtrl.h"
 #include "EncModeCtrl.h"
+
+#include <mutex>
 //! \ingroup EncoderLib
 //! \{
 
@@ -174,6 +176,7 @@ private:
   CodingStructure    ***m_pBestCS2;
   //  Access channel
   EncCfg*               m_pcEncCfg;
+  EncLib*               m_pcEncLib;
   IntraSearch*          m_pcIntraSearch;
   InterSearch*          m_pcInterSearch;
   TrQuant*              m_pcTrQuant;
@@ -186,6 +189,9 @@ private:
   IbcHashMap            m_ibcHashMap;
   EncModeCtrl          *m_modeCtrl;
 
+  std::mutex*           m_picCsMutex;           ///< guards the picture-level coding structure while CTU rows or split jobs are encoded in parallel
+  LutMotionCand         m_rowMotionLut;         ///< HMVP candidates of the CTU row, used instead of the picture-level ones in parallel mode
+
   PelStorage            m_acMergeBuffer[MMVD_MRG_MAX_RD_BUF_NUM];
   PelStorage            m_acRealMergeBuffer[MRG_MAX_NUM_CANDS];
   PelStorage            m_acMergeTmpBuffer[MRG_MAX_NUM_CANDS];
@@ -200,6 +206,9 @@ private:
   int                   m_bestBcwIdx[2];
   double                m_bestBcwCost[2];
   GeoMotionInfo         m_GeoModeTest[GEO_MAX_NUM_CANDS];
+  uint8_t               m_geoSadMaskRange[GEO_NUM_CU_SIZE][GEO_NUM_CU_SIZE][GEO_NUM_PARTITION_MODE][GEO_MAX_CU_SIZE][2]; // per row the first column and the column after the last one of the weighted SAD mask
+  bool                  m_geoSadMaskIsRange[GEO_NUM_CU_SIZE][GEO_NUM_CU_SIZE][GEO_NUM_PARTITION_MODE];
+  int                   m_geoRowAbsDiffSum[GEO_MAX_NUM_UNI_CANDS][GEO_MAX_CU_SIZE * ( GEO_MAX_CU_SIZE + 1 )]; // per row the prefix sums of the absolute differences
 #if SHARP_LUMA_DELTA_QP || ENABLE_QPA_SUB_CTU
   void    updateLambda      ( Slice* slice, const int dQP,
  #if WCG_EXT && ER_CHROMA_QP_WCG_PPS
@@ -208,9 +217,17 @@ private:
                               const bool updateRdCostLambda );
 #endif
   double                m_sbtCostSave[2];
+
+  std::unique_lock<std::mutex> xLockPicCs() { return m_picCsMutex ? std::unique_lock<std::mutex>( *m_picCsMutex ) : std::unique_lock<std::mutex>(); }
+  // the unit vectors of the picture are reserved before CTU rows are encoded in parallel, the other rows read them without the lock
+  void xCheckPicUnitCapacity( const CodingStructure& picCs, const CodingStructure& subCS ) const
+  {
+    CHECK( m_picCsMutex && ( picCs.cus.size() + subCS.cus.size() > picCs.cus.capacity() || picCs.pus.size() + subCS.pus.size() > picCs.pus.capacity()
+                             || picCs.tus.size() + subCS.tus.size() > picCs.tus.capacity() ), "Unit storage of the picture must not be reallocated while CTU rows are encoded in parallel" );
+  }
 public:
   /// copy parameters from encoder class
-  void  init                ( EncLib* pcEncLib, const SPS& sps );
+  void  init                ( EncLib* pcEncLib, const SPS& sps, const int jId = 0 );
 
   void setDecCuReshaperInEncCU(EncReshape* pcReshape, ChromaFormat chromaFormatIDC) { initDecCuReshaper((Reshape*) pcReshape, chromaFormatIDC); }
   /// create internal buffers
@@ -226,6 +243,10 @@ public:
 
   EncModeCtrl* getModeCtrl  () { return m_modeCtrl; }
 
+  /// enable (mutex != nullptr) or disable encoding of CTU rows or split jobs in parallel with other CU encoders
+  void  setPicCsMutex       ( std::mutex* picCsMutex ) { m_picCsMutex = picCsMutex; }
+  void  resetRowMotionLut   () { m_rowMotionLut.lut.resize( 0 ); m_rowMotionLut.lutIbc.resize( 0 ); }
+
 
   void   setMergeBestSATDCost(double cost) { m_mergeBestSATDCost = cost; }
   double getMergeBestSATDCost()            { return m_mergeBestSATDCost; }
@@ -243,6 +264,9 @@ protected:
   Distortion getDistortionDb  ( CodingStructure &cs, CPelBuf org, CPelBuf reco, ComponentID compID, const CompArea& compArea, bool afterDb );
 
   void xCompressCU            ( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& pm, double maxCostAllowed = MAX_DOUBLE );
+  void xResetUnitCache        ();
+  void xCopySplitJobNeighbours( Picture& picture, const Area& area, const int jobId );
+  void xCompressCUParallel    ( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& pm, const PartSplit jobs[], const int numJobs, const double maxCostAllowed );
 
   bool
     xCheckBestMode         ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestmode );
@@ -263,6 +287,7 @@ protected:
 
   void xCheckRDCostMerge2Nx2N ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode );
 
+  void xInitGeoSadMaskRanges();
   void xCheckRDCostMergeGeo2Nx2N(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode);
 
   void xEncodeInterResidual(   CodingStructure *&tempCS
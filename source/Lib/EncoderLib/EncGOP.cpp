@@ -67,6 +67,9 @@ using namespace std;
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
+thread_local EncSlice*   EncGOP::m_pcSliceEncoder = nullptr;
+thread_local EncReshape* EncGOP::m_pcReshaper     = nullptr;
+
 int getLSB(int poc, int maxLSB)
 {
   if (poc >= 0)
@@ -253,6 +256,7 @@ void EncGOP::init ( EncLib* pcEncLib )
   pcEncLib->getALF()->setAlfWSSD(alfWSSD);
 #endif
   m_pcReshaper = pcEncLib->getReshaper();
+  m_reshaperCarry = *m_pcReshaper;
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
   const bool calculateHdrMetrics = m_pcEncLib->getCalcluateHdrMetrics();
@@ -2096,6 +2100,129 @@ void EncGOP::xPicInitLMCS(Picture *pic, PicHeader *picHeader, Slice *slice)
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
+
+void EncGOP::PicStages::start( const int numPics )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_active      = true;
+  m_aborted     = false;
+  m_busy        = false;
+  m_numSetUp    = 0;
+  m_numFinished = 0;
+  m_stage.assign( numPics, STAGE_WAITING );
+  m_poc  .assign( numPics, NOT_VALID );
+}
+
+void EncGOP::PicStages::stop()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  CHECK( !m_aborted && m_numFinished != int( m_stage.size() ), "Not all pictures of the GOP have been finished" );
+  m_active = false;
+}
+
+void EncGOP::PicStages::abort()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_aborted = true;
+  }
+  m_cond.notify_all();
+}
+
+void EncGOP::PicStages::beginSetUp( const int picId )
+{
+  if( !m_active )
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [&]{ return m_aborted || ( m_numSetUp == picId && !m_busy ); } );
+  CHECK( m_aborted, "The compression of the GOP has been aborted by another thread" );
+  m_busy         = true;
+  m_stage[picId] = STAGE_SET_UP;
+}
+
+void EncGOP::PicStages::endSetUp( const int picId, const int poc )
+{
+  if( !m_active )
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lock( m_mutex );
+  CHECK( m_stage[picId] != STAGE_SET_UP, "Picture is not in its set-up" );
+  m_poc  [picId] = poc;
+  m_stage[picId] = STAGE_COMPRESS;
+  m_busy         = false;
+  m_numSetUp++;
+  m_cond.notify_all();
+}
+
+bool EncGOP::PicStages::xIsInFlight( const int poc ) const
+{
+  for( int picId = 0; picId < m_numSetUp; picId++ )
+  {
+    if( m_poc[picId] == poc && m_stage[picId] != STAGE_DONE )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::chrono::steady_clock::duration EncGOP::PicStages::waitForRefs( const Slice& slice )
+{
+  const auto startTime = std::chrono::steady_clock::now();
+  if( !m_active )
+  {
+    return std::chrono::steady_clock::duration::zero();
+  }
+  std::unique_lock<std::mutex> lock( m_mutex );
+  for( const RefPicList refList : { REF_PIC_LIST_0, REF_PIC_LIST_1 } )
+  {
+    for( int refIdx = 0; refIdx < slice.getNumRefIdx( refList ); refIdx++ )
+    {
+      const int refPoc = slice.getRefPic( refList, refIdx )->getPOC();
+      m_cond.wait( lock, [&]{ return m_aborted || !xIsInFlight( refPoc ); } );
+      CHECK( m_aborted, "The compression of the GOP has been aborted by another thread" );
+    }
+  }
+  return std::chrono::steady_clock::now() - startTime;
+}
+
+std::chrono::steady_clock::duration EncGOP::PicStages::beginFinish( const int picId )
+{
+  const auto startTime = std::chrono::steady_clock::now();
+  if( !m_active || m_stage[picId] == STAGE_FINISH )
+  {
+    return std::chrono::steady_clock::duration::zero();
+  }
+  if( m_stage[picId] == STAGE_SET_UP )
+  {
+    // a picture skipped right in its set-up
+    endSetUp( picId, NOT_VALID );
+  }
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [&]{ return m_aborted || ( m_numFinished == picId && !m_busy ); } );
+  CHECK( m_aborted, "The compression of the GOP has been aborted by another thread" );
+  m_busy         = true;
+  m_stage[picId] = STAGE_FINISH;
+  return std::chrono::steady_clock::now() - startTime;
+}
+
+void EncGOP::PicStages::endFinish( const int picId )
+{
+  if( !m_active )
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lock( m_mutex );
+  CHECK( m_stage[picId] != STAGE_FINISH, "Picture is not in its finishing stage" );
+  m_stage[picId] = STAGE_DONE;
+  m_busy         = false;
+  m_numFinished++;
+  m_cond.notify_all();
+}
+
 void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
                           std::list<PelUnitBuf*>& rcListPicYuvRecOut,
                           bool isField, bool isTff, const InputColourSpaceConversion snr_conversion,
@@ -2111,9 +2238,18 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
   AccessUnit::iterator  itLocationToPushSliceHeaderNALU; // used to store location where NALU containing slice header is to be inserted
   Picture* scaledRefPic[MAX_NUM_REF] = {};
 
+  // the slice encoder and the reshaper of the picture encoding context of this thread
+  m_pcSliceEncoder = m_pcEncLib->getSliceEncoder();
+  m_pcReshaper     = m_pcEncLib->getReshaper();
+
+  m_picStages.beginSetUp( picIdInGOP );
+  if( m_pcCfg->getNumFrameThreads() > 1 && m_pcCfg->getLmcs() )
+  {
+    *m_pcReshaper = m_reshaperCarry;
+  }
+
   xInitGOP( iPOCLast, iNumPicRcvd, isField, isEncodeLtRef );
 
-  m_iNumPicCoded = 0;
   SEIMessages leadingSeiMessages;
   SEIMessages nestedSeiMessages;
   SEIMessages duInfoSeiMessages;
@@ -2144,6 +2280,8 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
     //-- For time output for each slice
     auto beforeTime = std::chrono::steady_clock::now();
+    // time spent waiting for the reference pictures and for the turn to finish, not counted as encoding time
+    auto picWaitTime = std::chrono::steady_clock::duration::zero();
 
 #if !X0038_LAMBDA_FROM_QP_CAPABILITY
     uint32_t uiColDir = calculateCollocatedFromL1Flag(m_pcCfg, iGOPid, m_iGopSize);
@@ -2181,6 +2319,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       {
         iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
       }
+      m_picStages.beginFinish( picIdInGOP );
       continue;
     }
 
@@ -2226,6 +2365,12 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
     m_pcSliceEncoder->create( picWidth, picHeight, chromaFormatIDC, maxCUWidth, maxCUHeight, maxTotalCUDepth );
 
+#if ENABLE_8BIT_REFERENCES
+    if( m_pcCfg->getUse8bitRefPics() )
+    {
+      pcPic->createRecoBuffers();
+    }
+#endif
     pcPic->createTempBuffers( pcPic->cs->pps->pcv->maxCUWidth );
     pcPic->cs->createCoeffs((bool)pcPic->cs->sps->getPLTMode());
 
@@ -3038,6 +3183,21 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     }
 #endif
 
+    // the set-up of the picture is complete, the next picture may start its own while this one compresses,
+    // later set-ups may mark this picture as unused for reference before it is finished
+    const bool isReferenced = pcPic->referenced;
+    if( m_pcCfg->getNumFrameThreads() > 1 && m_pcCfg->getLmcs() )
+    {
+      m_reshaperCarry = *m_pcReshaper;
+    }
+    if( m_picStages.isActive() )
+    {
+      // the picture extends its own border once finished, the set-ups of the pictures referencing it must not
+      pcPic->setBorderExtension( true );
+    }
+    m_picStages.endSetUp( picIdInGOP, pocCurr );
+    picWaitTime += m_picStages.waitForRefs( *pcSlice );
+
     if( encPic )
     // now compress (trial encode) the various slice segments (slices, and dependent slices)
     {
@@ -3160,12 +3320,18 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         if( pcSlice->getSliceType() != I_SLICE && pcSlice->getRefPic( REF_PIC_LIST_0, 0 )->subPictures.size() > 1 )
         {
           clipMv = clipMvInSubpic;
-          m_pcEncLib->getInterSearch()->setClipMvInSubPic(true);
+          for( int jId = 0; jId < m_pcEncLib->getNumCuEncStacks(); jId++ )
+          {
+            m_pcEncLib->getInterSearch( jId )->setClipMvInSubPic(true);
+          }
         }
         else
         {
           clipMv = clipMvInPic;
-          m_pcEncLib->getInterSearch()->setClipMvInSubPic(false);
+          for( int jId = 0; jId < m_pcEncLib->getNumCuEncStacks(); jId++ )
+          {
+            m_pcEncLib->getInterSearch( jId )->setClipMvInSubPic(false);
+          }
         }
 
         m_pcSliceEncoder->precompressSlice( pcPic );
@@ -3187,6 +3353,10 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         }
       }
 
+      // loop filters, writing and analysis of the pictures run in coding order
+      picWaitTime += m_picStages.beginFinish( picIdInGOP );
+      m_iNumPicCoded = 0;
+
       duData.clear();
 
       CodingStructure& cs = *pcPic->cs;
@@ -3885,7 +4055,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       }
 
       //-- For time output for each slice
-      auto elapsed = std::chrono::steady_clock::now() - beforeTime;
+      auto elapsed = std::chrono::steady_clock::now() - beforeTime - picWaitTime;
       auto encTime = std::chrono::duration_cast<std::chrono::seconds>( elapsed ).count();
 
       std::string digestStr;
@@ -3931,7 +4101,14 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
       double PSNR_Y;
       xCalculateAddPSNRs(isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, encTime, snr_conversion,
-        printFrameMSE, printMSSSIM, &PSNR_Y, isEncodeLtRef );
+        printFrameMSE, printMSSSIM, &PSNR_Y, isEncodeLtRef, isReferenced );
+
+      // the PSNR was the last reader of the original planes, unless the interlaced PSNR, the hash ME of
+      // later pictures or the composite reference still need them
+      if( m_pcCfg->getLowMemoryMode() && !isField && !m_pcCfg->getUseHashME() && !m_pcCfg->getUseCompositeRef() )
+      {
+        pcPic->destroyOrigBuffers();
+      }
 
 
       xWriteTrailingSEIMessages(trailingSeiMessages, accessUnit, pcSlice->getTLayer());
@@ -4012,6 +4189,17 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "final", 0 ) ) );
 
     pcPic->reconstructed = true;
+    if( m_picStages.isActive() )
+    {
+      pcPic->extendPicBorderSamples( pcPic->cs->pps );
+    }
+#if ENABLE_8BIT_REFERENCES
+    if( m_pcCfg->getUse8bitRefPics() )
+    {
+      // the picture is final, later pictures only predict from it
+      pcPic->packRecoBuffers();
+    }
+#endif
     m_bFirst = false;
     m_iNumPicCoded++;
     if (!(m_pcCfg->getUseCompositeRef() && isEncodeLtRef))
@@ -4036,6 +4224,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
   delete pcBitstreamRedirect;
 
   CHECK( m_iNumPicCoded > 1, "Unspecified error" );
+  m_picStages.endFinish( picIdInGOP );
 }
 
 void EncGOP::printOutSummary( uint32_t uiNumAllPicCoded, bool isField, const bool printMSEBasedSNR,
@@ -4548,10 +4737,10 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
 void EncGOP::xCalculateAddPSNRs( const bool isField, const bool isFieldTopFieldFirst,
   const int iGOPid, Picture* pcPic, const AccessUnit&accessUnit, PicList &rcListPic,
   const int64_t dEncTime, const InputColourSpaceConversion snr_conversion,
-  const bool printFrameMSE, const bool printMSSSIM, double* PSNR_Y, bool isEncodeLtRef)
+  const bool printFrameMSE, const bool printMSSSIM, double* PSNR_Y, bool isEncodeLtRef, const bool isReferenced)
 {
   xCalculateAddPSNR(pcPic, pcPic->getRecoBuf(), accessUnit, (double)dEncTime, snr_conversion,
-    printFrameMSE, printMSSSIM, PSNR_Y, isEncodeLtRef);
+    printFrameMSE, printMSSSIM, PSNR_Y, isEncodeLtRef, isReferenced);
 
   //In case of field coding, compute the interlaced PSNR for both fields
   if(isField)
@@ -4621,7 +4810,7 @@ void EncGOP::xCalculateAddPSNRs( const bool isField, const bool isFieldTopFieldF
 
 void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUnit& accessUnit,
   double dEncTime, const InputColourSpaceConversion conversion, const bool printFrameMSE, const bool printMSSSIM,
-  double* PSNR_Y, bool isEncodeLtRef)
+  double* PSNR_Y, bool isEncodeLtRef, const bool isReferenced)
 {
   const SPS&         sps = *pcPic->cs->sps;
   const CPelUnitBuf& pic = cPicD;
@@ -4870,7 +5059,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 #endif
 
   char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (! pcPic->referenced)
+  if (! isReferenced)
   {
     c += 32;
   }
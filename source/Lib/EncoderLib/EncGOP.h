@@ -60,6 +60,9 @@
 #include "Analyze.h"
 #include "RateCtrl.h"
 #include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include "EncHRD.h"
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
@@ -99,6 +102,49 @@ class EncGOP
     int accumNalsDU;
   };
 
+  /// orders the stages of the pictures of a GOP compressed by several threads: the set-ups run in coding order,
+  /// then a picture compresses once its reference pictures are finished, and the finishing stages (loop filters,
+  /// writing, analysis) run in coding order again; a set-up and a finishing stage never run at the same time
+  class PicStages
+  {
+  public:
+    PicStages()
+    : m_active     ( false )
+    , m_aborted    ( false )
+    , m_busy       ( false )
+    , m_numSetUp   ( 0 )
+    , m_numFinished( 0 ) {};
+
+    void start      ( const int numPics );
+    void stop       ();
+    /// wakes the waiting threads after a thread failed, they leave their pictures by throwing an exception
+    void abort      ();
+    bool isActive   () const { return m_active; }
+
+    void beginSetUp ( const int picId );
+    void endSetUp   ( const int picId, const int poc );
+    /// waits until the active reference pictures of the slice are finished, returns the time spent waiting
+    std::chrono::steady_clock::duration waitForRefs( const Slice& slice );
+    /// waits for the turn of the picture to finish, returns the time spent waiting, ends the set-up if still open
+    std::chrono::steady_clock::duration beginFinish( const int picId );
+    void endFinish  ( const int picId );
+
+  private:
+    enum Stage { STAGE_WAITING, STAGE_SET_UP, STAGE_COMPRESS, STAGE_FINISH, STAGE_DONE };
+
+    bool xIsInFlight( const int poc ) const;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_cond;
+    bool                    m_active;
+    bool                    m_aborted;      ///< a thread failed, no further stage begins
+    bool                    m_busy;         ///< a set-up or a finishing stage is running
+    int                     m_numSetUp;     ///< pictures whose set-up has ended
+    int                     m_numFinished;  ///< pictures whose finishing stage has ended
+    std::vector<Stage>      m_stage;
+    std::vector<int>        m_poc;
+  };
+
 private:
 
   Analyze                 m_gcAnalyzeAll;
@@ -142,7 +188,7 @@ private:
   //  Access channel
   EncLib*                 m_pcEncLib;
   EncCfg*                 m_pcCfg;
-  EncSlice*               m_pcSliceEncoder;
+  static thread_local EncSlice* m_pcSliceEncoder;   ///< slice encoder of the picture encoding context of the thread
   PicList*                m_pcListPic;
 
   HLSWriter*              m_HLSWriter;
@@ -160,7 +206,8 @@ private:
   //--Adaptive Loop filter
   EncSampleAdaptiveOffset*  m_pcSAO;
   EncAdaptiveLoopFilter*    m_pcALF;
-  EncReshape*               m_pcReshaper;
+  static thread_local EncReshape* m_pcReshaper;   ///< reshaper of the picture encoding context of the thread
+  EncReshape                m_reshaperCarry;   ///< reshaper state handed from one picture set-up to the next
   RateCtrl*                 m_pcRateCtrl;
   // indicate sequence first
   bool                    m_bSeqFirst;
@@ -168,6 +215,8 @@ private:
 
   EncHRD*                 m_HRD;
 
+  PicStages               m_picStages;   ///< stages of the pictures of a GOP compressed by several threads
+
   // clean decoding refresh
   bool                    m_bRefreshPending;
   int                     m_pocCRA;
@@ -225,6 +274,9 @@ public:
   void  compressGOP ( int iPOCLast, int iNumPicRcvd, PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRec,
                       bool isField, bool isTff, const InputColourSpaceConversion snr_conversion, const bool printFrameMSE,
                       bool printMSSSIM, bool isEncodeLtRef, const int picIdInGOP);
+  void  startPicStages( const int numPics ) { m_picStages.start( numPics ); }
+  void  stopPicStages ()                    { m_picStages.stop(); }
+  void  abortPicStages()                    { m_picStages.abort(); }
   void  xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, OutputBitstream* pcBitstreamRedirect);
 
 
@@ -299,9 +351,9 @@ protected:
 
   void  xCalculateAddPSNRs(const bool isField, const bool isFieldTopFieldFirst, const int iGOPid, Picture* pcPic, 
     const AccessUnit&accessUnit, PicList &rcListPic, int64_t dEncTime, const InputColourSpaceConversion snr_conversion, 
-    const bool printFrameMSE, const bool printMSSSIM, double* PSNR_Y, bool isEncodeLtRef);
+    const bool printFrameMSE, const bool printMSSSIM, double* PSNR_Y, bool isEncodeLtRef, const bool isReferenced);
   void  xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUnit&, double dEncTime, const InputColourSpaceConversion snr_conversion, 
-    const bool printFrameMSE, const bool printMSSSIM, double* PSNR_Y, bool isEncodeLtRef);
+    const bool printFrameMSE, const bool printMSSSIM, double* PSNR_Y, bool isEncodeLtRef, const bool isReferenced);
   void  xCalculateInterlacedAddPSNR( Picture* pcPicOrgFirstField, Picture* pcPicOrgSecondField,
                                      PelUnitBuf cPicRecFirstField, PelUnitBuf cPicRecSecondField,
                                      const InputColourSpaceConversion snr_conversion, const bool printFrameMSE, 
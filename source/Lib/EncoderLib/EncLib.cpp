@@ -46,6 +46,10 @@
 #include "EncLibCommon.h"
 #include "CommonLib/ProfileLevelTier.h"
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+
 //! \ingroup EncoderLib
 //! \{
 
@@ -53,12 +57,25 @@
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
 
+thread_local int EncLib::m_picCtxId = 0;
+
 EncLib::EncLib( EncLibCommon* encLibCommon )
   : m_cListPic( encLibCommon->getPictureBuffer() )
+  , m_cInterSearch( nullptr )
+  , m_cIntraSearch( nullptr )
+  , m_cTrQuant( nullptr )
   , m_cEncALF( encLibCommon->getApsIdStart() )
+  , m_CABACEncoder( nullptr )
+  , m_cReshaper( nullptr )
+  , m_cSliceEncoder( nullptr )
+  , m_cCuEncoder( nullptr )
   , m_spsMap( encLibCommon->getSpsMap() )
   , m_ppsMap( encLibCommon->getPpsMap() )
   , m_apsMap( encLibCommon->getApsMap() )
+  , m_cRdCost( nullptr )
+  , m_CtxCache( nullptr )
+  , m_numCuEncStacks( 0 )
+  , m_numPicCtxs( 0 )
   , m_AUWriterIf( nullptr )
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
@@ -97,12 +114,42 @@ void EncLib::create( const int layerId )
 {
   m_layerId = layerId;
   m_iPOCLast = m_compositeRefEnabled ? -2 : -1;
+  // one stack of CU encoding classes per thread encoding CTU rows in parallel, or one per job evaluating split modes in parallel
+  m_numCuEncStacks  = getNumSplitThreads() > 1 ? 1 + PARL_SPLIT_MAX_NUM_JOBS : std::max( 1, getNumWppThreads() );
+  // one slice encoder and one set of CU encoding stacks per thread encoding a picture of the GOP
+  m_numPicCtxs      = std::max( 1, getNumFrameThreads() );
+  const int numAllStacks = m_numPicCtxs * m_numCuEncStacks;
+  m_cInterSearch    = new InterSearch [numAllStacks];
+  m_cIntraSearch    = new IntraSearch [numAllStacks];
+  m_cTrQuant        = new TrQuant     [numAllStacks];
+  m_CABACEncoder    = new CABACEncoder[numAllStacks];
+  m_cReshaper       = new EncReshape  [numAllStacks];
+  m_cCuEncoder      = new EncCu       [numAllStacks];
+  m_cRdCost         = new RdCost      [numAllStacks];
+  m_CtxCache        = new CtxCache    [numAllStacks];
+  m_cSliceEncoder   = new EncSlice    [m_numPicCtxs];
+
   // create processing unit classes
   m_cGOPEncoder.        create( );
-  m_cCuEncoder.         create( this );
+  for( int jId = 0; jId < numAllStacks; jId++ )
+  {
+    m_cCuEncoder[jId].  create( this );
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
-  m_cInterSearch.cacheAssign( &m_cacheModel );
+    m_cInterSearch[jId].cacheAssign( &m_cacheModel );
 #endif
+  }
+  if( getNumWppThreads() > 1 )
+  {
+    m_wppThreadPool.create( getNumWppThreads() );
+  }
+  if( getNumSplitThreads() > 1 )
+  {
+    m_splitThreadPool.create( getNumSplitThreads() );
+  }
+  if( m_numPicCtxs > 1 )
+  {
+    m_frameThreadPool.create( m_numPicCtxs );
+  }
 
   m_deblockingFilter.create(floorLog2(m_maxCUWidth) - MIN_CU_LOG2);
 
@@ -113,7 +160,10 @@ void EncLib::create( const int layerId )
 
   if (m_lmcsEnabled)
   {
-    m_cReshaper.createEnc( getSourceWidth(), getSourceHeight(), m_maxCUWidth, m_maxCUHeight, m_bitDepth[COMPONENT_Y]);
+    for( int ctxId = 0; ctxId < m_numPicCtxs; ctxId++ )
+    {
+      m_cReshaper[ctxId * m_numCuEncStacks].createEnc( getSourceWidth(), getSourceHeight(), m_maxCUWidth, m_maxCUHeight, m_bitDepth[COMPONENT_Y]);
+    }
   }
   if ( m_RCEnableRateControl )
   {
@@ -127,8 +177,17 @@ void EncLib::destroy ()
 {
   // destroy processing unit classes
   m_cGOPEncoder.        destroy();
-  m_cSliceEncoder.      destroy();
-  m_cCuEncoder.         destroy();
+  m_wppThreadPool.      destroy();
+  m_splitThreadPool.    destroy();
+  m_frameThreadPool.    destroy();
+  for( int ctxId = 0; ctxId < m_numPicCtxs; ctxId++ )
+  {
+    m_cSliceEncoder[ctxId].destroy();
+  }
+  for( int jId = 0; jId < m_numPicCtxs * m_numCuEncStacks; jId++ )
+  {
+    m_cCuEncoder[jId].  destroy();
+  }
   if( m_alf )
   {
     m_cEncALF.destroy();
@@ -137,9 +196,24 @@ void EncLib::destroy ()
   m_cEncSAO.            destroy();
   m_deblockingFilter.   destroy();
   m_cRateCtrl.          destroy();
-  m_cReshaper.          destroy();
-  m_cInterSearch.       destroy();
-  m_cIntraSearch.       destroy();
+  for( int jId = 0; jId < m_numPicCtxs * m_numCuEncStacks; jId++ )
+  {
+    m_cReshaper[jId].   destroy();
+    m_cInterSearch[jId].destroy();
+    m_cIntraSearch[jId].destroy();
+  }
+
+  delete[] m_cInterSearch;  m_cInterSearch = nullptr;
+  delete[] m_cIntraSearch;  m_cIntraSearch = nullptr;
+  delete[] m_cTrQuant;      m_cTrQuant     = nullptr;
+  delete[] m_CABACEncoder;  m_CABACEncoder = nullptr;
+  delete[] m_cReshaper;     m_cReshaper    = nullptr;
+  delete[] m_cCuEncoder;    m_cCuEncoder   = nullptr;
+  delete[] m_cRdCost;       m_cRdCost      = nullptr;
+  delete[] m_CtxCache;      m_CtxCache     = nullptr;
+  delete[] m_cSliceEncoder; m_cSliceEncoder = nullptr;
+  m_numCuEncStacks = 0;
+  m_numPicCtxs     = 0;
 
   return;
 }
@@ -181,7 +255,10 @@ void EncLib::init(AUWriterIf *auWriterIf)
     m_cRateCtrl.initHrdParam(sps0.getGeneralHrdParameters(), sps0.getOlsHrdParameters(), m_iFrameRate, m_RCInitialCpbFullness);
   }
 #endif
-  m_cRdCost.setCostMode ( m_costMode );
+  for( int jId = 0; jId < m_numPicCtxs * m_numCuEncStacks; jId++ )
+  {
+    m_cRdCost[jId].setCostMode ( m_costMode );
+  }
 
   // initialize PPS
   pps0.setPicWidthInLumaSamples( m_sourceWidth );
@@ -292,42 +369,49 @@ void EncLib::init(AUWriterIf *auWriterIf)
 
   // initialize processing unit classes
   m_cGOPEncoder.  init( this );
-  m_cSliceEncoder.init( this, sps0 );
-  m_cCuEncoder.   init( this, sps0 );
-
-  // initialize transform & quantization class
-  m_cTrQuant.init( nullptr,
-                   1 << m_log2MaxTbSize,
-                   m_useRDOQ,
-                   m_useRDOQTS,
+  for( m_picCtxId = 0; m_picCtxId < m_numPicCtxs; m_picCtxId++ )
+  {
+    getSliceEncoder()->init( this, sps0 );
+    for( int jId = 0; jId < m_numCuEncStacks; jId++ )
+    {
+      getCuEncoder( jId )->init( this, sps0, jId );
+
+      // initialize transform & quantization class
+      getTrQuant( jId )->init( nullptr,
+                               1 << m_log2MaxTbSize,
+                               m_useRDOQ,
+                               m_useRDOQTS,
 #if T0196_SELECTIVE_RDOQ
-                   m_useSelectiveRDOQ,
+                               m_useSelectiveRDOQ,
 #endif
-                   true
-  );
-
-  // initialize encoder search class
-  CABACWriter* cabacEstimator = m_CABACEncoder.getCABACEstimator(&sps0);
-  m_cIntraSearch.init( this,
-                       &m_cTrQuant,
-                       &m_cRdCost,
-                       cabacEstimator,
-                       getCtxCache(), m_maxCUWidth, m_maxCUHeight, floorLog2(m_maxCUWidth) - m_log2MinCUSize
-                     , &m_cReshaper
-                     , sps0.getBitDepth(CHANNEL_TYPE_LUMA)
-  );
-  m_cInterSearch.init( this,
-                       &m_cTrQuant,
-                       m_iSearchRange,
-                       m_bipredSearchRange,
-                       m_motionEstimationSearchMethod,
-                       getUseCompositeRef(),
-    m_maxCUWidth, m_maxCUHeight, floorLog2(m_maxCUWidth) - m_log2MinCUSize, &m_cRdCost, cabacEstimator, getCtxCache()
-                     , &m_cReshaper
-  );
-
-  // link temporary buffets from intra search with inter search to avoid unneccessary memory overhead
-  m_cInterSearch.setTempBuffers( m_cIntraSearch.getSplitCSBuf(), m_cIntraSearch.getFullCSBuf(), m_cIntraSearch.getSaveCSBuf() );
+                               true
+      );
+
+      // initialize encoder search class
+      CABACWriter* cabacEstimator = getCABACEncoder( jId )->getCABACEstimator(&sps0);
+      getIntraSearch( jId )->init( this,
+                                   getTrQuant( jId ),
+                                   getRdCost( jId ),
+                                   cabacEstimator,
+                                   getCtxCache( jId ), m_maxCUWidth, m_maxCUHeight, floorLog2(m_maxCUWidth) - m_log2MinCUSize
+                                 , getReshaper( jId )
+                                 , sps0.getBitDepth(CHANNEL_TYPE_LUMA)
+      );
+      getInterSearch( jId )->init( this,
+                                   getTrQuant( jId ),
+                                   m_iSearchRange,
+                                   m_bipredSearchRange,
+                                   m_motionEstimationSearchMethod,
+                                   getUseCompositeRef(),
+        m_maxCUWidth, m_maxCUHeight, floorLog2(m_maxCUWidth) - m_log2MinCUSize, getRdCost( jId ), cabacEstimator, getCtxCache( jId )
+                                 , getReshaper( jId )
+      );
+
+      // link temporary buffets from intra search with inter search to avoid unneccessary memory overhead
+      getInterSearch( jId )->setTempBuffers( getIntraSearch( jId )->getSplitCSBuf(), getIntraSearch( jId )->getFullCSBuf(), getIntraSearch( jId )->getSaveCSBuf() );
+    }
+  }
+  m_picCtxId = 0;
 
   m_iMaxRefPicNum = 0;
 
@@ -354,9 +438,9 @@ void EncLib::init(AUWriterIf *auWriterIf)
 #if GDR_ENABLED
     PicHeader *picHeader = new PicHeader();
     xInitPicHeader(*picHeader, sps0, pps0);
-    picBg->finalInit( m_vps, sps0, pps0, picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    picBg->finalInit( m_vps, sps0, pps0, picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_numPicCtxs > 1 );
 #else
-    picBg->finalInit( m_vps, sps0, pps0, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    picBg->finalInit( m_vps, sps0, pps0, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_numPicCtxs > 1 );
 #endif
     picBg->allocateNewSlice();
     picBg->createSpliceIdx(pps0.pcv->sizeInCtus);
@@ -411,6 +495,22 @@ void EncLib::xInitScalingLists( SPS &sps, APS &aps )
     THROW("error : ScalingList == " << getUseScalingListId() << " not supported\n");
   }
 
+  // the CU encoding stacks of the WPP threads and of the picture encoding contexts use the same scaling lists
+  for( int jId = 1; jId < m_numPicCtxs * m_numCuEncStacks; jId++ )
+  {
+    Quant* stackQuant = m_cTrQuant[jId].getQuant();
+    if( getUseScalingListId() == SCALING_LIST_OFF )
+    {
+      stackQuant->setFlatScalingList( maxLog2TrDynamicRange, sps.getBitDepths() );
+      stackQuant->setUseScalingList( false );
+    }
+    else
+    {
+      stackQuant->setScalingList( &( aps.getScalingList() ), maxLog2TrDynamicRange, sps.getBitDepths() );
+      stackQuant->setUseScalingList( true );
+    }
+  }
+
   if( getUseScalingListId() == SCALING_LIST_FILE_READ )
   {
     // Prepare delta's:
@@ -444,19 +544,29 @@ void EncLib::deletePicBuffer()
   {
     Picture* pcPic = *(iterPic++);
 
-    pcPic->destroy();
-
-    // get rid of the qpadaption layer
-    while( pcPic->aqlayer.size() )
-    {
-      delete pcPic->aqlayer.back(); pcPic->aqlayer.pop_back();
-    }
-
-    delete pcPic;
+    xDeletePicBuffer( pcPic );
     pcPic = NULL;
   }
 
   m_cListPic.clear();
+
+  while( Picture* pcPic = m_picPool.takeAny() )
+  {
+    xDeletePicBuffer( pcPic );
+  }
+}
+
+void EncLib::xDeletePicBuffer( Picture* pic )
+{
+  pic->destroy();
+
+  // get rid of the qpadaption layer
+  while( pic->aqlayer.size() )
+  {
+    delete pic->aqlayer.back(); pic->aqlayer.pop_back();
+  }
+
+  delete pic;
 }
 
 bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYuvTrueOrg, PelStorage* pcPicYuvFilteredOrg, const InputColourSpaceConversion snrCSC, std::list<PelUnitBuf*>& rcListPicYuvRecOut, int& iNumEncoded )
@@ -472,9 +582,9 @@ bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYu
 #if GDR_ENABLED
     PicHeader *picHeader = new PicHeader();
     xInitPicHeader(*picHeader, *sps, *pps);
-    picCurr->finalInit( m_vps, *sps, *pps, picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    picCurr->finalInit( m_vps, *sps, *pps, picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_numPicCtxs > 1 );
 #else
-    picCurr->finalInit( m_vps, *sps, *pps, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    picCurr->finalInit( m_vps, *sps, *pps, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_numPicCtxs > 1 );
 #endif
     picCurr->poc = m_iPOCLast - 1;
     m_iPOCLast -= 2;
@@ -596,9 +706,9 @@ bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYu
 #if GDR_ENABLED
     PicHeader *picHeader = new PicHeader();
     xInitPicHeader(*picHeader, *pSPS, *pPPS);
-    pcPicCurr->finalInit( m_vps, *pSPS, *pPPS, picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    pcPicCurr->finalInit( m_vps, *pSPS, *pPPS, picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_numPicCtxs > 1 );
 #else
-    pcPicCurr->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    pcPicCurr->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_numPicCtxs > 1 );
 #endif
 
     pcPicCurr->poc = m_iPOCLast;
@@ -642,11 +752,19 @@ bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYu
 
 bool EncLib::encode( const InputColourSpaceConversion snrCSC, std::list<PelUnitBuf*>& rcListPicYuvRecOut, int& iNumEncoded )
 {
-  // compress GOP
-  m_cGOPEncoder.compressGOP( m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut,
-    false, false, snrCSC, m_printFrameMSE, m_printMSSSIM, false, m_picIdInGOP );
+  if( m_numPicCtxs > 1 && m_iPOCLast )
+  {
+    // compress all pictures of the GOP at once
+    xEncodeGOPFrameParallel( snrCSC, rcListPicYuvRecOut );
+  }
+  else
+  {
+    // compress GOP
+    m_cGOPEncoder.compressGOP( m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut,
+      false, false, snrCSC, m_printFrameMSE, m_printMSSSIM, false, m_picIdInGOP );
 
-  m_picIdInGOP++;
+    m_picIdInGOP++;
+  }
 
   // go over all pictures in a GOP excluding the first IRAP
   if( m_picIdInGOP != m_iGOPSize && m_iPOCLast )
@@ -670,6 +788,49 @@ bool EncLib::encode( const InputColourSpaceConversion snrCSC, std::list<PelUnitB
   return false;
 }
 
+void EncLib::xEncodeGOPFrameParallel( const InputColourSpaceConversion snrCSC, std::list<PelUnitBuf*>& rcListPicYuvRecOut )
+{
+  std::atomic<int>   nextCtxId( 0 );
+  std::atomic<int>   nextPicId( m_picIdInGOP );
+  std::mutex         picErrorMutex;
+  std::exception_ptr picError;
+
+  // each thread takes the next picture in coding order, EncGOP orders the stages of the pictures and their references
+  m_cGOPEncoder.startPicStages( m_iGOPSize );
+  m_frameThreadPool.run( [&]()
+  {
+    m_picCtxId = nextCtxId++;
+    try
+    {
+      for( int picId = nextPicId++; picId < m_iGOPSize; picId = nextPicId++ )
+      {
+        m_cGOPEncoder.compressGOP( m_iPOCLast, m_iNumPicRcvd, m_cListPic, rcListPicYuvRecOut,
+          false, false, snrCSC, m_printFrameMSE, m_printMSSSIM, false, picId );
+      }
+    }
+    catch( ... )
+    {
+      // the first error is passed on, the other threads stop waiting for the stages of the failed picture
+      {
+        std::lock_guard<std::mutex> lock( picErrorMutex );
+        if( !picError )
+        {
+          picError = std::current_exception();
+        }
+      }
+      m_cGOPEncoder.abortPicStages();
+    }
+    m_picCtxId = 0;
+  }, m_numPicCtxs );
+  m_cGOPEncoder.stopPicStages();
+  if( picError )
+  {
+    std::rethrow_exception( picError );
+  }
+
+  m_picIdInGOP = m_iGOPSize;
+}
+
 /**------------------------------------------------
  Separate interlaced frame into two fields
  -------------------------------------------------**/
@@ -747,9 +908,9 @@ bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* pcPicY
 #if GDR_ENABLED
       PicHeader *picHeader = new PicHeader();
       xInitPicHeader(*picHeader, *pSPS, *pPPS);
-      pcField->finalInit( m_vps, *pSPS, *pPPS, picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+      pcField->finalInit( m_vps, *pSPS, *pPPS, picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_numPicCtxs > 1 );
 #else
-      pcField->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+      pcField->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_numPicCtxs > 1 );
 #endif
 
       pcField->poc = m_iPOCLast;
@@ -840,6 +1001,19 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
   // use an entry in the buffered list if the maximum number that need buffering has been reached:
   int maxDecPicBuffering = ( m_vps == nullptr || m_vps->m_numLayersInOls[m_vps->m_targetOlsIdx] == 1 ) ? sps.getMaxDecPicBuffering( MAX_TLAYER - 1 ) : m_vps->getMaxDecPicBuffering( MAX_TLAYER - 1 );
 
+  m_picPool.setCapacity( m_iGOPSize + maxDecPicBuffering + 2 );
+
+  if( std::none_of( m_cListPic.begin(), m_cListPic.end(), [&]( const Picture* pic ) { return pic->layerId == m_layerId; } ) )
+  {
+    // allocate the pictures the list of this layer grows to up front
+    const int numPics = std::min( m_iGOPSize + maxDecPicBuffering + 2, m_framesToBeEncoded );
+
+    for( int n = m_picPool.numFree( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth() ); n < numPics; n++ )
+    {
+      xReleasePicBuffer( xCreatePicBuffer( sps, pps ) );
+    }
+  }
+
   if( m_cListPic.size() >= (uint32_t)( m_iGOPSize + maxDecPicBuffering + 2 ) )
   {
     PicList::iterator iterPic = m_cListPic.begin();
@@ -862,40 +1036,39 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
     // and return the old object.
     if( rpcPic && pps.getPPSId() != rpcPic->cs->pps->getPPSId() )
     {
-      // the IDs differ - free up an entry in the list, and then create a new one, as with the case where the max buffering state has not been reached.
-      rpcPic->destroy();
-      delete rpcPic;
+      // the IDs differ - hand the entry back to the pool, and then take one for the new PPS, as with the case where the max buffering state has not been reached.
       m_cListPic.erase(iterPic);
+      xReleasePicBuffer( rpcPic );
       rpcPic=0;
     }
   }
 
   if (rpcPic==0)
   {
-    rpcPic = new Picture;
-    rpcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, false, m_layerId, m_gopBasedTemporalFilterEnabled );
-    if (m_resChangeInClvsEnabled)
-    {
-      const PPS &pps0 = *m_ppsMap.getPS(0);
-      rpcPic->M_BUFS(0, PIC_ORIGINAL_INPUT).create(sps.getChromaFormatIdc(), Area(Position(), Size(pps0.getPicWidthInLumaSamples(), pps0.getPicHeightInLumaSamples())));
-      rpcPic->M_BUFS(0, PIC_TRUE_ORIGINAL_INPUT).create(sps.getChromaFormatIdc(), Area(Position(), Size(pps0.getPicWidthInLumaSamples(), pps0.getPicHeightInLumaSamples())));
-      if(m_gopBasedTemporalFilterEnabled)
-      {
-        rpcPic->M_BUFS(0, PIC_FILTERED_ORIGINAL_INPUT).create(sps.getChromaFormatIdc(), Area(Position(), Size(pps0.getPicWidthInLumaSamples(), pps0.getPicHeightInLumaSamples())));
-      }
-    }
-    if ( getUseAdaptiveQP() )
-    {
-      const uint32_t iMaxDQPLayer = m_picHeader.getCuQpDeltaSubdivIntra()/2+1;
-      rpcPic->aqlayer.resize( iMaxDQPLayer );
-      for (uint32_t d = 0; d < iMaxDQPLayer; d++)
-      {
-        rpcPic->aqlayer[d] = new AQpLayer( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples(), sps.getMaxCUWidth() >> d, sps.getMaxCUHeight() >> d );
-      }
-    }
+    rpcPic = xLeasePicBuffer( sps, pps );
 
     m_cListPic.push_back( rpcPic );
   }
+  else if( !rpcPic->hasOrigBuffers() )
+  {
+    // the original planes were released once the previous picture held in this buffer had been encoded
+    rpcPic->createOrigBuffers( m_gopBasedTemporalFilterEnabled );
+  }
+
+  if( m_resChangeInClvsEnabled && !rpcPic->hasOrigInputBuffers() )
+  {
+    const PPS &pps0 = *m_ppsMap.getPS(0);
+    rpcPic->createOrigInputBuffers( Size( pps0.getPicWidthInLumaSamples(), pps0.getPicHeightInLumaSamples() ), m_gopBasedTemporalFilterEnabled );
+  }
+
+#if ENABLE_8BIT_REFERENCES
+  if( m_use8bitRefPics )
+  {
+    // the picture only gets its reconstruction once its compression starts, until then the buffers of the
+    // pictures waiting in the GOP would outweigh the 8-bit planes of the reference pictures
+    rpcPic->releaseRecoBuffers();
+  }
+#endif
 
   rpcPic->setBorderExtension( false );
   rpcPic->reconstructed = false;
@@ -906,6 +1079,60 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
   m_iNumPicRcvd++;
 }
 
+Picture* EncLib::xLeasePicBuffer( const SPS& sps, const PPS& pps )
+{
+  const Size picSize( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() );
+
+  Picture* pic = m_picPool.lease( sps.getChromaFormatIdc(), picSize, sps.getMaxCUWidth() );
+
+  if( pic )
+  {
+    if( !pic->hasOrigBuffers() )
+    {
+      pic->createOrigBuffers( m_gopBasedTemporalFilterEnabled );
+    }
+    return pic;
+  }
+
+  return xCreatePicBuffer( sps, pps );
+}
+
+Picture* EncLib::xCreatePicBuffer( const SPS& sps, const PPS& pps )
+{
+  const Size picSize( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() );
+
+  Picture* pic = new Picture;
+  pic->create( sps.getChromaFormatIdc(), picSize, sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, false, m_layerId, m_gopBasedTemporalFilterEnabled, m_lowMemoryMode );
+#if ENABLE_8BIT_REFERENCES
+  if( m_use8bitRefPics )
+  {
+    // the pictures allocated up front only get their reconstruction once their compression starts
+    pic->releaseRecoBuffers();
+  }
+#endif
+  if ( getUseAdaptiveQP() )
+  {
+    const uint32_t iMaxDQPLayer = m_picHeader.getCuQpDeltaSubdivIntra()/2+1;
+    pic->aqlayer.resize( iMaxDQPLayer );
+    for (uint32_t d = 0; d < iMaxDQPLayer; d++)
+    {
+      pic->aqlayer[d] = new AQpLayer( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples(), sps.getMaxCUWidth() >> d, sps.getMaxCUHeight() >> d );
+    }
+  }
+
+  return pic;
+}
+
+void EncLib::xReleasePicBuffer( Picture* pic )
+{
+  Picture* evicted = m_picPool.giveBack( pic );
+
+  if( evicted )
+  {
+    xDeletePicBuffer( evicted );
+  }
+}
+
 void EncLib::xInitVPS( const SPS& sps )
 {
   // The SPS must have already been set up.
@@ -1722,7 +1949,7 @@ void EncLib::xInitPPS(PPS &pps, const SPS &sps)
 
   pps.setDeblockingFilterControlPresentFlag(deblockingFilterControlPresentFlag);
 
-  pps.setCabacInitPresentFlag(CABAC_INIT_PRESENT_FLAG);
+  pps.setCabacInitPresentFlag(m_cabacInitPresent);
   pps.setLoopFilterAcrossSlicesEnabledFlag( m_bLFCrossSliceBoundaryFlag );
 
   bool chromaQPOffsetNotZero = false;
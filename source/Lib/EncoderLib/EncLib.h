@@ -57,6 +57,7 @@
 #include "EncReshape.h"
 #include "EncAdaptiveLoopFilter.h"
 #include "RateCtrl.h"
+#include "EncThreadPool.h"
 
 class EncLibCommon;
 
@@ -76,33 +77,40 @@ private:
   int                       m_iNumPicRcvd;                        ///< number of received pictures
   uint32_t                  m_uiNumAllPicCoded;                   ///< number of coded pictures
   PicList&                  m_cListPic;                           ///< dynamic list of pictures
+  PicturePool               m_picPool;                            ///< pictures of this layer dropped from the list, kept for a later picture of their size class
   int                       m_layerId;
 
   // encoder search
-  InterSearch               m_cInterSearch;                       ///< encoder search class
-  IntraSearch               m_cIntraSearch;                       ///< encoder search class
+  InterSearch              *m_cInterSearch;                       ///< encoder search class, one per CU encoding stack
+  IntraSearch              *m_cIntraSearch;                       ///< encoder search class, one per CU encoding stack
   // coding tool
-  TrQuant                   m_cTrQuant;                           ///< transform & quantization class
+  TrQuant                  *m_cTrQuant;                           ///< transform & quantization class, one per CU encoding stack
   DeblockingFilter          m_deblockingFilter;                   ///< deblocking filter class
   EncSampleAdaptiveOffset   m_cEncSAO;                            ///< sample adaptive offset class
   EncAdaptiveLoopFilter     m_cEncALF;
   HLSWriter                 m_HLSWriter;                          ///< CAVLC encoder
-  CABACEncoder              m_CABACEncoder;
+  CABACEncoder             *m_CABACEncoder;
 
-  EncReshape                m_cReshaper;                        ///< reshaper class
+  EncReshape               *m_cReshaper;                        ///< reshaper class, one per CU encoding stack
 
   // processing unit
   EncGOP                    m_cGOPEncoder;                        ///< GOP encoder
-  EncSlice                  m_cSliceEncoder;                      ///< slice encoder
-  EncCu                     m_cCuEncoder;                         ///< CU encoder
+  EncSlice                 *m_cSliceEncoder;                      ///< slice encoder, one per picture encoding context
+  EncCu                    *m_cCuEncoder;                         ///< CU encoder, one per CU encoding stack
   // SPS
   ParameterSetMap<SPS>&     m_spsMap;                             ///< SPS. This is the base value. This is copied to PicSym
   ParameterSetMap<PPS>&     m_ppsMap;                             ///< PPS. This is the base value. This is copied to PicSym
   ParameterSetMap<APS>&     m_apsMap;                             ///< APS. This is the base value. This is copied to PicSym
   PicHeader                 m_picHeader;                          ///< picture header
   // RD cost computation
-  RdCost                    m_cRdCost;                            ///< RD cost computation class
-  CtxCache                  m_CtxCache;                           ///< buffer for temporarily stored context models
+  RdCost                   *m_cRdCost;                            ///< RD cost computation class, one per CU encoding stack
+  CtxCache                 *m_CtxCache;                           ///< buffer for temporarily stored context models, one per CU encoding stack
+  int                       m_numCuEncStacks;                     ///< number of CU encoding stacks of a picture encoding context (one per WPP thread)
+  int                       m_numPicCtxs;                         ///< number of picture encoding contexts (one per frame thread)
+  static thread_local int   m_picCtxId;                           ///< picture encoding context of the calling thread
+  EncThreadPool             m_wppThreadPool;                      ///< threads encoding the CTU rows of a slice in parallel
+  EncThreadPool             m_splitThreadPool;                    ///< threads evaluating sibling split modes in parallel
+  EncThreadPool             m_frameThreadPool;                    ///< threads encoding pictures of a GOP in parallel
   // quality control
   RateCtrl                  m_cRateCtrl;                          ///< Rate control class
 
@@ -137,6 +145,10 @@ public:
 
 protected:
   void  xGetNewPicBuffer  ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Picture*& rpcPic, int ppsId ); ///< get picture buffer which will be processed. If ppsId<0, then the ppsMap will be queried for the first match.
+  Picture* xLeasePicBuffer  ( const SPS& sps, const PPS& pps );  ///< a pooled picture of the size class of the PPS, or a newly created one
+  Picture* xCreatePicBuffer ( const SPS& sps, const PPS& pps );  ///< a newly created picture of the size class of the PPS, bypassing the pool
+  void     xReleasePicBuffer( Picture* pic );
+  void     xDeletePicBuffer ( Picture* pic );
   void  xInitOPI(OPI& opi); ///< initialize Operating point Information (OPI) from encoder options
   void  xInitDCI(DCI& dci, const SPS& sps); ///< initialize Decoding Capability Information (DCI) from encoder options
   void  xInitVPS( const SPS& sps ); ///< initialize VPS from encoder options
@@ -150,6 +162,9 @@ protected:
 
   void xInitRPL(SPS &sps);   ///< initialize SPS from encoder options
 
+  int  xGetStackIdx( const int jId ) const { return m_picCtxId * m_numCuEncStacks + jId; }
+  void xEncodeGOPFrameParallel( const InputColourSpaceConversion snrCSC, std::list<PelUnitBuf*>& rcListPicYuvRecOut );
+
 public:
   EncLib( EncLibCommon* encLibCommon );
   virtual ~EncLib();
@@ -165,22 +180,25 @@ public:
 
   AUWriterIf*             getAUWriterIf         ()              { return   m_AUWriterIf;           }
   PicList*                getListPic            ()              { return  &m_cListPic;             }
-  InterSearch*            getInterSearch        ()              { return  &m_cInterSearch;         }
-  IntraSearch*            getIntraSearch        ()              { return  &m_cIntraSearch;         }
+  InterSearch*            getInterSearch        ( int jId = 0 ) { return  &m_cInterSearch[xGetStackIdx( jId )]; }
+  IntraSearch*            getIntraSearch        ( int jId = 0 ) { return  &m_cIntraSearch[xGetStackIdx( jId )]; }
 
-  TrQuant*                getTrQuant            ()              { return  &m_cTrQuant;             }
+  TrQuant*                getTrQuant            ( int jId = 0 ) { return  &m_cTrQuant[xGetStackIdx( jId )];     }
   DeblockingFilter*       getDeblockingFilter   ()              { return  &m_deblockingFilter;     }
   EncSampleAdaptiveOffset* getSAO               ()              { return  &m_cEncSAO;              }
   EncAdaptiveLoopFilter*  getALF                ()              { return  &m_cEncALF;              }
   EncGOP*                 getGOPEncoder         ()              { return  &m_cGOPEncoder;          }
-  EncSlice*               getSliceEncoder       ()              { return  &m_cSliceEncoder;        }
+  EncSlice*               getSliceEncoder       ()              { return  &m_cSliceEncoder[m_picCtxId];         }
   EncHRD*                 getHRD                ()              { return  &m_encHRD;               }
-  EncCu*                  getCuEncoder          ()              { return  &m_cCuEncoder;           }
+  EncCu*                  getCuEncoder          ( int jId = 0 ) { return  &m_cCuEncoder[xGetStackIdx( jId )];   }
   HLSWriter*              getHLSWriter          ()              { return  &m_HLSWriter;            }
-  CABACEncoder*           getCABACEncoder       ()              { return  &m_CABACEncoder;         }
+  CABACEncoder*           getCABACEncoder       ( int jId = 0 ) { return  &m_CABACEncoder[xGetStackIdx( jId )]; }
 
-  RdCost*                 getRdCost             ()              { return  &m_cRdCost;              }
-  CtxCache*               getCtxCache           ()              { return  &m_CtxCache;             }
+  RdCost*                 getRdCost             ( int jId = 0 ) { return  &m_cRdCost[xGetStackIdx( jId )];      }
+  CtxCache*               getCtxCache           ( int jId = 0 ) { return  &m_CtxCache[xGetStackIdx( jId )];     }
+  int                     getNumCuEncStacks     ()        const { return  m_numCuEncStacks;        }
+  EncThreadPool*          getWppThreadPool      ()              { return  &m_wppThreadPool;        }
+  EncThreadPool*          getSplitThreadPool    ()              { return  &m_splitThreadPool;      }
   RateCtrl*               getRateCtrl           ()              { return  &m_cRateCtrl;            }
 
 
@@ -194,7 +212,7 @@ public:
   const PPS* getPPS( int Id ) { return m_ppsMap.getPS( Id); }
   const APS*             getAPS(int Id) { return m_apsMap.getPS(Id); }
 
-  EncReshape*            getReshaper()                          { return  &m_cReshaper; }
+  EncReshape*            getReshaper( int jId = 0 )             { return  &m_cReshaper[xGetStackIdx( jId )]; }
 
   ParameterSetMap<APS>*  getApsMap() { return &m_apsMap; }
 
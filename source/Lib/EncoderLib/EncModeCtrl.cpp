@@ -55,6 +55,8 @@ void EncModeCtrl::init( EncCfg *pCfg, RateCtrl *pRateCtrl, RdCost* pRdCost )
   m_pcRateCtrl    = pRateCtrl;
   m_pcRdCost      = pRdCost;
   m_fastDeltaQP   = false;
+  m_parallelSplit      = CU_DONT_SPLIT;
+  m_parallelSplitLevel = 0;
 #if SHARP_LUMA_DELTA_QP
   m_lumaQPOffset  = 0;
 
@@ -62,8 +64,40 @@ void EncModeCtrl::init( EncCfg *pCfg, RateCtrl *pRateCtrl, RdCost* pRdCost )
 #endif
 }
 
+void EncModeCtrl::copyState( const EncModeCtrl& other, const Area& area )
+{
+  m_slice          = other.m_slice;
+  m_fastDeltaQP    = other.m_fastDeltaQP;
+#if SHARP_LUMA_DELTA_QP
+  m_lumaQPOffset   = other.m_lumaQPOffset;
+#endif
+  m_ComprCUCtxList = other.m_ComprCUCtxList;
+  m_doPlt          = other.m_doPlt;
+}
+
+int EncModeCtrl::getParallelSplitJobs( const CodingStructure &cs, Partitioner& partitioner, PartSplit jobs[PARL_SPLIT_MAX_NUM_JOBS] ) const
+{
+  bool canNo, canQt, canBh, canBv, canTh, canTv;
+  partitioner.canSplit( cs, canNo, canQt, canBh, canBv, canTh, canTv );
+
+  // one job tests all non-split modes, every other job one of the allowed splits
+  int numJobs = 0;
+  if( canNo ) jobs[numJobs++] = CU_DONT_SPLIT;
+  if( canQt ) jobs[numJobs++] = CU_QUAD_SPLIT;
+  if( canBh ) jobs[numJobs++] = CU_HORZ_SPLIT;
+  if( canBv ) jobs[numJobs++] = CU_VERT_SPLIT;
+  if( canTh ) jobs[numJobs++] = CU_TRIH_SPLIT;
+  if( canTv ) jobs[numJobs++] = CU_TRIV_SPLIT;
+
+  return numJobs;
+}
+
 bool EncModeCtrl::tryModeMaster( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner )
 {
+  if( m_parallelSplitLevel == m_ComprCUCtxList.size() && getPartSplit( encTestmode ) != m_parallelSplit )
+  {
+    return false;
+  }
   return tryMode( encTestmode, cs, partitioner );
 }
 
@@ -330,12 +364,15 @@ int EncModeCtrl::calculateLumaDQPsmooth(const CPelBuf& rcOrg, int baseQP)
   return qp;
 }
 
-void CacheBlkInfoCtrl::create()
+void CacheBlkIdxMap::create()
 {
   const unsigned numPos = MAX_CU_SIZE >> MIN_CU_LOG2;
 
   m_numWidths  = gp_sizeIdxInfo->numWidths();
   m_numHeights = gp_sizeIdxInfo->numHeights();
+  m_numEntries = 0;
+
+  m_idx.assign( numPos * numPos * m_numWidths * m_numHeights, -1 );
 
   bool isLog2MttPartitioning = !!dynamic_cast<SizeIndexInfoLog2*>( gp_sizeIdxInfo );
 
@@ -343,13 +380,10 @@ void CacheBlkInfoCtrl::create()
   {
     for( unsigned y = 0; y < numPos; y++ )
     {
-      m_codedCUInfo[x][y] = new CodedCUInfo**[m_numWidths];
-
       for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
       {
         if( !( gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( wIdx ) ) && x + ( gp_sizeIdxInfo->sizeFrom( wIdx ) >> MIN_CU_LOG2 ) <= ( MAX_CU_SIZE >> MIN_CU_LOG2 ) ) )
         {
-          m_codedCUInfo[x][y][wIdx] = nullptr;
           continue;
         }
 
@@ -357,17 +391,13 @@ void CacheBlkInfoCtrl::create()
 
         if( isLog2MttPartitioning && ( ( x << MIN_CU_LOG2 ) & ( ( 1 << ( wLog2 - 1 ) ) - 1 ) ) != 0 )
         {
-          m_codedCUInfo[x][y][wIdx] = nullptr;
           continue;
         }
 
-        m_codedCUInfo[x][y][wIdx] = new CodedCUInfo*[gp_sizeIdxInfo->numHeights()];
-
         for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
         {
           if( !( gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( hIdx ) ) && y + ( gp_sizeIdxInfo->sizeFrom( hIdx ) >> MIN_CU_LOG2 ) <= ( MAX_CU_SIZE >> MIN_CU_LOG2 ) ) )
           {
-            m_codedCUInfo[x][y][wIdx][hIdx] = nullptr;
             continue;
           }
 
@@ -375,129 +405,94 @@ void CacheBlkInfoCtrl::create()
 
           if( isLog2MttPartitioning && ( ( ( y << MIN_CU_LOG2 ) & ( ( 1 << ( hLog2 - 1 ) ) - 1 ) ) != 0 ) )
           {
-            m_codedCUInfo[x][y][wIdx][hIdx] = nullptr;
             continue;
           }
 
-          m_codedCUInfo[x][y][wIdx][hIdx] = new CodedCUInfo;
+          m_idx[( ( x * numPos + y ) * m_numWidths + wIdx ) * m_numHeights + hIdx] = m_numEntries++;
         }
       }
     }
   }
 }
 
-void CacheBlkInfoCtrl::destroy()
+void CacheBlkIdxMap::destroy()
 {
-  const unsigned numPos = MAX_CU_SIZE >> MIN_CU_LOG2;
+  m_idx.clear();
+  m_numEntries = 0;
+}
 
-  for( unsigned x = 0; x < numPos; x++ )
-  {
-    for( unsigned y = 0; y < numPos; y++ )
-    {
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-      {
-        if( m_codedCUInfo[x][y][wIdx] )
-        {
-          for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
-          {
-            if( m_codedCUInfo[x][y][wIdx][hIdx] )
-            {
-              delete m_codedCUInfo[x][y][wIdx][hIdx];
-            }
-          }
+void CacheBlkInfoCtrl::create()
+{
+  m_codedCUInfoIdx.create();
 
-          delete[] m_codedCUInfo[x][y][wIdx];
-        }
-      }
+  m_codedCUInfo = new CodedCUInfo[m_codedCUInfoIdx.numEntries()];
+}
 
-      delete[] m_codedCUInfo[x][y];
-    }
-  }
+void CacheBlkInfoCtrl::destroy()
+{
+  delete[] m_codedCUInfo;
+  m_codedCUInfo = nullptr;
+
+  m_codedCUInfoIdx.destroy();
 }
 
 void CacheBlkInfoCtrl::init( const Slice &slice )
 {
-  const unsigned numPos = MAX_CU_SIZE >> MIN_CU_LOG2;
-
-  for( unsigned x = 0; x < numPos; x++ )
-  {
-    for( unsigned y = 0; y < numPos; y++ )
-    {
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-      {
-        if( m_codedCUInfo[x][y][wIdx] )
-        {
-          for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
-          {
-            if( m_codedCUInfo[x][y][wIdx][hIdx] )
-            {
-              memset( m_codedCUInfo[x][y][wIdx][hIdx], 0, sizeof( CodedCUInfo ) );
-            }
-          }
-        }
-      }
-    }
-  }
+  memset( m_codedCUInfo, 0, sizeof( CodedCUInfo ) * m_codedCUInfoIdx.numEntries() );
 
   m_slice_chblk = &slice;
 }
 
 CodedCUInfo& CacheBlkInfoCtrl::getBlkInfo( const UnitArea& area )
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+  const int idx = m_codedCUInfoIdx.getIdx( area.Y(), *m_slice_chblk->getPPS()->pcv );
 
-  return *m_codedCUInfo[idx1][idx2][idx3][idx4];
+  return m_codedCUInfo[idx];
 }
 
 bool CacheBlkInfoCtrl::isSkip( const UnitArea& area )
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+  const int idx = m_codedCUInfoIdx.getIdx( area.Y(), *m_slice_chblk->getPPS()->pcv );
 
-  return m_codedCUInfo[idx1][idx2][idx3][idx4]->isSkip;
+  return m_codedCUInfo[idx].isSkip;
 }
 
 char CacheBlkInfoCtrl::getSelectColorSpaceOption(const UnitArea& area)
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx(area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4);
+  const int idx = m_codedCUInfoIdx.getIdx( area.Y(), *m_slice_chblk->getPPS()->pcv );
 
-  return m_codedCUInfo[idx1][idx2][idx3][idx4]->selectColorSpaceOption;
+  return m_codedCUInfo[idx].selectColorSpaceOption;
 }
 
 bool CacheBlkInfoCtrl::isMMVDSkip(const UnitArea& area)
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx(area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4);
+  const int idx = m_codedCUInfoIdx.getIdx( area.Y(), *m_slice_chblk->getPPS()->pcv );
 
-  return m_codedCUInfo[idx1][idx2][idx3][idx4]->isMMVDSkip;
+  return m_codedCUInfo[idx].isMMVDSkip;
 }
 
 void CacheBlkInfoCtrl::setMv( const UnitArea& area, const RefPicList refPicList, const int iRefIdx, const Mv& rMv )
 {
   if( iRefIdx >= MAX_STORED_CU_INFO_REFS ) return;
 
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+  const int idx = m_codedCUInfoIdx.getIdx( area.Y(), *m_slice_chblk->getPPS()->pcv );
 
-  m_codedCUInfo[idx1][idx2][idx3][idx4]->saveMv [refPicList][iRefIdx] = rMv;
-  m_codedCUInfo[idx1][idx2][idx3][idx4]->validMv[refPicList][iRefIdx] = true;
+  m_codedCUInfo[idx].saveMv [refPicList][iRefIdx] = rMv;
+  m_codedCUInfo[idx].validMv[refPicList][iRefIdx] = true;
 }
 
 bool CacheBlkInfoCtrl::getMv( const UnitArea& area, const RefPicList refPicList, const int iRefIdx, Mv& rMv ) const
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+  const int idx = m_codedCUInfoIdx.getIdx( area.Y(), *m_slice_chblk->getPPS()->pcv );
 
   if( iRefIdx >= MAX_STORED_CU_INFO_REFS )
   {
-    rMv = m_codedCUInfo[idx1][idx2][idx3][idx4]->saveMv[refPicList][0];
+    rMv = m_codedCUInfo[idx].saveMv[refPicList][0];
     return false;
   }
 
-  rMv = m_codedCUInfo[idx1][idx2][idx3][idx4]->saveMv[refPicList][iRefIdx];
-  return m_codedCUInfo[idx1][idx2][idx3][idx4]->validMv[refPicList][iRefIdx];
+  rMv = m_codedCUInfo[idx].saveMv[refPicList][iRefIdx];
+  return m_codedCUInfo[idx].validMv[refPicList][iRefIdx];
 }
 
 void SaveLoadEncInfoSbt::init( const Slice &slice )
@@ -598,26 +593,70 @@ void SaveLoadEncInfoSbt::resetSaveloadSbt( int maxSbtSize )
   }
 }
 
+void SaveLoadEncInfoSbt::copyState( const SaveLoadEncInfoSbt& other, const Area& area )
+{
+  m_sliceSbt = other.m_sliceSbt;
+
+  const int      numSizeIdx = gp_sizeIdxInfo->idxFrom( SBT_MAX_SIZE ) - MIN_CU_LOG2 + 1;
+  const unsigned x0         = ( area.x & m_sliceSbt->getPPS()->pcv->maxCUWidthMask  ) >> MIN_CU_LOG2;
+  const unsigned y0         = ( area.y & m_sliceSbt->getPPS()->pcv->maxCUHeightMask ) >> MIN_CU_LOG2;
+
+  for( unsigned xIdx = x0; xIdx < x0 + ( area.width >> MIN_CU_LOG2 ); xIdx++ )
+  {
+    for( unsigned yIdx = y0; yIdx < y0 + ( area.height >> MIN_CU_LOG2 ); yIdx++ )
+    {
+      for( int wIdx = 0; wIdx < numSizeIdx; wIdx++ )
+      {
+        memcpy( m_saveLoadSbt[xIdx][yIdx][wIdx], other.m_saveLoadSbt[xIdx][yIdx][wIdx], numSizeIdx * sizeof( SaveLoadStructSbt ) );
+      }
+    }
+  }
+}
+
+void CacheBlkInfoCtrl::copyState( const CacheBlkInfoCtrl& other, const Area& area )
+{
+  m_slice_chblk = other.m_slice_chblk;
+
+  const unsigned x0 = ( area.x & m_slice_chblk->getPPS()->pcv->maxCUWidthMask  ) >> MIN_CU_LOG2;
+  const unsigned y0 = ( area.y & m_slice_chblk->getPPS()->pcv->maxCUHeightMask ) >> MIN_CU_LOG2;
+
+  for( unsigned x = x0; x < x0 + ( area.width >> MIN_CU_LOG2 ); x++ )
+  {
+    for( unsigned y = y0; y < y0 + ( area.height >> MIN_CU_LOG2 ); y++ )
+    {
+      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
+      {
+        for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
+        {
+          const int idx = m_codedCUInfoIdx.getIdx( x, y, wIdx, hIdx );
+
+          if( idx >= 0 )
+          {
+            m_codedCUInfo[idx] = other.m_codedCUInfo[idx];
+          }
+        }
+      }
+    }
+  }
+}
+
 bool CacheBlkInfoCtrl::getInter(const UnitArea& area)
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx(area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4);
+  const int idx = m_codedCUInfoIdx.getIdx( area.Y(), *m_slice_chblk->getPPS()->pcv );
 
-  return m_codedCUInfo[idx1][idx2][idx3][idx4]->isInter;
+  return m_codedCUInfo[idx].isInter;
 }
 void CacheBlkInfoCtrl::setBcwIdx(const UnitArea& area, uint8_t gBiIdx)
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx(area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4);
+  const int idx = m_codedCUInfoIdx.getIdx( area.Y(), *m_slice_chblk->getPPS()->pcv );
 
-  m_codedCUInfo[idx1][idx2][idx3][idx4]->BcwIdx = gBiIdx;
+  m_codedCUInfo[idx].BcwIdx = gBiIdx;
 }
 uint8_t CacheBlkInfoCtrl::getBcwIdx(const UnitArea& area)
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx(area.Y(), *m_slice_chblk->getPPS()->pcv, idx1, idx2, idx3, idx4);
+  const int idx = m_codedCUInfoIdx.getIdx( area.Y(), *m_slice_chblk->getPPS()->pcv );
 
-  return m_codedCUInfo[idx1][idx2][idx3][idx4]->BcwIdx;
+  return m_codedCUInfo[idx].BcwIdx;
 }
 
 #if REUSE_CU_RESULTS
@@ -659,116 +698,27 @@ static bool isTheSameNbHood( const CodingUnit &cu, const CodingStructure& cs, co
 
 void BestEncInfoCache::create( const ChromaFormat chFmt )
 {
-  const unsigned numPos = MAX_CU_SIZE >> MIN_CU_LOG2;
-
-  m_numWidths  = gp_sizeIdxInfo->numWidths();
-  m_numHeights = gp_sizeIdxInfo->numHeights();
-
-  bool isLog2MttPartitioning = !!dynamic_cast<SizeIndexInfoLog2*>( gp_sizeIdxInfo );
-
-  for( unsigned x = 0; x < numPos; x++ )
-  {
-    for( unsigned y = 0; y < numPos; y++ )
-    {
-      m_bestEncInfo[x][y] = new BestEncodingInfo**[m_numWidths];
-
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-      {
-        if( !( gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( wIdx ) ) && x + ( gp_sizeIdxInfo->sizeFrom( wIdx ) >> MIN_CU_LOG2 ) <= ( MAX_CU_SIZE >> MIN_CU_LOG2 ) ) )
-        {
-          m_bestEncInfo[x][y][wIdx] = nullptr;
-          continue;
-        }
+  m_chromaFormat = chFmt;
 
-        const int wLog2 = floorLog2( gp_sizeIdxInfo->sizeFrom( wIdx ) );
-
-        if( isLog2MttPartitioning && ( ( x << MIN_CU_LOG2 ) & ( ( 1 << ( wLog2 - 1 ) ) - 1 ) ) != 0 )
-        {
-          m_bestEncInfo[x][y][wIdx] = nullptr;
-          continue;
-        }
-
-        m_bestEncInfo[x][y][wIdx] = new BestEncodingInfo*[gp_sizeIdxInfo->numHeights()];
-
-        for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
-        {
-          if( !( gp_sizeIdxInfo->isCuSize( gp_sizeIdxInfo->sizeFrom( hIdx ) ) && y + ( gp_sizeIdxInfo->sizeFrom( hIdx ) >> MIN_CU_LOG2 ) <= ( MAX_CU_SIZE >> MIN_CU_LOG2 ) ) )
-          {
-            m_bestEncInfo[x][y][wIdx][hIdx] = nullptr;
-            continue;
-          }
-
-          const int hLog2 = floorLog2( gp_sizeIdxInfo->sizeFrom( hIdx ) );
-
-          if( isLog2MttPartitioning && ( ( ( y << MIN_CU_LOG2 ) & ( ( 1 << ( hLog2 - 1 ) ) - 1 ) ) != 0 ) )
-          {
-            m_bestEncInfo[x][y][wIdx][hIdx] = nullptr;
-            continue;
-          }
-
-          m_bestEncInfo[x][y][wIdx][hIdx] = new BestEncodingInfo;
-
-          int w = gp_sizeIdxInfo->sizeFrom( wIdx );
-          int h = gp_sizeIdxInfo->sizeFrom( hIdx );
-
-          const UnitArea area( chFmt, Area( 0, 0, w, h ) );
-
-          new ( &m_bestEncInfo[x][y][wIdx][hIdx]->cu ) CodingUnit    ( area );
-          new ( &m_bestEncInfo[x][y][wIdx][hIdx]->pu ) PredictionUnit( area );
-#if REUSE_CU_RESULTS_WITH_MULTIPLE_TUS
-          m_bestEncInfo[x][y][wIdx][hIdx]->numTus = 0;
-          for( int i = 0; i < MAX_NUM_TUS; i++ )
-          {
-            new ( &m_bestEncInfo[x][y][wIdx][hIdx]->tus[i] ) TransformUnit( area );
-          }
-#else
-          new ( &m_bestEncInfo[x][y][wIdx][hIdx]->tu ) TransformUnit( area );
-#endif
-
-          m_bestEncInfo[x][y][wIdx][hIdx]->poc      = -1;
-          m_bestEncInfo[x][y][wIdx][hIdx]->testMode = EncTestMode();
-        }
-      }
-    }
-  }
+  m_bestEncInfoIdx.create();
+  m_bestEncInfo.assign( m_bestEncInfoIdx.numEntries(), nullptr );
 }
 
 void BestEncInfoCache::destroy()
 {
-  const unsigned numPos = MAX_CU_SIZE >> MIN_CU_LOG2;
-
-  for( unsigned x = 0; x < numPos; x++ )
+  for( BestEncodingInfo* encInfo : m_bestEncInfo )
   {
-    for( unsigned y = 0; y < numPos; y++ )
+    if( encInfo )
     {
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-      {
-        if( m_bestEncInfo[x][y][wIdx] )
-        {
-          for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
-          {
-            if( m_bestEncInfo[x][y][wIdx][hIdx] )
-            {
-              delete m_bestEncInfo[x][y][wIdx][hIdx];
-            }
-          }
-
-          delete[] m_bestEncInfo[x][y][wIdx];
-        }
-      }
-
-      delete[] m_bestEncInfo[x][y];
+      delete[] encInfo->coeff;
+      delete[] encInfo->pcmBuf;
+      delete[] encInfo->runType;
+      delete encInfo;
     }
   }
 
-  delete[] m_pCoeff;
-  delete[] m_pPcmBuf;
-
-  if (m_runType != nullptr)
-  {
-    delete[] m_runType;
-    m_runType = nullptr;
-  }
+  m_bestEncInfo.clear();
+  m_bestEncInfoIdx.destroy();
 }
 
 void BestEncInfoCache::init( const Slice &slice )
@@ -779,106 +729,74 @@ void BestEncInfoCache::init( const Slice &slice )
 
   if( isInitialized ) return;
 
-  const unsigned numPos = MAX_CU_SIZE >> MIN_CU_LOG2;
+  m_dummyCS.pcv = m_slice_bencinf->getPPS()->pcv;
+}
 
-  m_numWidths  = gp_sizeIdxInfo->numWidths();
-  m_numHeights = gp_sizeIdxInfo->numHeights();
+BestEncodingInfo* BestEncInfoCache::xGetBestEncInfo( const Area& area ) const
+{
+  return m_bestEncInfo[m_bestEncInfoIdx.getIdx( area, *m_slice_bencinf->getPPS()->pcv )];
+}
 
-  size_t numCoeff = 0;
+BestEncodingInfo& BestEncInfoCache::xCreateBestEncInfo( const Area& area )
+{
+  BestEncodingInfo*& encInfo = m_bestEncInfo[m_bestEncInfoIdx.getIdx( area, *m_slice_bencinf->getPPS()->pcv )];
 
-  for( unsigned x = 0; x < numPos; x++ )
+  if( encInfo )
   {
-    for( unsigned y = 0; y < numPos; y++ )
-    {
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-      {
-        if( m_bestEncInfo[x][y][wIdx] ) for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
-        {
-          if( m_bestEncInfo[x][y][wIdx][hIdx] )
-          {
-            for( const CompArea& blk : m_bestEncInfo[x][y][wIdx][hIdx]->cu.blocks )
-            {
-              numCoeff += blk.area();
-            }
-          }
-        }
-      }
-    }
+    return *encInfo;
   }
 
+  encInfo = new BestEncodingInfo;
+
+  const UnitArea unitArea( m_chromaFormat, Area( 0, 0, area.width, area.height ) );
+
+  new ( &encInfo->cu ) CodingUnit    ( unitArea );
+  new ( &encInfo->pu ) PredictionUnit( unitArea );
 #if REUSE_CU_RESULTS_WITH_MULTIPLE_TUS
-  m_pCoeff  = new TCoeff[numCoeff*MAX_NUM_TUS];
-  m_pPcmBuf = new Pel   [numCoeff*MAX_NUM_TUS];
-  if (slice.getSPS()->getPLTMode())
-  {
-    m_runType   = new bool[numCoeff*MAX_NUM_TUS];
-  }
+  encInfo->numTus = 0;
 #else
-  m_pCoeff  = new TCoeff[numCoeff];
-  m_pPcmBuf = new Pel   [numCoeff];
-  if (slice.getSPS()->getPLTMode())
-  {
-    m_runType   = new bool[numCoeff];
-  }
+  new ( &encInfo->tu ) TransformUnit ( unitArea );
 #endif
 
-  TCoeff *coeffPtr = m_pCoeff;
-  Pel    *pcmPtr   = m_pPcmBuf;
-  bool   *runTypePtr   = m_runType;
-  m_dummyCS.pcv = m_slice_bencinf->getPPS()->pcv;
+  encInfo->poc      = -1;
+  encInfo->testMode = EncTestMode();
 
-  for( unsigned x = 0; x < numPos; x++ )
-  {
-    for( unsigned y = 0; y < numPos; y++ )
-    {
-      for( int wIdx = 0; wIdx < gp_sizeIdxInfo->numWidths(); wIdx++ )
-      {
-        if( m_bestEncInfo[x][y][wIdx] ) for( int hIdx = 0; hIdx < gp_sizeIdxInfo->numHeights(); hIdx++ )
-        {
-          if( m_bestEncInfo[x][y][wIdx][hIdx] )
-          {
-            TCoeff *coeff[MAX_NUM_TBLOCKS] = { 0, };
-            Pel    *pcmbf[MAX_NUM_TBLOCKS] = { 0, };
-            bool   *runType[MAX_NUM_TBLOCKS - 1] = { 0, };
+  size_t numCoeff = 0;
 
-#if REUSE_CU_RESULTS_WITH_MULTIPLE_TUS
-            for( int i = 0; i < MAX_NUM_TUS; i++ )
-            {
-              TransformUnit &tu = m_bestEncInfo[x][y][wIdx][hIdx]->tus[i];
-              const UnitArea &area = tu;
+  for( const CompArea& blk : unitArea.blocks )
+  {
+    numCoeff += blk.area();
+  }
 
-              for( int i = 0; i < area.blocks.size(); i++ )
-              {
-                coeff[i] = coeffPtr; coeffPtr += area.blocks[i].area();
-                pcmbf[i] = pcmPtr;   pcmPtr += area.blocks[i].area();
-                if (i < 2)
-                {
-                  runType[i]   = runTypePtr;   runTypePtr   += area.blocks[i].area();
-                }
-              }
+  // the TUs of a CU never cover more than the CU itself, so one CU-sized buffer serves all of them
+  encInfo->coeff   = new TCoeff[numCoeff];
+  encInfo->pcmBuf  = new Pel   [numCoeff];
+  encInfo->runType = m_slice_bencinf->getSPS()->getPLTMode() ? new bool[numCoeff] : nullptr;
 
-              tu.cs = &m_dummyCS;
-              tu.init(coeff, pcmbf, runType);
-            }
-#else
-            const UnitArea &area = m_bestEncInfo[x][y][wIdx][hIdx]->tu;
+#if !REUSE_CU_RESULTS_WITH_MULTIPLE_TUS
+  TCoeff *coeff  [MAX_NUM_TBLOCKS]     = { 0, };
+  Pel    *pcmbf  [MAX_NUM_TBLOCKS]     = { 0, };
+  bool   *runType[MAX_NUM_TBLOCKS - 1] = { 0, };
 
-            for( int i = 0; i < area.blocks.size(); i++ )
-            {
-              coeff[i] = coeffPtr; coeffPtr += area.blocks[i].area();
-              pcmbf[i] =   pcmPtr;   pcmPtr += area.blocks[i].area();
-              runType[i] = runTypePtr;     runTypePtr += area.blocks[i].area();
-              runLength[i] = runLengthPtr; runLengthPtr += area.blocks[i].area();
-            }
+  TCoeff *coeffPtr   = encInfo->coeff;
+  Pel    *pcmPtr     = encInfo->pcmBuf;
+  bool   *runTypePtr = encInfo->runType;
 
-            m_bestEncInfo[x][y][wIdx][hIdx]->tu.cs = &m_dummyCS;
-            m_bestEncInfo[x][y][wIdx][hIdx]->tu.init(coeff, pcmbf, runLength, runType);
-#endif
-          }
-        }
-      }
+  for( int i = 0; i < unitArea.blocks.size(); i++ )
+  {
+    coeff[i] = coeffPtr; coeffPtr += unitArea.blocks[i].area();
+    pcmbf[i] =   pcmPtr;   pcmPtr += unitArea.blocks[i].area();
+    if( i < 2 && runTypePtr )
+    {
+      runType[i] = runTypePtr; runTypePtr += unitArea.blocks[i].area();
     }
   }
+
+  encInfo->tu.cs = &m_dummyCS;
+  encInfo->tu.init( coeff, pcmbf, runType );
+#endif
+
+  return *encInfo;
 }
 
 bool BestEncInfoCache::setFromCs( const CodingStructure& cs, const Partitioner& partitioner )
@@ -892,10 +810,7 @@ bool BestEncInfoCache::setFromCs( const CodingStructure& cs, const Partitioner&
     return false;
   }
 
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( cs.area.Y(), *m_slice_bencinf->getPPS()->pcv, idx1, idx2, idx3, idx4 );
-
-  BestEncodingInfo& encInfo = *m_bestEncInfo[idx1][idx2][idx3][idx4];
+  BestEncodingInfo& encInfo = xCreateBestEncInfo( cs.area.Y() );
 
   encInfo.poc            =  cs.picture->poc;
   encInfo.cu.repositionTo( *cs.cus.front() );
@@ -906,19 +821,49 @@ bool BestEncInfoCache::setFromCs( const CodingStructure& cs, const Partitioner&
   encInfo.cu             = *cs.cus.front();
   encInfo.pu             = *cs.pus.front();
 #if REUSE_CU_RESULTS_WITH_MULTIPLE_TUS
+  CHECKD( cs.tus.size() > MAX_NUM_TUS, "Exceeding tus array boundaries" );
+
+  TCoeff *coeffPtr   = encInfo.coeff;
+  Pel    *pcmPtr     = encInfo.pcmBuf;
+  bool   *runTypePtr = encInfo.runType;
+
   int tuIdx = 0;
   for( auto tu : cs.tus )
   {
-    encInfo.tus[tuIdx].repositionTo( *tu );
-    encInfo.tus[tuIdx].resizeTo( *tu );
+    if( tuIdx == encInfo.tus.size() )
+    {
+      encInfo.tus.emplace_back( encInfo.cu );
+      encInfo.tus.back().cs = &m_dummyCS;
+    }
+
+    TransformUnit &encTu = encInfo.tus[tuIdx];
+
+    encTu.repositionTo( *tu );
+    encTu.resizeTo( *tu );
+
+    TCoeff *coeff  [MAX_NUM_TBLOCKS]     = { 0, };
+    Pel    *pcmbf  [MAX_NUM_TBLOCKS]     = { 0, };
+    bool   *runType[MAX_NUM_TBLOCKS - 1] = { 0, };
+
+    for( int i = 0; i < encTu.blocks.size(); i++ )
+    {
+      coeff[i] = coeffPtr; coeffPtr += encTu.blocks[i].area();
+      pcmbf[i] =   pcmPtr;   pcmPtr += encTu.blocks[i].area();
+      if( i < 2 && runTypePtr )
+      {
+        runType[i] = runTypePtr; runTypePtr += encTu.blocks[i].area();
+      }
+    }
+
+    encTu.init( coeff, pcmbf, runType );
+
     for( auto &blk : tu->blocks )
     {
       if( blk.valid() )
-        encInfo.tus[tuIdx].copyComponentFrom( *tu, blk.compID );
+        encTu.copyComponentFrom( *tu, blk.compID );
     }
     tuIdx++;
   }
-  CHECKD( cs.tus.size() > MAX_NUM_TUS, "Exceeding tus array boundaries" );
   encInfo.numTus = cs.tus.size();
 #else
   for( auto &blk : cs.tus.front()->blocks )
@@ -937,10 +882,14 @@ bool BestEncInfoCache::isValid( const CodingStructure& cs, const Partitioner& pa
   {
     return false; //if save & load is allowed for chroma CUs, we should check whether luma info (pred, recon, etc) is the same, which is quite complex
   }
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( cs.area.Y(), *m_slice_bencinf->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+  const BestEncodingInfo* pEncInfo = xGetBestEncInfo( cs.area.Y() );
+
+  if( !pEncInfo )
+  {
+    return false;
+  }
 
-  BestEncodingInfo& encInfo = *m_bestEncInfo[idx1][idx2][idx3][idx4];
+  const BestEncodingInfo& encInfo = *pEncInfo;
 
   if( encInfo.cu.treeType != partitioner.treeType || encInfo.cu.modeType != partitioner.modeType )
   {
@@ -965,10 +914,14 @@ bool BestEncInfoCache::isValid( const CodingStructure& cs, const Partitioner& pa
 
 bool BestEncInfoCache::setCsFrom( CodingStructure& cs, EncTestMode& testMode, const Partitioner& partitioner ) const
 {
-  unsigned idx1, idx2, idx3, idx4;
-  getAreaIdx( cs.area.Y(), *m_slice_bencinf->getPPS()->pcv, idx1, idx2, idx3, idx4 );
+  const BestEncodingInfo* pEncInfo = xGetBestEncInfo( cs.area.Y() );
+
+  if( !pEncInfo )
+  {
+    return false;
+  }
 
-  BestEncodingInfo& encInfo = *m_bestEncInfo[idx1][idx2][idx3][idx4];
+  const BestEncodingInfo& encInfo = *pEncInfo;
 
   if( cs.picture->poc != encInfo.poc || CS::getArea( cs, cs.area, partitioner.chType ) != CS::getArea( cs, encInfo.cu, partitioner.chType ) || !isTheSameNbHood( encInfo.cu, cs, partitioner
     , encInfo.pu, (cs.picture->Y().width), (cs.picture->Y().height)
@@ -1388,6 +1341,19 @@ void EncModeCtrlMTnoRQT::finishCULevel( Partitioner &partitioner )
   m_ComprCUCtxList.pop_back();
 }
 
+void EncModeCtrlMTnoRQT::copyState( const EncModeCtrl& other, const Area& area )
+{
+  const EncModeCtrlMTnoRQT* pOther = dynamic_cast<const EncModeCtrlMTnoRQT*>( &other );
+  CHECK( !pOther, "Trying to copy state from an incompatible mode control" );
+
+  EncModeCtrl       ::copyState( *pOther, area );
+  CacheBlkInfoCtrl  ::copyState( *pOther, area );
+  SaveLoadEncInfoSbt::copyState( *pOther, area );
+  // the reuse cache stays with the stack, its entries are only taken over for the same neighbourhood
+
+  m_skipThreshold = pOther->m_skipThreshold;
+}
+
 
 bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner )
 {
@@ -1836,9 +1802,9 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
     {
       unsigned idx1, idx2, idx3, idx4;
       getAreaIdx(partitioner.currArea().Y(), *slice.getPPS()->pcv, idx1, idx2, idx3, idx4);
-      if (g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4])
+      if (m_pcInterSearch->isReusedUniMvsFilled(idx1, idx2, idx3, idx4))
       {
-        m_pcInterSearch->insertUniMvCands(partitioner.currArea().Y(), g_reusedUniMVs[idx1][idx2][idx3][idx4]);
+        m_pcInterSearch->insertUniMvCands(partitioner.currArea().Y(), m_pcInterSearch->getReusedUniMvs(idx1, idx2, idx3, idx4));
       }
     }
     if( !bestCS || ( bestCS && isModeSplit( bestMode ) ) )
@@ -282,6 +282,8 @@ protected:
   InterSearch*          m_pcInterSearch;
 
   bool                  m_doPlt;
+  PartSplit             m_parallelSplit;        ///< modes tested at the split-parallel CU level: the given split, or all non-split modes for CU_DONT_SPLIT
+  unsigned              m_parallelSplitLevel;   ///< size of the CU context list at the split-parallel CU level, 0 if no split job is evaluated
 
 public:
 
@@ -303,6 +305,10 @@ public:
   virtual bool checkSkipOtherLfnst  ( const EncTestMode& encTestmode, CodingStructure*& tempCS,  Partitioner& partitioner ) = 0;
 
   void         init                 ( EncCfg *pCfg, RateCtrl *pRateCtrl, RdCost *pRdCost );
+  virtual void copyState            ( const EncModeCtrl& other, const Area& area );
+  int          getParallelSplitJobs ( const CodingStructure &cs, Partitioner& partitioner, PartSplit jobs[PARL_SPLIT_MAX_NUM_JOBS] ) const;
+  void         setParallelSplitJob  ( const PartSplit split ) { m_parallelSplit = split; m_parallelSplitLevel = unsigned( m_ComprCUCtxList.size() ) + 1; }
+  void         resetParallelSplitJob()                        { m_parallelSplitLevel = 0; m_ComprCUCtxList.clear(); }
   bool         tryModeMaster        ( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner );
   bool         nextMode             ( const CodingStructure &cs, Partitioner &partitioner );
   EncTestMode  currTestMode         () const;
@@ -781,10 +787,39 @@ private:
 public:
   virtual  ~SaveLoadEncInfoSbt() { }
   void     resetSaveloadSbt( int maxSbtSize );
+  void     copyState( const SaveLoadEncInfoSbt& other, const Area& area );
   uint16_t findBestSbt( const UnitArea& area, const uint32_t curPuSse );
   bool     saveBestSbt( const UnitArea& area, const uint32_t curPuSse, const uint8_t curPuSbt, const uint8_t curPuTrs );
 };
 
+// maps the (x, y, width index, height index) of a block within a CTU onto a dense index,
+// counting only the block sizes and positions the partitioning can actually produce
+class CacheBlkIdxMap
+{
+private:
+
+  unsigned         m_numWidths, m_numHeights;
+  std::vector<int> m_idx;
+  unsigned         m_numEntries;
+
+public:
+
+  void     create    ();
+  void     destroy   ();
+
+  unsigned numEntries() const { return m_numEntries; }
+  int      getIdx    ( unsigned x, unsigned y, unsigned wIdx, unsigned hIdx ) const
+  {
+    return m_idx[( ( x * ( MAX_CU_SIZE >> MIN_CU_LOG2 ) + y ) * m_numWidths + wIdx ) * m_numHeights + hIdx];
+  }
+  int      getIdx    ( const Area& area, const PreCalcValues &pcv ) const
+  {
+    unsigned idx1, idx2, idx3, idx4;
+    getAreaIdx( area, pcv, idx1, idx2, idx3, idx4 );
+    return getIdx( idx1, idx2, idx3, idx4 );
+  }
+};
+
 static const int MAX_STORED_CU_INFO_REFS = 4;
 
 struct CodedCUInfo
@@ -811,10 +846,10 @@ class CacheBlkInfoCtrl
 {
 private:
 
-  unsigned         m_numWidths, m_numHeights;
   Slice const     *m_slice_chblk;
   // x in CTU, y in CTU, width, height
-  CodedCUInfo   ***m_codedCUInfo[MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2];
+  CacheBlkIdxMap   m_codedCUInfoIdx;
+  CodedCUInfo     *m_codedCUInfo;
 
 protected:
 
@@ -826,6 +861,7 @@ protected:
 
 public:
 
+  CacheBlkInfoCtrl() : m_slice_chblk( nullptr ), m_codedCUInfo( nullptr ) {}
   virtual ~CacheBlkInfoCtrl() {}
 
   bool isSkip ( const UnitArea& area );
@@ -838,6 +874,8 @@ public:
   uint8_t getBcwIdx( const UnitArea& area );
 
   char  getSelectColorSpaceOption(const UnitArea& area);
+
+  void  copyState( const CacheBlkInfoCtrl& other, const Area& area );
 };
 
 #if REUSE_CU_RESULTS
@@ -846,7 +884,7 @@ struct BestEncodingInfo
   CodingUnit     cu;
   PredictionUnit pu;
 #if REUSE_CU_RESULTS_WITH_MULTIPLE_TUS
-  TransformUnit  tus[MAX_NUM_TUS];
+  std::vector<TransformUnit> tus;
   size_t         numTus;
 #else
   TransformUnit  tu;
@@ -854,21 +892,29 @@ struct BestEncodingInfo
   EncTestMode    testMode;
 
   int            poc;
+
+  // residual storage for the area of the CU, split between its TUs when the info is stored
+  TCoeff        *coeff;
+  Pel           *pcmBuf;
+  bool          *runType;
 };
 
 class BestEncInfoCache
 {
 private:
 
-  unsigned            m_numWidths, m_numHeights;
+  ChromaFormat        m_chromaFormat;
   const Slice        *m_slice_bencinf;
-  BestEncodingInfo ***m_bestEncInfo[MAX_CU_SIZE >> MIN_CU_LOG2][MAX_CU_SIZE >> MIN_CU_LOG2];
-  TCoeff             *m_pCoeff;
-  Pel                *m_pPcmBuf;
-  bool               *m_runType;
+  // entries are only allocated once a result is stored for that block
+  CacheBlkIdxMap      m_bestEncInfoIdx;
+  std::vector<BestEncodingInfo*>
+                      m_bestEncInfo;
   CodingStructure     m_dummyCS;
   XUCache             m_dummyCache;
 
+  BestEncodingInfo*   xGetBestEncInfo   ( const Area& area ) const;
+  BestEncodingInfo&   xCreateBestEncInfo( const Area& area );
+
 protected:
 
   void create   ( const ChromaFormat chFmt );
@@ -878,7 +924,7 @@ protected:
   bool isValid  ( const CodingStructure &cs, const Partitioner &partitioner, int qp );
 public:
 
-  BestEncInfoCache() : m_slice_bencinf( nullptr ), m_dummyCS( m_dummyCache.cuCache, m_dummyCache.puCache, m_dummyCache.tuCache ) {}
+  BestEncInfoCache() : m_chromaFormat( NUM_CHROMA_FORMAT ), m_slice_bencinf( nullptr ), m_dummyCS( m_dummyCache.cuCache, m_dummyCache.puCache, m_dummyCache.tuCache ) {}
   virtual ~BestEncInfoCache() {}
   void     init     ( const Slice &slice );
   bool     setCsFrom( CodingStructure& cs, EncTestMode& testMode, const Partitioner& partitioner ) const;
@@ -931,6 +977,7 @@ public:
   virtual void initCTUEncoding    ( const Slice &slice );
   virtual void initCULevel        ( Partitioner &partitioner, const CodingStructure& cs );
   virtual void finishCULevel      ( Partitioner &partitioner );
+  virtual void copyState          ( const EncModeCtrl& other, const Area& area );
 
   virtual bool tryMode            ( const EncTestMode& encTestmode, const CodingStructure &cs, Partitioner& partitioner );
   virtual bool useModeResult      ( const EncTestMode& encTestmode, CodingStructure*& tempCS,  Partitioner& partitioner );
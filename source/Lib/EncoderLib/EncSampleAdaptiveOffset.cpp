@@ -277,13 +277,6 @@ void EncSampleAdaptiveOffset::getStatistics(std::vector<SAOStatData**>& blkStats
   const PreCalcValues& pcv = *cs.pcv;
   const int numberOfComponents = getNumberValidComponents(pcv.chrFormat);
 
-  size_t lineBufferSize = pcv.maxCUWidth + 1;
-  if (m_signLineBuf1.size() != lineBufferSize)
-  {
-    m_signLineBuf1.resize(lineBufferSize);
-    m_signLineBuf2.resize(lineBufferSize);
-  }
-
   int ctuRsAddr = 0;
   for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
   {
@@ -1130,12 +1123,23 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                         , bool isCtuCrossedByVirtualBoundaries, int horVirBndryPos[], int verVirBndryPos[], int numHorVirBndry, int numVerVirBndry
                         )
 {
-  int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
-  int8_t signLeft, signRight, signDown;
+  int x,y, startX, startY, endX, endY, firstLineStartX, firstLineEndX;
   int64_t *diff, *count;
   Pel *srcLine, *orgLine;
   int* skipLinesR = m_skipLinesR[compIdx];
   int* skipLinesB = m_skipLinesB[compIdx];
+  const int numVer = isCtuCrossedByVirtualBoundaries ? numVerVirBndry : 0;
+  const int numHor = isCtuCrossedByVirtualBoundaries ? numHorVirBndry : 0;
+
+  // the edge class of a sample follows from the signs towards its two neighbours at srcLine[x + offsetA] and
+  // srcLine[x + offsetB], samples next to a virtual boundary are not counted
+  auto statsLine = [&]( const int lineY, const int lineStartX, const int lineEndX, const int offsetA, const int offsetB, const int lineNumVer, const int lineNumHor )
+  {
+    forEachEnabledSegment( lineY, lineStartX, lineEndX, lineNumVer, lineNumHor, verVirBndryPos, horVirBndryPos, [&]( const int segStartX, const int segEndX )
+    {
+      m_calcStatsLineEO( srcLine, orgLine, offsetA, offsetB, segStartX, segEndX, diff, count );
+    } );
+  };
 
   for(int typeIdx=0; typeIdx< NUM_SAO_NEW_TYPES; typeIdx++)
   {
@@ -1161,21 +1165,7 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                                                  ;
         for (y=0; y<endY; y++)
         {
-          signLeft = (int8_t)sgn(srcLine[startX] - srcLine[startX-1]);
-          for (x=startX; x<endX; x++)
-          {
-            signRight =  (int8_t)sgn(srcLine[x] - srcLine[x+1]);
-            if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y, numVerVirBndry, 0, verVirBndryPos, horVirBndryPos))
-            {
-              signLeft = -signRight;
-              continue;
-            }
-            edgeType  =  signRight + signLeft;
-            signLeft  = -signRight;
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
+          statsLine( y, startX, endX, -1, 1, numVer, 0 );
           srcLine  += srcStride;
           orgLine  += orgStride;
         }
@@ -1188,21 +1178,7 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
 
             for(y=0; y<skipLinesB[typeIdx]; y++)
             {
-              signLeft = (int8_t)sgn(srcLine[startX] - srcLine[startX-1]);
-              for (x=startX; x<endX; x++)
-              {
-                signRight =  (int8_t)sgn(srcLine[x] - srcLine[x+1]);
-                if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, endY + y, numVerVirBndry, 0, verVirBndryPos, horVirBndryPos))
-                {
-                  signLeft = -signRight;
-                  continue;
-                }
-                edgeType  =  signRight + signLeft;
-                signLeft  = -signRight;
-
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
+              statsLine( endY + y, startX, endX, -1, 1, numVer, 0 );
               srcLine  += srcStride;
               orgLine  += orgStride;
             }
@@ -1214,7 +1190,6 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
       {
         diff +=2;
         count+=2;
-        int8_t *signUpLine = &m_signLineBuf1[0];
 
         startX = (!isCalculatePreDeblockSamples) ? 0
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : width)
@@ -1230,31 +1205,9 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
           orgLine += orgStride;
         }
 
-        Pel* srcLineAbove = srcLine - srcStride;
-        for (x=startX; x<endX; x++)
-        {
-          signUpLine[x] = (int8_t)sgn(srcLine[x] - srcLineAbove[x]);
-        }
-
-        Pel* srcLineBelow;
         for (y=startY; y<endY; y++)
         {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown  = (int8_t)sgn(srcLine[x] - srcLineBelow[x]);
-            if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y, 0, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-            {
-              signUpLine[x] = -signDown;
-              continue;
-            }
-            edgeType  = signDown + signUpLine[x];
-            signUpLine[x]= -signDown;
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-          }
+          statsLine( y, startX, endX, -srcStride, srcStride, 0, numHor );
           srcLine += srcStride;
           orgLine += orgStride;
         }
@@ -1262,24 +1215,9 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
         {
           if(isBelowAvail)
           {
-            startX = 0;
-            endX   = width;
-
             for(y=0; y<skipLinesB[typeIdx]; y++)
             {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y + endY, 0, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-                {
-                  continue;
-                }
-                edgeType = sgn(srcLine[x] - srcLineBelow[x]) + sgn(srcLine[x] - srcLineAbove[x]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
+              statsLine( endY + y, 0, width, -srcStride, srcStride, 0, numHor );
               srcLine  += srcStride;
               orgLine  += orgStride;
             }
@@ -1292,10 +1230,6 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
       {
         diff +=2;
         count+=2;
-        int8_t *signUpLine, *signDownLine, *signTmpLine;
-
-        signUpLine  = &m_signLineBuf1[0];
-        signDownLine= &m_signLineBuf2[0];
 
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -1306,56 +1240,17 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line's upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX; x<endX+1; x++)
-        {
-          signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x-1]);
-        }
-
         //1st line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, 0, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-          {
-            continue;
-          }
-          edgeType = sgn(srcLine[x] - srcLineAbove[x-1]) - signUpLine[x+1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
+        statsLine( 0, firstLineStartX, firstLineEndX, -srcStride - 1, srcStride + 1, numVer, numHor );
         srcLine  += srcStride;
         orgLine  += orgStride;
 
-
         //middle lines
         for (y=1; y<endY; y++)
         {
-          srcLineBelow = srcLine + srcStride;
-
-          for (x=startX; x<endX; x++)
-          {
-            signDown = (int8_t)sgn(srcLine[x] - srcLineBelow[x+1]);
-            if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-            {
-              signDownLine[x + 1] = -signDown;
-              continue;
-            }
-            edgeType = signDown + signUpLine[x];
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signDownLine[x+1] = -signDown;
-          }
-          signDownLine[startX] = (int8_t)sgn(srcLineBelow[startX] - srcLine[startX-1]);
-
-          signTmpLine  = signUpLine;
-          signUpLine   = signDownLine;
-          signDownLine = signTmpLine;
-
+          statsLine( y, startX, endX, -srcStride - 1, srcStride + 1, numVer, numHor );
           srcLine += srcStride;
           orgLine += orgStride;
         }
@@ -1368,19 +1263,7 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
 
             for(y=0; y<skipLinesB[typeIdx]; y++)
             {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x< endX; x++)
-              {
-                if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y + endY, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-                {
-                  continue;
-                }
-                edgeType = sgn(srcLine[x] - srcLineBelow[x+1]) + sgn(srcLine[x] - srcLineAbove[x-1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
+              statsLine( endY + y, startX, endX, -srcStride - 1, srcStride + 1, numVer, numHor );
               srcLine  += srcStride;
               orgLine  += orgStride;
             }
@@ -1392,7 +1275,6 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
       {
         diff +=2;
         count+=2;
-        int8_t *signUpLine = &m_signLineBuf1[1];
 
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -1402,57 +1284,21 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
                                                  ;
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
 
-        //prepare 2nd line upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX-1; x<endX; x++)
-        {
-          signUpLine[x] = (int8_t)sgn(srcLineBelow[x] - srcLine[x+1]);
-        }
-
-
         //first line
-        Pel* srcLineAbove = srcLine - srcStride;
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX)
                                                           : startX
                                                           ;
         firstLineEndX   = (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX)
                                                           : endX
                                                           ;
-        for(x=firstLineStartX; x<firstLineEndX; x++)
-        {
-          if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, 0, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-          {
-            continue;
-          }
-          edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) - signUpLine[x-1];
-          diff [edgeType] += (orgLine[x] - srcLine[x]);
-          count[edgeType] ++;
-        }
-
+        statsLine( 0, firstLineStartX, firstLineEndX, -srcStride + 1, srcStride - 1, numVer, numHor );
         srcLine += srcStride;
         orgLine += orgStride;
 
         //middle lines
         for (y=1; y<endY; y++)
         {
-          srcLineBelow = srcLine + srcStride;
-
-          for(x=startX; x<endX; x++)
-          {
-            signDown = (int8_t)sgn(srcLine[x] - srcLineBelow[x-1]);
-            if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-            {
-              signUpLine[x - 1] = -signDown;
-              continue;
-            }
-            edgeType = signDown + signUpLine[x];
-
-            diff [edgeType] += (orgLine[x] - srcLine[x]);
-            count[edgeType] ++;
-
-            signUpLine[x-1] = -signDown;
-          }
-          signUpLine[endX-1] = (int8_t)sgn(srcLineBelow[endX-1] - srcLine[endX]);
+          statsLine( y, startX, endX, -srcStride + 1, srcStride - 1, numVer, numHor );
           srcLine  += srcStride;
           orgLine  += orgStride;
         }
@@ -1465,19 +1311,7 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
 
             for(y=0; y<skipLinesB[typeIdx]; y++)
             {
-              srcLineBelow = srcLine + srcStride;
-              srcLineAbove = srcLine - srcStride;
-
-              for (x=startX; x<endX; x++)
-              {
-                if (isCtuCrossedByVirtualBoundaries && isProcessDisabled(x, y + endY, numVerVirBndry, numHorVirBndry, verVirBndryPos, horVirBndryPos))
-                {
-                  continue;
-                }
-                edgeType = sgn(srcLine[x] - srcLineBelow[x-1]) + sgn(srcLine[x] - srcLineAbove[x+1]);
-                diff [edgeType] += (orgLine[x] - srcLine[x]);
-                count[edgeType] ++;
-              }
+              statsLine( endY + y, startX, endX, -srcStride + 1, srcStride - 1, numVer, numHor );
               srcLine  += srcStride;
               orgLine  += orgStride;
             }
@@ -46,6 +46,10 @@
 
 
 #include <math.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 
 //! \ingroup EncoderLib
 //! \{
@@ -1315,7 +1319,10 @@ void EncSlice::setSearchRange( Slice* pcSlice )
     {
       iRefPOC = pcSlice->getRefPic(e, iRefIdx)->getPOC();
       int newSearchRange = Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
-      m_pcInterSearch->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+      for( int jId = 0; jId < m_pcLib->getNumCuEncStacks(); jId++ )
+      {
+        m_pcLib->getInterSearch( jId )->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+      }
     }
   }
 }
@@ -1491,7 +1498,10 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
 
   m_CABACEstimator->initCtxModels( *pcSlice );
 
-  m_pcCuEncoder->getModeCtrl()->setFastDeltaQp(bFastDeltaQP);
+  for( int jId = 0; jId < m_pcLib->getNumCuEncStacks(); jId++ )
+  {
+    m_pcLib->getCuEncoder( jId )->getModeCtrl()->setFastDeltaQp(bFastDeltaQP);
+  }
 
 
   //------------------------------------------------------------------------------
@@ -1546,14 +1556,17 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
 #endif // ENABLE_QPA
 
   bool checkPLTRatio = m_pcCfg->getIntraPeriod() != 1 && pcSlice->isIRAP();
-  if (checkPLTRatio)
+  for( int jId = 0; jId < m_pcLib->getNumCuEncStacks(); jId++ )
   {
-    m_pcCuEncoder->getModeCtrl()->setPltEnc(true);
-  }
-  else
-  {
-    bool doPlt = m_pcLib->getPltEnc();
-    m_pcCuEncoder->getModeCtrl()->setPltEnc(doPlt);
+    if (checkPLTRatio)
+    {
+      m_pcLib->getCuEncoder( jId )->getModeCtrl()->setPltEnc(true);
+    }
+    else
+    {
+      bool doPlt = m_pcLib->getPltEnc();
+      m_pcLib->getCuEncoder( jId )->getModeCtrl()->setPltEnc(doPlt);
+    }
   }
 
 #if K0149_BLOCK_STATISTICS
@@ -1561,9 +1574,12 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
   CHECK(sps == 0, "No SPS present");
   writeBlockStatisticsHeader(sps);
 #endif
-  m_pcInterSearch->resetAffineMVList();
-  m_pcInterSearch->resetUniMvList();
-  ::memset(g_isReusedUniMVsFilled, 0, sizeof(g_isReusedUniMVsFilled));
+  for( int jId = 0; jId < m_pcLib->getNumCuEncStacks(); jId++ )
+  {
+    m_pcLib->getInterSearch( jId )->resetAffineMVList();
+    m_pcLib->getInterSearch( jId )->resetUniMvList();
+    m_pcLib->getInterSearch( jId )->resetReusedUniMvs();
+  }
   encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, m_pcLib );
   if (checkPLTRatio)
   {
@@ -1717,6 +1733,36 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
   }
 
+  if( pEncLib->getNumWppThreads() > 1 )
+  {
+    xEncodeCtusWpp( pcPic, pEncLib );
+    return;
+  }
+
+  // the additional CU encoding stacks evaluate sibling split modes, each of them reconstructing into its own picture buffers
+  std::mutex picCsMutex;
+  const int  numSplitJobs = pEncLib->getNumCuEncStacks() - 1;
+  if( numSplitJobs > 0 )
+  {
+    if( cs.slice->getSliceType() == B_SLICE )
+    {
+      resetBcwCodingOrder( false, cs );
+    }
+    xInitCuEncStacks( pcSlice, pEncLib, pEncLib->getNumCuEncStacks() );
+
+    // the unit vectors of the picture must not be reallocated while the jobs are reading from them
+    const size_t maxNumUnits = 2 * cs.unitScale[COMPONENT_Y].scale( cs.area.blocks[COMPONENT_Y].size() ).area();
+    cs.cus.reserve( maxNumUnits );
+    cs.pus.reserve( maxNumUnits );
+    cs.tus.reserve( maxNumUnits );
+
+    pcPic->startSplitParallel( numSplitJobs, pcv.maxCUWidth );
+    for( int jId = 1; jId <= numSplitJobs; jId++ )
+    {
+      pEncLib->getCuEncoder( jId )->setPicCsMutex( &picCsMutex );
+    }
+  }
+
   // for every CTU in the slice
   for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
   {
@@ -1990,6 +2036,15 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
   }
 
+  if( numSplitJobs > 0 )
+  {
+    for( int jId = 1; jId <= numSplitJobs; jId++ )
+    {
+      pEncLib->getCuEncoder( jId )->setPicCsMutex( nullptr );
+    }
+    pcPic->finishSplitParallel();
+  }
+
   // this is wpp exclusive section
 
 //  m_uiPicTotalBits += actualBits;
@@ -1997,6 +2052,244 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
 
 }
 
+void EncSlice::xEncodeCtusWpp( Picture* pcPic, EncLib* pEncLib )
+{
+  CodingStructure&     cs          = *pcPic->cs;
+  Slice*               pcSlice     = cs.slice;
+  const PreCalcValues& pcv         = *cs.pcv;
+  const uint32_t       widthInCtus = pcv.widthInCtus;
+  EncCfg*              pCfg        = pEncLib;
+
+  CHECK( !pEncLib->getEntropyCodingSyncEnabledFlag(), "Parallel CTU row encoding requires entropy coding sync" );
+
+  // split the slice into CTU lines, i.e. the CTU rows inside of each tile, every one of them starting a new substream
+  std::vector<uint32_t> lineStart;
+  std::vector<bool>     lineAboveAvail;
+  for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
+  {
+    const uint32_t ctuRsAddr = pcSlice->getCtuAddrInSlice( ctuIdx );
+    if( ctuIdx == 0 || cs.pps->ctuIsTileColBd( ctuRsAddr % widthInCtus ) )
+    {
+      // the line above belongs to the same slice and tile unless a new slice or tile starts
+      lineAboveAvail.push_back( ctuIdx > 0 && !cs.pps->ctuIsTileRowBd( ctuRsAddr / widthInCtus ) );
+      lineStart.push_back( ctuIdx );
+    }
+  }
+  const int numLines = (int) lineStart.size();
+  lineStart.push_back( pcSlice->getNumCtuInSlice() );
+
+  const int numThreads = std::min( pEncLib->getNumCuEncStacks(), numLines );
+
+  // the unit vectors of the picture must not be reallocated while other threads are reading from them
+  const size_t maxNumUnits = 2 * cs.unitScale[COMPONENT_Y].scale( cs.area.blocks[COMPONENT_Y].size() ).area();
+  cs.cus.reserve( maxNumUnits );
+  cs.pus.reserve( maxNumUnits );
+  cs.tus.reserve( maxNumUnits );
+
+  // padding/restore at slice level
+  const uint32_t firstCtuRsAddr = pcSlice->getCtuAddrInSlice( 0 );
+  const SubPic  &curSubPic = pcSlice->getPPS()->getSubPicFromPos( Position( ( firstCtuRsAddr % widthInCtus ) * pcv.maxCUWidth, ( firstCtuRsAddr / widthInCtus ) * pcv.maxCUHeight ) );
+  const bool    padSubPic = pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag();
+  if( padSubPic )
+  {
+    for( int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++ )
+    {
+      for( int idx = 0; idx < pcSlice->getNumRefIdx( (RefPicList) rlist ); idx++ )
+      {
+        Picture *refPic = pcSlice->getRefPic( (RefPicList) rlist, idx );
+        if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+        {
+          refPic->saveSubPicBorder( refPic->getPOC(), curSubPic.getSubPicLeft(), curSubPic.getSubPicTop(), curSubPic.getSubPicWidthInLumaSample(), curSubPic.getSubPicHeightInLumaSample() );
+          refPic->extendSubPicBorder( refPic->getPOC(), curSubPic.getSubPicLeft(), curSubPic.getSubPicTop(), curSubPic.getSubPicWidthInLumaSample(), curSubPic.getSubPicHeightInLumaSample() );
+          refPic->setSubPicSaved( true );
+        }
+      }
+    }
+  }
+
+  if( cs.slice->getSliceType() == B_SLICE )
+  {
+    resetBcwCodingOrder( false, cs );
+  }
+
+  xInitCuEncStacks( pcSlice, pEncLib, numThreads );
+
+  std::mutex              picCsMutex;
+  std::mutex              progressMutex;
+  std::condition_variable progressCond;
+  std::vector<uint32_t>   lineProgress( numLines, 0 );  // number of finished CTUs in each line
+  std::vector<Ctx>        lineSyncCtx ( numLines );     // contexts after the first CTU of each line
+  std::vector<uint32_t>   sliceBits   ( numThreads, 0 );
+  std::atomic<int>        nextLine    ( 0 );
+  bool                    abortLines  = false;
+  std::exception_ptr      lineError;
+
+  auto encodeLines = [&]( const int jId )
+  {
+    EncCu*       cuEncoder   = pEncLib->getCuEncoder( jId );
+    InterSearch* interSearch = pEncLib->getInterSearch( jId );
+    CABACWriter* cabacWriter = pEncLib->getCABACEncoder( jId )->getCABACEstimator( pcSlice->getSPS() );
+    const int    currQP[2]   = { pcSlice->getSliceQp(), pcSlice->getSliceQp() };
+    int          prevQP[2];
+
+    for( int line = nextLine++; line < numLines; line = nextLine++ )
+    {
+      // the search caches only carry information along a line, so the result does not depend on the thread encoding it
+      interSearch->resetAffineMVList();
+      interSearch->resetUniMvList();
+      interSearch->resetReusedUniMvs();
+      cuEncoder->resetRowMotionLut();
+      pEncLib->getReshaper( jId )->setVPDULoc( -1, -1 );
+
+      cabacWriter->initCtxModels( *pcSlice );
+      prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
+
+      for( uint32_t ctuIdx = lineStart[line]; ctuIdx < lineStart[line + 1]; ctuIdx++ )
+      {
+        const uint32_t ctuInLine = ctuIdx - lineStart[line];
+
+        if( lineAboveAvail[line] )
+        {
+          // wait for the top-right CTU, or the top CTU at the end of the line
+          const uint32_t neededAbove = std::min( ctuInLine + 2, lineStart[line] - lineStart[line - 1] );
+          std::unique_lock<std::mutex> lock( progressMutex );
+          progressCond.wait( lock, [&]() { return abortLines || lineProgress[line - 1] >= neededAbove; } );
+          if( abortLines )
+          {
+            return;
+          }
+          if( ctuInLine == 0 )
+          {
+            cabacWriter->getCtx() = lineSyncCtx[line - 1];
+          }
+        }
+
+        const uint32_t ctuRsAddr = pcSlice->getCtuAddrInSlice( ctuIdx );
+        const Position pos( ( ctuRsAddr % widthInCtus ) * pcv.maxCUWidth, ( ctuRsAddr / widthInCtus ) * pcv.maxCUHeight );
+        const UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight ) );
+
+        if( pCfg->getSwitchPOC() != pcPic->poc || ctuRsAddr >= pCfg->getDebugCTU() )
+        {
+          cuEncoder->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
+        }
+
+        cabacWriter->resetBits();
+        cabacWriter->coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr, true, true );
+        sliceBits[jId] += uint32_t( cabacWriter->getEstFracBits() >> SCALE_BITS );
+
+        {
+          std::lock_guard<std::mutex> lock( progressMutex );
+          if( ctuInLine == 0 )
+          {
+            lineSyncCtx[line] = cabacWriter->getCtx();
+          }
+          lineProgress[line]++;
+        }
+        progressCond.notify_all();
+      }
+    }
+  };
+
+  auto runLines = [&]( const int jId )
+  {
+    try
+    {
+      encodeLines( jId );
+    }
+    catch( ... )
+    {
+      {
+        std::lock_guard<std::mutex> lock( progressMutex );
+        if( !lineError )
+        {
+          lineError = std::current_exception();
+        }
+        abortLines = true;
+      }
+      progressCond.notify_all();
+    }
+  };
+
+  for( int jId = 0; jId < numThreads; jId++ )
+  {
+    pEncLib->getCuEncoder( jId )->setPicCsMutex( &picCsMutex );
+  }
+
+  // the calling thread and the workers of the pool each take the next CU encoding stack
+  std::atomic<int> nextJobId( 0 );
+  pEncLib->getWppThreadPool()->run( [&]() { runLines( nextJobId++ ); }, numThreads );
+
+  for( int jId = 0; jId < numThreads; jId++ )
+  {
+    pEncLib->getCuEncoder( jId )->setPicCsMutex( nullptr );
+  }
+  if( lineError )
+  {
+    std::rethrow_exception( lineError );
+  }
+
+  for( int jId = 0; jId < numThreads; jId++ )
+  {
+    pcSlice->setSliceBits( pcSlice->getSliceBits() + sliceBits[jId] );
+  }
+  m_uiPicTotalBits = cs.fracBits >> SCALE_BITS;
+  m_uiPicDist      = cs.dist;
+
+#if K0149_BLOCK_STATISTICS
+  for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
+  {
+    const uint32_t ctuRsAddr = pcSlice->getCtuAddrInSlice( ctuIdx );
+    const Position pos( ( ctuRsAddr % widthInCtus ) * pcv.maxCUWidth, ( ctuRsAddr / widthInCtus ) * pcv.maxCUHeight );
+    getAndStoreBlockStatistics( cs, UnitArea( cs.area.chromaFormat, Area( pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight ) ) );
+  }
+#endif
+
+  if( padSubPic )
+  {
+    for( int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++ )
+    {
+      for( int idx = 0; idx < pcSlice->getNumRefIdx( (RefPicList) rlist ); idx++ )
+      {
+        Picture *refPic = pcSlice->getRefPic( (RefPicList) rlist, idx );
+        if( refPic->getSubPicSaved() )
+        {
+          refPic->restoreSubPicBorder( refPic->getPOC(), curSubPic.getSubPicLeft(), curSubPic.getSubPicTop(), curSubPic.getSubPicWidthInLumaSample(), curSubPic.getSubPicHeightInLumaSample() );
+          refPic->setSubPicSaved( false );
+        }
+      }
+    }
+  }
+}
+
+void EncSlice::xInitCuEncStacks( const Slice* pcSlice, EncLib* pEncLib, const int numStacks )
+{
+  // the CU encoding stacks of the other threads start from the slice settings of the first one
+  double lambdas[MAX_NUM_COMPONENT];
+  pEncLib->getTrQuant()->getLambdas( lambdas );
+  for( int jId = 0; jId < numStacks; jId++ )
+  {
+    if( jId > 0 )
+    {
+      *pEncLib->getRdCost( jId ) = *pEncLib->getRdCost();
+      pEncLib->getTrQuant( jId )->setLambdas( lambdas );
+      pEncLib->getTrQuant( jId )->resetStore();
+      pEncLib->getCABACEncoder( jId )->getCABACEstimator( pcSlice->getSPS() )->initCtxModels( *pcSlice );
+      if( pcSlice->getSPS()->getUseLmcs() )
+      {
+        static_cast<Reshape&>( *pEncLib->getReshaper( jId ) ) = *pEncLib->getReshaper();
+      }
+    }
+    if( pcSlice->getSliceType() == B_SLICE )
+    {
+      pEncLib->getInterSearch( jId )->initWeightIdxBits();
+    }
+    if( pcSlice->getSPS()->getUseLmcs() )
+    {
+      pEncLib->getCuEncoder( jId )->setDecCuReshaperInEncCU( pEncLib->getReshaper( jId ), pcSlice->getSPS()->getChromaFormatIdc() );
+    }
+  }
+}
+
 void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded )
 {
 
@@ -144,6 +144,8 @@ public:
   void    setEncCABACTableIdx (SliceType b)         { m_encCABACTableIdx = b; }
 private:
   double  xGetQPValueAccordingToLambda ( double lambda );
+  void    xEncodeCtusWpp      ( Picture* pcPic, EncLib* pcEncLib );                 ///< encode the CTU rows of the slice in parallel
+  void    xInitCuEncStacks    ( const Slice* pcSlice, EncLib* pcEncLib, const int numStacks ); ///< start the additional CU encoding stacks from the slice settings of the first one
 };
 
 //! \}
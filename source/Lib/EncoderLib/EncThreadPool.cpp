@@ -0,0 +1,142 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncThreadPool.cpp
+    \brief    persistent worker threads of the encoder
+*/
+
+#include "EncThreadPool.h"
+
+#include <algorithm>
+
+//! \ingroup EncoderLib
+//! \{
+
+EncThreadPool::EncThreadPool()
+  : m_task     ( nullptr )
+  , m_run      ( 0 )
+  , m_numActive( 0 )
+  , m_numBusy  ( 0 )
+  , m_stop     ( false )
+{
+}
+
+EncThreadPool::~EncThreadPool()
+{
+  destroy();
+}
+
+void EncThreadPool::create( const int numThreads )
+{
+  destroy();
+
+  m_stop = false;
+  for( int w = 0; w < numThreads - 1; w++ )
+  {
+    m_workers.push_back( std::thread( &EncThreadPool::xWork, this, w ) );
+  }
+}
+
+void EncThreadPool::destroy()
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_start.notify_all();
+
+  for( auto& worker : m_workers )
+  {
+    worker.join();
+  }
+  m_workers.clear();
+}
+
+void EncThreadPool::run( const std::function<void()>& task, const int numThreads )
+{
+  const int numWorkers = std::min( numThreads - 1, int( m_workers.size() ) );
+
+  if( numWorkers <= 0 )
+  {
+    task();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_task      = &task;
+    m_numActive = numWorkers;
+    m_numBusy   = numWorkers;
+    m_run++;
+  }
+  m_start.notify_all();
+
+  task();
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_done.wait( lock, [this]() { return m_numBusy == 0; } );
+  m_task = nullptr;
+}
+
+void EncThreadPool::xWork( const int workerIdx )
+{
+  uint64_t lastRun = 0;
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( true )
+  {
+    m_start.wait( lock, [&]() { return m_stop || m_run != lastRun; } );
+    if( m_stop )
+    {
+      return;
+    }
+    lastRun = m_run;
+
+    if( workerIdx >= m_numActive )
+    {
+      continue;
+    }
+
+    const std::function<void()>* task = m_task;
+    lock.unlock();
+    ( *task )();
+    lock.lock();
+
+    if( --m_numBusy == 0 )
+    {
+      m_done.notify_one();
+    }
+  }
+}
+
+//! \}
@@ -0,0 +1,81 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncThreadPool.h
+    \brief    persistent worker threads of the encoder (header)
+*/
+
+#ifndef __ENCTHREADPOOL__
+#define __ENCTHREADPOOL__
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+/// worker threads that are created once and run a task together with the calling thread
+class EncThreadPool
+{
+public:
+  EncThreadPool();
+  ~EncThreadPool();
+
+  void create       ( const int numThreads );
+  void destroy      ();
+  int  getNumThreads() const { return int( m_workers.size() ) + 1; }
+
+  /// runs task on numThreads threads including the caller, returns once every one of them has finished it
+  void run          ( const std::function<void()>& task, const int numThreads );
+
+private:
+  void xWork        ( const int workerIdx );
+
+  std::vector<std::thread>     m_workers;
+  std::mutex                   m_mutex;
+  std::condition_variable      m_start;
+  std::condition_variable      m_done;
+  const std::function<void()>* m_task;         ///< task of the current run
+  uint64_t                     m_run;          ///< counts the runs, a worker takes part in each run once
+  int                          m_numActive;    ///< number of workers taking part in the current run
+  int                          m_numBusy;      ///< workers of the current run that have not finished yet
+  bool                         m_stop;
+};
+
+//! \}
+
+#endif // __ENCTHREADPOOL__
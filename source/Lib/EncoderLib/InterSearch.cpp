@@ -97,6 +97,9 @@ InterSearch::InterSearch()
   , m_CABACEstimator              (nullptr)
   , m_CtxCache                    (nullptr)
   , m_pTempPel                    (nullptr)
+#if ENABLE_8BIT_REFERENCES
+  , m_refBlk16                    (nullptr)
+#endif
   , m_isInitialized               (false)
 {
   for (int i=0; i<MAX_NUM_REF_LIST_ADAPT_SR; i++)
@@ -118,6 +121,7 @@ InterSearch::InterSearch()
   m_uniMvList = nullptr;
   m_uniMvListSize = 0;
   m_uniMvListIdx = 0;
+  m_numReusedUniMvs = 0;
   m_histBestSbt    = MAX_UCHAR;
   m_histBestMtsIdx = MAX_UCHAR;
 
@@ -132,6 +136,13 @@ void InterSearch::destroy()
     delete [] m_pTempPel;
     m_pTempPel = NULL;
   }
+#if ENABLE_8BIT_REFERENCES
+  if ( m_refBlk16 )
+  {
+    delete [] m_refBlk16;
+    m_refBlk16 = nullptr;
+  }
+#endif
 
   m_pSplitCS = m_pFullCS = nullptr;
 
@@ -178,6 +189,10 @@ void InterSearch::destroy()
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+  m_reusedUniMvSlot.clear();
+  m_reusedUniMvs.clear();
+  m_reusedUniMvArea.clear();
+  m_numReusedUniMvs = 0;
   m_isInitialized = false;
 }
 
@@ -265,6 +280,9 @@ void InterSearch::init( EncCfg*        pcEncCfg,
   m_tmpAffiDeri[0] = new int[MAX_CU_SIZE * MAX_CU_SIZE];
   m_tmpAffiDeri[1] = new int[MAX_CU_SIZE * MAX_CU_SIZE];
   m_pTempPel = new Pel[maxCUWidth*maxCUHeight];
+#if ENABLE_8BIT_REFERENCES
+  m_refBlk16 = new Pel[MAX_CU_SIZE * MAX_CU_SIZE];
+#endif
   m_affMVListMaxSize = (pcEncCfg->getIntraPeriod() == (uint32_t)-1) ? AFFINE_ME_LIST_SIZE_LD : AFFINE_ME_LIST_SIZE;
   if (!m_affMVList)
   {
@@ -285,6 +303,8 @@ void InterSearch::init( EncCfg*        pcEncCfg,
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+  m_reusedUniMvSlot.resize( 32 * 32 * 8 * 8, 0 );
+  resetReusedUniMvs();
   m_isInitialized = true;
 }
 
@@ -317,6 +337,21 @@ void InterSearch::resetSavedAffineMotion()
   m_affineMotion.affine6ParaAvail = false;
 }
 
+void InterSearch::copyState( const InterSearch& other )
+{
+  // the affine and uni-prediction MV candidates of previously coded blocks, the reused uni-MVs stay with the stack
+  std::copy_n( other.m_affMVList, m_affMVListMaxSize, m_affMVList );
+#if GDR_ENABLED
+  std::copy_n( other.m_affMVListSolid, m_affMVListMaxSize, m_affMVListSolid );
+#endif
+  m_affMVListIdx  = other.m_affMVListIdx;
+  m_affMVListSize = other.m_affMVListSize;
+
+  std::copy_n( other.m_uniMvList, m_uniMvListMaxSize, m_uniMvList );
+  m_uniMvListIdx  = other.m_uniMvListIdx;
+  m_uniMvListSize = other.m_uniMvListSize;
+}
+
 #if GDR_ENABLED
 void InterSearch::storeAffineMotion(Mv acAffineMv[2][3], bool acAffineMvSolid[2][3], int16_t affineRefIdx[2], EAffineModel affineType, int bcwIdx)
 #else
@@ -356,15 +391,54 @@ void InterSearch::storeAffineMotion( Mv acAffineMv[2][3], int16_t affineRefIdx[2
   }
 }
 
+void InterSearch::xSetSearchDistParam( const IntTZSearchStruct& cStruct, int subShiftMode, bool useHadamard )
+{
+#if ENABLE_8BIT_REFERENCES
+  if( cStruct.piRefY8 )
+  {
+    if( useHadamard )
+    {
+      // the Hadamard kernels read the reference block widened into a 16-bit copy
+      m_pcRdCost->setDistParam( m_cDistParam, *cStruct.pcPatternKey, m_refBlk16, cStruct.pcPatternKey->width, m_lumaClpRng.bd, COMPONENT_Y, subShiftMode, 1, true );
+    }
+    else
+    {
+      m_pcRdCost->setDistParam( m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY8, cStruct.iRefStride, m_lumaClpRng.bd, COMPONENT_Y, subShiftMode );
+    }
+    return;
+  }
+#endif
+  m_pcRdCost->setDistParam( m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMPONENT_Y, subShiftMode, 1, useHadamard );
+}
+
+inline void InterSearch::xSetSearchCur( const IntTZSearchStruct& cStruct, const int offset )
+{
+#if ENABLE_8BIT_REFERENCES
+  if( cStruct.piRefY8 )
+  {
+    if( m_cDistParam.cur8 )
+    {
+      m_cDistParam.cur8 = cStruct.piRefY8 + offset;
+    }
+    else
+    {
+      g_pelBufOP.unpack8bit( cStruct.piRefY8 + offset, cStruct.iRefStride, m_refBlk16, m_cDistParam.cur.stride, m_cDistParam.org.width, m_cDistParam.org.height );
+    }
+    return;
+  }
+#endif
+  m_cDistParam.cur.buf = cStruct.piRefY + offset;
+}
+
 inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int iSearchX, const int iSearchY, const uint8_t ucPointNr, const uint32_t uiDistance )
 {
   Distortion  uiSad = 0;
 
 //  CHECK(!( !( rcStruct.searchRange.left > iSearchX || rcStruct.searchRange.right < iSearchX || rcStruct.searchRange.top > iSearchY || rcStruct.searchRange.bottom < iSearchY )), "Unspecified error");
 
-  const Pel* const  piRefSrch = rcStruct.piRefY + iSearchY * rcStruct.iRefStride + iSearchX;
+  const int iSearchOffset = iSearchY * rcStruct.iRefStride + iSearchX;
 
-  m_cDistParam.cur.buf = piRefSrch;
+  xSetSearchCur( rcStruct, iSearchOffset );
 
   if( 1 == rcStruct.subShiftMode )
   {
@@ -387,7 +461,7 @@ inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int i
         {
           int isubShift           = m_cDistParam.subShift -1;
           m_cDistParam.org.buf = rcStruct.pcPatternKey->buf + (rcStruct.pcPatternKey->stride << isubShift);
-          m_cDistParam.cur.buf = piRefSrch + (rcStruct.iRefStride << isubShift);
+          xSetSearchCur( rcStruct, iSearchOffset + ( rcStruct.iRefStride << isubShift ) );
           uiTempSad            = m_cDistParam.distFunc( m_cDistParam );
           uiSad               += uiTempSad >> m_cDistParam.subShift;
 
@@ -1474,6 +1548,9 @@ void InterSearch::xIBCEstimation(PredictionUnit& pu, PelUnitBuf& origBuf,
   cStruct.pcPatternKey = pcPatternKey;
   cStruct.iRefStride = refBuf.stride;
   cStruct.piRefY = refBuf.buf;
+#if ENABLE_8BIT_REFERENCES
+  cStruct.piRefY8 = nullptr;
+#endif
   CHECK(pu.cu->imv == IMV_HPEL, "IF_IBC");
   cStruct.imvShift = pu.cu->imv << 1;
   cStruct.subShiftMode = 0; // used by intra pattern search function
@@ -3196,8 +3273,19 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 
         unsigned idx1, idx2, idx3, idx4;
         getAreaIdx(cu.Y(), *cu.slice->getPPS()->pcv, idx1, idx2, idx3, idx4);
-        ::memcpy(&(g_reusedUniMVs[idx1][idx2][idx3][idx4][0][0]), cMvTemp, 2 * 33 * sizeof(Mv));
-        g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4] = true;
+        const unsigned areaIdx = xReusedUniMvIdx( idx1, idx2, idx3, idx4 );
+        uint32_t      &slot    = m_reusedUniMvSlot[areaIdx];
+        if( !slot )
+        {
+          if( m_numReusedUniMvs == m_reusedUniMvs.size() )
+          {
+            m_reusedUniMvs.emplace_back();
+            m_reusedUniMvArea.push_back( 0 );
+          }
+          m_reusedUniMvArea[m_numReusedUniMvs] = areaIdx;
+          slot = uint32_t( ++m_numReusedUniMvs );
+        }
+        ::memcpy( m_reusedUniMvs[slot - 1].uniMvs, cMvTemp, 2 * 33 * sizeof( Mv ) );
       }
       //  Bi-predictive Motion estimation
       if( ( cs.slice->isInterB() ) && ( PU::isBipredRestriction( pu ) == false )
@@ -4905,13 +4993,29 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
 
   m_lumaClpRng = pu.cs->slice->clpRng( COMPONENT_Y );
 
-  bool wrap =  pu.cu->slice->getRefPic(eRefPicList, iRefIdxPred)->isWrapAroundEnabled( pu.cs->pps );
-  CPelBuf buf = pu.cu->slice->getRefPic(eRefPicList, iRefIdxPred)->getRecoBuf(pu.blocks[COMPONENT_Y], wrap);
+  const Picture* refPic = pu.cu->slice->getRefPic(eRefPicList, iRefIdxPred);
+  bool wrap =  refPic->isWrapAroundEnabled( pu.cs->pps );
 
   IntTZSearchStruct cStruct;
   cStruct.pcPatternKey  = pcPatternKey;
-  cStruct.iRefStride    = buf.stride;
-  cStruct.piRefY        = buf.buf;
+#if ENABLE_8BIT_REFERENCES
+  if( refPic->isRecoPacked() )
+  {
+    CPel8Buf buf = refPic->getRecoBuf8(pu.blocks[COMPONENT_Y]);
+    cStruct.iRefStride    = buf.stride;
+    cStruct.piRefY        = nullptr;
+    cStruct.piRefY8       = buf.buf;
+  }
+  else
+#endif
+  {
+    CPelBuf buf = refPic->getRecoBuf(pu.blocks[COMPONENT_Y], wrap);
+    cStruct.iRefStride    = buf.stride;
+    cStruct.piRefY        = buf.buf;
+#if ENABLE_8BIT_REFERENCES
+    cStruct.piRefY8       = nullptr;
+#endif
+  }
   cStruct.imvShift = pu.cu->imv == IMV_HPEL ? 1 : (pu.cu->imv << 1);
   cStruct.useAltHpelIf = pu.cu->imv == IMV_HPEL;
   cStruct.inCtuSearch = false;
@@ -4954,14 +5058,14 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
   if( ( m_motionEstimationSearchMethod == MESEARCH_FULL ) || bBi || bQTBTMV )
   {
     cStruct.subShiftMode = m_pcEncCfg->getFastInterSearchMode() == FASTINTERSEARCH_MODE1 || m_pcEncCfg->getFastInterSearchMode() == FASTINTERSEARCH_MODE3 ? 2 : 0;
-    m_pcRdCost->setDistParam(m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMPONENT_Y, cStruct.subShiftMode);
+    xSetSearchDistParam(cStruct, cStruct.subShiftMode, false);
 
     Mv bestInitMv = (bBi ? rcMv : rcMvPred);
     Mv cTmpMv = bestInitMv;
 
     clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
     cTmpMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_INT);
-    m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    xSetSearchCur(cStruct, cTmpMv.ver * cStruct.iRefStride + cTmpMv.hor);
     Distortion uiBestSad = m_cDistParam.distFunc(m_cDistParam);
     uiBestSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
 
@@ -4986,7 +5090,7 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
       cTmpMv = curMvInfo->uniMvs[eRefPicList][iRefIdxPred];
       clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
       cTmpMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_INT);
-      m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+      xSetSearchCur(cStruct, cTmpMv.ver * cStruct.iRefStride + cTmpMv.hor);
 
       Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
       uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
@@ -5205,17 +5309,17 @@ void InterSearch::xPatternSearch( IntTZSearchStruct&    cStruct,
   int         iBestY = 0;
 
   //-- jclee for using the SAD function pointer
-  m_pcRdCost->setDistParam( m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMPONENT_Y, cStruct.subShiftMode );
+  xSetSearchDistParam( cStruct, cStruct.subShiftMode, false );
 
   const SearchRange& sr = cStruct.searchRange;
 
-  const Pel* piRef = cStruct.piRefY + (sr.top * cStruct.iRefStride);
+  int refOffset = sr.top * cStruct.iRefStride;
   for ( int y = sr.top; y <= sr.bottom; y++ )
   {
     for ( int x = sr.left; x <= sr.right; x++ )
     {
       //  find min. distortion position
-      m_cDistParam.cur.buf = piRef + x;
+      xSetSearchCur( cStruct, refOffset + x );
 
       uiSad = m_cDistParam.distFunc( m_cDistParam );
 
@@ -5230,7 +5334,7 @@ void InterSearch::xPatternSearch( IntTZSearchStruct&    cStruct,
         m_cDistParam.maximumDistortionForEarlyExit = uiSad;
       }
     }
-    piRef += cStruct.iRefStride;
+    refOffset += cStruct.iRefStride;
   }
   rcMv.set( iBestX, iBestY );
 
@@ -5323,7 +5427,7 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
 
   //
   m_cDistParam.maximumDistortionForEarlyExit = cStruct.uiBestSad;
-  m_pcRdCost->setDistParam( m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMPONENT_Y, cStruct.subShiftMode );
+  xSetSearchDistParam( cStruct, cStruct.subShiftMode, false );
 
   // distortion
 
@@ -5388,7 +5492,7 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
     Mv cTmpMv = curMvInfo->uniMvs[eRefPicList][iRefIdxPred];
     clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
     cTmpMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_INT);
-    m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    xSetSearchCur(cStruct, cTmpMv.ver * cStruct.iRefStride + cTmpMv.hor);
 
     Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
     uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
@@ -5684,7 +5788,7 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
   cStruct.iBestY = 0;
 
   m_cDistParam.maximumDistortionForEarlyExit = cStruct.uiBestSad;
-  m_pcRdCost->setDistParam( m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMPONENT_Y, cStruct.subShiftMode );
+  xSetSearchDistParam( cStruct, cStruct.subShiftMode, false );
 
 
   // set rcMv (Median predictor) as start point and as best point
@@ -5730,7 +5834,7 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
     Mv cTmpMv = curMvInfo->uniMvs[eRefPicList][iRefIdxPred];
     clipMv( cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
     cTmpMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_INT);
-    m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+    xSetSearchCur(cStruct, cTmpMv.ver * cStruct.iRefStride + cTmpMv.hor);
 
     Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
     uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
@@ -5863,7 +5967,7 @@ void InterSearch::xPatternSearchIntRefine(PredictionUnit& pu, IntTZSearchStruct&
   CHECK( amvpInfo.mvCand[riMVPIdx] != rcMvPred, "xPatternSearchIntRefine(): MvPred issue.");
 
   const SPS &sps = *pu.cs->sps;
-  m_pcRdCost->setDistParam(m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY, cStruct.iRefStride, m_lumaClpRng.bd, COMPONENT_Y, 0, 1, m_pcEncCfg->getUseHADME() && !pu.cs->slice->getDisableSATDForRD());
+  xSetSearchDistParam(cStruct, 0, m_pcEncCfg->getUseHADME() && !pu.cs->slice->getDisableSATDForRD());
 
   // -> set MV scale for cost calculation to QPEL (0)
   m_pcRdCost->setCostScale ( 0 );
@@ -5924,7 +6028,7 @@ void InterSearch::xPatternSearchIntRefine(PredictionUnit& pu, IntTZSearchStruct&
         {
           clipMv( cTempMV, pu.cu->lumaPos(), pu.cu->lumaSize(), sps, *pu.cs->pps );
         }
-        m_cDistParam.cur.buf = cStruct.piRefY  + cStruct.iRefStride * (cTempMV.getVer() >>  MV_FRACTIONAL_BITS_INTERNAL) + (cTempMV.getHor() >> MV_FRACTIONAL_BITS_INTERNAL);
+        xSetSearchCur(cStruct, cStruct.iRefStride * (cTempMV.getVer() >>  MV_FRACTIONAL_BITS_INTERNAL) + (cTempMV.getHor() >> MV_FRACTIONAL_BITS_INTERNAL));
         uiDist = uiSATD = (Distortion) (m_cDistParam.distFunc( m_cDistParam ) * fWeight);
       }
       else
@@ -6020,13 +6124,12 @@ void InterSearch::xPatternSearchFracDIF(
 
   //  Reference pattern initialization (integer scale)
   int         iOffset    = rcMvInt.getHor() + rcMvInt.getVer() * cStruct.iRefStride;
-  CPelBuf cPatternRoi(cStruct.piRefY + iOffset, cStruct.iRefStride, *cStruct.pcPatternKey);
   if (m_skipFracME)
   {
     Mv baseRefMv(0, 0);
     rcMvHalf.setZero();
     m_pcRdCost->setCostScale(0);
-    xExtDIFUpSamplingH(&cPatternRoi, cStruct.useAltHpelIf);
+    xExtDIFUpSamplingH(cStruct, iOffset);
     rcMvQter = rcMvInt;   rcMvQter <<= 2;    // for mv-cost
 #if GDR_ENABLED
     ruiCost = xPatternRefinement(pu, eRefPicList, iRefIdx, cStruct.pcPatternKey, baseRefMv, 1, rcMvQter, !pu.cs->slice->getDisableSATDForRD(), rbCleanCandExist);
@@ -6039,7 +6142,8 @@ void InterSearch::xPatternSearchFracDIF(
 
   if (cStruct.imvShift > IMV_FPEL || (m_useCompositeRef && cStruct.zeroMV))
   {
-    m_pcRdCost->setDistParam(m_cDistParam, *cStruct.pcPatternKey, cStruct.piRefY + iOffset, cStruct.iRefStride, m_lumaClpRng.bd, COMPONENT_Y, 0, 1, m_pcEncCfg->getUseHADME() && !pu.cs->slice->getDisableSATDForRD());
+    xSetSearchDistParam(cStruct, 0, m_pcEncCfg->getUseHADME() && !pu.cs->slice->getDisableSATDForRD());
+    xSetSearchCur(cStruct, iOffset);
     ruiCost = m_cDistParam.distFunc( m_cDistParam );
     ruiCost += m_pcRdCost->getCostOfVectorWithPredictor( rcMvInt.getHor(), rcMvInt.getVer(), cStruct.imvShift );
     return;
@@ -6047,7 +6151,7 @@ void InterSearch::xPatternSearchFracDIF(
 
   //  Half-pel refinement
   m_pcRdCost->setCostScale(1);
-  xExtDIFUpSamplingH(&cPatternRoi, cStruct.useAltHpelIf);
+  xExtDIFUpSamplingH(cStruct, iOffset);
 
   rcMvHalf = rcMvInt;   rcMvHalf <<= 1;    // for mv-cost
   Mv baseRefMv(0, 0);
@@ -6061,7 +6165,7 @@ void InterSearch::xPatternSearchFracDIF(
   if (cStruct.imvShift == IMV_OFF)
   {
     m_pcRdCost->setCostScale(0);
-    xExtDIFUpSamplingQ(&cPatternRoi, rcMvHalf);
+    xExtDIFUpSamplingQ(cStruct, iOffset, rcMvHalf);
     baseRefMv = rcMvHalf;
     baseRefMv <<= 1;
 
@@ -6087,7 +6191,11 @@ Distortion InterSearch::xGetSymmetricCost( PredictionUnit& pu, PelUnitBuf& origB
   const Picture* picRefA = pu.cu->slice->getRefPic( eCurRefPicList, cCurMvField.refIdx );
   Mv mvA = cCurMvField.mv;
   clipMv( mvA, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
-  if ( (mvA.hor & 15) == 0 && (mvA.ver & 15) == 0 )
+  if ( (mvA.hor & 15) == 0 && (mvA.ver & 15) == 0
+#if ENABLE_8BIT_REFERENCES
+    && !picRefA->isRecoPacked()
+#endif
+    )
   {
     Position offset = pu.blocks[COMPONENT_Y].pos().offset( mvA.getHor() >> 4, mvA.getVer() >> 4 );
     CPelBuf pelBufA = picRefA->getRecoBuf( CompArea( COMPONENT_Y, pu.chromaFormat, offset, pu.blocks[COMPONENT_Y].size() ), false );
@@ -6106,7 +6214,11 @@ Distortion InterSearch::xGetSymmetricCost( PredictionUnit& pu, PelUnitBuf& origB
   const Picture* picRefB = pu.cu->slice->getRefPic( eTarRefPicList, cTarMvField.refIdx );
   Mv mvB = cTarMvField.mv;
   clipMv( mvB, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
-  if ( (mvB.hor & 15) == 0 && (mvB.ver & 15) == 0 )
+  if ( (mvB.hor & 15) == 0 && (mvB.ver & 15) == 0
+#if ENABLE_8BIT_REFERENCES
+    && !picRefB->isRecoPacked()
+#endif
+    )
   {
     Position offset = pu.blocks[COMPONENT_Y].pos().offset( mvB.getHor() >> 4, mvB.getVer() >> 4 );
     CPelBuf pelBufB = picRefB->getRecoBuf( CompArea( COMPONENT_Y, pu.chromaFormat, offset, pu.blocks[COMPONENT_Y].size() ), false );
@@ -8929,18 +9041,39 @@ void InterSearch::xCopyAffineAMVPInfo (AffineAMVPInfo& src, AffineAMVPInfo& dst)
 }
 
 
+/**
+* \brief Horizontally filter the search reference into an intermediate block
+*
+* \param cStruct Search structure holding the reference picture
+* \param offset  Offset of the first sample from the reference block
+*/
+void InterSearch::xFilterSearchRefHor(const IntTZSearchStruct& cStruct, const int offset, Pel* dst, int dstStride, int width, int height, int frac, bool useAltHpelIf)
+{
+#if ENABLE_8BIT_REFERENCES
+  if (cStruct.piRefY8)
+  {
+    m_if.filterHor(COMPONENT_Y, cStruct.piRefY8 + offset, cStruct.iRefStride, dst, dstStride, width, height, frac, false,
+                   m_lumaClpRng, 0, false, useAltHpelIf);
+    return;
+  }
+#endif
+  m_if.filterHor(COMPONENT_Y, cStruct.piRefY + offset, cStruct.iRefStride, dst, dstStride, width, height, frac, false,
+                 m_lumaClpRng, 0, false, useAltHpelIf);
+}
+
 /**
 * \brief Generate half-sample interpolated block
 *
-* \param pattern Reference picture ROI
-* \param biPred    Flag indicating whether block is for biprediction
+* \param cStruct Search structure holding the reference picture
+* \param offset  Offset of the reference picture ROI
 */
-void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
+void InterSearch::xExtDIFUpSamplingH(const IntTZSearchStruct& cStruct, const int offset)
 {
   const ClpRng& clpRng = m_lumaClpRng;
-  int width      = pattern->width;
-  int height     = pattern->height;
-  int srcStride  = pattern->stride;
+  int width      = cStruct.pcPatternKey->width;
+  int height     = cStruct.pcPatternKey->height;
+  int srcStride  = cStruct.iRefStride;
+  const bool useAltHpelIf = cStruct.useAltHpelIf;
 
   int intStride = width + 1;
   int dstStride = width + 1;
@@ -8948,14 +9081,14 @@ void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
   Pel *dstPtr;
   int filterSize = NTAPS_LUMA;
   int halfFilterSize = (filterSize>>1);
-  const Pel *srcPtr = pattern->buf - halfFilterSize*srcStride - 1;
+  const int srcOffset = offset - halfFilterSize*srcStride - 1;
 
-  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, m_filteredBlockTmp[0][0], intStride, width + 1, height + filterSize,
-                 0 << MV_FRACTIONAL_BITS_DIFF, false, clpRng, 0, false, useAltHpelIf);
+  xFilterSearchRefHor(cStruct, srcOffset, m_filteredBlockTmp[0][0], intStride, width + 1, height + filterSize,
+                      0 << MV_FRACTIONAL_BITS_DIFF, useAltHpelIf);
   if (!m_skipFracME)
   {
-    m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, m_filteredBlockTmp[2][0], intStride, width + 1, height + filterSize,
-                   2 << MV_FRACTIONAL_BITS_DIFF, false, clpRng, 0, false, useAltHpelIf);
+    xFilterSearchRefHor(cStruct, srcOffset, m_filteredBlockTmp[2][0], intStride, width + 1, height + filterSize,
+                        2 << MV_FRACTIONAL_BITS_DIFF, useAltHpelIf);
   }
 
   intPtr = m_filteredBlockTmp[0][0] + halfFilterSize * intStride + 1;
@@ -8987,18 +9120,18 @@ void InterSearch::xExtDIFUpSamplingH(CPelBuf* pattern, bool useAltHpelIf)
 /**
 * \brief Generate quarter-sample interpolated blocks
 *
-* \param pattern    Reference picture ROI
+* \param cStruct    Search structure holding the reference picture
+* \param offset     Offset of the reference picture ROI
 * \param halfPelRef Half-pel mv
-* \param biPred     Flag indicating whether block is for biprediction
 */
-void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
+void InterSearch::xExtDIFUpSamplingQ( const IntTZSearchStruct& cStruct, const int offset, Mv halfPelRef )
 {
   const ClpRng& clpRng = m_lumaClpRng;
-  int width      = pattern->width;
-  int height     = pattern->height;
-  int srcStride  = pattern->stride;
+  int width      = cStruct.pcPatternKey->width;
+  int height     = cStruct.pcPatternKey->height;
+  int srcStride  = cStruct.iRefStride;
 
-  Pel const* srcPtr;
+  int srcOffset;
   int intStride = width + 1;
   int dstStride = width + 1;
   Pel *intPtr;
@@ -9010,32 +9143,30 @@ void InterSearch::xExtDIFUpSamplingQ( CPelBuf* pattern, Mv halfPelRef )
   int extHeight = (halfPelRef.getVer() == 0) ? height + filterSize : height + filterSize-1;
 
   // Horizontal filter 1/4
-  srcPtr = pattern->buf - halfFilterSize * srcStride - 1;
+  srcOffset = offset - halfFilterSize * srcStride - 1;
   intPtr = m_filteredBlockTmp[1][0];
   if (halfPelRef.getVer() > 0)
   {
-    srcPtr += srcStride;
+    srcOffset += srcStride;
   }
   if (halfPelRef.getHor() >= 0)
   {
-    srcPtr += 1;
+    srcOffset += 1;
   }
-  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, intPtr, intStride, width, extHeight, 1 << MV_FRACTIONAL_BITS_DIFF,
-                 false, clpRng);
+  xFilterSearchRefHor(cStruct, srcOffset, intPtr, intStride, width, extHeight, 1 << MV_FRACTIONAL_BITS_DIFF, false);
 
   // Horizontal filter 3/4
-  srcPtr = pattern->buf - halfFilterSize*srcStride - 1;
+  srcOffset = offset - halfFilterSize*srcStride - 1;
   intPtr = m_filteredBlockTmp[3][0];
   if (halfPelRef.getVer() > 0)
   {
-    srcPtr += srcStride;
+    srcOffset += srcStride;
   }
   if (halfPelRef.getHor() > 0)
   {
-    srcPtr += 1;
+    srcOffset += 1;
   }
-  m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, intPtr, intStride, width, extHeight, 3 << MV_FRACTIONAL_BITS_DIFF,
-                 false, clpRng);
+  xFilterSearchRefHor(cStruct, srcOffset, intPtr, intStride, width, extHeight, 3 << MV_FRACTIONAL_BITS_DIFF, false);
 
   // Generate @ 1,1
   intPtr = m_filteredBlockTmp[1][0] + (halfFilterSize-1) * intStride;
@@ -11074,7 +11205,11 @@ void InterSearch::symmvdCheckBestMvp(
   const Picture* picRefA = pu.cu->slice->getRefPic(curRefList, cCurMvField.refIdx);
   Mv mvA = cCurMvField.mv;
   clipMv( mvA, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
-  if ( (mvA.hor & 15) == 0 && (mvA.ver & 15) == 0 )
+  if ( (mvA.hor & 15) == 0 && (mvA.ver & 15) == 0
+#if ENABLE_8BIT_REFERENCES
+    && !picRefA->isRecoPacked()
+#endif
+    )
   {
     Position offset = pu.blocks[COMPONENT_Y].pos().offset( mvA.getHor() >> 4, mvA.getVer() >> 4 );
     CPelBuf pelBufA = picRefA->getRecoBuf( CompArea( COMPONENT_Y, pu.chromaFormat, offset, pu.blocks[COMPONENT_Y].size() ), false );
@@ -11111,7 +11246,11 @@ void InterSearch::symmvdCheckBestMvp(
       const Picture* picRefB = pu.cu->slice->getRefPic(tarRefList, cTarMvField.refIdx);
       Mv mvB = cTarMvField.mv;
       clipMv( mvB, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
-      if ( (mvB.hor & 15) == 0 && (mvB.ver & 15) == 0 )
+      if ( (mvB.hor & 15) == 0 && (mvB.ver & 15) == 0
+#if ENABLE_8BIT_REFERENCES
+        && !picRefB->isRecoPacked()
+#endif
+        )
       {
         Position offset = pu.blocks[COMPONENT_Y].pos().offset( mvB.getHor() >> 4, mvB.getVer() >> 4 );
         CPelBuf pelBufB = picRefB->getRecoBuf( CompArea( COMPONENT_Y, pu.chromaFormat, offset, pu.blocks[COMPONENT_Y].size() ), false );
@@ -139,6 +139,11 @@ private:
   int             m_uniMvListIdx;
   int             m_uniMvListSize;
   int             m_uniMvListMaxSize;
+  std::vector<uint32_t>     m_reusedUniMvSlot;    ///< per CU area of the CTU (getAreaIdx()), 1 + its entry in m_reusedUniMvs, 0 while not filled
+  std::vector<BlkUniMvInfo> m_reusedUniMvs;       ///< uni-prediction MVs of the filled areas, grows with the areas the encoder searches
+  std::vector<uint32_t>     m_reusedUniMvArea;    ///< area index of each entry of m_reusedUniMvs, the reset only clears these slots
+  size_t                    m_numReusedUniMvs;
+  static unsigned xReusedUniMvIdx( unsigned idx1, unsigned idx2, unsigned idx3, unsigned idx4 ) { return ( ( idx1 * 32 + idx2 ) * 8 + idx3 ) * 8 + idx4; }
   Distortion      m_hevcCost;
 #if GDR_ENABLED  
   bool            m_hevcCostOk;
@@ -172,6 +177,9 @@ protected:
 
   // Misc.
   Pel            *m_pTempPel;
+#if ENABLE_8BIT_REFERENCES
+  Pel            *m_refBlk16;             ///< 16-bit copy of an 8-bit reference block for the Hadamard cost
+#endif
 
   // AMVP cost computation
   uint32_t            m_auiMVPIdxCost               [AMVP_MAX_NUM_CANDS+1][AMVP_MAX_NUM_CANDS+1]; //th array bounds
@@ -287,6 +295,16 @@ public:
     }
   }
   void resetUniMvList() { m_uniMvListIdx = 0; m_uniMvListSize = 0; }
+  void resetReusedUniMvs()
+  {
+    for( size_t i = 0; i < m_numReusedUniMvs; i++ )
+    {
+      m_reusedUniMvSlot[m_reusedUniMvArea[i]] = 0;
+    }
+    m_numReusedUniMvs = 0;
+  }
+  bool isReusedUniMvsFilled( unsigned idx1, unsigned idx2, unsigned idx3, unsigned idx4 ) const { return m_reusedUniMvSlot[xReusedUniMvIdx( idx1, idx2, idx3, idx4 )] != 0; }
+  Mv  (*getReusedUniMvs( unsigned idx1, unsigned idx2, unsigned idx3, unsigned idx4 ))[33] { return m_reusedUniMvs[m_reusedUniMvSlot[xReusedUniMvIdx( idx1, idx2, idx3, idx4 )] - 1].uniMvs; }
   void insertUniMvCands(CompArea blkArea, Mv cMvTemp[2][33])
   {
     BlkUniMvInfo* curMvInfo = m_uniMvList + m_uniMvListIdx;
@@ -359,6 +377,7 @@ public:
     }
   }
   void resetSavedAffineMotion();
+  void copyState                    ( const InterSearch& other );
 #if GDR_ENABLED
   void storeAffineMotion(Mv acAffineMv[2][3], bool acAffineMvSolid[2][3], int16_t affineRefIdx[2], EAffineModel affineType, int bcwIdx);
 #else
@@ -388,6 +407,9 @@ protected:
     SearchRange searchRange;
     const CPelBuf* pcPatternKey;
     const Pel*  piRefY;
+#if ENABLE_8BIT_REFERENCES
+    const uint8_t* piRefY8;             ///< 8-bit reference plane, piRefY is unused when set
+#endif
     int         iRefStride;
     int         iBestX;
     int         iBestY;
@@ -403,6 +425,8 @@ protected:
   } IntTZSearchStruct;
 
   // sub-functions for ME
+  void        xSetSearchDistParam   ( const IntTZSearchStruct& cStruct, int subShiftMode, bool useHadamard );
+  inline void xSetSearchCur         ( const IntTZSearchStruct& cStruct, const int offset );
   inline void xTZSearchHelp         ( IntTZSearchStruct& rcStruct, const int iSearchX, const int iSearchY, const uint8_t ucPointNr, const uint32_t uiDistance );
   inline void xTZ2PointSearch       ( IntTZSearchStruct& rcStruct );
   inline void xTZ8PointSquareSearch ( IntTZSearchStruct& rcStruct, const int iStartX, const int iStartY, const int iDist );
@@ -731,8 +755,9 @@ public:
     );
 protected:
 
-  void xExtDIFUpSamplingH(CPelBuf* pcPattern, bool useAltHpelIf);
-  void xExtDIFUpSamplingQ         ( CPelBuf* pcPatternKey, Mv halfPelRef );
+  void xFilterSearchRefHor        ( const IntTZSearchStruct& cStruct, const int offset, Pel* dst, int dstStride, int width, int height, int frac, bool useAltHpelIf );
+  void xExtDIFUpSamplingH         ( const IntTZSearchStruct& cStruct, const int offset );
+  void xExtDIFUpSamplingQ         ( const IntTZSearchStruct& cStruct, const int offset, Mv halfPelRef );
   uint32_t xDetermineBestMvp      ( PredictionUnit& pu, Mv acMvTemp[3], int& mvpIdx, const AffineAMVPInfo& aamvpi );
   // -------------------------------------------------------------------------------------------------------------------
   // compute symbol bits
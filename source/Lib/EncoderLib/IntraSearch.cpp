@@ -184,6 +184,33 @@ void IntraSearch::destroy()
   }
 }
 
+void IntraSearch::resetUnitCache()
+{
+  // every structure built on the unit cache returns its units before the cache is rewound
+  for( uint32_t layer = 0; layer < 2; layer++ )
+  {
+    m_pSaveCS[layer]->clearUnits();
+  }
+
+  for( uint32_t width = 0; width < gp_sizeIdxInfo->numWidths(); width++ )
+  {
+    for( uint32_t height = 0; height < gp_sizeIdxInfo->numHeights(); height++ )
+    {
+      if( m_pBestCS[width][height] )
+      {
+        m_pBestCS [width][height]   ->clearUnits();
+        m_pTempCS [width][height]   ->clearUnits();
+        m_pFullCS [width][height][0]->clearUnits();
+        m_pSplitCS[width][height][0]->clearUnits();
+      }
+    }
+  }
+
+  m_unitCache.cuCache.reset();
+  m_unitCache.puCache.reset();
+  m_unitCache.tuCache.reset();
+}
+
 IntraSearch::~IntraSearch()
 {
   if( m_isInitialized )
@@ -1289,6 +1316,8 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
     csBest->initStructData();
     csTemp->picture = cs.picture;
     csBest->picture = cs.picture;
+    csTemp->lumaCS  = cs.lumaCS;
+    csBest->lumaCS  = cs.lumaCS;
 
     // just to be sure
     numModesForFullRD = (int) rdModeList.size();
@@ -1554,6 +1583,7 @@ void IntraSearch::estIntraPredChromaQT( CodingUnit &cu, Partitioner &partitioner
       CodingStructure &saveCS = *m_pSaveCS[0];
       saveCS.pcv      = cs.pcv;
       saveCS.picture  = cs.picture;
+      saveCS.lumaCS   = cs.lumaCS;
       saveCS.area.repositionTo( cs.area );
       saveCS.clearTUs();
 
@@ -4035,6 +4065,7 @@ bool IntraSearch::xRecurIntraCodingLumaQT( CodingStructure &cs, Partitioner &par
     {
       saveCS.pcv     = cs.pcv;
       saveCS.picture = cs.picture;
+      saveCS.lumaCS  = cs.lumaCS;
       saveCS.area.repositionTo(cs.area);
       saveCS.clearTUs();
       tmpTU = &saveCS.addTU(currArea, partitioner.chType);
@@ -4537,6 +4568,7 @@ bool IntraSearch::xRecurIntraCodingACTQT(CodingStructure &cs, Partitioner &parti
     {
       saveLumaCS.pcv = csFull->pcv;
       saveLumaCS.picture = csFull->picture;
+      saveLumaCS.lumaCS = csFull->lumaCS;
       saveLumaCS.area.repositionTo(csFull->area);
       saveLumaCS.clearTUs();
       tmpTU = &saveLumaCS.addTU(currArea, partitioner.chType);
@@ -4754,6 +4786,7 @@ bool IntraSearch::xRecurIntraCodingACTQT(CodingStructure &cs, Partitioner &parti
     CodingStructure &saveChromaCS = *m_pSaveCS[1];
     saveChromaCS.pcv = csFull->pcv;
     saveChromaCS.picture = csFull->picture;
+    saveChromaCS.lumaCS = csFull->lumaCS;
     saveChromaCS.area.repositionTo(csFull->area);
     saveChromaCS.initStructData(MAX_INT, true);
     tmpTU = &saveChromaCS.addTU(currArea, partitioner.chType);
@@ -5188,6 +5221,7 @@ ChromaCbfs IntraSearch::xRecurIntraChromaCodingQT( CodingStructure &cs, Partitio
     CodingStructure &saveCS = *m_pSaveCS[1];
     saveCS.pcv      = cs.pcv;
     saveCS.picture  = cs.picture;
+    saveCS.lumaCS   = cs.lumaCS;
     saveCS.area.repositionTo( cs.area );
     saveCS.initStructData( MAX_INT, true );
 
@@ -412,6 +412,7 @@ public:
                                   );
 
   void destroy                    ();
+  void resetUnitCache             ();
 
   CodingStructure****getSplitCSBuf() { return m_pSplitCS; }
   CodingStructure****getFullCSBuf () { return m_pFullCS; }